@@ -0,0 +1,164 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "geometry/meshdata.hpp"
+
+namespace Benchmark {
+
+/**
+ * @brief The number of times every measurement is repeated, the fastest run
+ * is reported.
+ */
+static constexpr int c_repetitions = 5;
+
+/**
+ * @brief Measures the fastest run of a function.
+ * @tparam Func Callable without parameters.
+ * @param func The function to be measured.
+ * @return The duration of the fastest run in seconds.
+ */
+template <typename Func> double measureSeconds(const Func &func) {
+  double best = std::numeric_limits<double>::max();
+  for (int i = 0; i < c_repetitions; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double>(end - start).count());
+  }
+  return best;
+}
+
+/**
+ * @brief Prints a single line of measurement.
+ * @param name The name of the measured operation.
+ * @param seconds The measured duration.
+ * @param items The number of processed items, used for the throughput.
+ */
+inline void report(const std::string &name, double seconds,
+                   std::size_t items) {
+  std::cout << std::left << std::setw(48) << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(3)
+            << seconds * 1000.0 << " ms" << std::setw(14)
+            << std::setprecision(1) << items / seconds / 1.0e6 << " M/s"
+            << std::endl;
+}
+
+/**
+ * @brief Creates a closed mesh approximating a sphere with a noisy surface.
+ * @param triangle_count The approximate number of Triangles to create.
+ * @return The created mesh.
+ */
+inline Converter::MeshData makeSphere(std::size_t triangle_count) {
+  const auto segments = static_cast<std::size_t>(
+      std::max(2.0, std::sqrt(static_cast<double>(triangle_count) / 2.0)));
+  constexpr double pi = 3.141592653589793238;
+
+  std::mt19937 generator(42U);
+  std::uniform_real_distribution<double> noise(0.95, 1.05);
+
+  const auto point = [segments](std::size_t i, std::size_t j, double radius) {
+    const double theta = pi * static_cast<double>(i) / segments;
+    const double phi = 2.0 * pi * static_cast<double>(j % segments) / segments;
+    return Eigen::Vector4d{radius * std::sin(theta) * std::cos(phi),
+                           radius * std::sin(theta) * std::sin(phi),
+                           radius * std::cos(theta), 1.0};
+  };
+
+  // The poles have a single radius, so the mesh stays closed.
+  std::vector<double> radii((segments + 1U) * segments, 100.0);
+  for (std::size_t i = segments; i < segments * segments; ++i) {
+    radii[i] = 100.0 * noise(generator);
+  }
+  const auto vertex = [&](std::size_t i, std::size_t j) {
+    return point(i, j, radii[i * segments + j % segments]);
+  };
+
+  Converter::MeshData mesh;
+  mesh.triangles.reserve(2U * segments * segments);
+  for (std::size_t i = 0U; i < segments; ++i) {
+    for (std::size_t j = 0U; j < segments; ++j) {
+      mesh.triangles.push_back(
+          {vertex(i, j), vertex(i + 1U, j), vertex(i + 1U, j + 1U)});
+      mesh.triangles.push_back(
+          {vertex(i, j), vertex(i + 1U, j + 1U), vertex(i, j + 1U)});
+    }
+  }
+  return mesh;
+}
+
+/**
+ * @brief Runs the area and volume reduction benchmarks.
+ * @param mesh The mesh to be measured.
+ */
+void runReductionBenchmarks(const Converter::MeshData &mesh);
+
+/**
+ * @brief Runs the mesh transformation benchmarks.
+ * @param mesh The mesh to be measured.
+ */
+void runTransformBenchmarks(const Converter::MeshData &mesh);
+
+/**
+ * @brief Runs the ray-triangle intersection benchmarks.
+ * @param mesh The mesh to be measured.
+ */
+void runRayBenchmarks(const Converter::MeshData &mesh);
+
+/**
+ * @brief Runs the vertex welding benchmarks with one and with every thread,
+ * and the validation and the normals of the welded mesh.
+ * @param mesh The mesh to be measured.
+ */
+void runWeldBenchmarks(const Converter::MeshData &mesh);
+
+/**
+ * @brief Runs the solid voxelization benchmarks at two resolutions.
+ * @param mesh The mesh to be measured.
+ */
+void runVoxelBenchmarks(const Converter::MeshData &mesh);
+
+/**
+ * @brief Runs the slicing benchmarks at two layer heights.
+ * @param mesh The mesh to be measured.
+ */
+void runSliceBenchmarks(const Converter::MeshData &mesh);
+
+/**
+ * @brief Runs the convex hull benchmark.
+ * @param mesh The mesh to be measured.
+ */
+void runHullBenchmarks(const Converter::MeshData &mesh);
+
+/**
+ * @brief Runs the bounding volume benchmark.
+ * @param mesh The mesh to be measured.
+ */
+void runBoundingVolumeBenchmarks(const Converter::MeshData &mesh);
+
+/**
+ * @brief Runs the self-intersection and interference benchmarks.
+ * @param mesh The mesh to be measured.
+ */
+void runIntersectionBenchmarks(const Converter::MeshData &mesh);
+
+/**
+ * @brief Runs the mesh distance benchmark.
+ * @param mesh The mesh to be measured.
+ */
+void runDistanceBenchmarks(const Converter::MeshData &mesh);
+
+} // namespace Benchmark
+
+#endif
@@ -0,0 +1,22 @@
+#include <iostream>
+
+#include "benchmark.hpp"
+#include "geometry/bounding_volumes.hpp"
+#include "geometry/meshdata.hpp"
+
+using namespace Converter;
+
+namespace Benchmark {
+
+void runBoundingVolumeBenchmarks(const MeshData &mesh) {
+  BoundingVolumes volumes;
+  const double seconds =
+      measureSeconds([&]() { volumes = BoundingVolumes::calculate(mesh); });
+  report("BoundingVolumes::calculate (triangles)", seconds,
+         mesh.triangles.size());
+  std::cout << "Oriented box volume: " << volumes.getOrientedBox().getVolume()
+            << " of " << volumes.getAxisAlignedBox().volume()
+            << ", sphere radius: " << volumes.getSphere().radius << std::endl;
+}
+
+} // namespace Benchmark
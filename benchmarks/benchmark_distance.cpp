@@ -0,0 +1,28 @@
+#include <Eigen/Dense>
+#include <iostream>
+
+#include "benchmark.hpp"
+#include "geometry/mesh_distance.hpp"
+#include "geometry/meshdata.hpp"
+#include "utility.hpp"
+
+using namespace Converter;
+
+namespace Benchmark {
+
+void runDistanceBenchmarks(const MeshData &mesh) {
+  MeshData moved = mesh;
+  moved.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{1.0, 0.5, 0.0}),
+      Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity());
+  const std::size_t sample_count = mesh.triangles.size();
+  MeshDistance distance;
+  const double seconds = measureSeconds([&]() {
+    distance = MeshDistance::compare(mesh, moved, sample_count);
+  });
+  report("MeshDistance::compare (samples)", seconds, 2U * sample_count);
+  std::cout << "Hausdorff distance: " << distance.getHausdorff()
+            << ", RMS distance: " << distance.getRms() << std::endl;
+}
+
+} // namespace Benchmark
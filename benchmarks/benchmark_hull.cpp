@@ -0,0 +1,20 @@
+#include <iostream>
+
+#include "benchmark.hpp"
+#include "geometry/convex_hull.hpp"
+#include "geometry/meshdata.hpp"
+
+using namespace Converter;
+
+namespace Benchmark {
+
+void runHullBenchmarks(const MeshData &mesh) {
+  MeshData hull;
+  const double seconds =
+      measureSeconds([&]() { hull = ConvexHull::calculate(mesh); });
+  report("ConvexHull::calculate (triangles)", seconds,
+         mesh.triangles.size());
+  std::cout << "Hull triangles: " << hull.triangles.size() << std::endl;
+}
+
+} // namespace Benchmark
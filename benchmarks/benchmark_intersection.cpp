@@ -0,0 +1,34 @@
+#include <Eigen/Dense>
+#include <iostream>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "geometry/mesh_intersection.hpp"
+#include "geometry/meshdata.hpp"
+#include "utility.hpp"
+
+using namespace Converter;
+
+namespace Benchmark {
+
+void runIntersectionBenchmarks(const MeshData &mesh) {
+  std::vector<MeshIntersection::Pair> pairs;
+  double seconds = measureSeconds(
+      [&]() { pairs = MeshIntersection::findSelfIntersections(mesh); });
+  report("MeshIntersection::findSelfIntersections (triangles)", seconds,
+         mesh.triangles.size());
+  std::cout << "Self-intersecting pairs: " << pairs.size() << std::endl;
+
+  // A slightly moved copy crosses the noisy surface everywhere.
+  MeshData moved = mesh;
+  moved.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{1.0, 0.5, 0.0}),
+      Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity());
+  seconds = measureSeconds(
+      [&]() { pairs = MeshIntersection::findInterference(mesh, moved); });
+  report("MeshIntersection::findInterference (triangles)", seconds,
+         2U * mesh.triangles.size());
+  std::cout << "Interfering pairs: " << pairs.size() << std::endl;
+}
+
+} // namespace Benchmark
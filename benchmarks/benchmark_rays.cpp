@@ -0,0 +1,117 @@
+#include <Eigen/Dense>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "geometry/closest_point_query.hpp"
+#include "geometry/distance_field.hpp"
+#include "geometry/meshdata.hpp"
+#include "geometry/triangle_packet.hpp"
+
+using namespace Converter;
+
+namespace {
+
+/**
+ * @brief The number of rays shot at the whole mesh.
+ */
+constexpr std::size_t c_ray_count = 16U;
+
+/**
+ * @brief The number of closest point queries.
+ */
+constexpr std::size_t c_query_count = 100000U;
+
+// The per Triangle test MeshData::isPointInside used before the packets.
+std::size_t referenceHitCount(const MeshData &mesh,
+                              const Eigen::Vector4d &origin) {
+  std::size_t hit_count = 0U;
+  for (const auto &triangle : mesh.triangles) {
+    if (triangle.rayIntersection(origin, {0.0, 1.0, 0.0, 0.0})) {
+      ++hit_count;
+    }
+  }
+  return hit_count;
+}
+
+std::size_t packetHitCount(const MeshData &mesh,
+                           const Eigen::Vector4d &origin) {
+  const TrianglePacket::Ray ray(origin, {0.0, 1.0, 0.0, 0.0});
+  std::size_t hit_count = 0U;
+  for (const auto &packet : mesh.getPackets()) {
+    hit_count += packet.intersect(ray).hit.count();
+  }
+  return hit_count;
+}
+
+} // namespace
+
+namespace Benchmark {
+
+void runRayBenchmarks(const MeshData &mesh) {
+  std::vector<Eigen::Vector4d> origins;
+  for (std::size_t i = 0U; i < c_ray_count; ++i) {
+    const double offset = static_cast<double>(i) / c_ray_count - 0.5;
+    origins.push_back({50.0 * offset, -20.0, 30.0 * offset, 1.0});
+  }
+  // Builds the caches outside of the measurement.
+  mesh.getPackets();
+  mesh.getPlanes();
+
+  const std::size_t tests = c_ray_count * mesh.triangles.size();
+  std::size_t hit_count = 0U;
+  report("Triangle::rayIntersection (ray-triangle tests)",
+         measureSeconds([&]() {
+           for (const auto &origin : origins) {
+             hit_count += referenceHitCount(mesh, origin);
+           }
+         }),
+         tests);
+  report("TrianglePacket::intersect (ray-triangle tests)",
+         measureSeconds([&]() {
+           for (const auto &origin : origins) {
+             hit_count += packetHitCount(mesh, origin);
+           }
+         }),
+         tests);
+  report("MeshData::isPointInside (ray-triangle tests)",
+         measureSeconds([&]() {
+           for (const auto &origin : origins) {
+             hit_count += mesh.isPointInside(origin);
+           }
+         }),
+         tests);
+  std::cout << "Hits: " << hit_count << std::endl;
+
+  // Probe points within 20 percent of the radius of the sphere surface.
+  std::vector<Eigen::Vector4d> points;
+  for (std::size_t i = 0U; i < c_query_count; ++i) {
+    const double t = static_cast<double>(i) / c_query_count;
+    const Eigen::Vector3d direction =
+        Eigen::Vector3d{std::sin(37.0 * t), std::cos(91.0 * t), 2.0 * t - 1.0}
+            .normalized();
+    const double radius = 80.0 + 40.0 * std::fmod(13.0 * t, 1.0);
+    points.push_back({radius * direction.x(), radius * direction.y(),
+                      radius * direction.z(), 1.0});
+  }
+  const ClosestPointQuery query(mesh);
+  double distance_sum = 0.0;
+  report("ClosestPointQuery::findClosestPoints (queries)",
+         measureSeconds([&]() {
+           for (const auto &result : query.findClosestPoints(points)) {
+             distance_sum += result->distance;
+           }
+         }),
+         c_query_count);
+  std::cout << "Distance sum: " << distance_sum << std::endl;
+
+  const DistanceField::Settings settings;
+  std::size_t voxel_count = 0U;
+  const double seconds = measureSeconds([&]() {
+    voxel_count = DistanceField::generate(mesh, settings).getValues().size();
+  });
+  report("DistanceField::generate (voxels)", seconds, voxel_count);
+}
+
+} // namespace Benchmark
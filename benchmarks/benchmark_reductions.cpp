@@ -0,0 +1,47 @@
+#include <cmath>
+#include <iostream>
+
+#include "benchmark.hpp"
+#include "geometry/meshdata.hpp"
+
+using namespace Converter;
+
+namespace {
+
+// The serial loops MeshData used before the parallel reductions.
+double referenceSurfaceArea(const MeshData &mesh) {
+  double surface_area = 0.0;
+  for (const auto &triangle : mesh.triangles) {
+    surface_area += triangle.getArea();
+  }
+  return surface_area;
+}
+
+double referenceVolume(const MeshData &mesh) {
+  double volume = 0.0;
+  for (const auto &triangle : mesh.triangles) {
+    volume += triangle.a.pos.cross3(triangle.b.pos).dot(triangle.c.pos);
+  }
+  return std::abs(volume / 6.0);
+}
+
+} // namespace
+
+namespace Benchmark {
+
+void runReductionBenchmarks(const MeshData &mesh) {
+  const std::size_t size = mesh.triangles.size();
+  volatile double sink = 0.0;
+
+  report("serial loop surface area",
+         measureSeconds([&]() { sink = referenceSurfaceArea(mesh); }), size);
+  report("MeshData::calculateSurfaceArea",
+         measureSeconds([&]() { sink = mesh.calculateSurfaceArea(); }), size);
+  report("serial loop volume",
+         measureSeconds([&]() { sink = referenceVolume(mesh); }), size);
+  report("MeshData::calculateVolume",
+         measureSeconds([&]() { sink = mesh.calculateVolume(); }), size);
+  (void)sink;
+}
+
+} // namespace Benchmark
@@ -0,0 +1,29 @@
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include "benchmark.hpp"
+#include "geometry/meshdata.hpp"
+#include "geometry/slice_stack.hpp"
+
+using namespace Converter;
+
+namespace Benchmark {
+
+void runSliceBenchmarks(const MeshData &mesh) {
+  for (const double layer_height : {1.0, 0.2}) {
+    std::size_t layer_count = 0U;
+    std::size_t open_count = 0U;
+    const double seconds = measureSeconds([&]() {
+      const auto stack = SliceStack::slice(mesh, layer_height);
+      layer_count = stack.getLayers().size();
+      open_count = stack.countOpenContours();
+    });
+    report("SliceStack::slice " + std::to_string(layer_count) +
+               " layers (triangles)",
+           seconds, mesh.triangles.size());
+    std::cout << "Open contours: " << open_count << std::endl;
+  }
+}
+
+} // namespace Benchmark
@@ -0,0 +1,40 @@
+#include <Eigen/Dense>
+
+#include "benchmark.hpp"
+#include "geometry/affine_transform.hpp"
+#include "geometry/meshdata.hpp"
+#include "utility.hpp"
+
+using namespace Converter;
+
+namespace Benchmark {
+
+void runTransformBenchmarks(const MeshData &mesh) {
+  const std::size_t size = mesh.triangles.size();
+  const Eigen::Matrix4d general =
+      Utility::getTranslationMatrix({1.0, 2.0, 3.0}) *
+      Utility::getRotationMatrix({1.0, 1.0, 0.0}, 0.3) *
+      Utility::getScaleMatrix({1.0, 2.0, 3.0});
+  const Eigen::Matrix4d normal_matrix = general.inverse().transpose();
+  const Eigen::Matrix4d translation =
+      Utility::getTranslationMatrix({1.0, 2.0, 3.0});
+
+  MeshData copy = mesh;
+  report("Triangle::transform loop",
+         measureSeconds([&]() {
+           for (auto &triangle : copy.triangles) {
+             triangle.transform(general, normal_matrix);
+           }
+         }),
+         size);
+  report("AffineTransform general",
+         measureSeconds(
+             [&]() { AffineTransform(general).apply(copy.triangles); }),
+         size);
+  report("AffineTransform translation",
+         measureSeconds(
+             [&]() { AffineTransform(translation).apply(copy.triangles); }),
+         size);
+}
+
+} // namespace Benchmark
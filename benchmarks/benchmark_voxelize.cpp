@@ -0,0 +1,26 @@
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include "benchmark.hpp"
+#include "geometry/meshdata.hpp"
+#include "geometry/voxel_grid.hpp"
+
+using namespace Converter;
+
+namespace Benchmark {
+
+void runVoxelBenchmarks(const MeshData &mesh) {
+  for (const std::size_t resolution : {256U, 1024U}) {
+    std::size_t filled_count = 0U;
+    const double seconds = measureSeconds([&]() {
+      filled_count = VoxelGrid::voxelize(mesh, resolution).countFilled();
+    });
+    report("VoxelGrid::voxelize " + std::to_string(resolution) +
+               "^3 (triangles)",
+           seconds, mesh.triangles.size());
+    std::cout << "Filled voxels: " << filled_count << std::endl;
+  }
+}
+
+} // namespace Benchmark
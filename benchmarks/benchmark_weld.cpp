@@ -0,0 +1,51 @@
+#include <string>
+
+#include "benchmark.hpp"
+#include "geometry/indexed_mesh.hpp"
+#include "geometry/mesh_statistics.hpp"
+#include "geometry/mesh_validation.hpp"
+#include "geometry/meshdata.hpp"
+#include "geometry/vertex_normals.hpp"
+#include "parallel.hpp"
+
+using namespace Converter;
+
+namespace Benchmark {
+
+void runWeldBenchmarks(const MeshData &mesh) {
+  // Clusters to roughly a hundred cells along the longest axis.
+  const double cell_size =
+      MeshStatistics::calculate(mesh).getBoundingBox().sizes().maxCoeff() /
+      100.0;
+
+  const unsigned int thread_count = Parallel::getThreadCount();
+  for (const unsigned int threads : {1U, thread_count}) {
+    Parallel::setThreadCount(threads);
+    report("IndexedMesh::weld, " + std::to_string(threads) + " threads",
+           measureSeconds([&]() { IndexedMesh::weld(mesh, 0.0); }),
+           mesh.triangles.size());
+    report("IndexedMesh::cluster, " + std::to_string(threads) + " threads",
+           measureSeconds([&]() { IndexedMesh::cluster(mesh, cell_size); }),
+           mesh.triangles.size());
+  }
+  Parallel::setThreadCount(0U);
+
+  const auto indexed_mesh = IndexedMesh::weld(mesh, 0.0);
+  report("MeshValidation::validate",
+         measureSeconds([&]() { MeshValidation::validate(indexed_mesh); }),
+         mesh.triangles.size());
+  report("VertexNormals::calculate, area",
+         measureSeconds([&]() {
+           VertexNormals::calculate(indexed_mesh,
+                                    VertexNormals::Weighting::AREA);
+         }),
+         mesh.triangles.size());
+  report("VertexNormals::calculate, angle, crease",
+         measureSeconds([&]() {
+           VertexNormals::calculate(indexed_mesh,
+                                    VertexNormals::Weighting::ANGLE, 0.5);
+         }),
+         mesh.triangles.size());
+}
+
+} // namespace Benchmark
@@ -0,0 +1,30 @@
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include "benchmark.hpp"
+#include "parallel.hpp"
+
+int main(int argc, char *argv[]) {
+  std::size_t triangle_count = 2000000U;
+  if (argc > 1) {
+    triangle_count = std::stoul(argv[1]);
+  }
+
+  const auto mesh = Benchmark::makeSphere(triangle_count);
+  std::cout << "Triangles: " << mesh.triangles.size()
+            << ", threads: " << Converter::Parallel::getThreadCount()
+            << std::endl;
+
+  Benchmark::runReductionBenchmarks(mesh);
+  Benchmark::runTransformBenchmarks(mesh);
+  Benchmark::runRayBenchmarks(mesh);
+  Benchmark::runWeldBenchmarks(mesh);
+  Benchmark::runVoxelBenchmarks(mesh);
+  Benchmark::runSliceBenchmarks(mesh);
+  Benchmark::runHullBenchmarks(mesh);
+  Benchmark::runBoundingVolumeBenchmarks(mesh);
+  Benchmark::runIntersectionBenchmarks(mesh);
+  Benchmark::runDistanceBenchmarks(mesh);
+  return 0;
+}
@@ -0,0 +1,136 @@
+#include <Eigen/Dense>
+#include <cstddef>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "parallel.hpp"
+#include "triangle.hpp"
+#include "vertexdata.hpp"
+
+namespace Converter {
+
+namespace {
+
+// The kernel maps the positions and normals of consecutive Triangles as
+// strided matrices, which relies on Triangle being three tightly packed
+// VertexData objects made of three Eigen::Vector4d each.
+constexpr int c_vertex_stride = 12;
+static_assert(sizeof(VertexData) == c_vertex_stride * sizeof(double),
+              "VertexData has an unexpected layout.");
+static_assert(sizeof(Triangle) == 3U * sizeof(VertexData),
+              "Triangle has an unexpected layout.");
+
+using StridedVectors =
+    Eigen::Map<Eigen::Matrix<double, 4, Eigen::Dynamic>, Eigen::Unaligned,
+               Eigen::OuterStride<c_vertex_stride>>;
+
+AffineTransform::Kind classify(const Eigen::Matrix<double, 3, 4> &matrix) {
+  const Eigen::Matrix3d linear = matrix.leftCols<3>();
+  const bool has_translation = !matrix.col(3).isZero(0.0);
+
+  if (linear == Eigen::Matrix3d::Identity()) {
+    return has_translation ? AffineTransform::Kind::TRANSLATION
+                           : AffineTransform::Kind::IDENTITY;
+  }
+  if (linear == linear(0, 0) * Eigen::Matrix3d::Identity()) {
+    return AffineTransform::Kind::UNIFORM_SCALE;
+  }
+  return AffineTransform::Kind::GENERAL;
+}
+
+} // namespace
+
+AffineTransform::AffineTransform()
+    : matrix(Eigen::Matrix<double, 3, 4>::Identity()),
+      normal_matrix(Eigen::Matrix3d::Identity()), kind(Kind::IDENTITY) {}
+
+AffineTransform::AffineTransform(const Eigen::Matrix4d &homogeneous_matrix)
+    : matrix(homogeneous_matrix.topRows<3>()),
+      normal_matrix(
+          homogeneous_matrix.topLeftCorner<3, 3>().inverse().transpose()),
+      kind(classify(matrix)) {}
+
+Eigen::Matrix4d AffineTransform::getMatrix() const {
+  Eigen::Matrix4d result = Eigen::Matrix4d::Identity();
+  result.topRows<3>() = matrix;
+  return result;
+}
+
+AffineTransform AffineTransform::getInverse() const {
+  Eigen::Matrix4d inverse = Eigen::Matrix4d::Identity();
+  inverse.topLeftCorner<3, 3>() = normal_matrix.transpose();
+  inverse.topRightCorner<3, 1>() = -normal_matrix.transpose() * matrix.col(3);
+  return AffineTransform(inverse);
+}
+
+AffineTransform AffineTransform::
+operator*(const AffineTransform &other) const {
+  return AffineTransform(getMatrix() * other.getMatrix());
+}
+
+Eigen::Vector4d
+AffineTransform::transformPoint(const Eigen::Vector4d &point) const {
+  Eigen::Vector4d result = point;
+  result.head<3>() = matrix * point;
+  return result;
+}
+
+Eigen::Vector4d
+AffineTransform::transformDirection(const Eigen::Vector4d &direction) const {
+  Eigen::Vector4d result = Eigen::Vector4d::Zero();
+  result.head<3>() = matrix.leftCols<3>() * direction.head<3>();
+  return result;
+}
+
+void AffineTransform::apply(Triangle &triangle) const {
+  applyToBlock(&triangle, 1U);
+}
+
+void AffineTransform::apply(std::vector<Triangle> &triangles) const {
+  if (kind == Kind::IDENTITY) {
+    return;
+  }
+
+  Parallel::forEachBlock(triangles.size(), Parallel::c_block_size,
+                         [this, &triangles](std::size_t, std::size_t begin,
+                                            std::size_t end) {
+                           applyToBlock(triangles.data() + begin, end - begin);
+                         });
+}
+
+void AffineTransform::applyToBlock(Triangle *triangles,
+                                   std::size_t count) const {
+  const auto vertex_count = static_cast<Eigen::Index>(3U * count);
+  StridedVectors positions(triangles->a.pos.data(), 4, vertex_count);
+  StridedVectors normals(triangles->a.normal.data(), 4, vertex_count);
+
+  // The translation is scaled by the homogeneous coordinate, the same way as
+  // a 4x4 matrix product would do it.
+  switch (kind) {
+  case Kind::IDENTITY:
+    return;
+  case Kind::TRANSLATION:
+    positions.topRows<3>() += matrix.col(3) * positions.row(3);
+    // Normals are not affected by translations.
+    return;
+  case Kind::UNIFORM_SCALE:
+    positions.topRows<3>() = matrix(0, 0) * positions.topRows<3>() +
+                             matrix.col(3) * positions.row(3);
+    // Normalizing cancels the scaling, only a negative scale has an effect.
+    if (matrix(0, 0) < 0.0) {
+      normals.topRows<3>() *= -1.0;
+    }
+    return;
+  case Kind::GENERAL:
+    positions.topRows<3>() = matrix * positions;
+    if (!normals.topRows<3>().isZero(0.0)) {
+      normals.topRows<3>() = normal_matrix * normals.topRows<3>();
+      for (Eigen::Index i = 0; i < vertex_count; ++i) {
+        normals.col(i).normalize();
+      }
+    }
+    return;
+  }
+}
+
+} // namespace Converter
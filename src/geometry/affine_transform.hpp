@@ -0,0 +1,122 @@
+#ifndef AFFINE_TRANSFORM_HPP
+#define AFFINE_TRANSFORM_HPP
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <vector>
+
+#include "triangle.hpp"
+
+namespace Converter {
+
+/**
+ * @brief An affine transformation applicable to whole meshes.
+ * @details Only the upper 3x4 part of the homogeneous matrix is stored, since
+ * the last row of an affine transformation is always (0, 0, 0, 1). The kind of
+ * the transformation is determined at construction, so a pure translation or
+ * a uniform scale is applied with less work than a general matrix.
+ */
+class AffineTransform {
+public:
+  /**
+   * @brief The kinds of transformations with specialized implementations.
+   */
+  enum class Kind { IDENTITY, TRANSLATION, UNIFORM_SCALE, GENERAL };
+
+  /**
+   * @brief Default constructor, creates the identity transformation.
+   */
+  AffineTransform();
+
+  /**
+   * @brief Creates the transformation from a homogeneous matrix.
+   * @param homogeneous_matrix The matrix, its last row is ignored.
+   */
+  explicit AffineTransform(const Eigen::Matrix4d &homogeneous_matrix);
+
+  /**
+   * @brief Returns the kind of the transformation.
+   * @return The kind of the transformation.
+   */
+  Kind getKind() const { return kind; }
+
+  /**
+   * @brief Returns the transformation as a homogeneous matrix.
+   * @return The 4x4 matrix of the transformation.
+   */
+  Eigen::Matrix4d getMatrix() const;
+
+  /**
+   * @brief Returns the matrix transforming the normal vectors.
+   * @return The inverse transpose of the linear part.
+   */
+  const Eigen::Matrix3d &getNormalMatrix() const { return normal_matrix; }
+
+  /**
+   * @brief Returns the inverse transformation.
+   * @return The transformation undoing this one.
+   */
+  AffineTransform getInverse() const;
+
+  /**
+   * @brief Returns the transformation applying other first and this second.
+   * @param other The transformation to be applied first.
+   * @return The composed transformation.
+   */
+  AffineTransform operator*(const AffineTransform &other) const;
+
+  /**
+   * @brief Transforms a single point.
+   * @param point The point in homogeneous coordinates.
+   * @return The transformed point.
+   */
+  Eigen::Vector4d transformPoint(const Eigen::Vector4d &point) const;
+
+  /**
+   * @brief Transforms a single direction, ignoring the translation.
+   * @param direction The direction, its fourth coordinate is ignored.
+   * @return The transformed direction, with zero as the fourth coordinate.
+   */
+  Eigen::Vector4d transformDirection(const Eigen::Vector4d &direction) const;
+
+  /**
+   * @brief Transforms a single Triangle.
+   * @details The normals are transformed with the normal matrix and
+   * normalized, normals that were not set are left untouched.
+   * @param triangle The Triangle to be transformed.
+   */
+  void apply(Triangle &triangle) const;
+
+  /**
+   * @brief Transforms every Triangle, using multiple threads.
+   * @details The positions are processed as 3x4 matrix products over blocks
+   * of vertices, blocks without normals skip the normal transformation.
+   * @param triangles The Triangles to be transformed.
+   */
+  void apply(std::vector<Triangle> &triangles) const;
+
+private:
+  /**
+   * @brief Holds the upper 3 rows of the homogeneous matrix.
+   */
+  Eigen::Matrix<double, 3, 4> matrix;
+  /**
+   * @brief Holds the inverse transpose of the linear part.
+   */
+  Eigen::Matrix3d normal_matrix;
+  /**
+   * @brief Holds the kind of the transformation.
+   */
+  Kind kind;
+
+  /**
+   * @brief Transforms a range of Triangles on the calling thread.
+   * @param triangles The first Triangle to be transformed.
+   * @param count The number of Triangles to be transformed.
+   */
+  void applyToBlock(Triangle *triangles, std::size_t count) const;
+};
+
+} // namespace Converter
+
+#endif
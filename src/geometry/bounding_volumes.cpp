@@ -0,0 +1,481 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "bounding_volumes.hpp"
+#include "convex_hull.hpp"
+#include "meshdata.hpp"
+#include "parallel.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief The seed of the order in which Welzl's algorithm visits the points.
+ */
+constexpr std::mt19937::result_type c_sphere_seed = 5489U;
+
+/**
+ * @brief The ratio of the volume of a degenerate simplex to the product of
+ * its edge lengths, below which it is treated as flat.
+ */
+constexpr double c_degenerate_ratio = 1e-12;
+
+/**
+ * @brief Fits a box with the given axes around points.
+ * @param points The points to be enclosed.
+ * @param axes The directions of the edges as the columns of a rotation.
+ * @return The smallest box with these axes.
+ */
+BoundingVolumes::OrientedBox fitBox(const std::vector<Eigen::Vector3d> &points,
+                                    const Eigen::Matrix3d &axes) {
+  Eigen::AlignedBox3d box;
+  for (const auto &point : points) {
+    box.extend(Eigen::Vector3d(axes.transpose() * point));
+  }
+  BoundingVolumes::OrientedBox result;
+  result.axes = axes;
+  result.center = axes * box.center();
+  result.half_sizes = box.sizes() / 2.0;
+  return result;
+}
+
+/**
+ * @brief Calculates the cross product of two planar vectors.
+ */
+double cross(const Eigen::Vector2d &first, const Eigen::Vector2d &second) {
+  return first.x() * second.y() - first.y() * second.x();
+}
+
+/**
+ * @brief Calculates the convex hull of planar points with Andrew's monotone
+ * chain algorithm.
+ * @param points The points, which are sorted.
+ * @return The vertices of the hull in counterclockwise order without
+ * collinear ones.
+ */
+std::vector<Eigen::Vector2d> calculateHull(
+    std::vector<Eigen::Vector2d> &points) {
+  std::sort(points.begin(), points.end(),
+            [](const Eigen::Vector2d &first, const Eigen::Vector2d &second) {
+              return first.x() < second.x() ||
+                     (first.x() == second.x() && first.y() < second.y());
+            });
+  std::vector<Eigen::Vector2d> hull(2U * points.size());
+  std::size_t size = 0U;
+  const auto addPoint = [&hull, &size](const Eigen::Vector2d &point,
+                                       std::size_t lower_size) {
+    while (size > lower_size &&
+           cross(hull[size - 1U] - hull[size - 2U], point - hull[size - 2U]) <=
+               0.0) {
+      --size;
+    }
+    hull[size++] = point;
+  };
+  for (const auto &point : points) {
+    addPoint(point, 1U);
+  }
+  const std::size_t lower_size = size;
+  for (std::size_t i = points.size() - 1U; i-- > 0U;) {
+    addPoint(points[i], lower_size);
+  }
+  // The first point is repeated at the end.
+  hull.resize(size > 0U ? size - 1U : 0U);
+  return hull;
+}
+
+/**
+ * @brief Fits the smallest box with one edge along an axis around points.
+ * @details The points are projected onto the plane orthogonal to the axis,
+ * where the minimum area rectangle has a side on their hull. Rotating
+ * calipers walk the extreme points along each hull edge and across it in
+ * linear time.
+ * @param points The points to be enclosed.
+ * @param axis The unit direction of one edge of the box.
+ * @return The box.
+ */
+BoundingVolumes::OrientedBox fitBoxAround(
+    const std::vector<Eigen::Vector3d> &points, const Eigen::Vector3d &axis) {
+  const Eigen::Vector3d u = axis.unitOrthogonal();
+  const Eigen::Vector3d v = axis.cross(u);
+  std::vector<Eigen::Vector2d> projections;
+  projections.reserve(points.size());
+  for (const auto &point : points) {
+    projections.emplace_back(u.dot(point), v.dot(point));
+  }
+  const auto hull = calculateHull(projections);
+  Eigen::Matrix3d axes;
+  if (hull.size() < 3U) {
+    axes << u, v, axis;
+    return fitBox(points, axes);
+  }
+
+  const std::size_t size = hull.size();
+  const auto at = [&hull, size](std::size_t i) -> const Eigen::Vector2d & {
+    return hull[i % size];
+  };
+  double min_area = std::numeric_limits<double>::infinity();
+  Eigen::Vector2d best_direction = Eigen::Vector2d::UnitX();
+  // The points farthest along the edge, across it and against it only move
+  // forward as the edge rotates counterclockwise.
+  std::size_t right = 1U;
+  std::size_t far = 1U;
+  std::size_t left = 1U;
+  for (std::size_t i = 0U; i < size; ++i) {
+    const Eigen::Vector2d direction = (at(i + 1U) - at(i)).normalized();
+    right = std::max(right, i + 1U);
+    while (right < i + size &&
+           direction.dot(at(right + 1U) - at(right)) > 0.0) {
+      ++right;
+    }
+    far = std::max(far, right);
+    while (far < i + size && cross(direction, at(far + 1U) - at(far)) > 0.0) {
+      ++far;
+    }
+    left = std::max(left, far);
+    while (left < i + size && direction.dot(at(left + 1U) - at(left)) < 0.0) {
+      ++left;
+    }
+    const double width =
+        direction.dot(at(right) - at(i)) - direction.dot(at(left) - at(i));
+    const double height = cross(direction, at(far) - at(i));
+    if (width * height < min_area) {
+      min_area = width * height;
+      best_direction = direction;
+    }
+  }
+
+  const Eigen::Vector3d first = best_direction.x() * u + best_direction.y() * v;
+  axes << first, axis.cross(first), axis;
+  return fitBox(points, axes);
+}
+
+/**
+ * @brief Compares boxes by volume, and flat boxes by area.
+ * @return True if the first box is smaller than the second.
+ */
+bool isSmaller(const BoundingVolumes::OrientedBox &first,
+               const BoundingVolumes::OrientedBox &second) {
+  const auto getArea = [](const Eigen::Vector3d &sizes) {
+    return sizes.x() * sizes.y() + sizes.y() * sizes.z() +
+           sizes.z() * sizes.x();
+  };
+  return std::make_pair(first.getVolume(), getArea(first.half_sizes)) <
+         std::make_pair(second.getVolume(), getArea(second.half_sizes));
+}
+
+/**
+ * @brief Fits a tight box around the vertices of a convex hull.
+ * @param points The vertices of the hull relative to a point close to
+ * their center.
+ * @param hull The Triangles of the hull in the same coordinates, empty if
+ * the points are in a plane.
+ * @return The smallest box found.
+ */
+BoundingVolumes::OrientedBox fitOrientedBox(
+    const std::vector<Eigen::Vector3d> &points, const MeshData &hull) {
+  // The covariance of the hull surface, or of the points if it is flat.
+  std::vector<std::pair<double, Eigen::Vector3d>> normals;
+  double total_weight = 0.0;
+  Eigen::Vector3d moment = Eigen::Vector3d::Zero();
+  Eigen::Matrix3d second_moment = Eigen::Matrix3d::Zero();
+  for (const auto &triangle : hull.triangles) {
+    const Eigen::Vector3d a = triangle.a.pos.head<3>();
+    const Eigen::Vector3d b = triangle.b.pos.head<3>();
+    const Eigen::Vector3d c = triangle.c.pos.head<3>();
+    const Eigen::Vector3d normal = (b - a).cross(c - a);
+    const double area = normal.norm() / 2.0;
+    const Eigen::Vector3d center = (a + b + c) / 3.0;
+    total_weight += area;
+    moment += area * center;
+    second_moment += area / 12.0 *
+                     (9.0 * center * center.transpose() + a * a.transpose() +
+                      b * b.transpose() + c * c.transpose());
+    if (area > 0.0) {
+      normals.emplace_back(area, normal.normalized());
+    }
+  }
+  if (total_weight == 0.0) {
+    total_weight = static_cast<double>(points.size());
+    for (const auto &point : points) {
+      moment += point;
+      second_moment += point * point.transpose();
+    }
+  }
+  const Eigen::Vector3d mean = moment / total_weight;
+  const Eigen::Matrix3d covariance =
+      second_moment / total_weight - mean * mean.transpose();
+  const Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(covariance);
+  Eigen::Matrix3d principal_axes = solver.eigenvectors();
+  if (principal_axes.determinant() < 0.0) {
+    principal_axes.col(2) = -principal_axes.col(2);
+  }
+
+  // The boxes along the coordinate and principal axes, then refined around
+  // the principal axes and the normals of the largest faces.
+  auto best = fitBox(points, Eigen::Matrix3d::Identity());
+  const auto tryBox = [&best](const BoundingVolumes::OrientedBox &box) {
+    if (isSmaller(box, best)) {
+      best = box;
+    }
+  };
+  tryBox(fitBox(points, principal_axes));
+  std::vector<Eigen::Vector3d> candidates;
+  for (Eigen::Index i = 0; i < 3; ++i) {
+    candidates.push_back(principal_axes.col(i));
+  }
+  const std::size_t face_count =
+      std::min(normals.size(), BoundingVolumes::c_candidate_face_count);
+  std::partial_sort(normals.begin(), normals.begin() + face_count,
+                    normals.end(), [](const auto &first, const auto &second) {
+                      return first.first > second.first;
+                    });
+  for (std::size_t i = 0U; i < face_count; ++i) {
+    const auto &normal = normals[i].second;
+    if (std::none_of(candidates.begin(), candidates.end(),
+                     [&normal](const Eigen::Vector3d &candidate) {
+                       return std::abs(candidate.dot(normal)) >
+                              1.0 - c_degenerate_ratio;
+                     })) {
+      candidates.push_back(normal);
+    }
+  }
+  for (const auto &candidate : candidates) {
+    tryBox(fitBoxAround(points, candidate));
+  }
+  return best;
+}
+
+/**
+ * @brief Calculates the smallest sphere with two points on its surface.
+ */
+BoundingVolumes::Sphere makeSphere(const Eigen::Vector3d &a,
+                                   const Eigen::Vector3d &b) {
+  return {(a + b) / 2.0, (b - a).norm() / 2.0};
+}
+
+/**
+ * @brief Checks whether a sphere contains a point.
+ * @param tolerance The distance by which the point may be outside.
+ */
+bool contains(const BoundingVolumes::Sphere &sphere,
+              const Eigen::Vector3d &point, double tolerance) {
+  return (point - sphere.center).norm() <= sphere.radius + tolerance;
+}
+
+/**
+ * @brief Returns the smallest of the spheres around pairs of the points
+ * which contains all of them.
+ * @details This is the fallback for points in a degenerate position, which
+ * have no sphere with every point on its surface.
+ */
+template <std::size_t N>
+BoundingVolumes::Sphere
+getPairSphere(const std::array<const Eigen::Vector3d *, N> &points,
+              double tolerance) {
+  BoundingVolumes::Sphere best;
+  best.radius = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0U; i < N; ++i) {
+    for (std::size_t j = i + 1U; j < N; ++j) {
+      const auto sphere = makeSphere(*points[i], *points[j]);
+      if (sphere.radius < best.radius &&
+          std::all_of(points.begin(), points.end(),
+                      [&sphere, tolerance](const Eigen::Vector3d *point) {
+                        return contains(sphere, *point, tolerance);
+                      })) {
+        best = sphere;
+      }
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief Calculates the smallest sphere with three points on its surface.
+ */
+BoundingVolumes::Sphere makeSphere(const Eigen::Vector3d &a,
+                                   const Eigen::Vector3d &b,
+                                   const Eigen::Vector3d &c, double tolerance) {
+  const Eigen::Vector3d u = b - a;
+  const Eigen::Vector3d v = c - a;
+  const Eigen::Vector3d normal = u.cross(v);
+  if (normal.norm() <= c_degenerate_ratio * u.norm() * v.norm()) {
+    return getPairSphere<3U>({&a, &b, &c}, tolerance);
+  }
+  const Eigen::Vector3d offset =
+      (u.squaredNorm() * v.cross(normal) + v.squaredNorm() * normal.cross(u)) /
+      (2.0 * normal.squaredNorm());
+  return {a + offset, offset.norm()};
+}
+
+/**
+ * @brief Calculates the sphere with four points on its surface.
+ */
+BoundingVolumes::Sphere makeSphere(const Eigen::Vector3d &a,
+                                   const Eigen::Vector3d &b,
+                                   const Eigen::Vector3d &c,
+                                   const Eigen::Vector3d &d, double tolerance) {
+  Eigen::Matrix3d edges;
+  edges << (b - a).transpose(), (c - a).transpose(), (d - a).transpose();
+  const double determinant = edges.determinant();
+  if (std::abs(determinant) <= c_degenerate_ratio * edges.row(0).norm() *
+                                   edges.row(1).norm() * edges.row(2).norm()) {
+    // Points in a plane, the sphere is defined by three or two of them.
+    const std::array<const Eigen::Vector3d *, 4U> points{&a, &b, &c, &d};
+    auto best = getPairSphere(points, tolerance);
+    for (std::size_t skipped = 0U; skipped < 4U; ++skipped) {
+      std::array<const Eigen::Vector3d *, 3U> triple{};
+      std::size_t size = 0U;
+      for (std::size_t i = 0U; i < 4U; ++i) {
+        if (i != skipped) {
+          triple[size++] = points[i];
+        }
+      }
+      const auto sphere =
+          makeSphere(*triple[0U], *triple[1U], *triple[2U], tolerance);
+      if (sphere.radius < best.radius &&
+          contains(sphere, *points[skipped], tolerance)) {
+        best = sphere;
+      }
+    }
+    return best;
+  }
+  const Eigen::Vector3d offset =
+      edges.inverse() * Eigen::Vector3d(edges.row(0).squaredNorm(),
+                                        edges.row(1).squaredNorm(),
+                                        edges.row(2).squaredNorm()) /
+      2.0;
+  return {a + offset, offset.norm()};
+}
+
+} // namespace
+
+BoundingVolumes BoundingVolumes::calculate(const MeshData &mesh) {
+  const auto &triangles = mesh.triangles;
+  const auto &transformation = mesh.getPendingTransform();
+  const std::size_t block_count =
+      (triangles.size() + Parallel::c_block_size - 1U) /
+      Parallel::c_block_size;
+  std::vector<Eigen::AlignedBox3d> block_boxes(block_count);
+  Parallel::forEachBlock(
+      triangles.size(), Parallel::c_block_size,
+      [&](std::size_t block, std::size_t begin, std::size_t end) {
+        auto &box = block_boxes[block];
+        for (std::size_t i = begin; i < end; ++i) {
+          const auto &triangle = triangles[i];
+          for (const auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+            const Eigen::Vector4d position =
+                transformation.transformPoint(vertex->pos);
+            if (position.allFinite()) {
+              box.extend(Eigen::Vector3d(position.head<3>()));
+            }
+          }
+        }
+      });
+
+  BoundingVolumes result;
+  for (const auto &box : block_boxes) {
+    result.axis_aligned_box.extend(box);
+  }
+  if (result.axis_aligned_box.isEmpty()) {
+    return result;
+  }
+
+  // Only the vertices of the hull matter, relative to the center of the box
+  // for accuracy. A flat mesh has no hull, so all of its vertices are used.
+  const Eigen::Vector3d origin = result.axis_aligned_box.center();
+  auto hull = ConvexHull::calculate(mesh);
+  std::vector<Eigen::Vector3d> points;
+  if (hull.triangles.empty()) {
+    for (const auto &triangle : triangles) {
+      for (const auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+        const Eigen::Vector4d position =
+            transformation.transformPoint(vertex->pos);
+        if (position.allFinite()) {
+          points.emplace_back(position.head<3>() - origin);
+        }
+      }
+    }
+  } else {
+    for (auto &triangle : hull.triangles) {
+      for (auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+        vertex->pos.head<3>() -= origin;
+        points.emplace_back(vertex->pos.head<3>());
+      }
+    }
+  }
+  std::sort(points.begin(), points.end(),
+            [](const Eigen::Vector3d &first, const Eigen::Vector3d &second) {
+              return std::lexicographical_compare(
+                  first.data(), first.data() + 3, second.data(),
+                  second.data() + 3);
+            });
+  points.erase(std::unique(points.begin(), points.end()), points.end());
+
+  result.oriented_box = fitOrientedBox(points, hull);
+  result.oriented_box.center += origin;
+  result.sphere = calculateSphere(points);
+  result.sphere.center += origin;
+  return result;
+}
+
+BoundingVolumes::Sphere
+BoundingVolumes::calculateSphere(const std::vector<Eigen::Vector3d> &points) {
+  if (points.empty()) {
+    return {};
+  }
+  double scale = 0.0;
+  for (const auto &point : points) {
+    scale = std::max(scale, point.cwiseAbs().maxCoeff());
+  }
+  const double tolerance =
+      16.0 * std::numeric_limits<double>::epsilon() * scale;
+
+  // Welzl's algorithm is expected linear time for points in random order.
+  std::vector<Eigen::Vector3d> shuffled = points;
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(c_sphere_seed));
+  Sphere sphere{shuffled[0U], 0.0};
+  for (std::size_t i = 1U; i < shuffled.size(); ++i) {
+    const auto &a = shuffled[i];
+    if (contains(sphere, a, tolerance)) {
+      continue;
+    }
+    sphere = {a, 0.0};
+    for (std::size_t j = 0U; j < i; ++j) {
+      const auto &b = shuffled[j];
+      if (contains(sphere, b, tolerance)) {
+        continue;
+      }
+      sphere = makeSphere(a, b);
+      for (std::size_t k = 0U; k < j; ++k) {
+        const auto &c = shuffled[k];
+        if (contains(sphere, c, tolerance)) {
+          continue;
+        }
+        sphere = makeSphere(a, b, c, tolerance);
+        for (std::size_t l = 0U; l < k; ++l) {
+          const auto &d = shuffled[l];
+          if (!contains(sphere, d, tolerance)) {
+            sphere = makeSphere(a, b, c, d, tolerance);
+          }
+        }
+      }
+    }
+  }
+
+  // The tolerance must not leave points outside of the result.
+  for (const auto &point : points) {
+    sphere.radius = std::max(sphere.radius, (point - sphere.center).norm());
+  }
+  return sphere;
+}
+
+} // namespace Converter
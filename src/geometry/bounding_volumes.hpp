@@ -0,0 +1,117 @@
+#ifndef BOUNDING_VOLUMES_HPP
+#define BOUNDING_VOLUMES_HPP
+
+#include <Eigen/Dense>
+#include <vector>
+
+namespace Converter {
+
+class MeshData;
+
+/**
+ * @brief The axis aligned box, a tight oriented box and the minimal
+ * enclosing sphere of a mesh.
+ * @details The axis aligned box is a parallel min/max reduction over the
+ * vertices. Every other volume only depends on the convex hull, so the
+ * remaining work is done on the vertices of the ConvexHull. The oriented box
+ * starts from the principal axes of the hull surface, the eigenvectors of
+ * its area weighted covariance matrix, which are stable under the
+ * tessellation of the mesh, unlike those of its vertices. Symmetric shapes
+ * like a cube have no distinct principal axes, so the box is refined by
+ * fitting the minimum area rectangle with rotating calipers around every
+ * principal axis and the normals of the largest hull faces, keeping the
+ * smallest box found. The sphere is found with Welzl's algorithm, the
+ * iterative form with up to four support points, over the hull vertices in
+ * a fixed random order.
+ */
+class BoundingVolumes {
+public:
+  /**
+   * @brief The number of largest hull faces whose normals are tried as an
+   * axis of the oriented box.
+   */
+  static constexpr std::size_t c_candidate_face_count = 32U;
+
+  /**
+   * @brief A box in an arbitrary orientation.
+   * @param center The center of the box.
+   * @param axes The directions of the edges as the columns of a rotation.
+   * @param half_sizes Half of the edge lengths along the axes.
+   */
+  struct OrientedBox {
+    Eigen::Vector3d center = Eigen::Vector3d::Zero();
+    Eigen::Matrix3d axes = Eigen::Matrix3d::Identity();
+    Eigen::Vector3d half_sizes = Eigen::Vector3d::Zero();
+
+    /**
+     * @brief Calculates the volume of the box.
+     * @return The product of the edge lengths.
+     */
+    double getVolume() const { return 8.0 * half_sizes.prod(); }
+  };
+
+  /**
+   * @brief A sphere.
+   * @param center The center of the sphere.
+   * @param radius The radius of the sphere.
+   */
+  struct Sphere {
+    Eigen::Vector3d center = Eigen::Vector3d::Zero();
+    double radius = 0.0;
+  };
+
+  /**
+   * @brief Calculates the bounding volumes of a mesh.
+   * @note The pending transformation of the mesh is applied. The result
+   * does not depend on the number of threads.
+   * @param mesh The mesh to be bounded.
+   * @return The bounding volumes, empty boxes and a zero sphere if the mesh
+   * has no Triangles.
+   */
+  static BoundingVolumes calculate(const MeshData &mesh);
+
+  /**
+   * @brief Calculates the minimal enclosing sphere of points.
+   * @param points The points to be enclosed.
+   * @return The smallest sphere containing every point.
+   */
+  static Sphere calculateSphere(const std::vector<Eigen::Vector3d> &points);
+
+  /**
+   * @brief Returns the axis aligned bounding box.
+   * @return The box, empty if the mesh has no Triangles.
+   */
+  const Eigen::AlignedBox3d &getAxisAlignedBox() const {
+    return axis_aligned_box;
+  }
+
+  /**
+   * @brief Returns the smallest oriented box found.
+   * @return The box, never larger than the axis aligned box.
+   */
+  const OrientedBox &getOrientedBox() const { return oriented_box; }
+
+  /**
+   * @brief Returns the minimal enclosing sphere.
+   * @return The sphere.
+   */
+  const Sphere &getSphere() const { return sphere; }
+
+private:
+  /**
+   * @brief Holds the axis aligned bounding box.
+   */
+  Eigen::AlignedBox3d axis_aligned_box;
+  /**
+   * @brief Holds the smallest oriented box found.
+   */
+  OrientedBox oriented_box;
+  /**
+   * @brief Holds the minimal enclosing sphere.
+   */
+  Sphere sphere;
+};
+
+} // namespace Converter
+
+#endif
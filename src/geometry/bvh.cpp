@@ -0,0 +1,88 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "bvh.hpp"
+#include "triangle.hpp"
+
+namespace Converter {
+
+Bvh::Bvh(const std::vector<Triangle> &triangles,
+         std::uint32_t max_leaf_size) {
+  if (triangles.empty()) {
+    return;
+  }
+
+  std::vector<Eigen::Vector3d> centroids;
+  std::vector<Eigen::AlignedBox3d> boxes;
+  centroids.reserve(triangles.size());
+  boxes.reserve(triangles.size());
+  for (const auto &triangle : triangles) {
+    Eigen::AlignedBox3d box{triangle.a.pos.head<3>()};
+    box.extend(triangle.b.pos.head<3>());
+    box.extend(triangle.c.pos.head<3>());
+    boxes.push_back(box);
+    centroids.push_back(box.center());
+  }
+
+  triangle_indices.resize(triangles.size());
+  std::iota(triangle_indices.begin(), triangle_indices.end(), 0U);
+
+  // A binary tree with leaves of at least half the maximum size has less
+  // than 4n / max_leaf_size nodes.
+  nodes.reserve(4U * triangles.size() / std::max(max_leaf_size, 1U) + 1U);
+  Node root;
+  root.first = 0U;
+  root.count = static_cast<std::uint32_t>(triangles.size());
+  nodes.push_back(root);
+  split(centroids, boxes, 0U, std::max(max_leaf_size, 1U));
+}
+
+void Bvh::split(const std::vector<Eigen::Vector3d> &centroids,
+                const std::vector<Eigen::AlignedBox3d> &boxes,
+                std::uint32_t node_index, std::uint32_t max_leaf_size) {
+  const std::uint32_t first = nodes[node_index].first;
+  const std::uint32_t count = nodes[node_index].count;
+  const auto begin = triangle_indices.begin() + first;
+  const auto end = begin + count;
+
+  Eigen::AlignedBox3d box;
+  Eigen::AlignedBox3d centroid_box;
+  for (auto it = begin; it != end; ++it) {
+    box.extend(boxes[*it]);
+    centroid_box.extend(centroids[*it]);
+  }
+  nodes[node_index].box = box;
+
+  if (count <= max_leaf_size) {
+    return;
+  }
+
+  Eigen::Index axis = 0;
+  centroid_box.sizes().maxCoeff(&axis);
+  const auto middle = begin + count / 2U;
+  std::nth_element(begin, middle, end,
+                   [&centroids, axis](std::uint32_t lhs, std::uint32_t rhs) {
+                     return centroids[lhs][axis] < centroids[rhs][axis];
+                   });
+
+  const auto left_index = static_cast<std::uint32_t>(nodes.size());
+  Node left;
+  left.first = first;
+  left.count = count / 2U;
+  Node right;
+  right.first = first + count / 2U;
+  right.count = count - count / 2U;
+  nodes.push_back(left);
+  nodes.push_back(right);
+
+  nodes[node_index].first = left_index;
+  nodes[node_index].count = 0U;
+
+  split(centroids, boxes, left_index, max_leaf_size);
+  split(centroids, boxes, left_index + 1U, max_leaf_size);
+}
+
+} // namespace Converter
@@ -0,0 +1,118 @@
+#ifndef BVH_HPP
+#define BVH_HPP
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "triangle.hpp"
+
+namespace Converter {
+
+/**
+ * @brief Bounding volume hierarchy over the Triangles of a mesh.
+ * @details The tree is built top-down by splitting the triangle centroids at
+ * the median of the longest axis of their bounds, so it is always balanced.
+ * The nodes are stored in a flat vector, the root is the first element and
+ * the two children of an inner node are stored next to each other, after
+ * their parent.
+ */
+class Bvh {
+public:
+  /**
+   * @brief A single node of the hierarchy.
+   */
+  struct Node {
+    /**
+     * @brief The bounding box of every Triangle under the node.
+     */
+    Eigen::AlignedBox3d box;
+    /**
+     * @brief For leaves the first position in triangle_indices, for inner
+     * nodes the index of the left child, the right one is first + 1.
+     */
+    std::uint32_t first = 0U;
+    /**
+     * @brief The number of Triangles in a leaf, zero for inner nodes.
+     */
+    std::uint32_t count = 0U;
+
+    /**
+     * @brief Returns if the node is a leaf.
+     * @return True if the node is a leaf, otherwise false.
+     */
+    bool isLeaf() const { return count != 0U; }
+  };
+
+  /**
+   * @brief The default maximum number of Triangles stored in a leaf.
+   */
+  static constexpr std::uint32_t c_max_leaf_size = 8U;
+
+  /**
+   * @brief Holds the nodes of the tree, the root is the first one.
+   */
+  std::vector<Node> nodes;
+  /**
+   * @brief Holds the indices of the Triangles in the order the leaves
+   * reference them.
+   */
+  std::vector<std::uint32_t> triangle_indices;
+
+  /**
+   * @brief Default constructor, creates an empty hierarchy.
+   */
+  Bvh() = default;
+
+  /**
+   * @brief Builds the hierarchy over the passed Triangles.
+   * @param triangles The Triangles the hierarchy should be built over.
+   * @param max_leaf_size The maximum number of Triangles in a leaf.
+   */
+  explicit Bvh(const std::vector<Triangle> &triangles,
+               std::uint32_t max_leaf_size = c_max_leaf_size);
+
+  /**
+   * @brief Returns if the hierarchy has no nodes.
+   * @return True if the hierarchy is empty, otherwise false.
+   */
+  bool empty() const { return nodes.empty(); }
+
+  /**
+   * @brief Recalculates the boxes of the nodes from the leaves up, for
+   * example after the Triangles were transformed.
+   * @details Children are always stored after their parents, so iterating
+   * backwards visits every child before its parent.
+   * @tparam Func Callable with the signature
+   * Eigen::AlignedBox3d(std::size_t node_index).
+   * @param getLeafBox Returns the bounding box of the Triangles of a leaf.
+   */
+  template <typename Func> void refit(const Func &getLeafBox) {
+    for (std::size_t i = nodes.size(); i-- > 0U;) {
+      auto &node = nodes[i];
+      if (node.isLeaf()) {
+        node.box = getLeafBox(i);
+      } else {
+        node.box = nodes[node.first].box;
+        node.box.extend(nodes[node.first + 1U].box);
+      }
+    }
+  }
+
+private:
+  /**
+   * @brief Splits the given node recursively until the leaf size is reached.
+   * @param centroids The centroids of the Triangles.
+   * @param boxes The bounding boxes of the Triangles.
+   * @param node_index The index of the node to be split.
+   * @param max_leaf_size The maximum number of Triangles in a leaf.
+   */
+  void split(const std::vector<Eigen::Vector3d> &centroids,
+             const std::vector<Eigen::AlignedBox3d> &boxes,
+             std::uint32_t node_index, std::uint32_t max_leaf_size);
+};
+
+} // namespace Converter
+
+#endif
@@ -0,0 +1,141 @@
+#include <Eigen/Dense>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "bvh.hpp"
+#include "closest_point_query.hpp"
+#include "meshdata.hpp"
+#include "parallel.hpp"
+#include "triangle_packet.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief The number of query points a task of findClosestPoints processes.
+ */
+constexpr std::size_t c_query_block_size = 64U;
+
+} // namespace
+
+ClosestPointQuery::ClosestPointQuery(const MeshData &mesh)
+    : bvh(mesh.triangles,
+          static_cast<std::uint32_t>(TrianglePacket::c_width)) {
+  const auto &transformation = mesh.getPendingTransform();
+  const bool is_transformed =
+      transformation.getKind() != AffineTransform::Kind::IDENTITY;
+  node_packets.resize(bvh.nodes.size(), 0U);
+  for (std::size_t i = 0U; i < bvh.nodes.size(); ++i) {
+    const auto &node = bvh.nodes[i];
+    if (node.isLeaf()) {
+      node_packets[i] = static_cast<std::uint32_t>(leaf_packets.size());
+      leaf_packets.emplace_back();
+      leaf_packets.back().load(mesh.triangles, bvh.triangle_indices,
+                               node.first, node.first + node.count);
+      if (is_transformed) {
+        leaf_packets.back().transform(transformation);
+      }
+    }
+  }
+
+  // The hierarchy was built before the transformation, its boxes have to be
+  // recalculated from the children up.
+  if (is_transformed) {
+    bvh.refit([this](std::size_t node_index) {
+      const auto &packet = leaf_packets[node_packets[node_index]];
+      Eigen::AlignedBox3d box;
+      box.setEmpty();
+      for (std::uint32_t lane = 0U; lane < bvh.nodes[node_index].count;
+           ++lane) {
+        for (const auto *vertex : {&packet.a, &packet.b, &packet.c}) {
+          box.extend(Eigen::Vector3d((*vertex)[0U][lane], (*vertex)[1U][lane],
+                                     (*vertex)[2U][lane]));
+        }
+      }
+      return box;
+    });
+  }
+}
+
+std::optional<ClosestPointQuery::Result>
+ClosestPointQuery::findClosestPoint(const Eigen::Vector4d &point,
+                                    double max_distance) const {
+  if (bvh.empty()) {
+    return {};
+  }
+
+  const Eigen::Vector3d query = point.head<3>();
+  double closest_squared = max_distance * max_distance;
+  std::optional<Result> closest;
+
+  // The queue holds the nodes with the squared distance of their boxes,
+  // the nearest on top.
+  using Entry = std::pair<double, std::uint32_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  queue.emplace(bvh.nodes[0U].box.squaredExteriorDistance(query), 0U);
+
+  while (!queue.empty()) {
+    const auto [box_distance, node_index] = queue.top();
+    queue.pop();
+    if (box_distance > closest_squared) {
+      break;
+    }
+
+    const auto &node = bvh.nodes[node_index];
+    if (node.isLeaf()) {
+      const auto &packet = leaf_packets[node_packets[node_index]];
+      const auto points = packet.findClosestPoints(query);
+      for (std::uint32_t lane = 0U; lane < node.count; ++lane) {
+        if (points.distance_squared[lane] > closest_squared ||
+            (closest && points.distance_squared[lane] == closest_squared)) {
+          continue;
+        }
+        closest_squared = points.distance_squared[lane];
+        const double u = points.u[lane];
+        const double v = points.v[lane];
+        Eigen::Vector4d closest_point{0.0, 0.0, 0.0, 1.0};
+        for (Eigen::Index axis = 0; axis < 3; ++axis) {
+          closest_point[axis] = (1.0 - u - v) * packet.a[axis][lane] +
+                                u * packet.b[axis][lane] +
+                                v * packet.c[axis][lane];
+        }
+        closest = Result{std::sqrt(closest_squared), closest_point, u, v,
+                         bvh.triangle_indices[node.first + lane]};
+      }
+      continue;
+    }
+
+    for (const std::uint32_t child : {node.first, node.first + 1U}) {
+      const double child_distance =
+          bvh.nodes[child].box.squaredExteriorDistance(query);
+      if (child_distance <= closest_squared) {
+        queue.emplace(child_distance, child);
+      }
+    }
+  }
+  return closest;
+}
+
+std::vector<std::optional<ClosestPointQuery::Result>>
+ClosestPointQuery::findClosestPoints(const std::vector<Eigen::Vector4d> &points,
+                                     double max_distance) const {
+  std::vector<std::optional<Result>> results(points.size());
+  Parallel::forEachBlock(
+      points.size(), c_query_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          results[i] = findClosestPoint(points[i], max_distance);
+        }
+      });
+  return results;
+}
+
+} // namespace Converter
@@ -0,0 +1,104 @@
+#ifndef CLOSEST_POINT_QUERY_HPP
+#define CLOSEST_POINT_QUERY_HPP
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "bvh.hpp"
+#include "triangle_packet.hpp"
+
+namespace Converter {
+
+class MeshData;
+
+/**
+ * @brief Acceleration structure for finding the closest point of a mesh to
+ * query points.
+ * @details The Triangles are grouped into a Bvh whose leaves hold at most
+ * TrianglePacket::c_width Triangles, every leaf is stored as a single
+ * TrianglePacket, and a leaf is tested with one call of the packet
+ * point-triangle distance. The hierarchy is traversed best-first: the nodes
+ * are visited in the order of the distance of their boxes from the point,
+ * and the traversal stops when the nearest remaining box is farther than the
+ * closest point found so far.
+ */
+class ClosestPointQuery {
+public:
+  /**
+   * @brief The closest point of the mesh to a query point.
+   * @param distance The distance of the query point and the closest point.
+   * @param point The closest point, with 1 as its homogeneous coordinate.
+   * @param u The barycentric coordinate of the second vertex at the point.
+   * @param v The barycentric coordinate of the third vertex at the point.
+   * @param triangle_index The index of the Triangle in the mesh.
+   */
+  struct Result {
+    double distance;
+    Eigen::Vector4d point;
+    double u;
+    double v;
+    std::uint32_t triangle_index;
+  };
+
+  /**
+   * @brief Builds the acceleration structure for the mesh.
+   * @note The pending transformation of the mesh is applied to the copy of
+   * the Triangles the structure holds, so the distances are measured in the
+   * transformed space.
+   * @param mesh The mesh whose closest points should be found.
+   */
+  explicit ClosestPointQuery(const MeshData &mesh);
+
+  /**
+   * @brief Returns the number of Triangles the structure was built over.
+   * @return The number of Triangles.
+   */
+  std::size_t size() const { return bvh.triangle_indices.size(); }
+
+  /**
+   * @brief Finds the closest point of the mesh to a point.
+   * @details If several Triangles are equally close, the first one found
+   * is returned.
+   * @param point The query point.
+   * @param max_distance The largest distance to look for points at.
+   * @return The closest point if the mesh has one within max_distance.
+   */
+  std::optional<Result> findClosestPoint(
+      const Eigen::Vector4d &point,
+      double max_distance = std::numeric_limits<double>::infinity()) const;
+
+  /**
+   * @brief Finds the closest point of the mesh to many points, using
+   * multiple threads.
+   * @param points The query points.
+   * @param max_distance The largest distance to look for points at.
+   * @return The closest point to every query point, in the order of the
+   * query points.
+   */
+  std::vector<std::optional<Result>> findClosestPoints(
+      const std::vector<Eigen::Vector4d> &points,
+      double max_distance = std::numeric_limits<double>::infinity()) const;
+
+private:
+  /**
+   * @brief The hierarchy of the Triangles, the boxes are in the transformed
+   * space.
+   */
+  Bvh bvh;
+  /**
+   * @brief The transformed Triangles of the leaves, the i-th leaf in node
+   * order is the i-th packet.
+   */
+  std::vector<TrianglePacket> leaf_packets;
+  /**
+   * @brief The index of the packet of every node, only valid for leaves.
+   */
+  std::vector<std::uint32_t> node_packets;
+};
+
+} // namespace Converter
+
+#endif
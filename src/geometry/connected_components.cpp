@@ -0,0 +1,195 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "connected_components.hpp"
+#include "indexed_mesh.hpp"
+#include "parallel.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief Lock-free disjoint set forest over the vertices.
+ */
+class UnionFind {
+public:
+  /**
+   * @brief Creates a forest where every element is its own set.
+   * @param size The number of elements.
+   */
+  explicit UnionFind(std::size_t size)
+      : parents(std::make_unique<std::atomic<std::uint32_t>[]>(size)) {
+    Parallel::forEachBlock(
+        size, Parallel::c_block_size,
+        [this](std::size_t, std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i) {
+            parents[i].store(static_cast<std::uint32_t>(i),
+                             std::memory_order_relaxed);
+          }
+        });
+  }
+
+  /**
+   * @brief Finds the root of the set of an element, halving the path.
+   * @param element The element to be searched.
+   * @return The root of the set.
+   */
+  std::uint32_t find(std::uint32_t element) {
+    std::uint32_t parent = parents[element].load(std::memory_order_acquire);
+    while (parent != element) {
+      const std::uint32_t grandparent =
+          parents[parent].load(std::memory_order_acquire);
+      // Failing is fine, another thread changed the parent to a node that is
+      // also on the path to the root.
+      parents[element].compare_exchange_weak(parent, grandparent,
+                                             std::memory_order_acq_rel);
+      element = parent;
+      parent = parents[element].load(std::memory_order_acquire);
+    }
+    return element;
+  }
+
+  /**
+   * @brief Merges the sets of two elements.
+   * @details The root with the larger index is linked under the other one,
+   * so the final root of every set is its smallest element.
+   * @param lhs An element of the first set.
+   * @param rhs An element of the second set.
+   */
+  void unite(std::uint32_t lhs, std::uint32_t rhs) {
+    while (true) {
+      lhs = find(lhs);
+      rhs = find(rhs);
+      if (lhs == rhs) {
+        return;
+      }
+      if (lhs < rhs) {
+        std::swap(lhs, rhs);
+      }
+      // Only succeeds if lhs is still a root.
+      std::uint32_t expected = lhs;
+      if (parents[lhs].compare_exchange_strong(expected, rhs,
+                                               std::memory_order_acq_rel)) {
+        return;
+      }
+    }
+  }
+
+private:
+  /**
+   * @brief Holds the parent of every element, roots are their own parents.
+   */
+  std::unique_ptr<std::atomic<std::uint32_t>[]> parents;
+};
+
+} // namespace
+
+ConnectedComponents ConnectedComponents::label(const IndexedMesh &mesh) {
+  ConnectedComponents components;
+  const std::size_t face_count = mesh.faces.size();
+  const std::size_t vertex_count = mesh.vertices.size();
+
+  UnionFind sets(vertex_count);
+  Parallel::forEachBlock(
+      face_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          const auto &face = mesh.faces[i];
+          sets.unite(face[0U], face[1U]);
+          sets.unite(face[0U], face[2U]);
+        }
+      });
+
+  std::vector<std::uint32_t> roots(vertex_count);
+  Parallel::forEachBlock(
+      vertex_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          roots[i] = sets.find(static_cast<std::uint32_t>(i));
+        }
+      });
+
+  // Numbers the components in the order of their first face.
+  std::vector<std::uint32_t> root_labels(vertex_count, c_no_component);
+  for (const auto &face : mesh.faces) {
+    auto &root_label = root_labels[roots[face[0U]]];
+    if (root_label == c_no_component) {
+      root_label = static_cast<std::uint32_t>(components.component_count++);
+    }
+  }
+
+  components.face_labels.resize(face_count);
+  Parallel::forEachBlock(
+      face_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          components.face_labels[i] = root_labels[roots[mesh.faces[i][0U]]];
+        }
+      });
+  components.vertex_labels.resize(vertex_count);
+  Parallel::forEachBlock(
+      vertex_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          components.vertex_labels[i] = root_labels[roots[i]];
+        }
+      });
+  return components;
+}
+
+std::vector<IndexedMesh>
+ConnectedComponents::split(const IndexedMesh &mesh) const {
+  // Groups the faces by component with a counting sort, which keeps their
+  // order within the components.
+  std::vector<std::size_t> offsets(component_count + 1U, 0U);
+  for (const auto label : face_labels) {
+    ++offsets[label + 1U];
+  }
+  for (std::size_t i = 0U; i < component_count; ++i) {
+    offsets[i + 1U] += offsets[i];
+  }
+  std::vector<std::uint32_t> sorted_faces(face_labels.size());
+  {
+    std::vector<std::size_t> next = offsets;
+    for (std::size_t i = 0U; i < face_labels.size(); ++i) {
+      sorted_faces[next[face_labels[i]]++] = static_cast<std::uint32_t>(i);
+    }
+  }
+
+  // Every vertex belongs to a single component, so the components can share
+  // the array of the new vertex indices.
+  std::vector<std::uint32_t> local_indices(mesh.vertices.size(),
+                                           c_no_component);
+  std::vector<IndexedMesh> meshes(component_count);
+  Parallel::forEachBlock(
+      component_count, 1U,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t component = begin; component < end; ++component) {
+          auto &component_mesh = meshes[component];
+          component_mesh.material_file = mesh.material_file;
+          component_mesh.faces.reserve(offsets[component + 1U] -
+                                       offsets[component]);
+          for (std::size_t i = offsets[component];
+               i < offsets[component + 1U]; ++i) {
+            IndexedMesh::Face face = mesh.faces[sorted_faces[i]];
+            for (auto &vertex : face) {
+              if (local_indices[vertex] == c_no_component) {
+                local_indices[vertex] = static_cast<std::uint32_t>(
+                    component_mesh.vertices.size());
+                component_mesh.vertices.push_back(mesh.vertices[vertex]);
+              }
+              vertex = local_indices[vertex];
+            }
+            component_mesh.faces.push_back(face);
+          }
+        }
+      });
+  return meshes;
+}
+
+} // namespace Converter
@@ -0,0 +1,88 @@
+#ifndef CONNECTED_COMPONENTS_HPP
+#define CONNECTED_COMPONENTS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Converter {
+
+class IndexedMesh;
+
+/**
+ * @brief Labels the connected components of an indexed mesh.
+ * @details Two faces belong to the same component if they are connected
+ * through shared vertices. The vertices of every face are merged with a
+ * lock-free union-find, where roots are always linked under the smaller
+ * vertex index and paths are halved during the searches, so the faces can be
+ * processed by multiple threads. The components are numbered in the order of
+ * their first face, which makes the labels independent of the number of
+ * threads.
+ */
+class ConnectedComponents {
+public:
+  /**
+   * @brief The label of the vertices not used by any face.
+   */
+  static constexpr std::uint32_t c_no_component =
+      std::numeric_limits<std::uint32_t>::max();
+
+  /**
+   * @brief Labels the components of a mesh.
+   * @note The mesh should be welded, every face of a triangle soup is a
+   * separate component.
+   * @param mesh The mesh to be labeled.
+   * @return The labels of the faces and the vertices.
+   */
+  static ConnectedComponents label(const IndexedMesh &mesh);
+
+  /**
+   * @brief Returns the number of components.
+   * @return The number of components.
+   */
+  std::size_t getComponentCount() const { return component_count; }
+
+  /**
+   * @brief Returns the component of every face.
+   * @return The labels of the faces.
+   */
+  const std::vector<std::uint32_t> &getFaceLabels() const {
+    return face_labels;
+  }
+
+  /**
+   * @brief Returns the component of every vertex.
+   * @return The labels of the vertices, c_no_component for unused ones.
+   */
+  const std::vector<std::uint32_t> &getVertexLabels() const {
+    return vertex_labels;
+  }
+
+  /**
+   * @brief Splits the mesh into one mesh per component.
+   * @details The components are built in parallel, each keeps the order of
+   * its faces, and its vertices are numbered in the order of their first use.
+   * @param mesh The mesh that was labeled.
+   * @return The meshes of the components, in the order of the labels.
+   */
+  std::vector<IndexedMesh> split(const IndexedMesh &mesh) const;
+
+private:
+  /**
+   * @brief Holds the number of components.
+   */
+  std::size_t component_count = 0U;
+  /**
+   * @brief Holds the component of every face.
+   */
+  std::vector<std::uint32_t> face_labels;
+  /**
+   * @brief Holds the component of every vertex.
+   */
+  std::vector<std::uint32_t> vertex_labels;
+};
+
+} // namespace Converter
+
+#endif
@@ -0,0 +1,555 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "convex_hull.hpp"
+#include "meshdata.hpp"
+#include "parallel.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief The number of Triangles whose vertices form a chunk.
+ */
+constexpr std::size_t c_chunk_size = std::size_t{1U} << 16U;
+
+/**
+ * @brief The number of directions the extreme vertices are searched along.
+ */
+constexpr std::size_t c_direction_count = 26U;
+
+/**
+ * @brief Marks a missing face or point.
+ */
+constexpr std::uint32_t c_none = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief The indices of the points of a face, counter-clockwise seen from
+ * the outside.
+ */
+using Face = std::array<std::uint32_t, 3U>;
+
+/**
+ * @brief Orders points lexicographically, so duplicates become neighbors.
+ */
+bool isLess(const Eigen::Vector3d &first, const Eigen::Vector3d &second) {
+  return std::lexicographical_compare(first.data(), first.data() + 3,
+                                      second.data(), second.data() + 3);
+}
+
+/**
+ * @brief Returns the directions the extreme vertices are searched along.
+ * @return Every direction with components -1, 0 or 1, except zero.
+ */
+std::array<Eigen::Vector3d, c_direction_count> getDirections() {
+  std::array<Eigen::Vector3d, c_direction_count> directions;
+  std::size_t next = 0U;
+  for (int x = -1; x <= 1; ++x) {
+    for (int y = -1; y <= 1; ++y) {
+      for (int z = -1; z <= 1; ++z) {
+        if (x != 0 || y != 0 || z != 0) {
+          directions[next++] =
+              Eigen::Vector3d(static_cast<double>(x), static_cast<double>(y),
+                              static_cast<double>(z));
+        }
+      }
+    }
+  }
+  return directions;
+}
+
+/**
+ * @brief Builds the convex hull of a set of points with Quickhull.
+ * @details Every face keeps the points above it that were not added to the
+ * hull yet, and the indices of its neighbors across its three edges, so the
+ * faces seen from a point are found by a search from any one of them.
+ */
+class HullBuilder {
+public:
+  /**
+   * @brief Builds the hull.
+   * @param points The points, they should be unique.
+   */
+  explicit HullBuilder(const std::vector<Eigen::Vector3d> &points)
+      : points(points) {
+    Eigen::Vector3d max_coordinates = Eigen::Vector3d::Zero();
+    for (const auto &point : points) {
+      max_coordinates = max_coordinates.cwiseMax(point.cwiseAbs());
+    }
+    tolerance = 3.0 * std::numeric_limits<double>::epsilon() *
+                max_coordinates.sum();
+    if (createSimplex()) {
+      expand();
+    }
+  }
+
+  /**
+   * @brief Returns the faces of the hull.
+   * @return The faces, empty if the points are all in a plane.
+   */
+  std::vector<Face> getFaces() const {
+    std::vector<Face> result;
+    for (const auto &face : faces) {
+      if (face.is_alive) {
+        result.push_back(face.vertices);
+      }
+    }
+    return result;
+  }
+
+private:
+  /**
+   * @brief A face of the hull under construction.
+   * @param vertices The indices of the points of the face.
+   * @param neighbors The faces across the edges starting at the vertices.
+   * @param normal The unit normal, pointing outwards.
+   * @param offset The distance of the plane of the face from the origin.
+   * @param outside The points above the face not added to the hull yet.
+   * @param farthest The point of outside farthest above the face.
+   * @param farthest_distance The distance of farthest above the face.
+   * @param visit The last search that reached the face.
+   * @param is_alive False if the face was replaced.
+   */
+  struct HullFace {
+    Face vertices;
+    std::array<std::uint32_t, 3U> neighbors;
+    Eigen::Vector3d normal;
+    double offset;
+    std::vector<std::uint32_t> outside;
+    std::uint32_t farthest = c_none;
+    double farthest_distance = 0.0;
+    std::size_t visit = 0U;
+    bool is_alive = true;
+  };
+
+  /**
+   * @brief Calculates the signed distance of a point above a face.
+   * @param face The index of the face.
+   * @param point The index of the point.
+   * @return The distance, positive above the face.
+   */
+  double getDistance(std::uint32_t face, std::uint32_t point) const {
+    return faces[face].normal.dot(points[point]) - faces[face].offset;
+  }
+
+  /**
+   * @brief Adds a face, without its neighbors.
+   * @param vertices The indices of the points of the face.
+   * @return The index of the face.
+   */
+  std::uint32_t addFace(const Face &vertices) {
+    HullFace face;
+    face.vertices = vertices;
+    face.neighbors = {c_none, c_none, c_none};
+    const auto &a = points[vertices[0U]];
+    face.normal =
+        (points[vertices[1U]] - a).cross(points[vertices[2U]] - a);
+    const double length = face.normal.norm();
+    face.normal = length > 0.0 ? Eigen::Vector3d(face.normal / length)
+                               : Eigen::Vector3d::Zero();
+    face.offset = face.normal.dot(a);
+    faces.push_back(std::move(face));
+    return static_cast<std::uint32_t>(faces.size() - 1U);
+  }
+
+  /**
+   * @brief Hands a point to the first of the faces it is above.
+   * @param point The index of the point.
+   * @param first The first face to be tried.
+   * @param end The face after the last one to be tried.
+   */
+  void assignPoint(std::uint32_t point, std::uint32_t first,
+                   std::uint32_t end) {
+    for (std::uint32_t face = first; face < end; ++face) {
+      const double distance = getDistance(face, point);
+      if (distance > tolerance) {
+        auto &hull_face = faces[face];
+        hull_face.outside.push_back(point);
+        if (distance > hull_face.farthest_distance) {
+          hull_face.farthest_distance = distance;
+          hull_face.farthest = point;
+        }
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Creates the initial tetrahedron from extreme points, and hands
+   * the other points to its faces.
+   * @return False if the points are all in a plane.
+   */
+  bool createSimplex() {
+    if (points.size() < 4U) {
+      return false;
+    }
+    // The farthest pair among the extreme points along the axes.
+    std::array<std::uint32_t, 6U> extremes = {0U, 0U, 0U, 0U, 0U, 0U};
+    for (std::uint32_t i = 0U; i < points.size(); ++i) {
+      for (Eigen::Index axis = 0; axis < 3; ++axis) {
+        auto &low = extremes[static_cast<std::size_t>(2 * axis)];
+        auto &high = extremes[static_cast<std::size_t>(2 * axis + 1)];
+        low = points[i][axis] < points[low][axis] ? i : low;
+        high = points[i][axis] > points[high][axis] ? i : high;
+      }
+    }
+    std::array<std::uint32_t, 4U> simplex = {0U, 0U, 0U, 0U};
+    double max_distance = -1.0;
+    for (const auto first : extremes) {
+      for (const auto second : extremes) {
+        const double distance = (points[first] - points[second]).norm();
+        if (distance > max_distance) {
+          max_distance = distance;
+          simplex[0U] = first;
+          simplex[1U] = second;
+        }
+      }
+    }
+    if (max_distance <= tolerance) {
+      return false;
+    }
+
+    // The point farthest from their line, then from the plane of the three.
+    const Eigen::Vector3d &origin = points[simplex[0U]];
+    const Eigen::Vector3d direction =
+        (points[simplex[1U]] - origin).normalized();
+    max_distance = -1.0;
+    for (std::uint32_t i = 0U; i < points.size(); ++i) {
+      const double distance = (points[i] - origin).cross(direction).norm();
+      if (distance > max_distance) {
+        max_distance = distance;
+        simplex[2U] = i;
+      }
+    }
+    if (max_distance <= tolerance) {
+      return false;
+    }
+    const Eigen::Vector3d normal =
+        direction.cross(points[simplex[2U]] - origin).normalized();
+    max_distance = -1.0;
+    double signed_distance = 0.0;
+    for (std::uint32_t i = 0U; i < points.size(); ++i) {
+      const double distance = normal.dot(points[i] - origin);
+      if (std::abs(distance) > max_distance) {
+        max_distance = std::abs(distance);
+        signed_distance = distance;
+        simplex[3U] = i;
+      }
+    }
+    if (max_distance <= tolerance) {
+      return false;
+    }
+
+    // The base faces away from the apex, the sides follow its orientation.
+    if (signed_distance > 0.0) {
+      std::swap(simplex[1U], simplex[2U]);
+    }
+    const auto [a, b, c, apex] = simplex;
+    addFace({a, b, c});
+    addFace({a, apex, b});
+    addFace({b, apex, c});
+    addFace({c, apex, a});
+    for (std::uint32_t face = 0U; face < 4U; ++face) {
+      for (std::size_t edge = 0U; edge < 3U; ++edge) {
+        const auto start = faces[face].vertices[edge];
+        const auto end = faces[face].vertices[(edge + 1U) % 3U];
+        for (std::uint32_t other = 0U; other < 4U; ++other) {
+          const auto &vertices = faces[other].vertices;
+          for (std::size_t other_edge = 0U; other_edge < 3U; ++other_edge) {
+            if (vertices[other_edge] == end &&
+                vertices[(other_edge + 1U) % 3U] == start) {
+              faces[face].neighbors[edge] = other;
+            }
+          }
+        }
+      }
+    }
+
+    for (std::uint32_t i = 0U; i < points.size(); ++i) {
+      if (std::find(simplex.begin(), simplex.end(), i) == simplex.end()) {
+        assignPoint(i, 0U, 4U);
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Adds the farthest outside points until no face has any.
+   */
+  void expand() {
+    std::vector<std::uint32_t> pending = {0U, 1U, 2U, 3U};
+    std::vector<std::uint32_t> visible;
+    std::vector<std::pair<std::uint32_t, std::size_t>> horizon;
+    std::vector<std::uint32_t> stack;
+    // The new faces by the horizon vertex their edge on the horizon starts
+    // and ends at.
+    std::vector<std::uint32_t> starting_faces(points.size(), c_none);
+    std::vector<std::uint32_t> ending_faces(points.size(), c_none);
+    std::size_t visit = 0U;
+
+    while (!pending.empty()) {
+      const std::uint32_t face = pending.back();
+      pending.pop_back();
+      if (!faces[face].is_alive || faces[face].outside.empty()) {
+        continue;
+      }
+      const std::uint32_t eye = faces[face].farthest;
+
+      // The faces seen from the eye form a connected region, its boundary
+      // is the horizon.
+      ++visit;
+      visible.clear();
+      horizon.clear();
+      stack.assign(1U, face);
+      faces[face].visit = visit;
+      while (!stack.empty()) {
+        const std::uint32_t current = stack.back();
+        stack.pop_back();
+        visible.push_back(current);
+        for (std::size_t edge = 0U; edge < 3U; ++edge) {
+          const std::uint32_t neighbor = faces[current].neighbors[edge];
+          if (faces[neighbor].visit == visit) {
+            continue;
+          }
+          if (getDistance(neighbor, eye) > tolerance) {
+            faces[neighbor].visit = visit;
+            stack.push_back(neighbor);
+          } else {
+            horizon.emplace_back(current, edge);
+          }
+        }
+      }
+
+      // Connects every edge of the horizon to the eye.
+      const auto first_new = static_cast<std::uint32_t>(faces.size());
+      for (const auto &[old_face, edge] : horizon) {
+        const std::uint32_t start = faces[old_face].vertices[edge];
+        const std::uint32_t end = faces[old_face].vertices[(edge + 1U) % 3U];
+        const std::uint32_t outer = faces[old_face].neighbors[edge];
+        const std::uint32_t new_face = addFace({start, end, eye});
+        faces[new_face].neighbors[0U] = outer;
+        for (std::size_t outer_edge = 0U; outer_edge < 3U; ++outer_edge) {
+          if (faces[outer].neighbors[outer_edge] == old_face &&
+              faces[outer].vertices[outer_edge] == end) {
+            faces[outer].neighbors[outer_edge] = new_face;
+          }
+        }
+        starting_faces[start] = new_face;
+        ending_faces[end] = new_face;
+      }
+      const auto end_new = static_cast<std::uint32_t>(faces.size());
+      for (std::uint32_t new_face = first_new; new_face < end_new;
+           ++new_face) {
+        auto &hull_face = faces[new_face];
+        hull_face.neighbors[1U] = starting_faces[hull_face.vertices[1U]];
+        hull_face.neighbors[2U] = ending_faces[hull_face.vertices[0U]];
+      }
+
+      // The points above the replaced faces are either above a new face or
+      // inside of the hull.
+      for (const auto old_face : visible) {
+        auto &hull_face = faces[old_face];
+        hull_face.is_alive = false;
+        for (const auto point : hull_face.outside) {
+          if (point != eye) {
+            assignPoint(point, first_new, end_new);
+          }
+        }
+        hull_face.outside = std::vector<std::uint32_t>();
+      }
+      for (std::uint32_t new_face = first_new; new_face < end_new;
+           ++new_face) {
+        if (!faces[new_face].outside.empty()) {
+          pending.push_back(new_face);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Holds the points.
+   */
+  const std::vector<Eigen::Vector3d> &points;
+  /**
+   * @brief Holds the distance within which a point is on a face.
+   */
+  double tolerance = 0.0;
+  /**
+   * @brief Holds every face created, including the replaced ones.
+   */
+  std::vector<HullFace> faces;
+};
+
+/**
+ * @brief Sorts points and removes the duplicates.
+ * @param points The points to be made unique.
+ */
+void makeUnique(std::vector<Eigen::Vector3d> &points) {
+  Parallel::sort(points, isLess);
+  points.erase(std::unique(points.begin(), points.end()), points.end());
+}
+
+/**
+ * @brief Builds the hull of the unique points and converts it to a mesh.
+ * @param points The unique points.
+ * @return The hull.
+ */
+MeshData toMeshData(const std::vector<Eigen::Vector3d> &points) {
+  MeshData mesh;
+  for (const auto &face : HullBuilder(points).getFaces()) {
+    Triangle triangle;
+    for (std::size_t corner = 0U; corner < 3U; ++corner) {
+      const auto &point = points[face[corner]];
+      auto &vertex = corner == 0U ? triangle.a
+                                  : (corner == 1U ? triangle.b : triangle.c);
+      vertex.pos = Eigen::Vector4d(point.x(), point.y(), point.z(), 1.0);
+    }
+    mesh.triangles.push_back(triangle);
+  }
+  return mesh;
+}
+
+} // namespace
+
+MeshData ConvexHull::calculate(const MeshData &mesh) {
+  const std::size_t triangle_count = mesh.triangles.size();
+  const std::size_t chunk_count =
+      (triangle_count + c_chunk_size - 1U) / c_chunk_size;
+  const auto &transformation = mesh.getPendingTransform();
+  const auto forEachPosition = [&mesh, &transformation](
+                                   std::size_t begin, std::size_t end,
+                                   const auto &func) {
+    for (std::size_t i = begin; i < end; ++i) {
+      const auto &triangle = mesh.triangles[i];
+      for (const auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+        const Eigen::Vector4d position =
+            transformation.transformPoint(vertex->pos);
+        if (position.allFinite()) {
+          func(Eigen::Vector3d(position.head<3>()));
+        }
+      }
+    }
+  };
+
+  // The extreme vertices of every chunk along every direction, then of the
+  // whole mesh.
+  const auto directions = getDirections();
+  using Extremes = std::array<std::pair<double, Eigen::Vector3d>,
+                              c_direction_count>;
+  Extremes extremes;
+  extremes.fill({-std::numeric_limits<double>::infinity(),
+                 Eigen::Vector3d::Zero()});
+  std::vector<Extremes> chunk_extremes(chunk_count, extremes);
+  Parallel::forEachBlock(
+      triangle_count, c_chunk_size,
+      [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto &chunk_extreme = chunk_extremes[chunk];
+        forEachPosition(begin, end, [&](const Eigen::Vector3d &position) {
+          for (std::size_t i = 0U; i < c_direction_count; ++i) {
+            const double projection = directions[i].dot(position);
+            if (projection > chunk_extreme[i].first) {
+              chunk_extreme[i] = {projection, position};
+            }
+          }
+        });
+      });
+  for (const auto &chunk_extreme : chunk_extremes) {
+    for (std::size_t i = 0U; i < c_direction_count; ++i) {
+      if (chunk_extreme[i].first > extremes[i].first) {
+        extremes[i] = chunk_extreme[i];
+      }
+    }
+  }
+  if (chunk_count == 0U || !std::isfinite(extremes[0U].first)) {
+    return MeshData();
+  }
+
+  // The planes of the hull of the extreme vertices, moved out by the
+  // tolerance, the vertices behind all of them are inside of the hull.
+  std::vector<Eigen::Vector3d> extreme_points;
+  for (const auto &extreme : extremes) {
+    extreme_points.push_back(extreme.second);
+  }
+  makeUnique(extreme_points);
+  std::vector<Eigen::Vector4d> planes;
+  Eigen::Vector3d max_coordinates = Eigen::Vector3d::Zero();
+  for (const auto &point : extreme_points) {
+    max_coordinates = max_coordinates.cwiseMax(point.cwiseAbs());
+  }
+  const double tolerance =
+      3.0 * std::numeric_limits<double>::epsilon() * max_coordinates.sum();
+  for (const auto &face : HullBuilder(extreme_points).getFaces()) {
+    const auto &a = extreme_points[face[0U]];
+    const Eigen::Vector3d normal = (extreme_points[face[1U]] - a)
+                                       .cross(extreme_points[face[2U]] - a)
+                                       .normalized();
+    planes.emplace_back(normal.x(), normal.y(), normal.z(),
+                        tolerance - normal.dot(a));
+  }
+
+  // The hulls of the chunks, keeping their vertices.
+  std::vector<std::vector<Eigen::Vector3d>> chunk_points(chunk_count);
+  Parallel::forEachBlock(
+      triangle_count, c_chunk_size,
+      [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto &candidates = chunk_points[chunk];
+        forEachPosition(begin, end, [&](const Eigen::Vector3d &position) {
+          const Eigen::Vector4d homogeneous(position.x(), position.y(),
+                                            position.z(), 1.0);
+          for (const auto &plane : planes) {
+            if (plane.dot(homogeneous) >= 0.0) {
+              candidates.push_back(position);
+              return;
+            }
+          }
+          if (planes.empty()) {
+            candidates.push_back(position);
+          }
+        });
+        std::sort(candidates.begin(), candidates.end(), isLess);
+        candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                         candidates.end());
+        const auto hull_faces = HullBuilder(candidates).getFaces();
+        if (hull_faces.empty()) {
+          return;
+        }
+        std::vector<std::uint8_t> is_vertex(candidates.size(), 0U);
+        for (const auto &face : hull_faces) {
+          for (const auto vertex : face) {
+            is_vertex[vertex] = 1U;
+          }
+        }
+        std::size_t kept = 0U;
+        for (std::size_t i = 0U; i < candidates.size(); ++i) {
+          if (is_vertex[i] != 0U) {
+            candidates[kept++] = candidates[i];
+          }
+        }
+        candidates.resize(kept);
+      });
+
+  std::vector<Eigen::Vector3d> points;
+  for (auto &candidates : chunk_points) {
+    points.insert(points.end(), candidates.begin(), candidates.end());
+    candidates = std::vector<Eigen::Vector3d>();
+  }
+  makeUnique(points);
+  return toMeshData(points);
+}
+
+MeshData ConvexHull::calculate(const std::vector<Eigen::Vector3d> &points) {
+  auto unique_points = points;
+  makeUnique(unique_points);
+  return toMeshData(unique_points);
+}
+
+} // namespace Converter
@@ -0,0 +1,49 @@
+#ifndef CONVEX_HULL_HPP
+#define CONVEX_HULL_HPP
+
+#include <Eigen/Dense>
+#include <vector>
+
+namespace Converter {
+
+class MeshData;
+
+/**
+ * @brief Calculates convex hulls of meshes with the Quickhull algorithm.
+ * @details The hull is built from the unique vertex positions in three
+ * steps. First the extreme vertices along 26 directions are found, and the
+ * vertices strictly inside of their hull are discarded, which removes most
+ * of the inside of a typical part for the cost of a dot product per plane.
+ * Then the remaining vertices are split into chunks of Triangles, whose
+ * hulls are built in parallel, keeping only the vertices of the chunk
+ * hulls. Finally the hull of those vertices is built. Quickhull grows a
+ * tetrahedron by repeatedly adding the point farthest above a face,
+ * replacing the faces it sees with a cone from the point to their horizon,
+ * and hands the points above the removed faces to the new ones. Points
+ * closer to a face than the numerical tolerance, three ulps of the
+ * coordinates, are treated as on it.
+ */
+class ConvexHull {
+public:
+  /**
+   * @brief Calculates the convex hull of a mesh.
+   * @note The pending transformation of the mesh is applied. The result
+   * does not depend on the number of threads.
+   * @param mesh The mesh whose hull should be calculated.
+   * @return The hull with outward facing Triangles, empty if the vertices
+   * are all in a plane.
+   */
+  static MeshData calculate(const MeshData &mesh);
+
+  /**
+   * @brief Calculates the convex hull of a set of points.
+   * @param points The points, duplicates are allowed.
+   * @return The hull with outward facing Triangles, empty if the points are
+   * all in a plane.
+   */
+  static MeshData calculate(const std::vector<Eigen::Vector3d> &points);
+};
+
+} // namespace Converter
+
+#endif
@@ -0,0 +1,686 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "decimation.hpp"
+#include "indexed_mesh.hpp"
+#include "parallel.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief Marks the end of a vertex group and the vertices shared by several
+ * partitions.
+ */
+constexpr std::uint32_t c_none = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief The weight of the quadrics keeping the boundary edges in place,
+ * relative to the quadrics of the faces.
+ */
+constexpr double c_boundary_weight = 100.0;
+
+/**
+ * @brief A possible collapse of an edge.
+ * @param cost The quadric error of the new position.
+ * @param position The position of the merged vertex.
+ * @param keep The vertex that is kept, the smaller index of the edge.
+ * @param remove The vertex that is merged into the kept one.
+ * @param keep_version The version of the kept vertex at the evaluation.
+ * @param remove_version The version of the removed vertex at the evaluation.
+ */
+struct Candidate {
+  double cost;
+  Eigen::Vector3d position;
+  std::uint32_t keep;
+  std::uint32_t remove;
+  std::uint32_t keep_version;
+  std::uint32_t remove_version;
+
+  /**
+   * @brief Orders the candidates by cost, ties are broken by the vertices so
+   * the order of the collapses is fully determined.
+   */
+  bool operator>(const Candidate &other) const {
+    return std::tie(cost, keep, remove) >
+           std::tie(other.cost, other.keep, other.remove);
+  }
+};
+
+/**
+ * @brief Min-heap of candidates, stale entries are skipped when popped.
+ */
+using CandidateQueue =
+    std::priority_queue<Candidate, std::vector<Candidate>,
+                        std::greater<Candidate>>;
+
+/**
+ * @brief Returns the quadric of a plane.
+ * @param normal The unit normal of the plane.
+ * @param point A point of the plane.
+ * @return The quadric measuring the squared distance from the plane.
+ */
+Eigen::Matrix4d planeQuadric(const Eigen::Vector3d &normal,
+                             const Eigen::Vector3d &point) {
+  Eigen::Vector4d plane;
+  plane << normal, -normal.dot(point);
+  return plane * plane.transpose();
+}
+
+/**
+ * @brief Evaluates a quadric at a point.
+ * @param quadric The quadric to be evaluated.
+ * @param point The point.
+ * @return The quadric error, clamped to non-negative values.
+ */
+double quadricError(const Eigen::Matrix4d &quadric,
+                    const Eigen::Vector3d &point) {
+  Eigen::Vector4d homogeneous;
+  homogeneous << point, 1.0;
+  return std::max(homogeneous.dot(quadric * homogeneous), 0.0);
+}
+
+/**
+ * @brief The mutable state of the simplification.
+ * @details The faces of every original vertex are stored in a compressed
+ * table. A collapse appends the vertex group of the removed vertex to the
+ * group of the kept one, so the faces of a vertex are the live faces in the
+ * lists of its group. Every live face is in exactly one list of each of its
+ * vertex groups.
+ */
+class Decimator {
+public:
+  /**
+   * @brief Builds the adjacency and the quadrics of a mesh.
+   * @param mesh The mesh to be simplified.
+   */
+  explicit Decimator(const IndexedMesh &mesh);
+
+  /**
+   * @brief Returns the number of live faces.
+   */
+  std::size_t getFaceCount() const;
+
+  /**
+   * @brief Assigns the faces to slabs along the longest axis and locks the
+   * vertices shared by several slabs.
+   * @param partition_count The number of slabs.
+   * @return The faces of every slab.
+   */
+  std::vector<std::vector<std::uint32_t>>
+  partition(std::size_t partition_count);
+
+  /**
+   * @brief Counts the faces having a locked vertex.
+   * @param partition_faces The faces to be checked.
+   * @return The number of faces on the seams of the partition.
+   */
+  std::size_t
+  countSeamFaces(const std::vector<std::uint32_t> &partition_faces) const;
+
+  /**
+   * @brief Assigns every live face to a single partition.
+   * @return The live faces.
+   */
+  std::vector<std::uint32_t> unpartition();
+
+  /**
+   * @brief Collapses edges of a partition until it has at most the target
+   * number of faces or the next collapse is too costly.
+   * @details Only the faces and the unlocked vertices of the partition are
+   * modified, so different partitions can be simplified concurrently.
+   * @param partition The index of the partition.
+   * @param faces The live faces of the partition.
+   * @param target_face_count The number of faces to stop at.
+   * @param max_cost The largest quadric error of a collapse.
+   */
+  void simplify(std::uint32_t partition,
+                const std::vector<std::uint32_t> &faces,
+                std::size_t target_face_count, double max_cost);
+
+  /**
+   * @brief Builds the mesh of the live faces.
+   * @return The mesh, with the vertices numbered in the order of their first
+   * use.
+   */
+  IndexedMesh toIndexedMesh() const;
+
+private:
+  /**
+   * @brief Calls a function for every live face of a vertex group.
+   */
+  template <typename Func>
+  void forEachFace(std::uint32_t vertex, const Func &func) const {
+    for (; vertex != c_none; vertex = next_in_group[vertex]) {
+      for (std::uint32_t i = face_offsets[vertex];
+           i < face_offsets[vertex + 1U]; ++i) {
+        if (face_alive[vertex_faces[i]] != 0U) {
+          func(vertex_faces[i]);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Collects the sorted, distinct neighbors of a vertex.
+   */
+  void collectNeighbors(std::uint32_t vertex,
+                        std::vector<std::uint32_t> &neighbors) const;
+
+  /**
+   * @brief Calculates the best position of a collapse and its cost.
+   */
+  Candidate evaluate(std::uint32_t first, std::uint32_t second) const;
+
+  /**
+   * @brief Checks that a collapse keeps the mesh manifold and doesn't flip
+   * any face.
+   */
+  bool isCollapseValid(const Candidate &candidate,
+                       std::vector<std::uint32_t> &keep_neighbors,
+                       std::vector<std::uint32_t> &remove_neighbors) const;
+
+  /**
+   * @brief Returns the unnormalized normal of a face, with one of its
+   * vertices moved.
+   */
+  Eigen::Vector3d faceNormal(std::uint32_t face, std::uint32_t moved,
+                             const Eigen::Vector3d &position) const;
+
+  /**
+   * @brief Holds the name of the material file of the input.
+   */
+  std::string material_file;
+  /**
+   * @brief Holds the current position of every vertex.
+   */
+  std::vector<Eigen::Vector3d> positions;
+  /**
+   * @brief Holds the accumulated quadric of every vertex.
+   */
+  std::vector<Eigen::Matrix4d> quadrics;
+  /**
+   * @brief Holds the faces, referencing the kept vertices of the collapses.
+   */
+  std::vector<IndexedMesh::Face> faces;
+  /**
+   * @brief Holds one for the faces that were not collapsed.
+   */
+  std::vector<std::uint8_t> face_alive;
+  /**
+   * @brief Holds where the faces of every original vertex start in
+   * vertex_faces, plus the end of the last one.
+   */
+  std::vector<std::uint32_t> face_offsets;
+  /**
+   * @brief Holds the faces of the original vertices.
+   */
+  std::vector<std::uint32_t> vertex_faces;
+  /**
+   * @brief Holds the next vertex of the group of every vertex.
+   */
+  std::vector<std::uint32_t> next_in_group;
+  /**
+   * @brief Holds the last vertex of the group of every kept vertex.
+   */
+  std::vector<std::uint32_t> group_tails;
+  /**
+   * @brief Holds the number of collapses every vertex was kept by, the
+   * candidates evaluated before the last one are stale.
+   */
+  std::vector<std::uint32_t> versions;
+  /**
+   * @brief Holds one for the vertices that were not removed.
+   */
+  std::vector<std::uint8_t> vertex_alive;
+  /**
+   * @brief Holds one for the vertices on a boundary edge.
+   */
+  std::vector<std::uint8_t> is_boundary;
+  /**
+   * @brief The partition of every vertex, c_none for the locked ones.
+   */
+  std::vector<std::uint32_t> owners;
+};
+
+Decimator::Decimator(const IndexedMesh &mesh)
+    : material_file(mesh.material_file), faces(mesh.faces) {
+  const std::size_t vertex_count = mesh.vertices.size();
+  const std::size_t face_count = faces.size();
+
+  positions.resize(vertex_count);
+  for (std::size_t i = 0U; i < vertex_count; ++i) {
+    positions[i] = mesh.vertices[i].head<3>();
+  }
+
+  // Faces referencing a vertex more than once are already collapsed.
+  face_alive.resize(face_count);
+  face_offsets.assign(vertex_count + 1U, 0U);
+  for (std::size_t i = 0U; i < face_count; ++i) {
+    const auto &[a, b, c] = faces[i];
+    face_alive[i] = a != b && b != c && c != a ? 1U : 0U;
+    if (face_alive[i] != 0U) {
+      ++face_offsets[a + 1U];
+      ++face_offsets[b + 1U];
+      ++face_offsets[c + 1U];
+    }
+  }
+  for (std::size_t i = 0U; i < vertex_count; ++i) {
+    face_offsets[i + 1U] += face_offsets[i];
+  }
+  vertex_faces.resize(face_offsets.back());
+  std::vector<std::uint32_t> fill(face_offsets.begin(),
+                                  face_offsets.end() - 1);
+  for (std::size_t i = 0U; i < face_count; ++i) {
+    if (face_alive[i] != 0U) {
+      for (const auto vertex : faces[i]) {
+        vertex_faces[fill[vertex]++] = static_cast<std::uint32_t>(i);
+      }
+    }
+  }
+
+  std::vector<Eigen::Vector3d> normals(face_count, Eigen::Vector3d::Zero());
+  Parallel::forEachBlock(
+      face_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          const auto &[a, b, c] = faces[i];
+          const Eigen::Vector3d cross =
+              (positions[b] - positions[a]).cross(positions[c] - positions[a]);
+          if (face_alive[i] != 0U && cross.norm() > 0.0) {
+            normals[i] = cross.normalized();
+          }
+        }
+      });
+
+  // Every vertex sums the quadrics of its own faces and boundary edges, so
+  // the vertices can be processed in parallel without sharing any writes.
+  quadrics.resize(vertex_count);
+  is_boundary.assign(vertex_count, 0U);
+  Parallel::forEachBlock(
+      vertex_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t vertex = begin; vertex < end; ++vertex) {
+          auto &quadric = quadrics[vertex];
+          quadric.setZero();
+          for (std::uint32_t i = face_offsets[vertex];
+               i < face_offsets[vertex + 1U]; ++i) {
+            const std::uint32_t face = vertex_faces[i];
+            quadric += planeQuadric(normals[face], positions[vertex]);
+
+            const auto &corners = faces[face];
+            const std::size_t corner = static_cast<std::size_t>(
+                std::find(corners.begin(), corners.end(), vertex) -
+                corners.begin());
+            for (const std::size_t step : {1U, 2U}) {
+              const std::uint32_t other = corners[(corner + step) % 3U];
+              std::size_t shared = 0U;
+              for (std::uint32_t j = face_offsets[vertex];
+                   j < face_offsets[vertex + 1U]; ++j) {
+                const auto &neighbor = faces[vertex_faces[j]];
+                shared += std::count(neighbor.begin(), neighbor.end(), other);
+              }
+              if (shared != 1U) {
+                continue;
+              }
+              is_boundary[vertex] = 1U;
+              const Eigen::Vector3d side =
+                  (positions[other] - positions[vertex])
+                      .cross(normals[face]);
+              if (side.norm() > 0.0) {
+                quadric += c_boundary_weight *
+                           planeQuadric(side.normalized(), positions[vertex]);
+              }
+            }
+          }
+        }
+      });
+
+  next_in_group.assign(vertex_count, c_none);
+  group_tails.resize(vertex_count);
+  for (std::size_t i = 0U; i < vertex_count; ++i) {
+    group_tails[i] = static_cast<std::uint32_t>(i);
+  }
+  versions.assign(vertex_count, 0U);
+  vertex_alive.assign(vertex_count, 1U);
+  owners.assign(vertex_count, 0U);
+}
+
+std::size_t Decimator::getFaceCount() const {
+  return static_cast<std::size_t>(
+      std::count(face_alive.begin(), face_alive.end(), 1U));
+}
+
+std::vector<std::vector<std::uint32_t>>
+Decimator::partition(std::size_t partition_count) {
+  std::vector<std::uint32_t> sorted_faces = unpartition();
+  Eigen::AlignedBox3d box;
+  for (const auto face : sorted_faces) {
+    for (const auto vertex : faces[face]) {
+      box.extend(positions[vertex]);
+    }
+  }
+  Eigen::Index axis = 0;
+  if (!box.isEmpty()) {
+    box.sizes().maxCoeff(&axis);
+  }
+
+  std::vector<double> centroids(faces.size(), 0.0);
+  for (const auto face : sorted_faces) {
+    for (const auto vertex : faces[face]) {
+      centroids[face] += positions[vertex][axis];
+    }
+  }
+  Parallel::sort(sorted_faces, [&centroids](std::uint32_t lhs,
+                                            std::uint32_t rhs) {
+    return std::tie(centroids[lhs], lhs) < std::tie(centroids[rhs], rhs);
+  });
+
+  std::vector<std::vector<std::uint32_t>> partitions(partition_count);
+  std::vector<std::uint32_t> face_partitions(faces.size(), c_none);
+  for (std::size_t i = 0U; i < sorted_faces.size(); ++i) {
+    const std::size_t index = i * partition_count / sorted_faces.size();
+    partitions[index].push_back(sorted_faces[i]);
+    face_partitions[sorted_faces[i]] = static_cast<std::uint32_t>(index);
+  }
+  for (auto &partition_faces : partitions) {
+    std::sort(partition_faces.begin(), partition_faces.end());
+  }
+
+  for (std::size_t vertex = 0U; vertex < owners.size(); ++vertex) {
+    if (vertex_alive[vertex] == 0U) {
+      continue;
+    }
+    std::uint32_t owner = c_none;
+    bool is_shared = false;
+    forEachFace(static_cast<std::uint32_t>(vertex),
+                [&](std::uint32_t face) {
+                  if (owner != c_none && owner != face_partitions[face]) {
+                    is_shared = true;
+                  }
+                  owner = face_partitions[face];
+                });
+    owners[vertex] = is_shared ? c_none : owner;
+  }
+  return partitions;
+}
+
+std::size_t Decimator::countSeamFaces(
+    const std::vector<std::uint32_t> &partition_faces) const {
+  return static_cast<std::size_t>(std::count_if(
+      partition_faces.begin(), partition_faces.end(),
+      [this](std::uint32_t face) {
+        const auto &corners = faces[face];
+        return std::any_of(corners.begin(), corners.end(),
+                           [this](std::uint32_t vertex) {
+                             return owners[vertex] == c_none;
+                           });
+      }));
+}
+
+std::vector<std::uint32_t> Decimator::unpartition() {
+  std::fill(owners.begin(), owners.end(), 0U);
+  std::vector<std::uint32_t> live_faces;
+  for (std::size_t i = 0U; i < faces.size(); ++i) {
+    if (face_alive[i] != 0U) {
+      live_faces.push_back(static_cast<std::uint32_t>(i));
+    }
+  }
+  return live_faces;
+}
+
+void Decimator::collectNeighbors(std::uint32_t vertex,
+                                 std::vector<std::uint32_t> &neighbors) const {
+  neighbors.clear();
+  forEachFace(vertex, [&](std::uint32_t face) {
+    for (const auto corner : faces[face]) {
+      if (corner != vertex) {
+        neighbors.push_back(corner);
+      }
+    }
+  });
+  std::sort(neighbors.begin(), neighbors.end());
+  neighbors.erase(std::unique(neighbors.begin(), neighbors.end()),
+                  neighbors.end());
+}
+
+Candidate Decimator::evaluate(std::uint32_t first,
+                              std::uint32_t second) const {
+  Candidate candidate;
+  candidate.keep = std::min(first, second);
+  candidate.remove = std::max(first, second);
+  candidate.keep_version = versions[candidate.keep];
+  candidate.remove_version = versions[candidate.remove];
+
+  const Eigen::Matrix4d quadric =
+      quadrics[candidate.keep] + quadrics[candidate.remove];
+  const Eigen::Vector3d &keep_position = positions[candidate.keep];
+  const Eigen::Vector3d &remove_position = positions[candidate.remove];
+  const Eigen::Vector3d midpoint = (keep_position + remove_position) / 2.0;
+
+  // The minimum of the quadric is only used if it is unique and near the
+  // edge, flat regions have a whole plane or line of minima.
+  const auto decomposition = quadric.topLeftCorner<3, 3>().fullPivLu();
+  if (decomposition.isInvertible()) {
+    const Eigen::Vector3d optimum =
+        decomposition.solve(-quadric.topRightCorner<3, 1>());
+    if ((optimum - midpoint).norm() <=
+        (keep_position - remove_position).norm()) {
+      candidate.position = optimum;
+      candidate.cost = quadricError(quadric, optimum);
+      return candidate;
+    }
+  }
+
+  candidate.position = midpoint;
+  candidate.cost = quadricError(quadric, midpoint);
+  for (const auto &position : {keep_position, remove_position}) {
+    const double cost = quadricError(quadric, position);
+    if (cost < candidate.cost) {
+      candidate.position = position;
+      candidate.cost = cost;
+    }
+  }
+  return candidate;
+}
+
+Eigen::Vector3d Decimator::faceNormal(std::uint32_t face, std::uint32_t moved,
+                                      const Eigen::Vector3d &position) const {
+  std::array<Eigen::Vector3d, 3U> corners;
+  for (std::size_t i = 0U; i < 3U; ++i) {
+    corners[i] = faces[face][i] == moved ? position : positions[faces[face][i]];
+  }
+  return (corners[1U] - corners[0U]).cross(corners[2U] - corners[0U]);
+}
+
+bool Decimator::isCollapseValid(
+    const Candidate &candidate, std::vector<std::uint32_t> &keep_neighbors,
+    std::vector<std::uint32_t> &remove_neighbors) const {
+  const std::uint32_t keep = candidate.keep;
+  const std::uint32_t remove = candidate.remove;
+
+  std::size_t shared_faces = 0U;
+  forEachFace(keep, [&](std::uint32_t face) {
+    shared_faces += std::count(faces[face].begin(), faces[face].end(), remove);
+  });
+  if (shared_faces == 0U ||
+      (is_boundary[keep] != 0U && is_boundary[remove] != 0U &&
+       shared_faces != 1U)) {
+    return false;
+  }
+
+  // The link condition: the only common neighbors of the two vertices are
+  // the opposite vertices of their shared faces.
+  collectNeighbors(keep, keep_neighbors);
+  collectNeighbors(remove, remove_neighbors);
+  std::size_t common_neighbors = 0U;
+  for (const auto neighbor : keep_neighbors) {
+    if (neighbor != remove &&
+        std::binary_search(remove_neighbors.begin(), remove_neighbors.end(),
+                           neighbor)) {
+      ++common_neighbors;
+    }
+  }
+  // Collapsing a tetrahedron or a lone triangle would leave faces without
+  // any volume or area.
+  const std::size_t all_neighbors =
+      keep_neighbors.size() + remove_neighbors.size() - 2U - common_neighbors;
+  if (common_neighbors != shared_faces || all_neighbors <= shared_faces) {
+    return false;
+  }
+
+  bool is_flipped = false;
+  for (const auto vertex : {keep, remove}) {
+    forEachFace(vertex, [&](std::uint32_t face) {
+      const auto &corners = faces[face];
+      if (is_flipped ||
+          std::count(corners.begin(), corners.end(), keep + remove - vertex) >
+              0) {
+        return;
+      }
+      const Eigen::Vector3d old_normal =
+          faceNormal(face, vertex, positions[vertex]);
+      const Eigen::Vector3d new_normal =
+          faceNormal(face, vertex, candidate.position);
+      is_flipped =
+          !old_normal.isZero(0.0) &&
+          (new_normal.isZero(0.0) || old_normal.dot(new_normal) <= 0.0);
+    });
+  }
+  return !is_flipped;
+}
+
+void Decimator::simplify(std::uint32_t partition,
+                         const std::vector<std::uint32_t> &partition_faces,
+                         std::size_t target_face_count, double max_cost) {
+  std::size_t face_count = 0U;
+  CandidateQueue queue;
+  for (const auto face : partition_faces) {
+    if (face_alive[face] == 0U) {
+      continue;
+    }
+    ++face_count;
+    const auto &corners = faces[face];
+    for (std::size_t i = 0U; i < 3U; ++i) {
+      const std::uint32_t first = corners[i];
+      const std::uint32_t second = corners[(i + 1U) % 3U];
+      if (owners[first] == partition && owners[second] == partition) {
+        queue.push(evaluate(first, second));
+      }
+    }
+  }
+
+  std::vector<std::uint32_t> keep_neighbors;
+  std::vector<std::uint32_t> remove_neighbors;
+  while (face_count > target_face_count && !queue.empty()) {
+    const Candidate candidate = queue.top();
+    queue.pop();
+    const std::uint32_t keep = candidate.keep;
+    const std::uint32_t remove = candidate.remove;
+    if (vertex_alive[keep] == 0U || vertex_alive[remove] == 0U ||
+        versions[keep] != candidate.keep_version ||
+        versions[remove] != candidate.remove_version) {
+      continue;
+    }
+    if (candidate.cost > max_cost) {
+      break;
+    }
+    if (!isCollapseValid(candidate, keep_neighbors, remove_neighbors)) {
+      continue;
+    }
+
+    forEachFace(remove, [&](std::uint32_t face) {
+      auto &corners = faces[face];
+      if (std::count(corners.begin(), corners.end(), keep) > 0) {
+        face_alive[face] = 0U;
+        --face_count;
+      } else {
+        std::replace(corners.begin(), corners.end(), remove, keep);
+      }
+    });
+    next_in_group[group_tails[keep]] = remove;
+    group_tails[keep] = group_tails[remove];
+    positions[keep] = candidate.position;
+    quadrics[keep] += quadrics[remove];
+    is_boundary[keep] |= is_boundary[remove];
+    vertex_alive[remove] = 0U;
+    ++versions[keep];
+
+    collectNeighbors(keep, keep_neighbors);
+    for (const auto neighbor : keep_neighbors) {
+      if (owners[neighbor] == partition) {
+        queue.push(evaluate(keep, neighbor));
+      }
+    }
+  }
+}
+
+IndexedMesh Decimator::toIndexedMesh() const {
+  IndexedMesh mesh;
+  mesh.material_file = material_file;
+  std::vector<std::uint32_t> new_indices(positions.size(), c_none);
+  for (std::size_t i = 0U; i < faces.size(); ++i) {
+    if (face_alive[i] == 0U) {
+      continue;
+    }
+    IndexedMesh::Face face;
+    for (std::size_t j = 0U; j < 3U; ++j) {
+      auto &new_index = new_indices[faces[i][j]];
+      if (new_index == c_none) {
+        new_index = static_cast<std::uint32_t>(mesh.vertices.size());
+        const auto &position = positions[faces[i][j]];
+        mesh.vertices.emplace_back(position.x(), position.y(), position.z(),
+                                   1.0);
+      }
+      face[j] = new_index;
+    }
+    mesh.faces.push_back(face);
+  }
+  return mesh;
+}
+
+} // namespace
+
+IndexedMesh Decimation::decimate(const IndexedMesh &mesh,
+                                 const Settings &settings) {
+  Decimator decimator(mesh);
+  const double max_cost = settings.max_error * settings.max_error;
+
+  const std::size_t face_count = decimator.getFaceCount();
+  if (settings.partition_count > 1U && face_count > 0U) {
+    const auto partitions = decimator.partition(settings.partition_count);
+    Parallel::forEachBlock(
+        partitions.size(), 1U,
+        [&](std::size_t index, std::size_t, std::size_t) {
+          const auto &faces = partitions[index];
+          // The slabs stop at twice their share of the target, plus the
+          // faces they can't collapse, so a slab with more detail than the
+          // others doesn't have to give up its features. The final pass
+          // distributes the rest of the collapses over the whole mesh.
+          const std::size_t share =
+              (settings.target_face_count * faces.size() + face_count - 1U) /
+              face_count;
+          const std::size_t target =
+              2U * share + decimator.countSeamFaces(faces);
+          decimator.simplify(static_cast<std::uint32_t>(index), faces,
+                             target, max_cost);
+        });
+  }
+
+  decimator.simplify(0U, decimator.unpartition(), settings.target_face_count,
+                     max_cost);
+  return decimator.toIndexedMesh();
+}
+
+} // namespace Converter
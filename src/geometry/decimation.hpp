@@ -0,0 +1,70 @@
+#ifndef DECIMATION_HPP
+#define DECIMATION_HPP
+
+#include <cstddef>
+#include <limits>
+
+namespace Converter {
+
+class IndexedMesh;
+
+/**
+ * @brief Simplifies indexed meshes with quadric error metric edge collapses.
+ * @details Every vertex accumulates the quadric of the planes of its faces,
+ * which measures the sum of the squared distances of a point from those
+ * planes. The edges are collapsed in the order of the error of their best
+ * position, taken from a priority queue whose stale entries are recognized
+ * by version stamps and skipped instead of being removed. The faces around
+ * a vertex are found through a compressed vertex to face table built once,
+ * merged vertices chain their lists together, so a collapse never moves
+ * faces around. Collapses that would flip a face or make the mesh
+ * non-manifold are rejected, and boundary edges are kept in place by
+ * additional quadrics perpendicular to their faces.
+ */
+class Decimation {
+public:
+  /**
+   * @brief A partition count that keeps the usual core counts busy, for
+   * callers that need the same result on every machine.
+   */
+  static constexpr std::size_t c_default_partition_count = 8U;
+
+  /**
+   * @brief The parameters of the simplification.
+   * @param target_face_count The simplification stops when the number of
+   * faces is at most this.
+   * @param max_error The simplification stops when the square root of the
+   * quadric error of the next collapse is greater than this.
+   * @param partition_count The number of spatial partitions simplified in
+   * parallel, one means the whole mesh is simplified serially.
+   */
+  struct Settings {
+    std::size_t target_face_count = 0U;
+    double max_error = std::numeric_limits<double>::infinity();
+    std::size_t partition_count = 1U;
+  };
+
+  /**
+   * @brief Simplifies a mesh.
+   * @details With multiple partitions the faces are sorted along the longest
+   * axis of the bounding box and split into slabs of equal face count. The
+   * vertices shared by several slabs are locked, so every slab only touches
+   * its own faces and vertices, and the slabs are simplified in parallel,
+   * each to twice its share of the target plus its faces on the seams. A
+   * final serial pass over the whole mesh then collapses the seams and the
+   * remaining edges until the target is reached. The result only depends on
+   * the settings, not on the number of threads.
+   * @note The mesh should be welded, the faces of a triangle soup share no
+   * edges. Faces referencing a vertex more than once are removed.
+   * @param mesh The mesh to be simplified.
+   * @param settings The parameters of the simplification.
+   * @return The simplified mesh, its faces keep their relative order and its
+   * vertices are numbered in the order of their first use.
+   */
+  static IndexedMesh decimate(const IndexedMesh &mesh,
+                              const Settings &settings);
+};
+
+} // namespace Converter
+
+#endif
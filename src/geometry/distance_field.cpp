@@ -0,0 +1,381 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "closest_point_query.hpp"
+#include "distance_field.hpp"
+#include "mesh_statistics.hpp"
+#include "meshdata.hpp"
+#include "parallel.hpp"
+#include "triangle.hpp"
+#include "triangle_packet.hpp"
+#include "utility.hpp"
+#include "winding_number.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief The number of rows of a sweep plane a task updates.
+ */
+constexpr std::size_t c_sweep_block_size = 4U;
+
+/**
+ * @brief Marks the grid points without a closest Triangle.
+ */
+constexpr std::uint32_t c_none = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief The grid of a distance field while it is being generated.
+ */
+struct Grid {
+  /**
+   * @brief The number of grid points along each axis.
+   */
+  std::array<std::size_t, 3U> dimensions;
+  /**
+   * @brief The distance of the closest Triangle found for every grid point,
+   * infinity if none was found yet.
+   */
+  std::vector<float> distances;
+  /**
+   * @brief The index of the closest Triangle found for every grid point.
+   */
+  std::vector<std::uint32_t> closest_triangles;
+  /**
+   * @brief Set for the grid points whose distance is exact.
+   */
+  std::vector<std::uint8_t> is_exact;
+};
+
+/**
+ * @brief Fills the distances outside of the band with the fast sweeping
+ * method.
+ * @details Instead of solving the eikonal equation, every grid point takes
+ * the closest Triangles of its neighbors as candidates, and keeps the
+ * nearest of them and its own, like the level set construction of Bridson.
+ * The candidates are tested with one call of the packet point-triangle
+ * distance, so the distances are exact distances to a nearby Triangle,
+ * without the smearing of the finite difference schemes around edges and
+ * corners. Every one of the eight sweep directions visits the planes of
+ * constant x + y + z in order, and the grid points of a plane are not
+ * neighbors, so they are updated in parallel, by the same threads for all
+ * the planes of a direction.
+ * @param grid The grid to be filled.
+ * @param triangles The Triangles of the mesh, transformed.
+ * @param getPosition Returns the position of a grid point by its index.
+ */
+template <typename GetPosition>
+void sweep(Grid &grid, const std::vector<Triangle> &triangles,
+           const GetPosition &getPosition) {
+  const std::size_t size_x = grid.dimensions[0U];
+  const std::size_t size_y = grid.dimensions[1U];
+  const std::size_t size_z = grid.dimensions[2U];
+  const std::size_t level_count = size_x + size_y + size_z - 2U;
+  const std::size_t max_yz_level = size_y + size_z - 2U;
+
+  const auto update = [&](std::size_t index,
+                          const std::array<std::size_t, 3U> &coordinates,
+                          std::vector<std::uint32_t> &candidates) {
+    candidates.clear();
+    std::size_t stride = 1U;
+    for (std::size_t axis = 0U; axis < 3U; ++axis) {
+      for (const bool is_forward : {false, true}) {
+        if (is_forward ? coordinates[axis] + 1U >= grid.dimensions[axis]
+                       : coordinates[axis] == 0U) {
+          continue;
+        }
+        const std::uint32_t candidate =
+            grid.closest_triangles[is_forward ? index + stride
+                                              : index - stride];
+        if (candidate != c_none &&
+            candidate != grid.closest_triangles[index] &&
+            std::find(candidates.begin(), candidates.end(), candidate) ==
+                candidates.end()) {
+          candidates.push_back(candidate);
+        }
+      }
+      stride *= grid.dimensions[axis];
+    }
+    if (candidates.empty()) {
+      return;
+    }
+
+    TrianglePacket packet;
+    packet.load(triangles, candidates, 0U, candidates.size());
+    const auto points =
+        packet.findClosestPoints(getPosition(index).template head<3>());
+    for (std::size_t lane = 0U; lane < packet.count; ++lane) {
+      const auto distance =
+          static_cast<float>(std::sqrt(points.distance_squared[lane]));
+      if (distance < grid.distances[index]) {
+        grid.distances[index] = distance;
+        grid.closest_triangles[index] = candidates[lane];
+      }
+    }
+  };
+
+  // The first x coordinate of a plane, the others are cut off by the grid.
+  const auto getFirstI = [max_yz_level](std::size_t level) {
+    return level > max_yz_level ? level - max_yz_level : 0U;
+  };
+  for (unsigned int direction = 0U; direction < 8U; ++direction) {
+    const bool is_x_flipped = (direction & 1U) != 0U;
+    const bool is_y_flipped = (direction & 2U) != 0U;
+    const bool is_z_flipped = (direction & 4U) != 0U;
+    Parallel::forEachLevel(
+        level_count,
+        [&](std::size_t level) {
+          return std::min(size_x - 1U, level) + 1U - getFirstI(level);
+        },
+        c_sweep_block_size,
+        [&](std::size_t level, std::size_t begin, std::size_t end) {
+          const std::size_t i_begin = getFirstI(level);
+          std::vector<std::uint32_t> candidates;
+          for (std::size_t i = i_begin + begin; i < i_begin + end; ++i) {
+            const std::size_t rest = level - i;
+            const std::size_t j_begin =
+                rest > size_z - 1U ? rest - (size_z - 1U) : 0U;
+            const std::size_t j_end = std::min(size_y - 1U, rest) + 1U;
+            for (std::size_t j = j_begin; j < j_end; ++j) {
+              const std::size_t k = rest - j;
+              const std::array<std::size_t, 3U> coordinates = {
+                  is_x_flipped ? size_x - 1U - i : i,
+                  is_y_flipped ? size_y - 1U - j : j,
+                  is_z_flipped ? size_z - 1U - k : k};
+              const std::size_t index =
+                  coordinates[0U] +
+                  size_x * (coordinates[1U] + size_y * coordinates[2U]);
+              if (grid.is_exact[index] == 0U) {
+                update(index, coordinates, candidates);
+              }
+            }
+          }
+        });
+  }
+}
+
+} // namespace
+
+DistanceField DistanceField::generate(const MeshData &mesh,
+                                      const Settings &settings) {
+  DistanceField field;
+  if (mesh.triangles.empty()) {
+    return field;
+  }
+
+  // The grid covers the bounding box, padded so the band fits in it.
+  const auto box = MeshStatistics::calculate(mesh).getBoundingBox();
+  const std::size_t band_width = std::max<std::size_t>(settings.band_width,
+                                                       1U);
+  const std::size_t padding = band_width + 1U;
+  field.voxel_size = box.sizes().maxCoeff() /
+                     static_cast<double>(std::max<std::size_t>(
+                         settings.resolution, 1U));
+  if (!(field.voxel_size > 0.0)) {
+    field.voxel_size = 1.0;
+  }
+  const double voxel_size = field.voxel_size;
+  field.origin = box.min().array() - static_cast<double>(padding) * voxel_size;
+  for (Eigen::Index axis = 0; axis < 3; ++axis) {
+    field.dimensions[static_cast<std::size_t>(axis)] =
+        static_cast<std::size_t>(std::ceil(box.sizes()[axis] / voxel_size)) +
+        1U + 2U * padding;
+  }
+  const auto [size_x, size_y, size_z] = field.dimensions;
+  const std::size_t point_count = size_x * size_y * size_z;
+  const double band_distance = static_cast<double>(band_width) * voxel_size;
+
+  // Marks the grid points around the bounding box of every Triangle.
+  const auto &transformation = mesh.getPendingTransform();
+  std::vector<std::uint8_t> is_in_band(point_count, 0U);
+  for (const auto &triangle : mesh.triangles) {
+    Eigen::AlignedBox3d triangle_box;
+    for (const auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+      triangle_box.extend(
+          Eigen::Vector3d(transformation.transformPoint(vertex->pos)
+                              .head<3>()));
+    }
+    std::array<std::size_t, 3U> first;
+    std::array<std::size_t, 3U> last;
+    for (std::size_t axis = 0U; axis < 3U; ++axis) {
+      const auto index = static_cast<Eigen::Index>(axis);
+      const double low =
+          std::floor((triangle_box.min()[index] - field.origin[index]) /
+                     voxel_size) -
+          static_cast<double>(band_width);
+      const double high =
+          std::ceil((triangle_box.max()[index] - field.origin[index]) /
+                    voxel_size) +
+          static_cast<double>(band_width);
+      const double max_index =
+          static_cast<double>(field.dimensions[axis] - 1U);
+      first[axis] = static_cast<std::size_t>(std::clamp(low, 0.0, max_index));
+      last[axis] = static_cast<std::size_t>(std::clamp(high, 0.0, max_index));
+    }
+    for (std::size_t z = first[2U]; z <= last[2U]; ++z) {
+      for (std::size_t y = first[1U]; y <= last[1U]; ++y) {
+        const std::size_t row = size_x * (y + size_y * z);
+        std::fill(is_in_band.begin() + row + first[0U],
+                  is_in_band.begin() + row + last[0U] + 1U, 1U);
+      }
+    }
+  }
+  std::vector<std::size_t> band;
+  for (std::size_t i = 0U; i < point_count; ++i) {
+    if (is_in_band[i] != 0U) {
+      band.push_back(i);
+    }
+  }
+  is_in_band = std::vector<std::uint8_t>();
+
+  // The exact distances and the signs within the band.
+  const ClosestPointQuery query(mesh);
+  const WindingNumber winding_number(mesh);
+  const auto getPosition = [&field](std::size_t index) {
+    const std::size_t x = index % field.dimensions[0U];
+    const std::size_t yz = index / field.dimensions[0U];
+    return field.getPosition(x, yz % field.dimensions[1U],
+                             yz / field.dimensions[1U]);
+  };
+  Grid grid;
+  grid.dimensions = field.dimensions;
+  grid.distances.assign(point_count, std::numeric_limits<float>::infinity());
+  grid.closest_triangles.assign(point_count, c_none);
+  grid.is_exact.assign(point_count, 0U);
+  std::vector<std::int8_t> signs(point_count, 0);
+  Parallel::forEachBlock(
+      band.size(), Parallel::c_block_size / 16U,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          const std::size_t index = band[i];
+          const Eigen::Vector4d position = getPosition(index);
+          const auto result = query.findClosestPoint(position, band_distance);
+          if (!result) {
+            continue;
+          }
+          grid.distances[index] = static_cast<float>(result->distance);
+          grid.closest_triangles[index] = result->triangle_index;
+          grid.is_exact[index] = 1U;
+          if (result->distance <= voxel_size) {
+            signs[index] =
+                winding_number.isPointInside(position) ? std::int8_t{-1}
+                                                       : std::int8_t{1};
+          }
+        }
+      });
+
+  if (settings.is_narrow_band) {
+    for (std::size_t i = 0U; i < point_count; ++i) {
+      if (grid.is_exact[i] == 0U) {
+        grid.distances[i] = static_cast<float>(band_distance);
+      }
+    }
+  } else {
+    std::vector<Triangle> triangles;
+    if (transformation.getKind() != AffineTransform::Kind::IDENTITY) {
+      triangles.reserve(mesh.triangles.size());
+      for (const auto &triangle : mesh.triangles) {
+        triangles.push_back({transformation.transformPoint(triangle.a.pos),
+                             transformation.transformPoint(triangle.b.pos),
+                             transformation.transformPoint(triangle.c.pos)});
+      }
+    }
+    sweep(grid, triangles.empty() ? mesh.triangles : triangles, getPosition);
+  }
+
+  // A segment between neighbors crossing the surface has an end within half
+  // a voxel of it, so the surface does not pass between the grid points
+  // farther than a voxel, and every connected region of them takes the sign
+  // of one of its points.
+  const std::array<std::size_t, 3U> strides = {1U, size_x, size_x * size_y};
+  std::vector<std::size_t> stack;
+  for (std::size_t seed = 0U; seed < point_count; ++seed) {
+    if (signs[seed] != 0) {
+      continue;
+    }
+    const std::int8_t sign = winding_number.isPointInside(getPosition(seed))
+                                 ? std::int8_t{-1}
+                                 : std::int8_t{1};
+    signs[seed] = sign;
+    stack.push_back(seed);
+    while (!stack.empty()) {
+      const std::size_t index = stack.back();
+      stack.pop_back();
+      std::size_t remainder = index;
+      for (std::size_t axis = 0U; axis < 3U; ++axis) {
+        const std::size_t coordinate =
+            remainder % field.dimensions[axis];
+        remainder /= field.dimensions[axis];
+        if (coordinate > 0U && signs[index - strides[axis]] == 0) {
+          signs[index - strides[axis]] = sign;
+          stack.push_back(index - strides[axis]);
+        }
+        if (coordinate + 1U < field.dimensions[axis] &&
+            signs[index + strides[axis]] == 0) {
+          signs[index + strides[axis]] = sign;
+          stack.push_back(index + strides[axis]);
+        }
+      }
+    }
+  }
+
+  field.values.resize(point_count);
+  for (std::size_t i = 0U; i < point_count; ++i) {
+    field.values[i] = static_cast<float>(signs[i]) * grid.distances[i];
+  }
+  return field;
+}
+
+Eigen::Vector4d DistanceField::getPosition(std::size_t x, std::size_t y,
+                                           std::size_t z) const {
+  return {origin.x() + static_cast<double>(x) * voxel_size,
+          origin.y() + static_cast<double>(y) * voxel_size,
+          origin.z() + static_cast<double>(z) * voxel_size, 1.0};
+}
+
+void DistanceField::write(std::ostream &out_stream) const {
+  out_stream << std::setprecision(std::numeric_limits<double>::max_digits10);
+  out_stream << "NRRD0004\n"
+             << "# Signed distance field, negative inside the mesh\n"
+             << "type: float\n"
+             << "dimension: 3\n"
+             << "space dimension: 3\n"
+             << "sizes: " << dimensions[0U] << ' ' << dimensions[1U] << ' '
+             << dimensions[2U] << '\n'
+             << "space directions: (" << voxel_size << ",0,0) (0,"
+             << voxel_size << ",0) (0,0," << voxel_size << ")\n"
+             << "space origin: (" << origin.x() << ',' << origin.y() << ','
+             << origin.z() << ")\n"
+             << "endian: little\n"
+             << "encoding: raw\n\n";
+  if (Utility::isFloatLittleEndian()) {
+    out_stream.write(reinterpret_cast<const char *>(values.data()),
+                     static_cast<std::streamsize>(values.size() *
+                                                  sizeof(float)));
+    return;
+  }
+
+  // The values are swapped a block at a time, so the field is not copied.
+  std::array<float, Parallel::c_block_size> block;
+  for (std::size_t begin = 0U; begin < values.size();
+       begin += block.size()) {
+    const std::size_t count = std::min(block.size(), values.size() - begin);
+    for (std::size_t i = 0U; i < count; ++i) {
+      block[i] = Utility::swapByteOrder(values[begin + i]);
+    }
+    out_stream.write(reinterpret_cast<const char *>(block.data()),
+                     static_cast<std::streamsize>(count * sizeof(float)));
+  }
+}
+
+} // namespace Converter
@@ -0,0 +1,137 @@
+#ifndef DISTANCE_FIELD_HPP
+#define DISTANCE_FIELD_HPP
+
+#include <Eigen/Dense>
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace Converter {
+
+class MeshData;
+
+/**
+ * @brief Signed distance field of a mesh sampled on a regular grid.
+ * @details The grid covers the bounding box of the mesh with some padding.
+ * The distances of the grid points within a band around the surface are
+ * calculated exactly with a ClosestPointQuery. The rest of the grid is
+ * either clamped to the width of the band, or filled with the fast sweeping
+ * method: the closest Triangles are propagated from neighbor to neighbor and
+ * the distance of every grid point is measured to the nearest of its
+ * candidates. The sweeps visit the grid points along the planes of constant
+ * x + y + z, so the points of a plane are updated in parallel. The sign is
+ * taken from the generalized winding number rather than ray parity: it is
+ * evaluated for every grid point within a voxel of the surface, while the
+ * farther grid points are flood filled from a single evaluation per
+ * connected region, since the surface can't pass between them. Negative
+ * values are inside the mesh.
+ */
+class DistanceField {
+public:
+  /**
+   * @brief The parameters of the generation.
+   * @param resolution The number of voxels along the longest side of the
+   * bounding box of the mesh.
+   * @param band_width The distance from the surface within which the
+   * distances are exact, in voxels, at least one.
+   * @param is_narrow_band If true, the grid points outside of the band are
+   * set to the width of the band instead of their distance.
+   */
+  struct Settings {
+    std::size_t resolution = 64U;
+    std::size_t band_width = 3U;
+    bool is_narrow_band = false;
+  };
+
+  /**
+   * @brief Generates the distance field of a mesh.
+   * @note The pending transformation of the mesh is applied. The result
+   * does not depend on the number of threads.
+   * @param mesh The mesh whose distance field should be generated, it
+   * should be closed for the sign to be meaningful.
+   * @param settings The parameters of the generation.
+   * @return The distance field, empty if the mesh has no Triangles.
+   */
+  static DistanceField generate(const MeshData &mesh,
+                                const Settings &settings);
+
+  /**
+   * @brief Returns the number of grid points along each axis.
+   * @return The number of grid points along x, y and z.
+   */
+  const std::array<std::size_t, 3U> &getDimensions() const {
+    return dimensions;
+  }
+
+  /**
+   * @brief Returns the position of the first grid point.
+   * @return The position of the grid point (0, 0, 0).
+   */
+  const Eigen::Vector3d &getOrigin() const { return origin; }
+
+  /**
+   * @brief Returns the distance of neighboring grid points.
+   * @return The edge length of a voxel.
+   */
+  double getVoxelSize() const { return voxel_size; }
+
+  /**
+   * @brief Returns the signed distances of every grid point.
+   * @return The distances with x changing the fastest, then y, then z.
+   */
+  const std::vector<float> &getValues() const { return values; }
+
+  /**
+   * @brief Returns the signed distance of a grid point.
+   * @param x The index of the grid point along the x axis.
+   * @param y The index of the grid point along the y axis.
+   * @param z The index of the grid point along the z axis.
+   * @return The signed distance, negative inside the mesh.
+   */
+  float getValue(std::size_t x, std::size_t y, std::size_t z) const {
+    return values[x + dimensions[0U] * (y + dimensions[1U] * z)];
+  }
+
+  /**
+   * @brief Returns the position of a grid point.
+   * @param x The index of the grid point along the x axis.
+   * @param y The index of the grid point along the y axis.
+   * @param z The index of the grid point along the z axis.
+   * @return The position with 1 as its homogeneous coordinate.
+   */
+  Eigen::Vector4d getPosition(std::size_t x, std::size_t y,
+                              std::size_t z) const;
+
+  /**
+   * @brief Writes the field as an NRRD file.
+   * @details A short text header describing the type, the dimensions, the
+   * spacing and the origin of the grid is followed by the values as raw
+   * little endian 32-bit floats, which are byte swapped on big endian
+   * hosts.
+   * @param out_stream The binary stream to write to.
+   */
+  void write(std::ostream &out_stream) const;
+
+private:
+  /**
+   * @brief Holds the number of grid points along each axis.
+   */
+  std::array<std::size_t, 3U> dimensions = {0U, 0U, 0U};
+  /**
+   * @brief Holds the position of the first grid point.
+   */
+  Eigen::Vector3d origin = Eigen::Vector3d::Zero();
+  /**
+   * @brief Holds the distance of neighboring grid points.
+   */
+  double voxel_size = 0.0;
+  /**
+   * @brief Holds the signed distances, x changing the fastest.
+   */
+  std::vector<float> values;
+};
+
+} // namespace Converter
+
+#endif
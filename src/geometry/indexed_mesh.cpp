@@ -0,0 +1,542 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "indexed_mesh.hpp"
+#include "meshdata.hpp"
+#include "parallel.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief The quantized position of a vertex.
+ */
+using VertexKey = std::array<std::uint64_t, 3U>;
+
+/**
+ * @brief Returns the key of a position.
+ * @param position The position to be quantized.
+ * @param tolerance The size of the grid cells, zero uses the bit patterns
+ * of the coordinates.
+ * @return The key of the position.
+ */
+VertexKey makeKey(const Eigen::Vector4d &position, double tolerance) {
+  VertexKey key;
+  for (Eigen::Index axis = 0; axis < 3; ++axis) {
+    if (tolerance > 0.0) {
+      key[axis] = static_cast<std::uint64_t>(
+          static_cast<std::int64_t>(std::floor(position[axis] / tolerance)));
+    } else {
+      // Adding zero turns -0.0 into 0.0, so they are merged.
+      const double coordinate = position[axis] + 0.0;
+      std::memcpy(&key[axis], &coordinate, sizeof(double));
+    }
+  }
+  return key;
+}
+
+/**
+ * @brief Mixes the coordinates of a key into a hash value.
+ * @param key The key to be hashed.
+ * @return The hash of the key.
+ */
+std::uint64_t hashKey(const VertexKey &key) {
+  std::uint64_t hash = 0x9E3779B97F4A7C15ULL;
+  for (const auto coordinate : key) {
+    hash ^= coordinate + 0x9E3779B97F4A7C15ULL + (hash << 6U) + (hash >> 2U);
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 31U;
+  }
+  return hash;
+}
+
+/**
+ * @brief Lock-free hash set of vertex keys, identified by the index of a
+ * Triangle corner having the key.
+ * @details Every slot holds a corner index plus one, zero marks the empty
+ * slots. Slots are never freed, so the slot of a key never changes once it
+ * is inserted, and inserting a smaller corner with the same key replaces the
+ * stored one, which makes the final content independent of the order of the
+ * insertions.
+ */
+class CornerTable {
+public:
+  /**
+   * @brief Creates a table large enough for the given number of corners.
+   * @param corner_count The maximum number of inserted keys.
+   */
+  explicit CornerTable(std::size_t corner_count) {
+    std::size_t capacity = 16U;
+    while (capacity < 2U * corner_count) {
+      capacity *= 2U;
+    }
+    mask = capacity - 1U;
+    slots = std::make_unique<std::atomic<std::uint32_t>[]>(capacity);
+    for (std::size_t i = 0U; i < capacity; ++i) {
+      slots[i].store(0U, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Inserts a corner, keeping the smallest corner of every key.
+   * @param keys The keys of every corner.
+   * @param corner The index of the corner to be inserted.
+   */
+  void insert(const std::vector<VertexKey> &keys, std::uint32_t corner) {
+    const auto &key = keys[corner];
+    for (std::size_t slot = hashKey(key) & mask;; slot = (slot + 1U) & mask) {
+      std::uint32_t stored = slots[slot].load(std::memory_order_acquire);
+      if (stored == 0U) {
+        if (slots[slot].compare_exchange_strong(stored, corner + 1U,
+                                                std::memory_order_acq_rel)) {
+          return;
+        }
+        // Another thread claimed the slot, stored now holds its corner.
+      }
+      if (keys[stored - 1U] != key) {
+        continue;
+      }
+      while (corner + 1U < stored &&
+             !slots[slot].compare_exchange_weak(stored, corner + 1U,
+                                                std::memory_order_acq_rel)) {
+      }
+      return;
+    }
+  }
+
+  /**
+   * @brief Finds the representative corner of a key.
+   * @param keys The keys of every corner.
+   * @param corner A corner that was inserted before.
+   * @return The smallest corner with the same key.
+   */
+  std::uint32_t find(const std::vector<VertexKey> &keys,
+                     std::uint32_t corner) const {
+    const auto &key = keys[corner];
+    for (std::size_t slot = hashKey(key) & mask;; slot = (slot + 1U) & mask) {
+      const std::uint32_t stored = slots[slot].load(std::memory_order_acquire);
+      if (keys[stored - 1U] == key) {
+        return stored - 1U;
+      }
+    }
+  }
+
+private:
+  /**
+   * @brief Holds the slots of the table.
+   */
+  std::unique_ptr<std::atomic<std::uint32_t>[]> slots;
+  /**
+   * @brief Holds the capacity minus one, the capacity is a power of two.
+   */
+  std::size_t mask;
+};
+
+/**
+ * @brief Marks the cells that are not used by any face yet.
+ */
+constexpr std::uint32_t c_unused_cell =
+    std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief Returns a corner of a Triangle.
+ * @param triangle The Triangle.
+ * @param corner The index of the corner, 0, 1 or 2.
+ * @return The position of the corner.
+ */
+const Eigen::Vector4d &getCorner(const Triangle &triangle, std::size_t corner) {
+  return corner == 0U ? triangle.a.pos
+                      : (corner == 1U ? triangle.b.pos : triangle.c.pos);
+}
+
+/**
+ * @brief Collects the indices of the selected elements of a range, using
+ * multiple threads.
+ * @details The selected elements are counted for each block, then every
+ * block writes its indices after the counts of the blocks before it.
+ * @tparam Predicate Callable with the signature bool(std::size_t).
+ * @param size The number of elements in the range.
+ * @param is_selected Returns if an element is selected.
+ * @return The indices of the selected elements, in increasing order.
+ */
+template <typename Predicate>
+std::vector<std::uint32_t> selectIndices(std::size_t size,
+                                         const Predicate &is_selected) {
+  const std::size_t block_count =
+      (size + Parallel::c_block_size - 1U) / Parallel::c_block_size;
+  std::vector<std::size_t> block_offsets(block_count + 1U, 0U);
+  Parallel::forEachBlock(
+      size, Parallel::c_block_size,
+      [&](std::size_t block, std::size_t begin, std::size_t end) {
+        std::size_t count = 0U;
+        for (std::size_t i = begin; i < end; ++i) {
+          count += is_selected(i) ? 1U : 0U;
+        }
+        block_offsets[block + 1U] = count;
+      });
+  for (std::size_t block = 0U; block < block_count; ++block) {
+    block_offsets[block + 1U] += block_offsets[block];
+  }
+
+  std::vector<std::uint32_t> indices(block_offsets.back());
+  Parallel::forEachBlock(
+      size, Parallel::c_block_size,
+      [&](std::size_t block, std::size_t begin, std::size_t end) {
+        std::size_t next = block_offsets[block];
+        for (std::size_t i = begin; i < end; ++i) {
+          if (is_selected(i)) {
+            indices[next++] = static_cast<std::uint32_t>(i);
+          }
+        }
+      });
+  return indices;
+}
+
+/**
+ * @brief Points merged by their keys.
+ * @param indices The group of every point.
+ * @param firsts The first point of every group.
+ */
+struct Groups {
+  std::vector<std::uint32_t> indices;
+  std::vector<std::uint32_t> firsts;
+};
+
+/**
+ * @brief Merges the points with equal keys, using multiple threads.
+ * @details The points are inserted into a CornerTable, and the groups are
+ * numbered in the order of their first point, so the result does not
+ * depend on the number of threads.
+ * @param keys The key of every point.
+ * @return The groups of the points.
+ */
+Groups groupKeys(const std::vector<VertexKey> &keys) {
+  const std::size_t point_count = keys.size();
+  CornerTable table(point_count);
+  Parallel::forEachBlock(point_count, Parallel::c_block_size,
+                         [&](std::size_t, std::size_t begin, std::size_t end) {
+                           for (std::size_t i = begin; i < end; ++i) {
+                             table.insert(keys,
+                                          static_cast<std::uint32_t>(i));
+                           }
+                         });
+
+  Groups groups;
+  std::vector<std::uint32_t> representatives(point_count);
+  Parallel::forEachBlock(
+      point_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          representatives[i] = table.find(keys, static_cast<std::uint32_t>(i));
+        }
+      });
+  groups.firsts = selectIndices(point_count, [&](std::size_t i) {
+    return representatives[i] == i;
+  });
+
+  // Representatives always precede the points referencing them, but they
+  // can be in another block, so the other points are resolved afterwards.
+  groups.indices.resize(point_count);
+  Parallel::forEachBlock(
+      groups.firsts.size(), Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t group = begin; group < end; ++group) {
+          groups.indices[groups.firsts[group]] =
+              static_cast<std::uint32_t>(group);
+        }
+      });
+  Parallel::forEachBlock(
+      point_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          if (representatives[i] != i) {
+            groups.indices[i] = groups.indices[representatives[i]];
+          }
+        }
+      });
+  return groups;
+}
+
+/**
+ * @brief Rotates a face so its smallest index comes first, which keeps its
+ * orientation.
+ * @param face The face to be rotated.
+ * @return The rotated face.
+ */
+IndexedMesh::Face rotateToSmallest(const IndexedMesh::Face &face) {
+  const std::size_t first = static_cast<std::size_t>(
+      std::min_element(face.begin(), face.end()) - face.begin());
+  return {face[first], face[(first + 1U) % 3U], face[(first + 2U) % 3U]};
+}
+
+} // namespace
+
+IndexedMesh IndexedMesh::weld(const MeshData &mesh, double tolerance) {
+  IndexedMesh indexed_mesh;
+  indexed_mesh.material_file = mesh.material_file;
+  const std::size_t corner_count = 3U * mesh.triangles.size();
+  if (corner_count == 0U) {
+    return indexed_mesh;
+  }
+
+  const auto &transformation = mesh.getPendingTransform();
+  const auto getPosition = [&mesh, &transformation](std::size_t corner) {
+    return transformation.transformPoint(
+        getCorner(mesh.triangles[corner / 3U], corner % 3U));
+  };
+
+  std::vector<VertexKey> keys(corner_count);
+  Parallel::forEachBlock(corner_count, Parallel::c_block_size,
+                         [&](std::size_t, std::size_t begin, std::size_t end) {
+                           for (std::size_t i = begin; i < end; ++i) {
+                             keys[i] = makeKey(getPosition(i), tolerance);
+                           }
+                         });
+  const auto groups = groupKeys(keys);
+
+  indexed_mesh.vertices.resize(groups.firsts.size());
+  Parallel::forEachBlock(
+      groups.firsts.size(), Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          indexed_mesh.vertices[i] = getPosition(groups.firsts[i]);
+        }
+      });
+  indexed_mesh.faces.resize(mesh.triangles.size());
+  Parallel::forEachBlock(
+      mesh.triangles.size(), Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          for (std::size_t corner = 0U; corner < 3U; ++corner) {
+            indexed_mesh.faces[i][corner] = groups.indices[3U * i + corner];
+          }
+        }
+      });
+  return indexed_mesh;
+}
+
+IndexedMesh IndexedMesh::cluster(const MeshData &mesh, double cell_size) {
+  // Every distinct position counts once in the average of its cell, no
+  // matter how many faces share it.
+  const IndexedMesh exact = weld(mesh, 0.0);
+  const std::size_t vertex_count = exact.vertices.size();
+  std::vector<VertexKey> keys(vertex_count);
+  Parallel::forEachBlock(
+      vertex_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          keys[i] = makeKey(exact.vertices[i], cell_size);
+        }
+      });
+  const auto cells = groupKeys(keys);
+  const std::size_t cell_count = cells.firsts.size();
+
+  // The vertices of every cell in a compressed table: the cells are counted
+  // with atomics, offset by a prefix sum over blocks of cells, and filled in
+  // any order, so every cell is sorted before its vertices are summed.
+  const auto counts =
+      std::make_unique<std::atomic<std::uint32_t>[]>(cell_count);
+  Parallel::forEachBlock(cell_count, Parallel::c_block_size,
+                         [&](std::size_t, std::size_t begin, std::size_t end) {
+                           for (std::size_t i = begin; i < end; ++i) {
+                             counts[i].store(0U, std::memory_order_relaxed);
+                           }
+                         });
+  Parallel::forEachBlock(
+      vertex_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          counts[cells.indices[i]].fetch_add(1U, std::memory_order_relaxed);
+        }
+      });
+  const std::size_t cell_block_count =
+      (cell_count + Parallel::c_block_size - 1U) / Parallel::c_block_size;
+  std::vector<std::uint32_t> block_offsets(cell_block_count + 1U, 0U);
+  Parallel::forEachBlock(
+      cell_count, Parallel::c_block_size,
+      [&](std::size_t block, std::size_t begin, std::size_t end) {
+        std::uint32_t sum = 0U;
+        for (std::size_t i = begin; i < end; ++i) {
+          sum += counts[i].load(std::memory_order_relaxed);
+        }
+        block_offsets[block + 1U] = sum;
+      });
+  for (std::size_t block = 0U; block < cell_block_count; ++block) {
+    block_offsets[block + 1U] += block_offsets[block];
+  }
+  std::vector<std::uint32_t> cell_offsets(cell_count + 1U);
+  cell_offsets[cell_count] = static_cast<std::uint32_t>(vertex_count);
+  Parallel::forEachBlock(
+      cell_count, Parallel::c_block_size,
+      [&](std::size_t block, std::size_t begin, std::size_t end) {
+        std::uint32_t offset = block_offsets[block];
+        for (std::size_t i = begin; i < end; ++i) {
+          cell_offsets[i] = offset;
+          offset += counts[i].load(std::memory_order_relaxed);
+          // The counts become the fill positions of the scatter.
+          counts[i].store(cell_offsets[i], std::memory_order_relaxed);
+        }
+      });
+  std::vector<std::uint32_t> cell_vertices(vertex_count);
+  Parallel::forEachBlock(
+      vertex_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          cell_vertices[counts[cells.indices[i]].fetch_add(
+              1U, std::memory_order_relaxed)] = static_cast<std::uint32_t>(i);
+        }
+      });
+
+  std::vector<Eigen::Vector4d> cell_positions(cell_count);
+  Parallel::forEachBlock(
+      cell_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t cell = begin; cell < end; ++cell) {
+          const auto first = cell_vertices.begin() + cell_offsets[cell];
+          const auto last = cell_vertices.begin() + cell_offsets[cell + 1U];
+          std::sort(first, last);
+          Eigen::Vector4d sum = Eigen::Vector4d::Zero();
+          for (auto vertex = first; vertex != last; ++vertex) {
+            sum += exact.vertices[*vertex];
+          }
+          cell_positions[cell] = sum / static_cast<double>(last - first);
+        }
+      });
+
+  // The faces with two corners in the same cell collapse, and of the faces
+  // becoming identical only the first one is kept.
+  const std::size_t face_count = exact.faces.size();
+  std::vector<Face> cell_faces(face_count);
+  Parallel::forEachBlock(
+      face_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          for (std::size_t corner = 0U; corner < 3U; ++corner) {
+            cell_faces[i][corner] = cells.indices[exact.faces[i][corner]];
+          }
+          cell_faces[i] = rotateToSmallest(cell_faces[i]);
+        }
+      });
+  auto candidates = selectIndices(face_count, [&](std::size_t i) {
+    const auto &face = cell_faces[i];
+    return face[0U] != face[1U] && face[1U] != face[2U] &&
+           face[2U] != face[0U];
+  });
+  Parallel::sort(candidates, [&](std::uint32_t first, std::uint32_t second) {
+    return cell_faces[first] < cell_faces[second] ||
+           (cell_faces[first] == cell_faces[second] && first < second);
+  });
+  std::vector<std::uint8_t> is_kept(face_count, 0U);
+  Parallel::forEachBlock(
+      candidates.size(), Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          is_kept[candidates[i]] =
+              i == 0U || cell_faces[candidates[i]] !=
+                             cell_faces[candidates[i - 1U]];
+        }
+      });
+  candidates = {};
+  const auto kept_faces = selectIndices(
+      face_count, [&](std::size_t i) { return is_kept[i] != 0U; });
+
+  // The used cells are numbered in the order of their first corner, which
+  // is the smallest corner referencing them.
+  const auto first_corners =
+      std::make_unique<std::atomic<std::uint32_t>[]>(cell_count);
+  Parallel::forEachBlock(cell_count, Parallel::c_block_size,
+                         [&](std::size_t, std::size_t begin, std::size_t end) {
+                           for (std::size_t i = begin; i < end; ++i) {
+                             first_corners[i].store(
+                                 c_unused_cell, std::memory_order_relaxed);
+                           }
+                         });
+  const std::size_t corner_count = 3U * kept_faces.size();
+  const auto getCell = [&](std::size_t corner) {
+    const auto &face = exact.faces[kept_faces[corner / 3U]];
+    return cells.indices[face[corner % 3U]];
+  };
+  Parallel::forEachBlock(
+      corner_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          auto &first_corner = first_corners[getCell(i)];
+          std::uint32_t stored = first_corner.load(std::memory_order_relaxed);
+          while (i < stored && !first_corner.compare_exchange_weak(
+                                   stored, static_cast<std::uint32_t>(i),
+                                   std::memory_order_relaxed)) {
+          }
+        }
+      });
+  const auto used_corners = selectIndices(corner_count, [&](std::size_t i) {
+    return first_corners[getCell(i)].load(std::memory_order_relaxed) == i;
+  });
+
+  IndexedMesh clustered;
+  clustered.material_file = exact.material_file;
+  clustered.vertices.resize(used_corners.size());
+  std::vector<std::uint32_t> new_indices(cell_count, c_unused_cell);
+  Parallel::forEachBlock(
+      used_corners.size(), Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          const std::uint32_t cell = getCell(used_corners[i]);
+          new_indices[cell] = static_cast<std::uint32_t>(i);
+          clustered.vertices[i] = cell_positions[cell];
+        }
+      });
+  clustered.faces.resize(kept_faces.size());
+  Parallel::forEachBlock(
+      corner_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          clustered.faces[i / 3U][i % 3U] = new_indices[getCell(i)];
+        }
+      });
+  return clustered;
+}
+
+MeshData IndexedMesh::toMeshData() const {
+  MeshData mesh;
+  mesh.material_file = material_file;
+  mesh.triangles.resize(faces.size());
+  Parallel::forEachBlock(
+      faces.size(), Parallel::c_block_size,
+      [this, &mesh](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          auto &triangle = mesh.triangles[i];
+          triangle.a.pos = vertices[faces[i][0U]];
+          triangle.b.pos = vertices[faces[i][1U]];
+          triangle.c.pos = vertices[faces[i][2U]];
+        }
+      });
+  return mesh;
+}
+
+void IndexedMesh::applyPositions(MeshData &mesh) const {
+  mesh.applyPendingTransform();
+  auto &triangles = mesh.triangles;
+  Parallel::forEachBlock(
+      faces.size(), Parallel::c_block_size,
+      [this, &triangles](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          auto &triangle = triangles[i];
+          triangle.a.pos = vertices[faces[i][0U]];
+          triangle.b.pos = vertices[faces[i][1U]];
+          triangle.c.pos = vertices[faces[i][2U]];
+        }
+      });
+}
+
+} // namespace Converter
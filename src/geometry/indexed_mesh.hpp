@@ -0,0 +1,106 @@
+#ifndef INDEXED_MESH_HPP
+#define INDEXED_MESH_HPP
+
+#include <Eigen/Dense>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Converter {
+
+class MeshData;
+
+/**
+ * @brief Data structure for holding a mesh as shared vertices and faces
+ * referencing them.
+ * @details Unlike MeshData, where every Triangle owns its vertices, the
+ * Triangles sharing a vertex reference the same position, which is what the
+ * connectivity based algorithms work on.
+ */
+class IndexedMesh {
+public:
+  /**
+   * @brief The indices of the three vertices of a face.
+   */
+  using Face = std::array<std::uint32_t, 3U>;
+
+  /**
+   * @brief Holds the name of the material file if there is one.
+   */
+  std::string material_file;
+  /**
+   * @brief Holds the positions of the vertices.
+   */
+  std::vector<Eigen::Vector4d> vertices;
+  /**
+   * @brief Holds the faces, the i-th face belongs to the i-th Triangle of
+   * the mesh it was created from.
+   */
+  std::vector<Face> faces;
+
+  /**
+   * @brief Creates an indexed mesh by merging the vertices of a triangle
+   * soup.
+   * @details The positions are quantized to a grid of tolerance sized cells
+   * and inserted into a lock-free open addressing hash table by multiple
+   * threads. Vertices falling into the same cell are merged, and the first
+   * one in Triangle order becomes the representative whose position is kept.
+   * The table keeps the smallest Triangle corner of every cell, and the
+   * vertices are numbered in the order of their first occurrence, so the
+   * result does not depend on the number of threads. Faces that became
+   * degenerate are kept, so the faces stay in sync with the Triangles.
+   * @note Vertices closer than the tolerance but in neighboring cells are not
+   * merged. The pending transformation of the mesh is applied to the
+   * positions before quantizing them.
+   * @param mesh The mesh whose vertices should be welded.
+   * @param tolerance The size of the grid cells, zero merges only vertices
+   * with exactly the same position.
+   * @return The welded mesh.
+   */
+  static IndexedMesh weld(const MeshData &mesh, double tolerance);
+
+  /**
+   * @brief Creates a simplified indexed mesh by clustering the vertices of a
+   * triangle soup on a grid.
+   * @details The distinct positions of the mesh are merged on a grid of
+   * cell_size sized cells, and every cell becomes one vertex at the average
+   * of its distinct positions, so vertices shared by many faces do not pull
+   * the average towards them. The faces having two corners in the same cell
+   * are dropped, and so are all but the first of the faces becoming
+   * identical, while faces with the opposite orientation are kept. Every
+   * step runs in parallel and all but a sort are linear in the number of
+   * Triangles, which makes this much faster but coarser than decimation.
+   * The result does not depend on the number of threads.
+   * @note The pending transformation of the mesh is applied to the positions
+   * before quantizing them.
+   * @param mesh The mesh to be simplified.
+   * @param cell_size The size of the grid cells, must be positive.
+   * @return The simplified mesh, its faces keep the order of the Triangles
+   * and its vertices are numbered in the order of their first use.
+   */
+  static IndexedMesh cluster(const MeshData &mesh, double cell_size);
+
+  /**
+   * @brief Converts the indexed mesh back to a list of Triangles.
+   * @note Only the positions are set, normals and texture coordinates are
+   * left zero. Use applyPositions to keep them when the faces are still in
+   * sync with the Triangles.
+   * @return The mesh holding the Triangles of the faces.
+   */
+  MeshData toMeshData() const;
+
+  /**
+   * @brief Moves the corners of the Triangles to the positions of the
+   * vertices of their faces, keeping the normals and texture coordinates.
+   * @note The pending transformation of the mesh is applied first, as the
+   * positions of the vertices already include it. The i-th face must belong
+   * to the i-th Triangle, which holds for the result of weld.
+   * @param mesh The mesh the indexed mesh was welded from.
+   */
+  void applyPositions(MeshData &mesh) const;
+};
+
+} // namespace Converter
+
+#endif
@@ -0,0 +1,169 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "closest_point_query.hpp"
+#include "mesh_distance.hpp"
+#include "meshdata.hpp"
+#include "parallel.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief Measures the distances of samples to a mesh.
+ * @param samples The sampled points.
+ * @param mesh The mesh the distances are measured to.
+ * @return The distances, infinite if the mesh has no Triangles.
+ */
+MeshDistance::OneSided measure(const std::vector<Eigen::Vector4d> &samples,
+                               const MeshData &mesh) {
+  MeshDistance::OneSided result;
+  result.sample_count = samples.size();
+  if (samples.empty()) {
+    return result;
+  }
+
+  const ClosestPointQuery query(mesh);
+  const auto closest_points = query.findClosestPoints(samples);
+  const auto getDistance = [&closest_points](std::size_t i) {
+    return closest_points[i] ? closest_points[i]->distance
+                             : std::numeric_limits<double>::infinity();
+  };
+
+  // The sums are reduced in a fixed tree, so they are rounded the same way
+  // with any number of threads.
+  const double sum = Parallel::reproducibleSum(
+      samples.size(),
+      [&getDistance](std::size_t begin, std::size_t end, double *values) {
+        for (std::size_t i = begin; i < end; ++i) {
+          values[i - begin] = getDistance(i);
+        }
+      });
+  const double squared_sum = Parallel::reproducibleSum(
+      samples.size(),
+      [&getDistance](std::size_t begin, std::size_t end, double *values) {
+        for (std::size_t i = begin; i < end; ++i) {
+          const double distance = getDistance(i);
+          values[i - begin] = distance * distance;
+        }
+      });
+  std::size_t farthest = 0U;
+  for (std::size_t i = 1U; i < samples.size(); ++i) {
+    if (getDistance(i) > getDistance(farthest)) {
+      farthest = i;
+    }
+  }
+
+  result.max = getDistance(farthest);
+  const auto count = static_cast<double>(samples.size());
+  result.mean = sum / count;
+  result.rms = std::sqrt(squared_sum / count);
+  result.farthest_point = samples[farthest];
+  return result;
+}
+
+} // namespace
+
+MeshDistance MeshDistance::compare(const MeshData &first,
+                                   const MeshData &second,
+                                   std::size_t sample_count) {
+  MeshDistance result;
+  result.first_to_second = measure(samplePoints(first, sample_count), second);
+  result.second_to_first = measure(samplePoints(second, sample_count), first);
+  return result;
+}
+
+std::vector<Eigen::Vector4d>
+MeshDistance::samplePoints(const MeshData &mesh, std::size_t sample_count) {
+  const auto &triangles = mesh.triangles;
+  const auto &transformation = mesh.getPendingTransform();
+
+  // The transformed corners and the accumulated areas of the Triangles.
+  std::vector<std::array<Eigen::Vector3d, 3U>> corners(triangles.size());
+  std::vector<double> accumulated_areas(triangles.size());
+  Parallel::forEachBlock(
+      triangles.size(), Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          const auto &triangle = triangles[i];
+          auto &points = corners[i];
+          std::size_t corner = 0U;
+          for (const auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+            points[corner++] =
+                transformation.transformPoint(vertex->pos).head<3>();
+          }
+          const double area =
+              (points[1U] - points[0U]).cross(points[2U] - points[0U]).norm() /
+              2.0;
+          accumulated_areas[i] = std::isfinite(area) ? area : 0.0;
+        }
+      });
+  std::partial_sum(accumulated_areas.begin(), accumulated_areas.end(),
+                   accumulated_areas.begin());
+  const double total_area =
+      accumulated_areas.empty() ? 0.0 : accumulated_areas.back();
+  if (sample_count == 0U || !(total_area > 0.0)) {
+    return {};
+  }
+
+  // Every sample is placed in its own stratum of the accumulated area.
+  std::vector<Eigen::Vector4d> samples(sample_count);
+  const double stratum = total_area / static_cast<double>(sample_count);
+  Parallel::forEachBlock(
+      sample_count, Parallel::c_block_size,
+      [&](std::size_t block, std::size_t begin, std::size_t end) {
+        std::mt19937 generator(c_seed + static_cast<std::uint32_t>(block));
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        for (std::size_t i = begin; i < end; ++i) {
+          const double position =
+              (static_cast<double>(i) + uniform(generator)) * stratum;
+          const auto found =
+              std::upper_bound(accumulated_areas.begin(),
+                               accumulated_areas.end(), position);
+          const auto index = static_cast<std::size_t>(
+              std::min(found, accumulated_areas.end() - 1) -
+              accumulated_areas.begin());
+
+          // Uniform barycentric coordinates over the Triangle.
+          const double root = std::sqrt(uniform(generator));
+          const double v = uniform(generator);
+          const auto &points = corners[index];
+          const Eigen::Vector3d point = (1.0 - root) * points[0U] +
+                                        root * (1.0 - v) * points[1U] +
+                                        root * v * points[2U];
+          samples[i] = Eigen::Vector4d(point.x(), point.y(), point.z(), 1.0);
+        }
+      });
+  return samples;
+}
+
+double MeshDistance::getHausdorff() const {
+  return std::max(first_to_second.max, second_to_first.max);
+}
+
+double MeshDistance::getRms() const {
+  const std::size_t count =
+      first_to_second.sample_count + second_to_first.sample_count;
+  if (count == 0U) {
+    return 0.0;
+  }
+  const auto squaredSum = [](const OneSided &distances) {
+    return distances.rms * distances.rms *
+           static_cast<double>(distances.sample_count);
+  };
+  return std::sqrt((squaredSum(first_to_second) +
+                    squaredSum(second_to_first)) /
+                   static_cast<double>(count));
+}
+
+} // namespace Converter
@@ -0,0 +1,121 @@
+#ifndef MESH_DISTANCE_HPP
+#define MESH_DISTANCE_HPP
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Converter {
+
+class MeshData;
+
+/**
+ * @brief Measures how far the surfaces of two meshes are apart.
+ * @details Points are sampled on the surface of every mesh in proportion to
+ * the area of the Triangles, and the distance of every sample to the other
+ * mesh is found with a ClosestPointQuery, using multiple threads. The
+ * samples are stratified over the accumulated area, so every Triangle gets
+ * its share of them, and the random numbers are seeded per block of
+ * samples, so the result does not depend on the number of threads. The
+ * Hausdorff distance found this way is a lower bound of the exact one,
+ * which it approaches as the number of samples grows.
+ */
+class MeshDistance {
+public:
+  /**
+   * @brief The distances of the samples of one mesh to the other mesh.
+   * @param max The largest distance, the one-sided Hausdorff distance.
+   * @param mean The average distance.
+   * @param rms The root mean square of the distances.
+   * @param farthest_point The sample with the largest distance, with 1 as
+   * its homogeneous coordinate.
+   * @param sample_count The number of samples.
+   */
+  struct OneSided {
+    double max = 0.0;
+    double mean = 0.0;
+    double rms = 0.0;
+    Eigen::Vector4d farthest_point = Eigen::Vector4d::UnitW();
+    std::size_t sample_count = 0U;
+  };
+
+  /**
+   * @brief The default number of samples on every mesh.
+   */
+  static constexpr std::size_t c_default_sample_count = 100000U;
+
+  /**
+   * @brief Compares two meshes in both directions.
+   * @note The pending transformations of the meshes are applied. The
+   * distances are infinite if one mesh has samples and the other one has
+   * no Triangles.
+   * @param first The first mesh.
+   * @param second The second mesh.
+   * @param sample_count The number of samples on every mesh, none are taken
+   * from a mesh without area.
+   * @return The distances.
+   */
+  static MeshDistance compare(const MeshData &first, const MeshData &second,
+                              std::size_t sample_count =
+                                  c_default_sample_count);
+
+  /**
+   * @brief Samples points on the surface of a mesh, with a density
+   * proportional to the area.
+   * @note The pending transformation of the mesh is applied.
+   * @param mesh The mesh to be sampled.
+   * @param sample_count The number of samples.
+   * @return The samples, with 1 as their homogeneous coordinate, empty if
+   * the mesh has no area.
+   */
+  static std::vector<Eigen::Vector4d> samplePoints(const MeshData &mesh,
+                                                   std::size_t sample_count);
+
+  /**
+   * @brief Returns the distances of the samples of the first mesh to the
+   * second one.
+   * @return The distances.
+   */
+  const OneSided &getFirstToSecond() const { return first_to_second; }
+
+  /**
+   * @brief Returns the distances of the samples of the second mesh to the
+   * first one.
+   * @return The distances.
+   */
+  const OneSided &getSecondToFirst() const { return second_to_first; }
+
+  /**
+   * @brief Returns the symmetric Hausdorff distance.
+   * @return The larger one of the one-sided Hausdorff distances.
+   */
+  double getHausdorff() const;
+
+  /**
+   * @brief Returns the symmetric root mean square distance.
+   * @return The root mean square of the distances of the samples of both
+   * meshes.
+   */
+  double getRms() const;
+
+private:
+  /**
+   * @brief The seed of the random numbers of the first block of samples,
+   * the following blocks count up from it.
+   */
+  static constexpr std::uint32_t c_seed = 5489U;
+
+  /**
+   * @brief Holds the distances of the samples of the first mesh.
+   */
+  OneSided first_to_second;
+  /**
+   * @brief Holds the distances of the samples of the second mesh.
+   */
+  OneSided second_to_first;
+};
+
+} // namespace Converter
+
+#endif
@@ -0,0 +1,694 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "bvh.hpp"
+#include "mesh_intersection.hpp"
+#include "meshdata.hpp"
+#include "parallel.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief The corners of a Triangle.
+ */
+using Points = std::array<Eigen::Vector3d, 3U>;
+
+/**
+ * @brief A node of the first and a node of the second tree.
+ */
+using NodePair = std::pair<std::uint32_t, std::uint32_t>;
+
+/**
+ * @brief Half of the distance of 1 and the next double, the largest
+ * relative rounding error.
+ */
+constexpr double c_epsilon = std::numeric_limits<double>::epsilon() / 2.0;
+
+/**
+ * @brief The relative error bound of the floating point planar orientation,
+ * from Shewchuk's adaptive predicates.
+ */
+constexpr double c_orient2d_bound = (3.0 + 16.0 * c_epsilon) * c_epsilon;
+
+/**
+ * @brief The relative error bound of the floating point spatial
+ * orientation, from Shewchuk's adaptive predicates.
+ */
+constexpr double c_orient3d_bound = (7.0 + 56.0 * c_epsilon) * c_epsilon;
+
+/**
+ * @brief Accumulates products of doubles without rounding.
+ * @details Every product is split into terms with fused multiply-adds, which
+ * add up to it exactly. The sign is found by distillation: a pass of
+ * error-free additions over the terms leaves their sum unchanged and moves
+ * the rounded sum into the last term, and the passes are repeated until the
+ * last term outweighs the others.
+ */
+class ExactSum {
+public:
+  /**
+   * @brief Adds the product of three doubles.
+   */
+  void addProduct(double a, double b, double c) {
+    const double product = a * b;
+    const double error = std::fma(a, b, -product);
+    for (const double term : {product, error}) {
+      const double high = term * c;
+      add(high);
+      add(std::fma(term, c, -high));
+    }
+  }
+
+  /**
+   * @brief Adds the product of two doubles.
+   */
+  void addProduct(double a, double b) {
+    const double product = a * b;
+    add(product);
+    add(std::fma(a, b, -product));
+  }
+
+  /**
+   * @brief Returns the sign of the sum.
+   * @return 1 if the sum is positive, -1 if it is negative, otherwise 0.
+   */
+  int getSign() {
+    if (size == 0U) {
+      return 0;
+    }
+    // The rounding error of the sum of the magnitudes of the other terms.
+    const double bound = 1.0 + 2.0 * static_cast<double>(size) * c_epsilon;
+    for (;;) {
+      double rest = 0.0;
+      for (std::size_t i = 1U; i < size; ++i) {
+        const double sum = terms[i - 1U] + terms[i];
+        const double part = sum - terms[i];
+        terms[i - 1U] = (terms[i - 1U] - part) + (terms[i] - (sum - part));
+        terms[i] = sum;
+        rest += std::abs(terms[i - 1U]);
+      }
+      const double last = terms[size - 1U];
+      if (rest == 0.0 || std::abs(last) > bound * rest) {
+        return (last > 0.0) - (last < 0.0);
+      }
+    }
+  }
+
+private:
+  /**
+   * @brief The largest number of terms of a sum.
+   */
+  static constexpr std::size_t c_capacity = 96U;
+
+  /**
+   * @brief Adds a term, dropping zeros.
+   */
+  void add(double value) {
+    if (value != 0.0) {
+      terms[size++] = value;
+    }
+  }
+
+  /**
+   * @brief Holds the terms, which add up to the sum exactly.
+   */
+  std::array<double, c_capacity> terms;
+  /**
+   * @brief Holds the number of terms.
+   */
+  std::size_t size = 0U;
+};
+
+/**
+ * @brief Returns the sign of a value.
+ */
+int getSign(double value) { return (value > 0.0) - (value < 0.0); }
+
+/**
+ * @brief Determines on which side of the line through a and b the point c
+ * is, exactly.
+ * @return 1 if a, b and c are counterclockwise, -1 if they are clockwise,
+ * 0 if they are collinear.
+ */
+int orient2d(const Eigen::Vector2d &a, const Eigen::Vector2d &b,
+             const Eigen::Vector2d &c) {
+  const double left = (b.x() - a.x()) * (c.y() - a.y());
+  const double right = (b.y() - a.y()) * (c.x() - a.x());
+  const double determinant = left - right;
+  if (std::abs(determinant) >
+      c_orient2d_bound * (std::abs(left) + std::abs(right))) {
+    return getSign(determinant);
+  }
+
+  ExactSum sum;
+  sum.addProduct(b.x(), c.y());
+  sum.addProduct(-b.x(), a.y());
+  sum.addProduct(-a.x(), c.y());
+  sum.addProduct(-b.y(), c.x());
+  sum.addProduct(b.y(), a.x());
+  sum.addProduct(a.y(), c.x());
+  return sum.getSign();
+}
+
+/**
+ * @brief Determines on which side of the plane through a, b and c the point
+ * d is, exactly.
+ * @return 1 if d is on the side the normal (b - a) x (c - a) points to, -1
+ * if it is on the other side, 0 if the four points are in a plane.
+ */
+int orient3d(const Eigen::Vector3d &a, const Eigen::Vector3d &b,
+             const Eigen::Vector3d &c, const Eigen::Vector3d &d) {
+  const Eigen::Vector3d u = b - a;
+  const Eigen::Vector3d v = c - a;
+  const Eigen::Vector3d w = d - a;
+  const double determinant = u.dot(v.cross(w));
+  const Eigen::Vector3d abs_u = u.cwiseAbs();
+  const Eigen::Vector3d abs_v = v.cwiseAbs();
+  const Eigen::Vector3d abs_w = w.cwiseAbs();
+  const double permanent =
+      abs_u.x() * (abs_v.y() * abs_w.z() + abs_v.z() * abs_w.y()) +
+      abs_u.y() * (abs_v.z() * abs_w.x() + abs_v.x() * abs_w.z()) +
+      abs_u.z() * (abs_v.x() * abs_w.y() + abs_v.y() * abs_w.x());
+  if (std::abs(determinant) > c_orient3d_bound * permanent) {
+    return getSign(determinant);
+  }
+
+  // The determinant of the differences is multilinear, it expands to four
+  // determinants of the points themselves.
+  ExactSum sum;
+  const auto addDeterminant = [&sum](const Eigen::Vector3d &x,
+                                     const Eigen::Vector3d &y,
+                                     const Eigen::Vector3d &z, double sign) {
+    sum.addProduct(sign * x.x(), y.y(), z.z());
+    sum.addProduct(-sign * x.x(), y.z(), z.y());
+    sum.addProduct(sign * x.y(), y.z(), z.x());
+    sum.addProduct(-sign * x.y(), y.x(), z.z());
+    sum.addProduct(sign * x.z(), y.x(), z.y());
+    sum.addProduct(-sign * x.z(), y.y(), z.x());
+  };
+  addDeterminant(b, c, d, 1.0);
+  addDeterminant(b, c, a, -1.0);
+  addDeterminant(b, a, d, -1.0);
+  addDeterminant(a, c, d, -1.0);
+  return sum.getSign();
+}
+
+/**
+ * @brief Returns the axis along which a Triangle is the largest when
+ * projected onto the other two.
+ */
+Eigen::Index getDominantAxis(const Points &triangle) {
+  Eigen::Index axis = 0;
+  (triangle[1U] - triangle[0U])
+      .cross(triangle[2U] - triangle[0U])
+      .cwiseAbs()
+      .maxCoeff(&axis);
+  return axis;
+}
+
+/**
+ * @brief Projects a point onto the plane orthogonal to an axis.
+ */
+Eigen::Vector2d project(const Eigen::Vector3d &point, Eigen::Index axis) {
+  return {point[(axis + 1) % 3], point[(axis + 2) % 3]};
+}
+
+/**
+ * @brief Projects the corners of a Triangle onto the plane orthogonal to an
+ * axis.
+ */
+std::array<Eigen::Vector2d, 3U> project(const Points &triangle,
+                                        Eigen::Index axis) {
+  return {project(triangle[0U], axis), project(triangle[1U], axis),
+          project(triangle[2U], axis)};
+}
+
+/**
+ * @brief Determines if the point c, collinear with a and b, is between
+ * them.
+ */
+bool isBetween(const Eigen::Vector2d &a, const Eigen::Vector2d &b,
+               const Eigen::Vector2d &c) {
+  return std::min(a.x(), b.x()) <= c.x() && c.x() <= std::max(a.x(), b.x()) &&
+         std::min(a.y(), b.y()) <= c.y() && c.y() <= std::max(a.y(), b.y());
+}
+
+/**
+ * @brief Determines if two closed planar segments have a point in common.
+ */
+bool intersectSegments(const Eigen::Vector2d &p, const Eigen::Vector2d &q,
+                       const Eigen::Vector2d &r, const Eigen::Vector2d &s) {
+  const int r_side = orient2d(p, q, r);
+  const int s_side = orient2d(p, q, s);
+  const int p_side = orient2d(r, s, p);
+  const int q_side = orient2d(r, s, q);
+  if (r_side * s_side < 0 && p_side * q_side < 0) {
+    return true;
+  }
+  return (r_side == 0 && isBetween(p, q, r)) ||
+         (s_side == 0 && isBetween(p, q, s)) ||
+         (p_side == 0 && isBetween(r, s, p)) ||
+         (q_side == 0 && isBetween(r, s, q));
+}
+
+/**
+ * @brief Determines if a closed planar triangle contains a point.
+ * @return False if the triangle is degenerate.
+ */
+bool containsPoint(const std::array<Eigen::Vector2d, 3U> &triangle,
+                   const Eigen::Vector2d &point) {
+  const int orientation = orient2d(triangle[0U], triangle[1U], triangle[2U]);
+  if (orientation == 0) {
+    return false;
+  }
+  for (std::size_t i = 0U; i < 3U; ++i) {
+    if (orient2d(triangle[i], triangle[(i + 1U) % 3U], point) ==
+        -orientation) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Determines if a planar segment and a closed planar triangle have a
+ * point in common.
+ */
+bool intersectSegmentTriangle(const Eigen::Vector2d &p,
+                              const Eigen::Vector2d &q,
+                              const std::array<Eigen::Vector2d, 3U> &triangle) {
+  if (containsPoint(triangle, p)) {
+    return true;
+  }
+  for (std::size_t i = 0U; i < 3U; ++i) {
+    if (intersectSegments(p, q, triangle[i], triangle[(i + 1U) % 3U])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Determines if a segment and a closed Triangle have a point in
+ * common.
+ * @param p The first end of the segment.
+ * @param q The second end of the segment.
+ * @param triangle The Triangle.
+ * @param p_side The orientation of p to the plane of the Triangle.
+ * @param q_side The orientation of q to the plane of the Triangle.
+ */
+bool intersectSegmentTriangle(const Eigen::Vector3d &p,
+                              const Eigen::Vector3d &q,
+                              const Points &triangle, int p_side,
+                              int q_side) {
+  if (p_side * q_side > 0) {
+    return false;
+  }
+  if (p_side == 0 && q_side == 0) {
+    const auto axis = getDominantAxis(triangle);
+    return intersectSegmentTriangle(project(p, axis), project(q, axis),
+                                    project(triangle, axis));
+  }
+
+  // The line crosses the Triangle if it passes every edge on the same side.
+  const int first = orient3d(p, q, triangle[0U], triangle[1U]);
+  const int second = orient3d(p, q, triangle[1U], triangle[2U]);
+  const int third = orient3d(p, q, triangle[2U], triangle[0U]);
+  return (first >= 0 && second >= 0 && third >= 0) ||
+         (first <= 0 && second <= 0 && third <= 0);
+}
+
+/**
+ * @brief Returns the orientations of the corners of a Triangle to the plane
+ * of another one.
+ */
+std::array<int, 3U> getSides(const Points &plane, const Points &triangle) {
+  std::array<int, 3U> sides{};
+  for (std::size_t i = 0U; i < 3U; ++i) {
+    sides[i] = orient3d(plane[0U], plane[1U], plane[2U], triangle[i]);
+  }
+  return sides;
+}
+
+/**
+ * @brief Determines if the corners are all strictly on one side.
+ */
+bool isOneSided(const std::array<int, 3U> &sides) {
+  return (sides[0U] > 0 && sides[1U] > 0 && sides[2U] > 0) ||
+         (sides[0U] < 0 && sides[1U] < 0 && sides[2U] < 0);
+}
+
+/**
+ * @brief Determines if two closed Triangles have a point in common.
+ * @details Unless the Triangles are in a plane, their intersection is a
+ * segment on the line where their planes meet, whose ends are on the edges
+ * of the Triangles, so they intersect if and only if an edge of one
+ * intersects the other one.
+ */
+bool intersectTriangles(const Points &first, const Points &second) {
+  const auto first_sides = getSides(second, first);
+  if (isOneSided(first_sides)) {
+    return false;
+  }
+  const auto second_sides = getSides(first, second);
+  if (isOneSided(second_sides)) {
+    return false;
+  }
+
+  if (first_sides == std::array<int, 3U>{}) {
+    const Eigen::Vector3d first_normal =
+        (first[1U] - first[0U]).cross(first[2U] - first[0U]);
+    const Eigen::Vector3d second_normal =
+        (second[1U] - second[0U]).cross(second[2U] - second[0U]);
+    const auto axis = getDominantAxis(
+        first_normal.squaredNorm() >= second_normal.squaredNorm() ? first
+                                                                   : second);
+    const auto first_projection = project(first, axis);
+    const auto second_projection = project(second, axis);
+    for (std::size_t i = 0U; i < 3U; ++i) {
+      if (intersectSegmentTriangle(first_projection[i],
+                                   first_projection[(i + 1U) % 3U],
+                                   second_projection)) {
+        return true;
+      }
+    }
+    return containsPoint(first_projection, second_projection[0U]);
+  }
+
+  for (std::size_t i = 0U; i < 3U; ++i) {
+    const std::size_t j = (i + 1U) % 3U;
+    if (intersectSegmentTriangle(first[i], first[j], second, first_sides[i],
+                                 first_sides[j]) ||
+        intersectSegmentTriangle(second[i], second[j], first,
+                                 second_sides[i], second_sides[j])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Determines if two Triangles of a mesh have a point in common
+ * besides their shared vertices.
+ * @details Triangles sharing an edge meet the line of the edge only on the
+ * edge, so they only intersect if they are in a plane and on the same side
+ * of the edge. Triangles sharing a vertex meet the line where their planes
+ * meet in segments starting at the vertex, so they intersect if the shorter
+ * one ends inside of the other Triangle, on the edge opposite of the
+ * vertex.
+ */
+bool intersectNeighbors(const Points &first, const Points &second) {
+  std::array<std::size_t, 3U> shared{3U, 3U, 3U};
+  std::size_t shared_count = 0U;
+  for (std::size_t i = 0U; i < 3U; ++i) {
+    for (std::size_t j = 0U; j < 3U; ++j) {
+      if (first[i] == second[j]) {
+        shared[i] = j;
+        ++shared_count;
+        break;
+      }
+    }
+  }
+
+  if (shared_count == 0U) {
+    return intersectTriangles(first, second);
+  }
+  if (shared_count == 3U) {
+    return true;
+  }
+  if (shared_count == 2U) {
+    const std::size_t i = static_cast<std::size_t>(
+        std::find(shared.begin(), shared.end(), 3U) - shared.begin());
+    const std::size_t j = 3U - shared[(i + 1U) % 3U] - shared[(i + 2U) % 3U];
+    const auto &edge_start = first[(i + 1U) % 3U];
+    const auto &edge_end = first[(i + 2U) % 3U];
+    if (orient3d(edge_start, edge_end, first[i], second[j]) != 0) {
+      return false;
+    }
+    const auto axis = getDominantAxis(first);
+    const auto start = project(edge_start, axis);
+    const auto end = project(edge_end, axis);
+    return orient2d(start, end, project(first[i], axis)) ==
+           orient2d(start, end, project(second[j], axis));
+  }
+
+  const std::size_t i = static_cast<std::size_t>(
+      std::find_if(shared.begin(), shared.end(),
+                   [](std::size_t j) { return j != 3U; }) -
+      shared.begin());
+  const std::size_t j = shared[i];
+  const auto &first_start = first[(i + 1U) % 3U];
+  const auto &first_end = first[(i + 2U) % 3U];
+  const auto &second_start = second[(j + 1U) % 3U];
+  const auto &second_end = second[(j + 2U) % 3U];
+  return intersectSegmentTriangle(
+             first_start, first_end, second,
+             orient3d(second[0U], second[1U], second[2U], first_start),
+             orient3d(second[0U], second[1U], second[2U], first_end)) ||
+         intersectSegmentTriangle(
+             second_start, second_end, first,
+             orient3d(first[0U], first[1U], first[2U], second_start),
+             orient3d(first[0U], first[1U], first[2U], second_end));
+}
+
+/**
+ * @brief Returns the corners of a Triangle.
+ */
+Points getPoints(const Triangle &triangle) {
+  return {triangle.a.pos.head<3>(), triangle.b.pos.head<3>(),
+          triangle.c.pos.head<3>()};
+}
+
+/**
+ * @brief The transformed Triangles of a mesh with a hierarchy over them.
+ */
+struct Tree {
+  /**
+   * @brief Builds the hierarchy and transforms the Triangles.
+   * @details The hierarchy is built before the transformation, so its
+   * boxes are recalculated with Bvh::refit.
+   */
+  explicit Tree(const MeshData &mesh) : bvh(mesh.triangles) {
+    const auto &transformation = mesh.getPendingTransform();
+    triangles.resize(mesh.triangles.size());
+    is_valid.resize(mesh.triangles.size());
+    boxes.resize(mesh.triangles.size());
+    Parallel::forEachBlock(
+        triangles.size(), Parallel::c_block_size,
+        [&](std::size_t, std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i) {
+            const auto &triangle = mesh.triangles[i];
+            auto &points = triangles[i];
+            std::size_t corner = 0U;
+            for (const auto *vertex :
+                 {&triangle.a, &triangle.b, &triangle.c}) {
+              points[corner++] =
+                  transformation.transformPoint(vertex->pos).head<3>();
+            }
+            const Eigen::Vector3d normal =
+                (points[1U] - points[0U]).cross(points[2U] - points[0U]);
+            is_valid[i] = points[0U].allFinite() && points[1U].allFinite() &&
+                                  points[2U].allFinite() && !normal.isZero(0.0)
+                              ? 1U
+                              : 0U;
+            auto &box = boxes[i];
+            box.setEmpty();
+            for (const auto &point : points) {
+              box.extend(point);
+            }
+          }
+        });
+
+    if (transformation.getKind() != AffineTransform::Kind::IDENTITY) {
+      bvh.refit([this](std::size_t node_index) {
+        const auto &node = bvh.nodes[node_index];
+        Eigen::AlignedBox3d box;
+        box.setEmpty();
+        for (std::uint32_t j = node.first; j < node.first + node.count; ++j) {
+          box.extend(boxes[bvh.triangle_indices[j]]);
+        }
+        return box;
+      });
+    }
+  }
+
+  /**
+   * @brief Holds the hierarchy over the Triangles.
+   */
+  Bvh bvh;
+  /**
+   * @brief Holds the transformed corners of the Triangles.
+   */
+  std::vector<Points> triangles;
+  /**
+   * @brief Holds 1 for the Triangles that are finite and not degenerate.
+   */
+  std::vector<std::uint8_t> is_valid;
+  /**
+   * @brief Holds the bounding boxes of the transformed Triangles.
+   */
+  std::vector<Eigen::AlignedBox3d> boxes;
+};
+
+/**
+ * @brief Finds the pairs of Triangles of two trees that pass a test.
+ * @details The subtrees of the first levels are expanded breadth first into
+ * at least c_task_count pairs unless the trees are smaller, which only
+ * depends on the trees, and every pair is then traversed depth first by one
+ * task.
+ * @param first The first tree.
+ * @param second The second tree.
+ * @param is_self If the trees are the same, then every pair of Triangles is
+ * only tested once, with the smaller index first.
+ * @param test Callable with the signature bool(const Points &first,
+ * const Points &second), called for the valid Triangles whose boxes
+ * overlap.
+ * @return The pairs of the indices of the Triangles, in ascending order.
+ */
+template <typename Test>
+std::vector<MeshIntersection::Pair> findPairs(const Tree &first,
+                                              const Tree &second,
+                                              bool is_self, const Test &test) {
+  if (first.bvh.empty() || second.bvh.empty() ||
+      !first.bvh.nodes[0U].box.intersects(second.bvh.nodes[0U].box)) {
+    return {};
+  }
+  const auto &first_nodes = first.bvh.nodes;
+  const auto &second_nodes = second.bvh.nodes;
+
+  // Appends the pairs of children whose boxes overlap, false for pairs of
+  // leaves.
+  const auto expand = [&](const NodePair &pair,
+                          std::vector<NodePair> &pairs) {
+    const auto &first_node = first_nodes[pair.first];
+    const auto &second_node = second_nodes[pair.second];
+    if (is_self && pair.first == pair.second) {
+      if (first_node.isLeaf()) {
+        return false;
+      }
+      const std::uint32_t left = first_node.first;
+      pairs.emplace_back(left, left);
+      pairs.emplace_back(left + 1U, left + 1U);
+      if (first_nodes[left].box.intersects(first_nodes[left + 1U].box)) {
+        pairs.emplace_back(left, left + 1U);
+      }
+      return true;
+    }
+    if (first_node.isLeaf() && second_node.isLeaf()) {
+      return false;
+    }
+
+    // The larger node is split, so the boxes shrink evenly.
+    const bool is_first_split =
+        second_node.isLeaf() ||
+        (!first_node.isLeaf() &&
+         first_node.box.volume() >= second_node.box.volume());
+    for (std::uint32_t child = 0U; child < 2U; ++child) {
+      const NodePair child_pair =
+          is_first_split ? NodePair{first_node.first + child, pair.second}
+                         : NodePair{pair.first, second_node.first + child};
+      if (first_nodes[child_pair.first].box.intersects(
+              second_nodes[child_pair.second].box)) {
+        pairs.push_back(child_pair);
+      }
+    }
+    return true;
+  };
+
+  const auto testLeaves = [&](const NodePair &pair,
+                              std::vector<MeshIntersection::Pair> &result) {
+    const auto &first_node = first_nodes[pair.first];
+    const auto &second_node = second_nodes[pair.second];
+    const bool is_same = is_self && pair.first == pair.second;
+    for (std::uint32_t i = first_node.first;
+         i < first_node.first + first_node.count; ++i) {
+      const std::uint32_t first_index = first.bvh.triangle_indices[i];
+      if (first.is_valid[first_index] == 0U) {
+        continue;
+      }
+      for (std::uint32_t j = is_same ? i + 1U : second_node.first;
+           j < second_node.first + second_node.count; ++j) {
+        const std::uint32_t second_index = second.bvh.triangle_indices[j];
+        if (second.is_valid[second_index] == 0U ||
+            !first.boxes[first_index].intersects(
+                second.boxes[second_index]) ||
+            !test(first.triangles[first_index],
+                  second.triangles[second_index])) {
+          continue;
+        }
+        if (is_self && second_index < first_index) {
+          result.emplace_back(second_index, first_index);
+        } else {
+          result.emplace_back(first_index, second_index);
+        }
+      }
+    }
+  };
+
+  std::vector<NodePair> tasks{{0U, 0U}};
+  std::vector<NodePair> next_tasks;
+  bool is_expanded = true;
+  while (is_expanded && tasks.size() < MeshIntersection::c_task_count) {
+    is_expanded = false;
+    next_tasks.clear();
+    for (const auto &pair : tasks) {
+      if (expand(pair, next_tasks)) {
+        is_expanded = true;
+      } else {
+        next_tasks.push_back(pair);
+      }
+    }
+    tasks.swap(next_tasks);
+  }
+
+  std::vector<std::vector<MeshIntersection::Pair>> task_results(tasks.size());
+  Parallel::forEachBlock(
+      tasks.size(), 1U, [&](std::size_t task, std::size_t, std::size_t) {
+        std::vector<NodePair> stack{tasks[task]};
+        while (!stack.empty()) {
+          const NodePair pair = stack.back();
+          stack.pop_back();
+          if (!expand(pair, stack)) {
+            testLeaves(pair, task_results[task]);
+          }
+        }
+      });
+
+  std::vector<MeshIntersection::Pair> result;
+  for (const auto &task_result : task_results) {
+    result.insert(result.end(), task_result.begin(), task_result.end());
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+} // namespace
+
+std::vector<MeshIntersection::Pair>
+MeshIntersection::findSelfIntersections(const MeshData &mesh) {
+  const Tree tree(mesh);
+  return findPairs(tree, tree, true, intersectNeighbors);
+}
+
+std::vector<MeshIntersection::Pair>
+MeshIntersection::findInterference(const MeshData &first,
+                                   const MeshData &second) {
+  return findPairs(Tree(first), Tree(second), false, intersectTriangles);
+}
+
+bool MeshIntersection::intersect(const Triangle &first,
+                                 const Triangle &second) {
+  return intersectTriangles(getPoints(first), getPoints(second));
+}
+
+} // namespace Converter
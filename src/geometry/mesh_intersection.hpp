@@ -0,0 +1,77 @@
+#ifndef MESH_INTERSECTION_HPP
+#define MESH_INTERSECTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Converter {
+
+class MeshData;
+class Triangle;
+
+/**
+ * @brief Finds the intersecting Triangles of a mesh, and between two meshes.
+ * @details A Bvh is built over the transformed Triangles of every mesh, and
+ * the two trees are traversed together, descending only into the pairs of
+ * nodes whose boxes overlap. The first levels of the traversal are expanded
+ * until there are c_task_count pairs of subtrees, which are then handed out
+ * to the threads. The pairs of Triangles in overlapping leaves are tested
+ * exactly: every orientation test is evaluated in floating point and only
+ * redone with exact expansion arithmetic when the result is within the
+ * rounding error, so touching Triangles are found reliably. The pairs are
+ * sorted, so the result does not depend on the number of threads.
+ */
+class MeshIntersection {
+public:
+  /**
+   * @brief The indices of two intersecting Triangles.
+   */
+  using Pair = std::pair<std::uint32_t, std::uint32_t>;
+
+  /**
+   * @brief The number of pairs of subtrees the traversal is split into
+   * before they are handed out to the threads.
+   */
+  static constexpr std::size_t c_task_count = 256U;
+
+  /**
+   * @brief Finds the Triangles of a mesh that intersect each other.
+   * @details Triangles sharing a vertex position only intersect if they
+   * have another point in common, Triangles sharing an edge only if they
+   * are folded onto each other, and Triangles with the same three vertices
+   * always do. Degenerate Triangles are skipped.
+   * @note The pending transformation of the mesh is applied.
+   * @param mesh The mesh to be checked.
+   * @return The pairs of intersecting Triangles, the smaller index first,
+   * in ascending order.
+   */
+  static std::vector<Pair> findSelfIntersections(const MeshData &mesh);
+
+  /**
+   * @brief Finds the Triangles of two meshes that intersect or touch.
+   * @note The pending transformations of the meshes are applied. Degenerate
+   * Triangles are skipped.
+   * @param first The first mesh.
+   * @param second The second mesh.
+   * @return The pairs of the index in the first and in the second mesh, in
+   * ascending order.
+   */
+  static std::vector<Pair> findInterference(const MeshData &first,
+                                            const MeshData &second);
+
+  /**
+   * @brief Determines if two Triangles have a point in common.
+   * @details The test is exact, Triangles touching in a single point
+   * intersect.
+   * @param first The first Triangle, must not be degenerate.
+   * @param second The second Triangle, must not be degenerate.
+   * @return True if the Triangles intersect, otherwise false.
+   */
+  static bool intersect(const Triangle &first, const Triangle &second);
+};
+
+} // namespace Converter
+
+#endif
@@ -0,0 +1,141 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "mesh_statistics.hpp"
+#include "meshdata.hpp"
+#include "parallel.hpp"
+
+namespace Converter {
+
+MeshStatistics MeshStatistics::calculate(const MeshData &mesh) {
+  const auto &triangles = mesh.triangles;
+  const auto &transformation = mesh.getPendingTransform();
+  const bool is_transformed =
+      transformation.getKind() != AffineTransform::Kind::IDENTITY;
+  const std::size_t block_count =
+      (triangles.size() + Parallel::c_block_size - 1U) /
+      Parallel::c_block_size;
+  std::vector<MeshStatistics> block_statistics(block_count);
+  // The areas and volumes are summed pairwise within and across the blocks,
+  // the same reduction tree as Parallel::reproducibleSum.
+  std::vector<double> block_areas(block_count, 0.0);
+  std::vector<double> block_volumes(block_count, 0.0);
+
+  Parallel::forEachBlock(
+      triangles.size(), Parallel::c_block_size,
+      [&](std::size_t block, std::size_t begin, std::size_t end) {
+        auto &statistics = block_statistics[block];
+        double areas[Parallel::c_block_size];
+        double volumes[Parallel::c_block_size];
+        for (std::size_t i = begin; i < end; ++i) {
+          if (is_transformed) {
+            Triangle triangle = triangles[i];
+            transformation.apply(triangle);
+            statistics.accumulate(triangle, areas[i - begin],
+                                  volumes[i - begin]);
+          } else {
+            statistics.accumulate(triangles[i], areas[i - begin],
+                                  volumes[i - begin]);
+          }
+        }
+        block_areas[block] = Parallel::pairwiseSum(areas, end - begin);
+        block_volumes[block] = Parallel::pairwiseSum(volumes, end - begin);
+      });
+
+  // Merging in the order of the blocks keeps the result independent of the
+  // number of threads.
+  MeshStatistics result;
+  for (const auto &statistics : block_statistics) {
+    result.merge(statistics);
+  }
+  result.surface_area =
+      Parallel::pairwiseSum(block_areas.data(), block_areas.size());
+  result.volume =
+      Parallel::pairwiseSum(block_volumes.data(), block_volumes.size());
+  return result;
+}
+
+void MeshStatistics::add(const Triangle &triangle) {
+  double area = 0.0;
+  double signed_volume = 0.0;
+  accumulate(triangle, area, signed_volume);
+  surface_area += area;
+  volume += signed_volume;
+}
+
+void MeshStatistics::accumulate(const Triangle &triangle, double &area,
+                                double &signed_volume) {
+  const Eigen::Vector3d a = triangle.a.pos.head<3>();
+  const Eigen::Vector3d b = triangle.b.pos.head<3>();
+  const Eigen::Vector3d c = triangle.c.pos.head<3>();
+
+  ++triangle_count;
+  bounding_box.extend(a);
+  bounding_box.extend(b);
+  bounding_box.extend(c);
+
+  const Eigen::Vector3d cross = (b - a).cross(c - a);
+  const double double_area = cross.norm();
+  const double longest_edge_squared = std::max(
+      {(b - a).squaredNorm(), (c - b).squaredNorm(), (a - c).squaredNorm()});
+  if (double_area <= c_degenerate_epsilon * longest_edge_squared) {
+    ++degenerate_count;
+  }
+
+  area = double_area / 2.0;
+  surface_moment += area * (a + b + c) / 3.0;
+
+  // The integrals over the signed tetrahedron formed by the Triangle and the
+  // origin, the determinant is six times its volume.
+  const double determinant = a.dot(b.cross(c));
+  signed_volume = determinant / 6.0;
+  volume_moment += determinant / 24.0 * (a + b + c);
+
+  const Eigen::Vector3d sum = a + b + c;
+  second_moment += determinant / 120.0 *
+                   (a * a.transpose() + b * b.transpose() + c * c.transpose() +
+                    sum * sum.transpose());
+}
+
+void MeshStatistics::merge(const MeshStatistics &other) {
+  triangle_count += other.triangle_count;
+  degenerate_count += other.degenerate_count;
+  surface_area += other.surface_area;
+  volume += other.volume;
+  bounding_box.extend(other.bounding_box);
+  surface_moment += other.surface_moment;
+  volume_moment += other.volume_moment;
+  second_moment += other.second_moment;
+}
+
+Eigen::Vector3d MeshStatistics::getCentroid() const {
+  if (volume != 0.0) {
+    return volume_moment / volume;
+  }
+  if (surface_area != 0.0) {
+    return surface_moment / surface_area;
+  }
+  return Eigen::Vector3d::Zero();
+}
+
+Eigen::Matrix3d MeshStatistics::getInertiaTensor() const {
+  if (volume == 0.0) {
+    return Eigen::Matrix3d::Zero();
+  }
+
+  // Inward facing Triangles negate every volume integral.
+  const double sign = volume < 0.0 ? -1.0 : 1.0;
+  const double mass = sign * volume;
+  const Eigen::Vector3d centroid = getCentroid();
+
+  // The second moment around the centroid, by the parallel axis theorem.
+  const Eigen::Matrix3d central_moment =
+      sign * second_moment - mass * centroid * centroid.transpose();
+  return central_moment.trace() * Eigen::Matrix3d::Identity() -
+         central_moment;
+}
+
+} // namespace Converter
@@ -0,0 +1,131 @@
+#ifndef MESH_STATISTICS_HPP
+#define MESH_STATISTICS_HPP
+
+#include <Eigen/Dense>
+#include <cstddef>
+
+#include "triangle.hpp"
+
+namespace Converter {
+
+class MeshData;
+
+/**
+ * @brief Accumulates the geometric properties of a mesh in a single pass.
+ * @details Triangles can be added one by one, for example straight from a
+ * reader, so the mesh never has to be stored, and partial results can be
+ * merged, which is how calculate processes a MeshData in parallel. The volume
+ * related properties treat the mesh as a solid of unit density, they are only
+ * meaningful for closed meshes.
+ */
+class MeshStatistics {
+public:
+  /**
+   * @brief The ratio of the doubled area and the squared longest edge under
+   * which a Triangle is considered degenerate.
+   */
+  static constexpr double c_degenerate_epsilon = 1e-12;
+
+  /**
+   * @brief Calculates the statistics of a whole mesh in parallel.
+   * @details The pending transformation of the mesh is applied to each
+   * Triangle on the fly. The area and the volume are summed pairwise, like
+   * Parallel::reproducibleSum, so they are bit-identical for any number of
+   * threads.
+   * @param mesh The mesh whose statistics should be calculated.
+   * @return The statistics of the mesh.
+   */
+  static MeshStatistics calculate(const MeshData &mesh);
+
+  /**
+   * @brief Adds a single Triangle to the statistics.
+   * @param triangle The Triangle to be added.
+   */
+  void add(const Triangle &triangle);
+
+  /**
+   * @brief Adds the Triangles accumulated by another object.
+   * @param other The statistics to be merged into this one.
+   */
+  void merge(const MeshStatistics &other);
+
+  /**
+   * @brief Returns the number of added Triangles.
+   * @return The number of Triangles.
+   */
+  std::size_t getTriangleCount() const { return triangle_count; }
+
+  /**
+   * @brief Returns the number of Triangles whose area is zero relative to
+   * their size.
+   * @return The number of degenerate Triangles.
+   */
+  std::size_t getDegenerateCount() const { return degenerate_count; }
+
+  /**
+   * @brief Returns the surface area of the added Triangles.
+   * @return The surface area.
+   */
+  double getSurfaceArea() const { return surface_area; }
+
+  /**
+   * @brief Returns the signed volume enclosed by the added Triangles.
+   * @return The volume, positive if the Triangles face outwards.
+   */
+  double getSignedVolume() const { return volume; }
+
+  /**
+   * @brief Returns the axis aligned bounding box of the added Triangles.
+   * @return The bounding box, empty if no Triangles were added.
+   */
+  const Eigen::AlignedBox3d &getBoundingBox() const { return bounding_box; }
+
+  /**
+   * @brief Returns the centroid of the mesh.
+   * @return The centroid of the enclosed volume, or the area weighted
+   * centroid of the surface if the volume is zero.
+   */
+  Eigen::Vector3d getCentroid() const;
+
+  /**
+   * @brief Returns the inertia tensor of the enclosed solid.
+   * @details The tensor is calculated around the centroid, with unit
+   * density.
+   * @return The inertia tensor.
+   */
+  Eigen::Matrix3d getInertiaTensor() const;
+
+private:
+  /**
+   * @brief Adds a Triangle to everything but the area and the volume.
+   * @param triangle The Triangle to be added.
+   * @param area Set to the area of the Triangle.
+   * @param signed_volume Set to the signed volume of the tetrahedron formed
+   * by the Triangle and the origin.
+   */
+  void accumulate(const Triangle &triangle, double &area,
+                  double &signed_volume);
+
+  std::size_t triangle_count = 0U;
+  std::size_t degenerate_count = 0U;
+  double surface_area = 0.0;
+  double volume = 0.0;
+  Eigen::AlignedBox3d bounding_box;
+  /**
+   * @brief The area weighted sum of the Triangle centroids.
+   */
+  Eigen::Vector3d surface_moment = Eigen::Vector3d::Zero();
+  /**
+   * @brief The integral of the position over the enclosed volume.
+   */
+  Eigen::Vector3d volume_moment = Eigen::Vector3d::Zero();
+  /**
+   * @brief The integral of the outer product of the position with itself
+   * over the enclosed volume.
+   */
+  Eigen::Matrix3d second_moment = Eigen::Matrix3d::Zero();
+};
+
+} // namespace Converter
+
+#endif
@@ -0,0 +1,147 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "indexed_mesh.hpp"
+#include "mesh_statistics.hpp"
+#include "mesh_validation.hpp"
+#include "parallel.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief A directed edge in a sortable form.
+ * @details The first element holds the smaller vertex in the upper 32 bits
+ * and the larger one in the lower 32 bits, so the copies of an undirected
+ * edge are sorted next to each other. The second element is 1 if the edge
+ * points from the smaller vertex to the larger one. Keeping the direction
+ * apart leaves the full 32 bits to both vertex indices.
+ */
+using EdgeKey = std::pair<std::uint64_t, std::uint8_t>;
+
+/**
+ * @brief Packs a directed edge into a sortable key.
+ */
+EdgeKey makeEdgeKey(std::uint32_t from, std::uint32_t to) {
+  const std::uint64_t low = std::min(from, to);
+  const std::uint64_t high = std::max(from, to);
+  return {(low << 32U) | high, from < to ? 1U : 0U};
+}
+
+/**
+ * @brief Unpacks the undirected edge of a key.
+ */
+MeshValidation::Edge getEdge(const EdgeKey &key) {
+  return {static_cast<std::uint32_t>(key.first >> 32U),
+          static_cast<std::uint32_t>(key.first & 0xFFFFFFFFULL)};
+}
+
+/**
+ * @brief Appends the per block results in block order.
+ */
+template <typename T>
+void concatenate(const std::vector<std::vector<T>> &blocks,
+                 std::vector<T> &result) {
+  for (const auto &block : blocks) {
+    result.insert(result.end(), block.begin(), block.end());
+  }
+}
+
+} // namespace
+
+MeshValidation MeshValidation::validate(const IndexedMesh &mesh) {
+  MeshValidation validation;
+  const std::size_t face_count = mesh.faces.size();
+  const std::size_t face_block_count =
+      (face_count + Parallel::c_block_size - 1U) / Parallel::c_block_size;
+
+  // Every face writes its edges to fixed positions, the edges of faces with
+  // repeated vertices are marked with an invalid key and dropped later.
+  // An edge can't start and end at the largest vertex index.
+  static constexpr EdgeKey c_invalid_key{~std::uint64_t{0U}, 0U};
+  std::vector<EdgeKey> keys(3U * face_count);
+  std::vector<std::vector<std::size_t>> degenerate_blocks(face_block_count);
+  Parallel::forEachBlock(
+      face_count, Parallel::c_block_size,
+      [&](std::size_t block, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          const auto &face = mesh.faces[i];
+          const bool has_repeated_vertex = face[0U] == face[1U] ||
+                                           face[1U] == face[2U] ||
+                                           face[2U] == face[0U];
+          for (std::size_t j = 0U; j < 3U; ++j) {
+            keys[3U * i + j] =
+                has_repeated_vertex
+                    ? c_invalid_key
+                    : makeEdgeKey(face[j], face[(j + 1U) % 3U]);
+          }
+
+          const Eigen::Vector3d a = mesh.vertices[face[0U]].head<3>();
+          const Eigen::Vector3d ab = mesh.vertices[face[1U]].head<3>() - a;
+          const Eigen::Vector3d ac = mesh.vertices[face[2U]].head<3>() - a;
+          const Eigen::Vector3d bc = ac - ab;
+          const double longest_edge = std::max(
+              {ab.squaredNorm(), ac.squaredNorm(), bc.squaredNorm()});
+          if (has_repeated_vertex ||
+              ab.cross(ac).norm() <=
+                  MeshStatistics::c_degenerate_epsilon * longest_edge) {
+            degenerate_blocks[block].push_back(i);
+          }
+        }
+      });
+  concatenate(degenerate_blocks, validation.degenerate_faces);
+
+  Parallel::sort(keys);
+  // The invalid keys are sorted to the end.
+  keys.erase(std::lower_bound(keys.begin(), keys.end(), c_invalid_key),
+             keys.end());
+
+  // Every block classifies the groups starting in it, a group may extend
+  // into the following blocks.
+  const std::size_t key_count = keys.size();
+  const std::size_t key_block_count =
+      (key_count + Parallel::c_block_size - 1U) / Parallel::c_block_size;
+  std::vector<std::vector<Edge>> boundary_blocks(key_block_count);
+  std::vector<std::vector<Edge>> non_manifold_blocks(key_block_count);
+  std::vector<std::vector<Edge>> inconsistent_blocks(key_block_count);
+  Parallel::forEachBlock(
+      key_count, Parallel::c_block_size,
+      [&](std::size_t block, std::size_t begin, std::size_t end) {
+        std::size_t first = begin;
+        while (first > 0U && first < key_count &&
+               keys[first - 1U].first == keys[first].first) {
+          ++first;
+        }
+        while (first < end) {
+          const std::uint64_t edge_key = keys[first].first;
+          std::size_t last = first + 1U;
+          std::size_t forward_count = keys[first].second;
+          while (last < key_count && keys[last].first == edge_key) {
+            forward_count += keys[last].second;
+            ++last;
+          }
+
+          const std::size_t count = last - first;
+          if (count == 1U) {
+            boundary_blocks[block].push_back(getEdge(keys[first]));
+          } else if (count > 2U) {
+            non_manifold_blocks[block].push_back(getEdge(keys[first]));
+          } else if (forward_count != 1U) {
+            inconsistent_blocks[block].push_back(getEdge(keys[first]));
+          }
+          first = last;
+        }
+      });
+  concatenate(boundary_blocks, validation.boundary_edges);
+  concatenate(non_manifold_blocks, validation.non_manifold_edges);
+  concatenate(inconsistent_blocks, validation.inconsistent_edges);
+
+  return validation;
+}
+
+} // namespace Converter
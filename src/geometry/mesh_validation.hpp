@@ -0,0 +1,110 @@
+#ifndef MESH_VALIDATION_HPP
+#define MESH_VALIDATION_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Converter {
+
+class IndexedMesh;
+
+/**
+ * @brief Checks whether a mesh is a closed, consistently oriented manifold.
+ * @details The volume and the parity based inside test are only meaningful
+ * for such meshes. Every face contributes its three edges, the edges are
+ * sorted in parallel so the copies of the same undirected edge become
+ * neighbors, and each group is classified by its size and the directions of
+ * its copies. Sorting keeps the memory use at 8 bytes per edge, so it
+ * scales to meshes of hundreds of millions of Triangles.
+ */
+class MeshValidation {
+public:
+  /**
+   * @brief An undirected edge, the smaller vertex index first.
+   */
+  using Edge = std::array<std::uint32_t, 2U>;
+
+  /**
+   * @brief Validates an indexed mesh.
+   * @note The mesh should be welded, for a triangle soup every edge is a
+   * boundary edge. At most 2^31 vertices are supported.
+   * @param mesh The mesh to be validated.
+   * @return The result of the validation.
+   */
+  static MeshValidation validate(const IndexedMesh &mesh);
+
+  /**
+   * @brief Returns the edges used by only one face.
+   * @return The boundary edges in ascending order.
+   */
+  const std::vector<Edge> &getBoundaryEdges() const { return boundary_edges; }
+
+  /**
+   * @brief Returns the edges shared by more than two faces.
+   * @return The non-manifold edges in ascending order.
+   */
+  const std::vector<Edge> &getNonManifoldEdges() const {
+    return non_manifold_edges;
+  }
+
+  /**
+   * @brief Returns the edges shared by two faces traversing it in the same
+   * direction, which means their winding orders disagree.
+   * @return The inconsistently oriented edges in ascending order.
+   */
+  const std::vector<Edge> &getInconsistentEdges() const {
+    return inconsistent_edges;
+  }
+
+  /**
+   * @brief Returns the faces with repeated vertices or zero area.
+   * @details Zero area is decided the same way as in MeshStatistics. The
+   * edges of faces with repeated vertices are left out of the
+   * edge checks.
+   * @return The indices of the degenerate faces in ascending order.
+   */
+  const std::vector<std::size_t> &getDegenerateFaces() const {
+    return degenerate_faces;
+  }
+
+  /**
+   * @brief Returns if the mesh is closed and every edge has two faces.
+   * @return True if there are no boundary and non-manifold edges.
+   */
+  bool isWatertight() const {
+    return boundary_edges.empty() && non_manifold_edges.empty();
+  }
+
+  /**
+   * @brief Returns if the mesh is watertight and consistently oriented, so
+   * its volume and inside test can be trusted.
+   * @return True if every check passed, degenerate faces are allowed.
+   */
+  bool isValid() const {
+    return isWatertight() && inconsistent_edges.empty();
+  }
+
+private:
+  /**
+   * @brief Holds the edges used by only one face.
+   */
+  std::vector<Edge> boundary_edges;
+  /**
+   * @brief Holds the edges shared by more than two faces.
+   */
+  std::vector<Edge> non_manifold_edges;
+  /**
+   * @brief Holds the edges whose two faces have opposite winding.
+   */
+  std::vector<Edge> inconsistent_edges;
+  /**
+   * @brief Holds the indices of the degenerate faces.
+   */
+  std::vector<std::size_t> degenerate_faces;
+};
+
+} // namespace Converter
+
+#endif
@@ -1,71 +1,267 @@
 #include <Eigen/Dense>
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
+#include "affine_transform.hpp"
 #include "meshdata.hpp"
+#include "morton.hpp"
+#include "parallel.hpp"
+#include "triangle_packet.hpp"
 
 namespace Converter {
 
 double MeshData::calculateSurfaceArea() const {
-  double surface_area = 0.0;
-  for (const auto &triangle : triangles) {
-    surface_area += triangle.getArea();
-  }
-  return surface_area;
+  const bool is_transformed =
+      pending_transform.getKind() != AffineTransform::Kind::IDENTITY;
+  return Parallel::reproducibleSum(
+      triangles.size(),
+      [this, is_transformed](std::size_t begin, std::size_t end,
+                             double *values) {
+        TrianglePacket packet;
+        for (std::size_t first = begin; first < end;
+             first += TrianglePacket::c_width) {
+          packet.load(triangles, first, end);
+          if (is_transformed) {
+            packet.transform(pending_transform);
+          }
+          const auto areas = packet.getAreas();
+          std::copy_n(areas.data(), packet.count, values + (first - begin));
+        }
+      });
 }
 
 double MeshData::calculateVolume() const {
-  double volume = 0.0;
-
   // Adds together the signed volume of the tetrahedron
   // formed by the triangle and the origin.
-  for (const auto &triangle : triangles) {
-    volume += triangle.a.pos.cross3(triangle.b.pos).dot(triangle.c.pos);
-  }
-  return std::abs(volume / 6.0);
+  const bool is_transformed =
+      pending_transform.getKind() != AffineTransform::Kind::IDENTITY;
+  const double volume = Parallel::reproducibleSum(
+      triangles.size(),
+      [this, is_transformed](std::size_t begin, std::size_t end,
+                             double *values) {
+        TrianglePacket packet;
+        for (std::size_t first = begin; first < end;
+             first += TrianglePacket::c_width) {
+          packet.load(triangles, first, end);
+          if (is_transformed) {
+            packet.transform(pending_transform);
+          }
+          const auto volumes = packet.getSignedVolumes();
+          std::copy_n(volumes.data(), packet.count, values + (first - begin));
+        }
+      });
+  return std::abs(volume);
 }
 
-bool MeshData::isPointInside(const Eigen::Vector4d &point) const {
-  std::vector<Eigen::Vector4d> intersections;
+bool MeshData::isPointInside(const Eigen::Vector4d &world_point) const {
+  // Containment is invariant under affine transformations, so the query is
+  // moved instead of the mesh.
+  const Eigen::Vector4d point =
+      pending_transform.getInverse().transformPoint(world_point);
+  // The direction is arbitrary.
+  const TrianglePacket::Ray ray(point, {0.0, 1.0, 0.0, 0.0});
+  const auto &triangle_packets = getPackets();
+  std::size_t hit_count = 0U;
 
-  for (const auto &triangle : triangles) {
-    if (triangle.isInside(point)) {
+  for (std::size_t i = 0U; i < triangle_packets.size(); ++i) {
+    const auto intersections = triangle_packets[i].intersect(ray);
+    if (intersections.contains_origin.any()) {
       return true;
     }
 
-    // The direction is arbitrary.
-    const auto intersection =
-        triangle.rayIntersection(point, {0.0, 1.0, 0.0, 0.0});
-
-    // If there is an intersection store it in a vector and check if there
-    // were no intersections previously with the same coordinates.
-    if (intersection) {
-      const auto &predicate = [&intersection](const auto &point) {
-        const auto &i_point = intersection.value();
-        return point.isApprox(i_point);
-      };
-
-      if (std::find_if(intersections.begin(), intersections.end(), predicate) ==
-          intersections.end()) {
-        intersections.push_back(intersection.value());
+    // Triangles parallel to the ray can't be hit, but the point can still be
+    // on them. Degenerate Triangles have no normal and are skipped.
+    if (intersections.is_parallel.any()) {
+      const auto &triangle_planes = getPlanes();
+      // The last packet may be partial, its unused lanes have no Triangle.
+      for (std::size_t lane = 0U; lane < triangle_packets[i].count; ++lane) {
+        const std::size_t index = i * TrianglePacket::c_width + lane;
+        const auto &normal = triangle_planes[index].normal;
+        if (intersections.is_parallel[lane] && !normal.isZero(0.0) &&
+            triangles[index].isInside(point, normal)) {
+          return true;
+        }
       }
     }
+
+    hit_count += intersections.hit.count();
+  }
+  return hit_count % 2U == 1U;
+}
+
+const std::vector<MeshData::Plane> &MeshData::getPlanes() const {
+  if (are_planes_valid && planes.size() == triangles.size()) {
+    return planes;
+  }
+
+  planes.resize(triangles.size());
+  Parallel::forEachBlock(
+      triangles.size(), Parallel::c_block_size,
+      [this](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          const auto &triangle = triangles[i];
+          planes[i].normal = triangle.getNormal();
+          planes[i].offset = planes[i].normal.dot(triangle.a.pos);
+        }
+      });
+  are_planes_valid = true;
+  return planes;
+}
+
+const std::vector<TrianglePacket> &MeshData::getPackets() const {
+  const std::size_t packet_count =
+      (triangles.size() + TrianglePacket::c_width - 1U) /
+      TrianglePacket::c_width;
+  if (are_packets_valid && packets.size() == packet_count) {
+    return packets;
+  }
+
+  packets.resize(packet_count);
+  Parallel::forEachBlock(
+      packet_count, Parallel::c_block_size / TrianglePacket::c_width,
+      [this](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          packets[i].load(triangles, i * TrianglePacket::c_width,
+                          triangles.size());
+        }
+      });
+  are_packets_valid = true;
+  return packets;
+}
+
+std::optional<RayCaster::Hit>
+MeshData::castRay(const Eigen::Vector4d &origin,
+                  const Eigen::Vector4d &direction, double max_t) const {
+  const auto inverse = pending_transform.getInverse();
+  return getRayCaster().castRay(inverse.transformPoint(origin),
+                                inverse.transformDirection(direction), max_t);
+}
+
+bool MeshData::isOccluded(const Eigen::Vector4d &origin,
+                          const Eigen::Vector4d &direction,
+                          double max_t) const {
+  const auto inverse = pending_transform.getInverse();
+  return getRayCaster().isOccluded(inverse.transformPoint(origin),
+                                   inverse.transformDirection(direction),
+                                   max_t);
+}
+
+std::vector<std::optional<RayCaster::Hit>>
+MeshData::castRays(const std::vector<Eigen::Vector4d> &origins,
+                   const std::vector<Eigen::Vector4d> &directions) const {
+  const auto &caster = getRayCaster();
+  if (pending_transform.getKind() == AffineTransform::Kind::IDENTITY) {
+    return caster.castRays(origins, directions);
+  }
+
+  const auto inverse = pending_transform.getInverse();
+  std::vector<Eigen::Vector4d> local_origins(origins.size());
+  std::vector<Eigen::Vector4d> local_directions(directions.size());
+  std::transform(origins.begin(), origins.end(), local_origins.begin(),
+                 [&inverse](const Eigen::Vector4d &origin) {
+                   return inverse.transformPoint(origin);
+                 });
+  std::transform(directions.begin(), directions.end(),
+                 local_directions.begin(),
+                 [&inverse](const Eigen::Vector4d &direction) {
+                   return inverse.transformDirection(direction);
+                 });
+  return caster.castRays(local_origins, local_directions);
+}
+
+const RayCaster &MeshData::getRayCaster() const {
+  if (!ray_caster || ray_caster->size() != triangles.size()) {
+    ray_caster.emplace(triangles);
+  }
+  return *ray_caster;
+}
+
+void MeshData::sortSpatially() {
+  const std::size_t triangle_count = triangles.size();
+  if (triangle_count < 2U) {
+    return;
+  }
+
+  const auto getCentroid = [this](std::size_t i) {
+    const auto &triangle = triangles[i];
+    return Eigen::Vector3d(
+        ((triangle.a.pos + triangle.b.pos + triangle.c.pos) / 3.0).head<3>());
+  };
+
+  const std::size_t block_count =
+      (triangle_count + Parallel::c_block_size - 1U) / Parallel::c_block_size;
+  std::vector<Eigen::AlignedBox3d> block_boxes(block_count);
+  Parallel::forEachBlock(
+      triangle_count, Parallel::c_block_size,
+      [&](std::size_t block, std::size_t begin, std::size_t end) {
+        block_boxes[block].setEmpty();
+        for (std::size_t i = begin; i < end; ++i) {
+          block_boxes[block].extend(getCentroid(i));
+        }
+      });
+  Eigen::AlignedBox3d box;
+  box.setEmpty();
+  for (const auto &block_box : block_boxes) {
+    box.extend(block_box);
+  }
+
+  const unsigned int bits_per_axis =
+      triangle_count < c_small_sort_size ? 10U : Morton::c_max_bits_per_axis;
+  std::vector<std::uint64_t> keys(triangle_count);
+  std::vector<std::uint32_t> indices(triangle_count);
+  Parallel::forEachBlock(
+      triangle_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          keys[i] = Morton::encodePoint(getCentroid(i), box, bits_per_axis);
+          indices[i] = static_cast<std::uint32_t>(i);
+        }
+      });
+  Parallel::radixSort(keys, indices, 3U * bits_per_axis);
+
+  std::vector<Triangle> sorted(triangle_count);
+  Parallel::forEachBlock(
+      triangle_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          sorted[i] = triangles[indices[i]];
+        }
+      });
+  triangles.swap(sorted);
+  invalidateCaches();
+}
+
+void MeshData::invalidateCaches() {
+  are_planes_valid = false;
+  are_packets_valid = false;
+  ray_caster.reset();
+}
+
+void MeshData::deferTransform(const Eigen::Matrix4d &translation_matrix,
+                              const Eigen::Matrix4d &rotation_matrix,
+                              const Eigen::Matrix4d &scale_matrix) {
+  pending_transform = AffineTransform(translation_matrix * rotation_matrix *
+                                      scale_matrix) *
+                      pending_transform;
+}
+
+void MeshData::applyPendingTransform() {
+  if (pending_transform.getKind() == AffineTransform::Kind::IDENTITY) {
+    return;
   }
-  return intersections.size() % 2 == 1;
+  pending_transform.apply(triangles);
+  pending_transform = AffineTransform();
+  invalidateCaches();
 }
 
 void MeshData::transform(const Eigen::Matrix4d &translation_matrix,
                          const Eigen::Matrix4d &rotation_matrix,
                          const Eigen::Matrix4d &scale_matrix) {
-  const Eigen::Matrix4d &transformation_matrix =
-      translation_matrix * rotation_matrix * scale_matrix;
-  const Eigen::Matrix4d &normal_transformation_matrix =
-      (rotation_matrix * scale_matrix).inverse().transpose();
-
-  for (auto &triangle : triangles) {
-    triangle.transform(transformation_matrix, normal_transformation_matrix);
-  }
+  deferTransform(translation_matrix, rotation_matrix, scale_matrix);
+  applyPendingTransform();
 }
 
 } // namespace Converter
\ No newline at end of file
@@ -2,10 +2,16 @@
 #define MESHDATA_HPP
 
 #include <Eigen/Dense>
+#include <cstddef>
+#include <limits>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "affine_transform.hpp"
+#include "ray_caster.hpp"
 #include "triangle.hpp"
+#include "triangle_packet.hpp"
 
 namespace Converter {
 
@@ -14,23 +20,42 @@ namespace Converter {
  */
 class MeshData {
 public:
+  /**
+   * @brief The plane of a single Triangle.
+   * @param normal The normalized normal vector of the Triangle, zero for
+   * degenerate Triangles.
+   * @param offset The dot product of the normal and the vertices of the
+   * Triangle.
+   */
+  struct Plane {
+    Eigen::Vector4d normal;
+    double offset;
+  };
+
   /**
    * @brief Holds the name of the material file if there is one.
    */
   std::string material_file;
   /**
    * @brief Holds the triangles that the mesh contains.
+   * @note If a transformation is pending, these hold the coordinates before
+   * the transformation.
    */
   std::vector<Triangle> triangles;
 
   /**
    * @brief Calculates the surface area of the mesh.
+   * @details The areas are calculated with SIMD instructions and summed in
+   * parallel with Parallel::reproducibleSum, so the result does not depend on
+   * the number of threads.
    * @return The surface area of the mesh.
    */
   double calculateSurfaceArea() const;
 
   /**
    * @brief Calculates the volume of the mesh.
+   * @details Sums the signed volumes of the tetrahedrons formed by the
+   * Triangles and the origin, the same way as calculateSurfaceArea.
    * @return The volume of the mesh.
    */
   double calculateVolume() const;
@@ -40,12 +65,146 @@ public:
    * @param point The point you wish to know if it's inside.
    * @details The concept of the algorithm is, if the point is inside
    * the mesh and we shoot a ray into any direction, then the number of
-   * hit triangles must be odd. The corner case if you hit an edge or vertex,
-   * but the implementation handles that.
+   * hit triangles must be odd. The ray is tested against the cached packets
+   * with the watertight TrianglePacket::intersect, which counts a hit on a
+   * shared edge or vertex only once. Points on the surface are inside.
+   * @note The result is unreliable for meshes that are not closed, use
+   * WindingNumber for those.
    * @return True if the point is inside the mesh, otherwise false.
    */
   bool isPointInside(const Eigen::Vector4d &point) const;
 
+  /**
+   * @brief Finds the closest intersection of a ray and the mesh.
+   * @details The rays are cast with the cached RayCaster. The pending
+   * transformation is taken into account by transforming the ray with its
+   * inverse, which leaves the distances and barycentric coordinates intact.
+   * @param origin The point in which the ray starts.
+   * @param direction The direction of the ray, does not have to be
+   * normalized but must not be zero.
+   * @param max_t The largest distance to look for hits at, in units of the
+   * direction vector.
+   * @return The closest hit if there is one.
+   */
+  std::optional<RayCaster::Hit>
+  castRay(const Eigen::Vector4d &origin, const Eigen::Vector4d &direction,
+          double max_t = std::numeric_limits<double>::infinity()) const;
+
+  /**
+   * @brief Determines if a ray hits the mesh, stopping at the first hit.
+   * @param origin The point in which the ray starts.
+   * @param direction The direction of the ray, does not have to be
+   * normalized but must not be zero.
+   * @param max_t The largest distance to look for hits at, in units of the
+   * direction vector.
+   * @return True if the ray hits a Triangle, otherwise false.
+   */
+  bool isOccluded(const Eigen::Vector4d &origin,
+                  const Eigen::Vector4d &direction,
+                  double max_t = std::numeric_limits<double>::infinity()) const;
+
+  /**
+   * @brief Finds the closest intersection of many rays, using multiple
+   * threads.
+   * @param origins The starting points of the rays.
+   * @param directions The directions of the rays, the same number as
+   * origins.
+   * @return The closest hit of every ray, in the order of the rays.
+   */
+  std::vector<std::optional<RayCaster::Hit>>
+  castRays(const std::vector<Eigen::Vector4d> &origins,
+           const std::vector<Eigen::Vector4d> &directions) const;
+
+  /**
+   * @brief Returns the ray casting acceleration structure of the Triangles.
+   * @details The structure is built on the first call and cached the same
+   * way as the planes.
+   * @note The pending transformation is not applied to the structure.
+   * @return The cached RayCaster.
+   */
+  const RayCaster &getRayCaster() const;
+
+  /**
+   * @brief Returns the planes of the Triangles.
+   * @details The planes are calculated in parallel on the first call and
+   * cached, so the normals are only calculated once no matter how many
+   * queries use them. The cache is invalidated by applying a transformation
+   * or by invalidateCaches, and rebuilt if the number of Triangles changed.
+   * @note The planes belong to the Triangles as they are stored, the pending
+   * transformation is not applied to them. Building the cache is not
+   * thread-safe, call this once before using the mesh from multiple threads.
+   * @return The planes, one for each Triangle.
+   */
+  const std::vector<Plane> &getPlanes() const;
+
+  /**
+   * @brief Returns the Triangles packed into TrianglePackets.
+   * @details The packets are built in parallel on the first call and cached
+   * the same way as the planes, the last packet may be partially filled.
+   * @note The pending transformation is not applied to the packets.
+   * @return The packets, the i-th holds the Triangles from i * c_width.
+   */
+  const std::vector<TrianglePacket> &getPackets() const;
+
+  /**
+   * @brief Reorders the Triangles along a Z-order curve.
+   * @details The centroids of the Triangles are quantized to a grid over
+   * their bounding box and the Triangles are sorted by the Morton codes of
+   * their cells with Parallel::radixSort. Triangles close in space end up
+   * close in memory, which speeds up building and querying the spatial
+   * structures, and the order is kept when the mesh is written. Meshes with
+   * fewer than c_small_sort_size Triangles use 30-bit codes, larger ones
+   * 63-bit codes. The sort is stable, so the result does not depend on the
+   * number of threads.
+   * @note The codes are calculated from the stored coordinates, the pending
+   * transformation is not applied. The caches are invalidated.
+   */
+  void sortSpatially();
+
+  /**
+   * @brief The number of Triangles from which sortSpatially uses 63-bit
+   * Morton codes instead of 30-bit ones.
+   */
+  static constexpr std::size_t c_small_sort_size = std::size_t{1U} << 20U;
+
+  /**
+   * @brief Drops the cached planes, packets and ray casting structure.
+   * @details Has to be called after modifying the Triangles directly.
+   */
+  void invalidateCaches();
+
+  /**
+   * @brief Records a transformation without touching the Triangles.
+   * @details The transformation is composed with the already pending one.
+   * The functions of MeshData and the writers take the pending
+   * transformation into account, either by transforming the data while they
+   * process it anyway, or by transforming their queries with the inverse, so
+   * an extra pass over the mesh is avoided. Code reading the triangles
+   * directly should call applyPendingTransform first.
+   * @param translation_matrix The transformation matrix describing the
+   * translation.
+   * @param rotation_matrix The transformation matrix describing the
+   * rotation.
+   * @param scale_matrix The transformation matrix describing the
+   * scaling.
+   */
+  void deferTransform(const Eigen::Matrix4d &translation_matrix,
+                      const Eigen::Matrix4d &rotation_matrix,
+                      const Eigen::Matrix4d &scale_matrix);
+
+  /**
+   * @brief Returns the transformation not yet applied to the Triangles.
+   * @return The pending transformation, the identity if there is none.
+   */
+  const AffineTransform &getPendingTransform() const {
+    return pending_transform;
+  }
+
+  /**
+   * @brief Applies the pending transformation to the Triangles.
+   */
+  void applyPendingTransform();
+
   /**
    * @brief Transforms the whole mesh.
    * @param translation_matrix The transformation matrix describing the
@@ -55,12 +214,39 @@ public:
    * @param scale_matrix The transformation matrix describing the
    * scaling.
    * @details The implementation is using homogeneous coordinates so it
-   * can do calculations fast, so these matrices are 4x4.
-   * @return True if the point is inside the mesh, otherwise false.
+   * can do calculations fast, so these matrices are 4x4. The composed
+   * matrix is applied with AffineTransform, together with the pending
+   * transformation if there is one.
    */
   void transform(const Eigen::Matrix4d &translation_matrix,
                  const Eigen::Matrix4d &rotation_matrix,
                  const Eigen::Matrix4d &scale_matrix);
+
+private:
+  /**
+   * @brief Holds the transformation not yet applied to the Triangles.
+   */
+  AffineTransform pending_transform;
+  /**
+   * @brief Holds the cached planes of the Triangles.
+   */
+  mutable std::vector<Plane> planes;
+  /**
+   * @brief Holds whether the cached planes are up to date.
+   */
+  mutable bool are_planes_valid = false;
+  /**
+   * @brief Holds the cached packets of the Triangles.
+   */
+  mutable std::vector<TrianglePacket> packets;
+  /**
+   * @brief Holds whether the cached packets are up to date.
+   */
+  mutable bool are_packets_valid = false;
+  /**
+   * @brief Holds the cached ray casting acceleration structure.
+   */
+  mutable std::optional<RayCaster> ray_caster;
 };
 
 } // namespace Converter
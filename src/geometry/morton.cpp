@@ -0,0 +1,54 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "morton.hpp"
+
+namespace Converter {
+namespace Morton {
+
+namespace {
+
+/**
+ * @brief Spreads the lowest 21 bits of a value to every third bit.
+ * @param value The value to be spread.
+ * @return The spread bits.
+ */
+std::uint64_t spreadBits(std::uint64_t value) {
+  value &= 0x1FFFFFU;
+  value = (value | (value << 32U)) & 0x1F00000000FFFFULL;
+  value = (value | (value << 16U)) & 0x1F0000FF0000FFULL;
+  value = (value | (value << 8U)) & 0x100F00F00F00F00FULL;
+  value = (value | (value << 4U)) & 0x10C30C30C30C30C3ULL;
+  value = (value | (value << 2U)) & 0x1249249249249249ULL;
+  return value;
+}
+
+} // namespace
+
+std::uint64_t encode(std::uint32_t x, std::uint32_t y, std::uint32_t z) {
+  return spreadBits(x) | (spreadBits(y) << 1U) | (spreadBits(z) << 2U);
+}
+
+std::uint64_t encodePoint(const Eigen::Vector3d &point,
+                          const Eigen::AlignedBox3d &box,
+                          unsigned int bits_per_axis) {
+  const double cell_count = static_cast<double>(1U << bits_per_axis);
+  std::uint32_t cells[3U];
+  for (Eigen::Index axis = 0; axis < 3; ++axis) {
+    const double size = box.max()[axis] - box.min()[axis];
+    double relative = size > 0.0 ? (point[axis] - box.min()[axis]) / size
+                                 : 0.0;
+    // Points with NaN coordinates still get a valid cell.
+    if (std::isnan(relative)) {
+      relative = 0.0;
+    }
+    cells[axis] = static_cast<std::uint32_t>(
+        std::clamp(std::floor(relative * cell_count), 0.0, cell_count - 1.0));
+  }
+  return encode(cells[0U], cells[1U], cells[2U]);
+}
+
+} // namespace Morton
+} // namespace Converter
@@ -0,0 +1,42 @@
+#ifndef MORTON_HPP
+#define MORTON_HPP
+
+#include <Eigen/Dense>
+#include <cstdint>
+
+namespace Converter {
+namespace Morton {
+
+/**
+ * @brief The largest number of bits per axis of a code.
+ */
+static constexpr unsigned int c_max_bits_per_axis = 21U;
+
+/**
+ * @brief Interleaves the bits of three coordinates into a Morton code.
+ * @details Bit i of x, y and z becomes bit 3i, 3i + 1 and 3i + 2 of the
+ * code, so points close in space tend to have close codes.
+ * @param x The x coordinate, only its lowest 21 bits are used.
+ * @param y The y coordinate, only its lowest 21 bits are used.
+ * @param z The z coordinate, only its lowest 21 bits are used.
+ * @return The 63-bit code.
+ */
+std::uint64_t encode(std::uint32_t x, std::uint32_t y, std::uint32_t z);
+
+/**
+ * @brief Quantizes a point to a grid over a box and returns the Morton code
+ * of its cell.
+ * @param point The point, points outside the box are clamped to it.
+ * @param box The box the grid is spanning.
+ * @param bits_per_axis The number of bits per axis, at most
+ * c_max_bits_per_axis, the code has three times as many bits.
+ * @return The code of the cell of the point.
+ */
+std::uint64_t encodePoint(const Eigen::Vector3d &point,
+                          const Eigen::AlignedBox3d &box,
+                          unsigned int bits_per_axis);
+
+} // namespace Morton
+} // namespace Converter
+
+#endif
@@ -0,0 +1,432 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "meshdata.hpp"
+#include "parallel.hpp"
+#include "quantized_mesh.hpp"
+#include "triangle_packet.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief The largest value of a 16-bit attribute coordinate.
+ */
+constexpr double c_max_code16 = 65535.0;
+
+/**
+ * @brief Returns a vertex of a Triangle.
+ * @param triangle The Triangle.
+ * @param vertex The index of the vertex, 0, 1 or 2.
+ * @return The vertex.
+ */
+const VertexData &getVertex(const Triangle &triangle, std::size_t vertex) {
+  return vertex == 0U ? triangle.a : (vertex == 1U ? triangle.b : triangle.c);
+}
+
+/**
+ * @brief Returns a vertex of a Triangle.
+ * @param triangle The Triangle.
+ * @param vertex The index of the vertex, 0, 1 or 2.
+ * @return The vertex.
+ */
+VertexData &getVertex(Triangle &triangle, std::size_t vertex) {
+  return vertex == 0U ? triangle.a : (vertex == 1U ? triangle.b : triangle.c);
+}
+
+/**
+ * @brief Quantizes a value to a grid.
+ * @param value The value to be quantized.
+ * @param origin The value of the grid point zero.
+ * @param scale The distance of the grid points, zero maps every value to
+ * the grid point zero.
+ * @param max_code The largest grid point.
+ * @return The nearest grid point.
+ */
+std::uint32_t quantize(double value, double origin, double scale,
+                       double max_code) {
+  if (!(scale > 0.0)) {
+    return 0U;
+  }
+  return static_cast<std::uint32_t>(
+      std::clamp(std::round((value - origin) / scale), 0.0, max_code));
+}
+
+/**
+ * @brief Returns the sign of a value, treating zero as positive.
+ */
+double signNotZero(double value) { return value < 0.0 ? -1.0 : 1.0; }
+
+/**
+ * @brief Quantizes a value in [-1, 1] to [1, 65535], so zero is exactly
+ * representable and 0 is left free.
+ */
+std::uint32_t quantizeSnorm(double value) {
+  return static_cast<std::uint32_t>(std::round(
+             (std::clamp(value, -1.0, 1.0) + 1.0) * (c_max_code16 - 1.0) /
+             2.0)) +
+         1U;
+}
+
+/**
+ * @brief Inverse of quantizeSnorm.
+ */
+double dequantizeSnorm(std::uint32_t code) {
+  return static_cast<double>(code - 1U) * 2.0 / (c_max_code16 - 1.0) - 1.0;
+}
+
+/**
+ * @brief Encodes a normal by projecting it onto an octahedron, and
+ * unfolding the octahedron into a square.
+ * @param normal The normal to be encoded.
+ * @return The two 16-bit coordinates on the square, zero for the zero
+ * normal.
+ */
+std::uint32_t encodeNormal(const Eigen::Vector4d &normal) {
+  const double length = normal.head<3>().lpNorm<1>();
+  if (!(length > 0.0)) {
+    return 0U;
+  }
+  double x = normal.x() / length;
+  double y = normal.y() / length;
+  if (normal.z() < 0.0) {
+    const double folded_x = (1.0 - std::abs(y)) * signNotZero(x);
+    y = (1.0 - std::abs(x)) * signNotZero(y);
+    x = folded_x;
+  }
+  return quantizeSnorm(x) | (quantizeSnorm(y) << 16U);
+}
+
+/**
+ * @brief Inverse of encodeNormal.
+ * @param code The encoded normal.
+ * @return The normalized normal, or zero.
+ */
+Eigen::Vector4d decodeNormal(std::uint32_t code) {
+  if (code == 0U) {
+    return Eigen::Vector4d::Zero();
+  }
+  double x = dequantizeSnorm(code & 0xFFFFU);
+  double y = dequantizeSnorm(code >> 16U);
+  const double z = 1.0 - std::abs(x) - std::abs(y);
+  if (z < 0.0) {
+    const double folded_x = (1.0 - std::abs(y)) * signNotZero(x);
+    y = (1.0 - std::abs(x)) * signNotZero(y);
+    x = folded_x;
+  }
+  Eigen::Vector4d normal{x, y, z, 0.0};
+  return normal / normal.norm();
+}
+
+} // namespace
+
+QuantizedMesh QuantizedMesh::encode(const MeshData &mesh,
+                                    unsigned int position_bits) {
+  QuantizedMesh quantized;
+  quantized.material_file = mesh.material_file;
+  quantized.triangle_count = mesh.triangles.size();
+  quantized.position_bits =
+      std::clamp(position_bits, 1U, c_max_position_bits);
+  const std::size_t vertex_count = 3U * quantized.triangle_count;
+
+  const auto &transformation = mesh.getPendingTransform();
+  const auto getPosition = [&mesh, &transformation](std::size_t vertex) {
+    return transformation.transformPoint(
+        getVertex(mesh.triangles[vertex / 3U], vertex % 3U).pos);
+  };
+
+  // The bounds of the positions and the texture coordinates are reduced per
+  // block, then the blocks are combined in order.
+  const std::size_t block_count =
+      (vertex_count + Parallel::c_block_size - 1U) / Parallel::c_block_size;
+  std::vector<Eigen::AlignedBox3d> position_boxes(block_count);
+  std::vector<Eigen::AlignedBox2d> texture_boxes(block_count);
+  std::vector<std::uint8_t> has_normals(block_count, 0U);
+  std::vector<std::uint8_t> has_textures(block_count, 0U);
+  Parallel::forEachBlock(
+      vertex_count, Parallel::c_block_size,
+      [&](std::size_t block, std::size_t begin, std::size_t end) {
+        position_boxes[block].setEmpty();
+        texture_boxes[block].setEmpty();
+        for (std::size_t i = begin; i < end; ++i) {
+          const auto &vertex = getVertex(mesh.triangles[i / 3U], i % 3U);
+          position_boxes[block].extend(getPosition(i).head<3>());
+          texture_boxes[block].extend(vertex.texture.head<2>());
+          has_normals[block] |= vertex.normal.isZero(0.0) ? 0U : 1U;
+          has_textures[block] |= vertex.texture.isZero(0.0) ? 0U : 1U;
+        }
+      });
+  Eigen::AlignedBox3d position_box;
+  position_box.setEmpty();
+  Eigen::AlignedBox2d texture_box;
+  texture_box.setEmpty();
+  for (std::size_t block = 0U; block < block_count; ++block) {
+    position_box.extend(position_boxes[block]);
+    texture_box.extend(texture_boxes[block]);
+  }
+  if (vertex_count == 0U) {
+    return quantized;
+  }
+  quantized.allocate(
+      position_box, texture_box,
+      std::find(has_normals.begin(), has_normals.end(), 1U) !=
+          has_normals.end(),
+      std::find(has_textures.begin(), has_textures.end(), 1U) !=
+          has_textures.end());
+
+  const bool is_transformed =
+      transformation.getKind() != AffineTransform::Kind::IDENTITY;
+  Parallel::forEachBlock(
+      vertex_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          const auto &vertex = getVertex(mesh.triangles[i / 3U], i % 3U);
+          Eigen::Vector4d normal = vertex.normal;
+          if (is_transformed) {
+            normal.head<3>() =
+                transformation.getNormalMatrix() * normal.head<3>();
+          }
+          quantized.encodeVertex(i, getPosition(i), normal, vertex.texture);
+        }
+      });
+  return quantized;
+}
+
+QuantizedMesh QuantizedMesh::encodeStreamed(const TriangleSource &source,
+                                            unsigned int position_bits) {
+  QuantizedMesh quantized;
+  quantized.position_bits =
+      std::clamp(position_bits, 1U, c_max_position_bits);
+
+  Eigen::AlignedBox3d position_box;
+  position_box.setEmpty();
+  Eigen::AlignedBox2d texture_box;
+  texture_box.setEmpty();
+  bool has_normals = false;
+  bool has_textures = false;
+  source([&](const Triangle &triangle) {
+    for (std::size_t i = 0U; i < 3U; ++i) {
+      const auto &vertex = getVertex(triangle, i);
+      position_box.extend(vertex.pos.head<3>());
+      texture_box.extend(vertex.texture.head<2>());
+      has_normals = has_normals || !vertex.normal.isZero(0.0);
+      has_textures = has_textures || !vertex.texture.isZero(0.0);
+    }
+    ++quantized.triangle_count;
+  });
+  if (quantized.triangle_count == 0U) {
+    return quantized;
+  }
+  quantized.allocate(position_box, texture_box, has_normals, has_textures);
+
+  // A source yielding more Triangles the second time is cut off, so the
+  // storage is never overrun.
+  std::size_t index = 0U;
+  source([&](const Triangle &triangle) {
+    if (index < 3U * quantized.triangle_count) {
+      for (std::size_t i = 0U; i < 3U; ++i) {
+        const auto &vertex = getVertex(triangle, i);
+        quantized.encodeVertex(index++, vertex.pos, vertex.normal,
+                               vertex.texture);
+      }
+    }
+  });
+  return quantized;
+}
+
+void QuantizedMesh::allocate(const Eigen::AlignedBox3d &position_box,
+                             const Eigen::AlignedBox2d &texture_box,
+                             bool has_normals, bool has_textures) {
+  const std::size_t vertex_count = 3U * triangle_count;
+  const double max_position_code =
+      static_cast<double>((1U << position_bits) - 1U);
+  position_origin = position_box.min();
+  position_scale = position_box.sizes() / max_position_code;
+  if (position_bits > 16U) {
+    positions21.resize(vertex_count);
+  } else {
+    positions16.resize(3U * vertex_count);
+  }
+  if (has_normals) {
+    normals.resize(vertex_count);
+  }
+  if (has_textures) {
+    texture_origin = texture_box.min();
+    texture_scale = texture_box.sizes() / c_max_code16;
+    texture_coordinates.resize(2U * vertex_count);
+  }
+}
+
+void QuantizedMesh::encodeVertex(std::size_t index,
+                                 const Eigen::Vector4d &position,
+                                 const Eigen::Vector4d &normal,
+                                 const Eigen::Vector4d &texture) {
+  const double max_position_code =
+      static_cast<double>((1U << position_bits) - 1U);
+  std::uint64_t cells[3U];
+  for (Eigen::Index axis = 0; axis < 3; ++axis) {
+    cells[axis] = quantize(position[axis], position_origin[axis],
+                           position_scale[axis], max_position_code);
+  }
+  if (position_bits > 16U) {
+    positions21[index] = cells[0U] | (cells[1U] << c_max_position_bits) |
+                         (cells[2U] << (2U * c_max_position_bits));
+  } else {
+    for (std::size_t axis = 0U; axis < 3U; ++axis) {
+      positions16[3U * index + axis] = static_cast<std::uint16_t>(cells[axis]);
+    }
+  }
+
+  if (!normals.empty()) {
+    normals[index] = encodeNormal(normal);
+  }
+  if (!texture_coordinates.empty()) {
+    for (std::size_t axis = 0U; axis < 2U; ++axis) {
+      texture_coordinates[2U * index + axis] = static_cast<std::uint16_t>(
+          quantize(texture[axis], texture_origin[axis], texture_scale[axis],
+                   c_max_code16));
+    }
+  }
+}
+
+double QuantizedMesh::getMaxPositionError() const {
+  return position_scale.norm() / 2.0;
+}
+
+double QuantizedMesh::getMaxTextureError() const {
+  return texture_scale.maxCoeff() / 2.0;
+}
+
+std::size_t QuantizedMesh::getMemoryUsage() const {
+  return positions16.size() * sizeof(std::uint16_t) +
+         positions21.size() * sizeof(std::uint64_t) +
+         normals.size() * sizeof(std::uint32_t) +
+         texture_coordinates.size() * sizeof(std::uint16_t);
+}
+
+Eigen::Vector4d QuantizedMesh::getPosition(std::size_t vertex) const {
+  Eigen::Vector3d cells;
+  if (positions21.empty()) {
+    for (Eigen::Index axis = 0; axis < 3; ++axis) {
+      cells[axis] = positions16[3U * vertex + axis];
+    }
+  } else {
+    constexpr std::uint64_t mask = (1U << c_max_position_bits) - 1U;
+    const std::uint64_t packed = positions21[vertex];
+    for (Eigen::Index axis = 0; axis < 3; ++axis) {
+      cells[axis] = static_cast<double>(
+          (packed >> (axis * c_max_position_bits)) & mask);
+    }
+  }
+  Eigen::Vector4d position{0.0, 0.0, 0.0, 1.0};
+  position.head<3>() =
+      position_origin + cells.cwiseProduct(position_scale);
+  return position;
+}
+
+Triangle QuantizedMesh::getTriangle(std::size_t index) const {
+  Triangle triangle;
+  for (std::size_t i = 0U; i < 3U; ++i) {
+    const std::size_t vertex_index = 3U * index + i;
+    auto &vertex = getVertex(triangle, i);
+    vertex.pos = getPosition(vertex_index);
+    if (!normals.empty()) {
+      vertex.normal = decodeNormal(normals[vertex_index]);
+    }
+    if (!texture_coordinates.empty()) {
+      for (Eigen::Index axis = 0; axis < 2; ++axis) {
+        vertex.texture[axis] =
+            texture_origin[axis] +
+            texture_coordinates[2U * vertex_index + axis] *
+                texture_scale[axis];
+      }
+    }
+  }
+  return triangle;
+}
+
+void QuantizedMesh::loadPacket(TrianglePacket &packet, std::size_t first,
+                               std::size_t end) const {
+  packet.count = std::min(TrianglePacket::c_width, end - first);
+  constexpr std::uint64_t mask = (1U << c_max_position_bits) - 1U;
+
+  std::size_t vertex = 0U;
+  for (auto *lanes : {&packet.a, &packet.b, &packet.c}) {
+    // Gathers the integer coordinates, then decodes all lanes at once.
+    for (std::size_t lane = 0U; lane < TrianglePacket::c_width; ++lane) {
+      const std::size_t index = 3U * (first + lane) + vertex;
+      for (std::size_t axis = 0U; axis < 3U; ++axis) {
+        if (lane >= packet.count) {
+          (*lanes)[axis][lane] = 0.0;
+        } else if (positions21.empty()) {
+          (*lanes)[axis][lane] = positions16[3U * index + axis];
+        } else {
+          (*lanes)[axis][lane] = static_cast<double>(
+              (positions21[index] >> (axis * c_max_position_bits)) & mask);
+        }
+      }
+    }
+    for (Eigen::Index axis = 0; axis < 3; ++axis) {
+      (*lanes)[axis] = (*lanes)[axis] * position_scale[axis] +
+                       position_origin[axis];
+    }
+    for (std::size_t lane = packet.count; lane < TrianglePacket::c_width;
+         ++lane) {
+      for (std::size_t axis = 0U; axis < 3U; ++axis) {
+        (*lanes)[axis][lane] = 0.0;
+      }
+    }
+    ++vertex;
+  }
+}
+
+double QuantizedMesh::calculateSurfaceArea() const {
+  return Parallel::reproducibleSum(
+      triangle_count,
+      [this](std::size_t begin, std::size_t end, double *values) {
+        TrianglePacket packet;
+        for (std::size_t first = begin; first < end;
+             first += TrianglePacket::c_width) {
+          loadPacket(packet, first, end);
+          const auto areas = packet.getAreas();
+          std::copy_n(areas.data(), packet.count, values + (first - begin));
+        }
+      });
+}
+
+double QuantizedMesh::calculateVolume() const {
+  const double volume = Parallel::reproducibleSum(
+      triangle_count,
+      [this](std::size_t begin, std::size_t end, double *values) {
+        TrianglePacket packet;
+        for (std::size_t first = begin; first < end;
+             first += TrianglePacket::c_width) {
+          loadPacket(packet, first, end);
+          const auto volumes = packet.getSignedVolumes();
+          std::copy_n(volumes.data(), packet.count, values + (first - begin));
+        }
+      });
+  return std::abs(volume);
+}
+
+MeshData QuantizedMesh::toMeshData() const {
+  MeshData mesh;
+  mesh.material_file = material_file;
+  mesh.triangles.resize(triangle_count);
+  Parallel::forEachBlock(
+      triangle_count, Parallel::c_block_size,
+      [this, &mesh](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          mesh.triangles[i] = getTriangle(i);
+        }
+      });
+  return mesh;
+}
+
+} // namespace Converter
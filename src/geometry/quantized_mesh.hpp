@@ -0,0 +1,244 @@
+#ifndef QUANTIZED_MESH_HPP
+#define QUANTIZED_MESH_HPP
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "triangle.hpp"
+
+namespace Converter {
+
+class MeshData;
+class TrianglePacket;
+
+/**
+ * @brief Compact, read-only storage of a triangle soup with quantized
+ * attributes.
+ * @details The positions are stored as integers on a grid spanning the
+ * bounding box of the mesh, either as three 16-bit integers or packed into a
+ * single 64-bit integer with 21 bits per axis. The normals are stored with
+ * the octahedral encoding in two 16-bit integers, and the texture
+ * coordinates as two 16-bit integers relative to their bounding rectangle.
+ * Normals and texture coordinates are only stored if the mesh has any.
+ * A 16-bit position takes 6 bytes instead of the 32 bytes of an
+ * Eigen::Vector4d, a 21-bit one 8 bytes. The positions are decoded 8
+ * Triangles at a time into TrianglePackets, so the area, the volume and the
+ * writers work on the compact data directly.
+ */
+class QuantizedMesh {
+public:
+  /**
+   * @brief The default number of bits per position coordinate.
+   */
+  static constexpr unsigned int c_default_position_bits = 16U;
+  /**
+   * @brief The largest number of bits per position coordinate.
+   */
+  static constexpr unsigned int c_max_position_bits = 21U;
+  /**
+   * @brief The largest angle between a normal and its decoded value, in
+   * radians.
+   */
+  static constexpr double c_max_normal_error = 1e-4;
+
+  /**
+   * @brief Quantizes the Triangles of a mesh.
+   * @note The pending transformation of the mesh is applied to the positions
+   * and the normals before quantizing them.
+   * @param mesh The mesh to be quantized.
+   * @param position_bits The number of bits per position coordinate,
+   * between 1 and c_max_position_bits, at most 16 uses the 16-bit storage.
+   * @return The quantized mesh.
+   */
+  static QuantizedMesh encode(const MeshData &mesh,
+                              unsigned int position_bits =
+                                  c_default_position_bits);
+
+  /**
+   * @brief Function receiving the Triangles of a mesh one by one.
+   */
+  using TriangleCallback = std::function<void(const Triangle &)>;
+  /**
+   * @brief Function passing every Triangle of a mesh to a callback, in the
+   * same order on every call, for example by reading a file.
+   */
+  using TriangleSource = std::function<void(const TriangleCallback &)>;
+
+  /**
+   * @brief Quantizes the Triangles of a mesh without storing it at full
+   * precision.
+   * @details The source is called twice, first to find the bounds of the
+   * attributes and the number of Triangles, then to quantize the Triangles
+   * into storage of the final size, so the peak memory is that of the
+   * result. Unlike the encoding of a MeshData it runs on a single thread.
+   * @note The Triangles are expected to be transformed already.
+   * @param source The function passing the Triangles.
+   * @param position_bits The number of bits per position coordinate,
+   * between 1 and c_max_position_bits, at most 16 uses the 16-bit storage.
+   * @return The quantized mesh, the same as encoding a MeshData holding the
+   * Triangles.
+   */
+  static QuantizedMesh encodeStreamed(const TriangleSource &source,
+                                      unsigned int position_bits =
+                                          c_default_position_bits);
+
+  /**
+   * @brief Returns the number of Triangles.
+   * @return The number of Triangles.
+   */
+  std::size_t size() const { return triangle_count; }
+
+  /**
+   * @brief Returns the name of the material file of the mesh.
+   * @return The name of the material file, empty if there is none.
+   */
+  const std::string &getMaterialFile() const { return material_file; }
+
+  /**
+   * @brief Returns the largest distance between a position and its decoded
+   * value.
+   * @return Half of the diagonal of a grid cell.
+   */
+  double getMaxPositionError() const;
+
+  /**
+   * @brief Returns the largest difference between a texture coordinate and
+   * its decoded value.
+   * @return Half of the larger side of a texture grid cell.
+   */
+  double getMaxTextureError() const;
+
+  /**
+   * @brief Returns the number of bytes used by the quantized attributes.
+   * @return The size of the attribute storage.
+   */
+  std::size_t getMemoryUsage() const;
+
+  /**
+   * @brief Decodes every attribute of a Triangle.
+   * @param index The index of the Triangle.
+   * @return The decoded Triangle.
+   */
+  Triangle getTriangle(std::size_t index) const;
+
+  /**
+   * @brief Decodes the positions of the next Triangles into a packet.
+   * @details The integers are gathered into the lanes, then scaled and
+   * offset for all lanes at once.
+   * @param packet The packet to be loaded, the unused lanes are set to
+   * zero.
+   * @param first The index of the first Triangle to load.
+   * @param end The index after the last Triangle that may be loaded, at most
+   * TrianglePacket::c_width Triangles are loaded.
+   */
+  void loadPacket(TrianglePacket &packet, std::size_t first,
+                  std::size_t end) const;
+
+  /**
+   * @brief Calculates the surface area of the mesh, the same way as
+   * MeshData::calculateSurfaceArea.
+   * @return The surface area of the decoded mesh.
+   */
+  double calculateSurfaceArea() const;
+
+  /**
+   * @brief Calculates the volume of the mesh, the same way as
+   * MeshData::calculateVolume.
+   * @return The volume of the decoded mesh.
+   */
+  double calculateVolume() const;
+
+  /**
+   * @brief Decodes the whole mesh.
+   * @return The mesh holding the decoded Triangles.
+   */
+  MeshData toMeshData() const;
+
+private:
+  /**
+   * @brief Sets up the grids and allocates the storage of triangle_count
+   * Triangles.
+   * @param position_box The bounds of the positions.
+   * @param texture_box The bounds of the texture coordinates.
+   * @param has_normals True if any vertex has a normal.
+   * @param has_textures True if any vertex has texture coordinates.
+   */
+  void allocate(const Eigen::AlignedBox3d &position_box,
+                const Eigen::AlignedBox2d &texture_box, bool has_normals,
+                bool has_textures);
+
+  /**
+   * @brief Quantizes the attributes of a vertex into the storage.
+   * @param index The index of the vertex, three per Triangle.
+   * @param position The transformed position.
+   * @param normal The transformed normal.
+   * @param texture The texture coordinates.
+   */
+  void encodeVertex(std::size_t index, const Eigen::Vector4d &position,
+                    const Eigen::Vector4d &normal,
+                    const Eigen::Vector4d &texture);
+
+  /**
+   * @brief Decodes the position of a vertex.
+   * @param vertex The index of the vertex, three per Triangle.
+   * @return The decoded position.
+   */
+  Eigen::Vector4d getPosition(std::size_t vertex) const;
+
+  /**
+   * @brief Holds the name of the material file if there is one.
+   */
+  std::string material_file;
+  /**
+   * @brief Holds the number of Triangles.
+   */
+  std::size_t triangle_count = 0U;
+  /**
+   * @brief Holds the number of bits per position coordinate.
+   */
+  unsigned int position_bits = c_default_position_bits;
+  /**
+   * @brief Holds the position of the grid point zero.
+   */
+  Eigen::Vector3d position_origin = Eigen::Vector3d::Zero();
+  /**
+   * @brief Holds the size of a grid cell along each axis.
+   */
+  Eigen::Vector3d position_scale = Eigen::Vector3d::Zero();
+  /**
+   * @brief Holds three coordinates per vertex, if position_bits is at most
+   * 16.
+   */
+  std::vector<std::uint16_t> positions16;
+  /**
+   * @brief Holds one packed position per vertex, if position_bits is above
+   * 16.
+   */
+  std::vector<std::uint64_t> positions21;
+  /**
+   * @brief Holds one octahedral normal per vertex, zero marks the zero
+   * normals. Empty if the mesh has no normals.
+   */
+  std::vector<std::uint32_t> normals;
+  /**
+   * @brief Holds the texture coordinate zero.
+   */
+  Eigen::Vector2d texture_origin = Eigen::Vector2d::Zero();
+  /**
+   * @brief Holds the size of a texture grid cell along each axis.
+   */
+  Eigen::Vector2d texture_scale = Eigen::Vector2d::Zero();
+  /**
+   * @brief Holds two coordinates per vertex, empty if the mesh has no
+   * texture coordinates.
+   */
+  std::vector<std::uint16_t> texture_coordinates;
+};
+
+} // namespace Converter
+
+#endif
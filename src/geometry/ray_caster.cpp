@@ -0,0 +1,184 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "bvh.hpp"
+#include "parallel.hpp"
+#include "ray_caster.hpp"
+#include "triangle_packet.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief The number of rays a task of castRays processes.
+ */
+constexpr std::size_t c_ray_block_size = 64U;
+
+/**
+ * @brief Scales the exit distance of the box tests, so the rounding errors of
+ * the slab test can't cull a Triangle the watertight test would hit.
+ */
+constexpr double c_box_exit_scale =
+    1.0 + 2.0 * 3.0 * std::numeric_limits<double>::epsilon() /
+              (1.0 - 3.0 * std::numeric_limits<double>::epsilon());
+
+/**
+ * @brief Intersects a ray with an axis aligned box.
+ * @param box The box to be tested.
+ * @param origin The starting point of the ray.
+ * @param inverse_direction The component-wise reciprocal of the direction.
+ * @param max_t The largest distance to look for hits at.
+ * @return The distance the ray enters the box at, if it hits it before
+ * max_t.
+ */
+std::optional<double> intersectBox(const Eigen::AlignedBox3d &box,
+                                   const Eigen::Vector3d &origin,
+                                   const Eigen::Vector3d &inverse_direction,
+                                   double max_t) {
+  double entry = 0.0;
+  double exit = max_t;
+  for (Eigen::Index axis = 0; axis < 3; ++axis) {
+    // With a zero direction component the near and far distances are
+    // infinities of the same sign outside the slab, and opposite inside.
+    double near = (box.min()[axis] - origin[axis]) * inverse_direction[axis];
+    double far = (box.max()[axis] - origin[axis]) * inverse_direction[axis];
+    if (std::isnan(near) || std::isnan(far)) {
+      // The origin is on the boundary of the slab and parallel to it.
+      continue;
+    }
+    if (near > far) {
+      std::swap(near, far);
+    }
+    entry = std::max(entry, near);
+    exit = std::min(exit, far * c_box_exit_scale);
+    if (entry > exit) {
+      return {};
+    }
+  }
+  return entry;
+}
+
+} // namespace
+
+RayCaster::RayCaster(const std::vector<Triangle> &triangles)
+    : bvh(triangles, static_cast<std::uint32_t>(TrianglePacket::c_width)) {
+  node_packets.resize(bvh.nodes.size(), 0U);
+  for (std::size_t i = 0U; i < bvh.nodes.size(); ++i) {
+    const auto &node = bvh.nodes[i];
+    if (node.isLeaf()) {
+      node_packets[i] = static_cast<std::uint32_t>(leaf_packets.size());
+      leaf_packets.emplace_back();
+      leaf_packets.back().load(triangles, bvh.triangle_indices, node.first,
+                               node.first + node.count);
+    }
+  }
+}
+
+template <bool is_any_hit>
+std::optional<RayCaster::Hit>
+RayCaster::traverse(const Eigen::Vector4d &origin,
+                    const Eigen::Vector4d &direction, double max_t) const {
+  if (bvh.empty()) {
+    return {};
+  }
+
+  const TrianglePacket::Ray ray(origin, direction);
+  const Eigen::Vector3d ray_origin = origin.head<3>();
+  const Eigen::Vector3d inverse_direction =
+      direction.head<3>().cwiseInverse();
+
+  std::optional<Hit> closest;
+  double closest_t = max_t;
+
+  // The stack holds the nodes with the distance the ray enters them at.
+  std::vector<std::pair<std::uint32_t, double>> stack;
+  if (const auto entry =
+          intersectBox(bvh.nodes[0U].box, ray_origin, inverse_direction,
+                       closest_t)) {
+    stack.emplace_back(0U, *entry);
+  }
+
+  while (!stack.empty()) {
+    const auto [node_index, entry] = stack.back();
+    stack.pop_back();
+    if (entry > closest_t) {
+      continue;
+    }
+
+    const auto &node = bvh.nodes[node_index];
+    if (node.isLeaf()) {
+      const auto intersections =
+          leaf_packets[node_packets[node_index]].intersect(ray);
+      for (std::uint32_t lane = 0U; lane < node.count; ++lane) {
+        if (intersections.inclusive_hit[lane] &&
+            intersections.t[lane] <= closest_t) {
+          closest_t = intersections.t[lane];
+          closest = Hit{intersections.t[lane], intersections.u[lane],
+                        intersections.v[lane],
+                        bvh.triangle_indices[node.first + lane]};
+          if constexpr (is_any_hit) {
+            return closest;
+          }
+        }
+      }
+      continue;
+    }
+
+    const auto left_entry = intersectBox(bvh.nodes[node.first].box,
+                                         ray_origin, inverse_direction,
+                                         closest_t);
+    const auto right_entry = intersectBox(bvh.nodes[node.first + 1U].box,
+                                          ray_origin, inverse_direction,
+                                          closest_t);
+    // The nearer child is pushed last, so it is visited first.
+    if (left_entry && right_entry && *left_entry < *right_entry) {
+      stack.emplace_back(node.first + 1U, *right_entry);
+      stack.emplace_back(node.first, *left_entry);
+    } else {
+      if (left_entry) {
+        stack.emplace_back(node.first, *left_entry);
+      }
+      if (right_entry) {
+        stack.emplace_back(node.first + 1U, *right_entry);
+      }
+    }
+  }
+  return closest;
+}
+
+std::optional<RayCaster::Hit>
+RayCaster::castRay(const Eigen::Vector4d &origin,
+                   const Eigen::Vector4d &direction, double max_t) const {
+  return traverse<false>(origin, direction, max_t);
+}
+
+bool RayCaster::isOccluded(const Eigen::Vector4d &origin,
+                           const Eigen::Vector4d &direction,
+                           double max_t) const {
+  return traverse<true>(origin, direction, max_t).has_value();
+}
+
+std::vector<std::optional<RayCaster::Hit>>
+RayCaster::castRays(const std::vector<Eigen::Vector4d> &origins,
+                    const std::vector<Eigen::Vector4d> &directions) const {
+  const std::size_t ray_count = std::min(origins.size(), directions.size());
+  std::vector<std::optional<Hit>> hits(ray_count);
+  Parallel::forEachBlock(
+      ray_count, c_ray_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          hits[i] = castRay(origins[i], directions[i]);
+        }
+      });
+  return hits;
+}
+
+} // namespace Converter
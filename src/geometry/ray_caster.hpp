@@ -0,0 +1,128 @@
+#ifndef RAY_CASTER_HPP
+#define RAY_CASTER_HPP
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "bvh.hpp"
+#include "triangle.hpp"
+#include "triangle_packet.hpp"
+
+namespace Converter {
+
+/**
+ * @brief Acceleration structure for casting rays against the Triangles of a
+ * mesh.
+ * @details The Triangles are grouped into a Bvh whose leaves hold at most
+ * TrianglePacket::c_width Triangles, and every leaf is stored as a single
+ * TrianglePacket, so a leaf is tested with one call of the watertight packet
+ * intersection.
+ */
+class RayCaster {
+public:
+  /**
+   * @brief The closest intersection of a ray and the mesh.
+   * @param t The distance along the ray in units of the direction vector.
+   * @param u The barycentric coordinate of the second vertex at the hit.
+   * @param v The barycentric coordinate of the third vertex at the hit.
+   * @param triangle_index The index of the hit Triangle in the mesh.
+   */
+  struct Hit {
+    double t;
+    double u;
+    double v;
+    std::uint32_t triangle_index;
+  };
+
+  /**
+   * @brief Default constructor, creates a caster without Triangles.
+   */
+  RayCaster() = default;
+
+  /**
+   * @brief Builds the acceleration structure over the Triangles.
+   * @param triangles The Triangles rays should be cast against.
+   */
+  explicit RayCaster(const std::vector<Triangle> &triangles);
+
+  /**
+   * @brief Returns the number of Triangles the caster was built over.
+   * @return The number of Triangles.
+   */
+  std::size_t size() const { return bvh.triangle_indices.size(); }
+
+  /**
+   * @brief Finds the closest intersection of a ray and the mesh.
+   * @param origin The point in which the ray starts.
+   * @param direction The direction of the ray, does not have to be
+   * normalized but must not be zero.
+   * @param max_t The largest distance to look for hits at, in units of the
+   * direction vector.
+   * @return The closest hit if there is one.
+   */
+  std::optional<Hit>
+  castRay(const Eigen::Vector4d &origin, const Eigen::Vector4d &direction,
+          double max_t = std::numeric_limits<double>::infinity()) const;
+
+  /**
+   * @brief Determines if a ray hits anything.
+   * @details Stops at the first hit found, so it is cheaper than castRay
+   * when only the visibility matters.
+   * @param origin The point in which the ray starts.
+   * @param direction The direction of the ray, does not have to be
+   * normalized but must not be zero.
+   * @param max_t The largest distance to look for hits at, in units of the
+   * direction vector.
+   * @return True if the ray hits a Triangle, otherwise false.
+   */
+  bool isOccluded(const Eigen::Vector4d &origin,
+                  const Eigen::Vector4d &direction,
+                  double max_t = std::numeric_limits<double>::infinity()) const;
+
+  /**
+   * @brief Finds the closest intersection of many rays, using multiple
+   * threads.
+   * @param origins The starting points of the rays.
+   * @param directions The directions of the rays, the same number as
+   * origins.
+   * @return The closest hit of every ray, in the order of the rays.
+   */
+  std::vector<std::optional<Hit>>
+  castRays(const std::vector<Eigen::Vector4d> &origins,
+           const std::vector<Eigen::Vector4d> &directions) const;
+
+private:
+  /**
+   * @brief Walks the hierarchy along a ray.
+   * @tparam is_any_hit If true, the traversal stops at the first hit.
+   * @param origin The point in which the ray starts.
+   * @param direction The direction of the ray.
+   * @param max_t The largest distance to look for hits at.
+   * @return The closest hit, or the first one found for any-hit queries.
+   */
+  template <bool is_any_hit>
+  std::optional<Hit> traverse(const Eigen::Vector4d &origin,
+                              const Eigen::Vector4d &direction,
+                              double max_t) const;
+
+  /**
+   * @brief The hierarchy of the Triangles.
+   */
+  Bvh bvh;
+  /**
+   * @brief The Triangles of the leaves, the i-th leaf in node order is the
+   * i-th packet.
+   */
+  std::vector<TrianglePacket> leaf_packets;
+  /**
+   * @brief The index of the packet of every node, only valid for leaves.
+   */
+  std::vector<std::uint32_t> node_packets;
+};
+
+} // namespace Converter
+
+#endif
@@ -0,0 +1,377 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "meshdata.hpp"
+#include "parallel.hpp"
+#include "slice_stack.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief The number of Triangles a task transforms and sorts.
+ */
+constexpr std::size_t c_chunk_size = std::size_t{1U} << 16U;
+
+/**
+ * @brief Marks the end of a list of segments.
+ */
+constexpr std::uint32_t c_none = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief The transformed vertex positions of a Triangle.
+ */
+using Corners = std::array<Eigen::Vector3d, 3U>;
+
+/**
+ * @brief A directed segment of a contour.
+ */
+using Segment = std::pair<Eigen::Vector2d, Eigen::Vector2d>;
+
+/**
+ * @brief Mixes the bit patterns of the coordinates of a point into a hash
+ * value.
+ * @param point The point to be hashed.
+ * @return The hash of the point, equal for -0.0 and 0.0.
+ */
+std::uint64_t hashPoint(const Eigen::Vector2d &point) {
+  std::uint64_t hash = 0x9E3779B97F4A7C15ULL;
+  for (Eigen::Index axis = 0; axis < 2; ++axis) {
+    // Adding zero turns -0.0 into 0.0, which compare equal.
+    const double coordinate = point[axis] + 0.0;
+    std::uint64_t bits;
+    std::memcpy(&bits, &coordinate, sizeof(double));
+    hash ^= bits + 0x9E3779B97F4A7C15ULL + (hash << 6U) + (hash >> 2U);
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 31U;
+  }
+  return hash;
+}
+
+/**
+ * @brief Intersects an edge crossing a plane with the plane.
+ * @details The intersection is interpolated from the lower end of the edge,
+ * so both Triangles sharing the edge get the same bits, and it is exactly
+ * the upper end if that lies on the plane.
+ * @param start One end of the edge.
+ * @param end The other end of the edge, on the other side of the plane.
+ * @param height The z coordinate of the plane.
+ * @return The x and y coordinates of the intersection.
+ */
+Eigen::Vector2d intersectEdge(const Eigen::Vector3d &start,
+                              const Eigen::Vector3d &end, double height) {
+  const auto &low = start.z() < end.z() ? start : end;
+  const auto &high = start.z() < end.z() ? end : start;
+  if (high.z() == height) {
+    return high.head<2>();
+  }
+  const double t = (height - low.z()) / (high.z() - low.z());
+  return low.head<2>() + t * (high.head<2>() - low.head<2>());
+}
+
+/**
+ * @brief Cuts a Triangle with a plane.
+ * @details The segment runs from the edge leaving the vertex alone on its
+ * side of the plane to the edge entering it if that vertex is above the
+ * plane, and the other way around if it is below. This orients it
+ * counter-clockwise around the inside, seen from above.
+ * @param corners The transformed vertex positions of the Triangle.
+ * @param height The z coordinate of the plane.
+ * @param segment Set to the cut if there is one.
+ * @return True if the Triangle crosses the plane with a segment of nonzero
+ * length.
+ */
+bool cutTriangle(const Corners &corners, double height, Segment &segment) {
+  std::array<bool, 3U> is_above;
+  for (std::size_t i = 0U; i < 3U; ++i) {
+    is_above[i] = corners[i].z() >= height;
+  }
+  if (is_above[0U] == is_above[1U] && is_above[1U] == is_above[2U]) {
+    return false;
+  }
+  std::size_t alone = 0U;
+  if (is_above[1U] != is_above[0U] && is_above[1U] != is_above[2U]) {
+    alone = 1U;
+  } else if (is_above[2U] != is_above[0U] && is_above[2U] != is_above[1U]) {
+    alone = 2U;
+  }
+  const auto &vertex = corners[alone];
+  const auto &next = corners[(alone + 1U) % 3U];
+  const auto &previous = corners[(alone + 2U) % 3U];
+  segment.first = intersectEdge(vertex, next, height);
+  segment.second = intersectEdge(previous, vertex, height);
+  if (!is_above[alone]) {
+    std::swap(segment.first, segment.second);
+  }
+  return segment.first != segment.second;
+}
+
+/**
+ * @brief Stitches the segments of a layer into contours.
+ * @details The segments are looked up by their start points. The open
+ * polylines are followed from the segments nothing leads to first, so they
+ * are not split, then the remaining segments form the closed ones.
+ * @param segments The segments of the layer.
+ * @return The contours of the layer.
+ */
+std::vector<SliceStack::Contour>
+stitchSegments(const std::vector<Segment> &segments) {
+  // An open addressing hash table of the start points, every slot holds
+  // the first of the segments starting at a point, the others are linked
+  // into a list in the order of the segments.
+  std::size_t capacity = 16U;
+  while (capacity < 2U * segments.size()) {
+    capacity *= 2U;
+  }
+  const std::size_t mask = capacity - 1U;
+  std::vector<std::uint32_t> slots(capacity, c_none);
+  const auto findSlot = [&segments, &slots,
+                         mask](const Eigen::Vector2d &point) {
+    std::size_t slot = hashPoint(point) & mask;
+    while (slots[slot] != c_none && segments[slots[slot]].first != point) {
+      slot = (slot + 1U) & mask;
+    }
+    return slot;
+  };
+  std::vector<std::uint32_t> next_segments(segments.size(), c_none);
+  for (std::size_t i = segments.size(); i-- > 0U;) {
+    auto &first = slots[findSlot(segments[i].first)];
+    next_segments[i] = first;
+    first = static_cast<std::uint32_t>(i);
+  }
+  std::vector<std::uint8_t> is_reached(segments.size(), 0U);
+  for (const auto &segment : segments) {
+    for (std::uint32_t next = slots[findSlot(segment.second)]; next != c_none;
+         next = next_segments[next]) {
+      is_reached[next] = 1U;
+    }
+  }
+
+  std::vector<SliceStack::Contour> contours;
+  std::vector<std::uint8_t> is_used(segments.size(), 0U);
+  const auto follow = [&](std::size_t first) {
+    SliceStack::Contour contour;
+    contour.points.push_back(segments[first].first);
+    std::size_t current = first;
+    while (true) {
+      is_used[current] = 1U;
+      const auto &end = segments[current].second;
+      if (end == segments[first].first) {
+        break;
+      }
+      contour.points.push_back(end);
+      std::uint32_t next = slots[findSlot(end)];
+      while (next != c_none && is_used[next] != 0U) {
+        next = next_segments[next];
+      }
+      if (next == c_none) {
+        contour.is_closed = false;
+        break;
+      }
+      current = next;
+    }
+    contours.push_back(std::move(contour));
+  };
+  for (std::size_t i = 0U; i < segments.size(); ++i) {
+    if (is_reached[i] == 0U && is_used[i] == 0U) {
+      follow(i);
+    }
+  }
+  for (std::size_t i = 0U; i < segments.size(); ++i) {
+    if (is_used[i] == 0U) {
+      follow(i);
+    }
+  }
+  return contours;
+}
+
+} // namespace
+
+SliceStack SliceStack::slice(const MeshData &mesh, double layer_height) {
+  SliceStack stack;
+  if (mesh.triangles.empty()) {
+    return stack;
+  }
+
+  // Transforms the positions once, they are read by every layer a Triangle
+  // spans.
+  const std::size_t triangle_count = mesh.triangles.size();
+  const std::size_t chunk_count =
+      (triangle_count + c_chunk_size - 1U) / c_chunk_size;
+  const auto &transformation = mesh.getPendingTransform();
+  std::vector<Corners> corners(triangle_count);
+  std::vector<Eigen::AlignedBox3d> chunk_boxes(chunk_count);
+  Parallel::forEachBlock(
+      triangle_count, c_chunk_size,
+      [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto &chunk_box = chunk_boxes[chunk];
+        chunk_box.setEmpty();
+        for (std::size_t i = begin; i < end; ++i) {
+          const auto &triangle = mesh.triangles[i];
+          std::size_t corner = 0U;
+          for (const auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+            const Eigen::Vector3d position =
+                transformation.transformPoint(vertex->pos).head<3>();
+            corners[i][corner++] = position;
+            if (position.allFinite()) {
+              chunk_box.extend(position);
+            }
+          }
+        }
+      });
+  for (const auto &chunk_box : chunk_boxes) {
+    stack.box.extend(chunk_box);
+  }
+  if (stack.box.isEmpty()) {
+    return stack;
+  }
+
+  // The planes are in the middle of the layers, the last one below the top
+  // of the mesh.
+  const double bottom = stack.box.min().z();
+  const double layer_count_estimate =
+      std::ceil(stack.box.sizes().z() / layer_height - 0.5);
+  const std::size_t layer_count =
+      layer_count_estimate > 0.0
+          ? static_cast<std::size_t>(layer_count_estimate)
+          : 0U;
+  stack.layers.resize(layer_count);
+  for (std::size_t layer = 0U; layer < layer_count; ++layer) {
+    stack.layers[layer].height =
+        bottom + (static_cast<double>(layer) + 0.5) * layer_height;
+  }
+  if (layer_count == 0U) {
+    return stack;
+  }
+
+  // The layers whose planes a Triangle may cross, widened by one layer on
+  // both sides against rounding, the exact test is done by cutTriangle.
+  const auto getLayerRange = [bottom, layer_height,
+                          layer_count](const Corners &triangle) {
+    const auto [min_z, max_z] = std::minmax(
+        {triangle[0U].z(), triangle[1U].z(), triangle[2U].z()});
+    const auto max_layer = static_cast<double>(layer_count - 1U);
+    const double first = std::clamp(
+        std::floor((min_z - bottom) / layer_height - 0.5), 0.0, max_layer);
+    const double last = std::clamp(
+        std::floor((max_z - bottom) / layer_height - 0.5) + 1.0, 0.0,
+        max_layer);
+    // Not a number fails both comparisons and yields no layers.
+    return first <= last ? std::make_pair(static_cast<std::size_t>(first),
+                                          static_cast<std::size_t>(last) + 1U)
+                         : std::make_pair(std::size_t{0U}, std::size_t{0U});
+  };
+
+  // Sorts the Triangles into the layers they span, counting the Triangles
+  // of every chunk and layer first.
+  std::vector<std::size_t> offsets(chunk_count * layer_count, 0U);
+  const auto forEachLayerOfTriangle = [&](const auto &func) {
+    Parallel::forEachBlock(
+        triangle_count, c_chunk_size,
+        [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i) {
+            const auto range = getLayerRange(corners[i]);
+            for (std::size_t layer = range.first; layer < range.second;
+                 ++layer) {
+              func(chunk * layer_count + layer, i);
+            }
+          }
+        });
+  };
+  forEachLayerOfTriangle(
+      [&offsets](std::size_t slot, std::size_t) { ++offsets[slot]; });
+  std::vector<std::size_t> layer_offsets(layer_count + 1U, 0U);
+  std::size_t position = 0U;
+  for (std::size_t layer = 0U; layer < layer_count; ++layer) {
+    layer_offsets[layer] = position;
+    for (std::size_t chunk = 0U; chunk < chunk_count; ++chunk) {
+      const std::size_t count = offsets[chunk * layer_count + layer];
+      offsets[chunk * layer_count + layer] = position;
+      position += count;
+    }
+  }
+  layer_offsets[layer_count] = position;
+  std::vector<std::uint32_t> layer_triangles(position);
+  forEachLayerOfTriangle([&](std::size_t slot, std::size_t i) {
+    layer_triangles[offsets[slot]++] = static_cast<std::uint32_t>(i);
+  });
+  offsets = std::vector<std::size_t>();
+
+  Parallel::forEachBlock(
+      layer_count, 1U, [&](std::size_t layer, std::size_t, std::size_t) {
+        auto &result = stack.layers[layer];
+        std::vector<Segment> segments;
+        segments.reserve(layer_offsets[layer + 1U] - layer_offsets[layer]);
+        Segment segment;
+        for (std::size_t i = layer_offsets[layer];
+             i < layer_offsets[layer + 1U]; ++i) {
+          if (cutTriangle(corners[layer_triangles[i]], result.height,
+                          segment)) {
+            segments.push_back(segment);
+          }
+        }
+        result.contours = stitchSegments(segments);
+      });
+  return stack;
+}
+
+std::size_t SliceStack::countOpenContours() const {
+  std::size_t count = 0U;
+  for (const auto &layer : layers) {
+    for (const auto &contour : layer.contours) {
+      count += contour.is_closed ? 0U : 1U;
+    }
+  }
+  return count;
+}
+
+void SliceStack::writeSvg(std::ostream &out_stream, std::size_t layer) const {
+  const auto &contours = layers[layer].contours;
+  const auto writePath = [&out_stream, &contours](bool is_closed) {
+    for (const auto &contour : contours) {
+      if (contour.is_closed != is_closed) {
+        continue;
+      }
+      char command = 'M';
+      for (const auto &point : contour.points) {
+        out_stream << command << point.x() << ',' << point.y() << ' ';
+        command = 'L';
+      }
+      if (is_closed) {
+        out_stream << "Z ";
+      }
+    }
+  };
+
+  out_stream << std::setprecision(std::numeric_limits<double>::max_digits10);
+  const Eigen::Vector3d sizes = box.sizes();
+  out_stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+             << "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\""
+             << box.min().x() << ' ' << -box.max().y() << ' ' << sizes.x()
+             << ' ' << sizes.y() << "\" width=\"" << sizes.x()
+             << "\" height=\"" << sizes.y() << "\">\n"
+             << "<desc>Layer " << layer << " at z = " << layers[layer].height
+             << "</desc>\n"
+             // The y axis of SVG points down, the paths are mirrored.
+             << "<g transform=\"scale(1,-1)\">\n"
+             << "<path fill=\"black\" fill-rule=\"evenodd\" d=\"";
+  writePath(true);
+  out_stream << "\"/>\n"
+             << "<path fill=\"none\" stroke=\"red\" "
+                "vector-effect=\"non-scaling-stroke\" d=\"";
+  writePath(false);
+  out_stream << "\"/>\n</g>\n</svg>\n";
+}
+
+} // namespace Converter
@@ -0,0 +1,112 @@
+#ifndef SLICE_STACK_HPP
+#define SLICE_STACK_HPP
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace Converter {
+
+class MeshData;
+
+/**
+ * @brief The contours of a mesh cut by a stack of planes of constant z, as
+ * used for additive manufacturing.
+ * @details The planes are placed in the middle of layers of equal height
+ * starting at the bottom of the bounding box. The Triangles are sorted once
+ * into the layers their z extent spans with a counting sort, then the layers
+ * are processed in parallel: every Triangle crossing the plane produces a
+ * segment, and the segments are stitched into polylines by hashing their
+ * endpoints. A vertex lying exactly on a plane is treated as above it, and
+ * the intersection of a shared edge is calculated the same way for both of
+ * its Triangles, so the endpoints of neighboring segments are bit-identical
+ * and a closed mesh always produces closed contours.
+ */
+class SliceStack {
+public:
+  /**
+   * @brief The default distance of neighboring planes.
+   */
+  static constexpr double c_default_layer_height = 0.2;
+
+  /**
+   * @brief A polyline in a plane.
+   * @param points The vertices of the polyline, the first one is not
+   * repeated at the end of a closed one.
+   * @param is_closed True if the last vertex is connected to the first one.
+   * False means the mesh has a hole along the polyline.
+   */
+  struct Contour {
+    std::vector<Eigen::Vector2d> points;
+    bool is_closed = true;
+  };
+
+  /**
+   * @brief The cut of the mesh by a single plane.
+   * @param height The z coordinate of the plane.
+   * @param contours The polylines of the cut. Seen from above, the closed
+   * contours of a consistently oriented mesh run counter-clockwise around
+   * the material and clockwise around the holes.
+   */
+  struct Layer {
+    double height = 0.0;
+    std::vector<Contour> contours;
+  };
+
+  /**
+   * @brief Slices a mesh.
+   * @note The pending transformation of the mesh is applied. The result
+   * does not depend on the number of threads.
+   * @param mesh The mesh to be sliced.
+   * @param layer_height The distance of neighboring planes, should be
+   * positive.
+   * @return The contours of every layer, without layers if the mesh has no
+   * Triangles.
+   */
+  static SliceStack slice(const MeshData &mesh,
+                          double layer_height = c_default_layer_height);
+
+  /**
+   * @brief Returns the layers from the bottom to the top.
+   * @return The layers.
+   */
+  const std::vector<Layer> &getLayers() const { return layers; }
+
+  /**
+   * @brief Returns the bounding box of the sliced mesh.
+   * @return The bounding box with the pending transformation applied.
+   */
+  const Eigen::AlignedBox3d &getBoundingBox() const { return box; }
+
+  /**
+   * @brief Counts the contours that are not closed.
+   * @return The number of open contours in every layer.
+   */
+  std::size_t countOpenContours() const;
+
+  /**
+   * @brief Writes a layer as an SVG image.
+   * @details The image covers the bounding box of the whole mesh, so the
+   * images of the layers line up. The closed contours form a single path
+   * filled with the even-odd rule, the open contours are stroked in red.
+   * The y axis points up like in the mesh.
+   * @param out_stream The stream to write to.
+   * @param layer The index of the layer to be written.
+   */
+  void writeSvg(std::ostream &out_stream, std::size_t layer) const;
+
+private:
+  /**
+   * @brief Holds the layers from the bottom to the top.
+   */
+  std::vector<Layer> layers;
+  /**
+   * @brief Holds the bounding box of the sliced mesh.
+   */
+  Eigen::AlignedBox3d box;
+};
+
+} // namespace Converter
+
+#endif
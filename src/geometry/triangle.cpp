@@ -37,8 +37,11 @@ bool Triangle::operator==(const Triangle &other) const {
 }
 
 bool Triangle::isInside(const Eigen::Vector4d &point) const {
-  const auto triangle_normal = getNormal();
+  return isInside(point, getNormal());
+}
 
+bool Triangle::isInside(const Eigen::Vector4d &point,
+                        const Eigen::Vector4d &triangle_normal) const {
   // Test if the point and the triangle are on the same plane.
   if (!Utility::isEqual((a.pos - point).dot(triangle_normal), 0.0)) {
     return false;
@@ -59,12 +62,11 @@ bool Triangle::isInside(const Eigen::Vector4d &point) const {
 std::optional<Eigen::Vector4d>
 Triangle::rayIntersection(const Eigen::Vector4d &ray_starting_point,
                           const Eigen::Vector4d &ray_direction) const {
-  if (isInside(ray_starting_point)) {
+  const auto triangle_normal = getNormal();
+  if (isInside(ray_starting_point, triangle_normal)) {
     return {ray_starting_point};
   }
 
-  const auto triangle_normal = getNormal();
-
   const double d = triangle_normal.dot(a.pos);
   const double det = triangle_normal.dot(ray_direction);
 
@@ -83,7 +85,7 @@ Triangle::rayIntersection(const Eigen::Vector4d &ray_starting_point,
   // The intersection of the plane of the triangle and the ray.
   const auto intersection_point = ray_starting_point + t * ray_direction;
 
-  if (isInside(intersection_point)) {
+  if (isInside(intersection_point, triangle_normal)) {
     return {intersection_point};
   }
   return {};
@@ -72,6 +72,16 @@ public:
    */
   bool isInside(const Eigen::Vector4d &point) const;
 
+  /**
+   * @brief Returns if a Point is in the Triangle, using a precomputed normal.
+   * @param point The point to check.
+   * @param normal The normalized normal vector of the Triangle, as returned
+   * by getNormal.
+   * @return True if the point is inside, otherwise false.
+   */
+  bool isInside(const Eigen::Vector4d &point,
+                const Eigen::Vector4d &normal) const;
+
   /**
    * @brief Returns the intersection of a ray and the Triangle.
    * @details It considers points on the edges and vertices to be inside.
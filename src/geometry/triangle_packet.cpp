@@ -0,0 +1,274 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "triangle.hpp"
+#include "triangle_packet.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief Decides which Triangle owns an edge an intersection lies on.
+ * @details An edge is owned if it points down in the projected plane, or
+ * exactly to the right when it is horizontal. The reversed edge of the
+ * neighboring Triangle gives the opposite answer, so exactly one of them
+ * reports the hit.
+ * @param dx The x component of the projected edge.
+ * @param dy The y component of the projected edge.
+ * @return Set for the owned edges.
+ */
+TrianglePacket::Mask
+isTopLeft(const TrianglePacket::Lanes &dx, const TrianglePacket::Lanes &dy) {
+  return (dy < 0.0) || (dy == 0.0 && dx > 0.0);
+}
+
+/**
+ * @brief Clamps the parameter of the closest point of a segment to a point.
+ * @param numerator The dot product of the segment and the vector from its
+ * start to the point.
+ * @param length_squared The squared length of the segment.
+ * @return The parameter between 0 and 1, 0 for segments of zero length.
+ */
+TrianglePacket::Lanes
+clampSegmentParameter(const TrianglePacket::Lanes &numerator,
+                      const TrianglePacket::Lanes &length_squared) {
+  return (length_squared > 0.0)
+      .select((numerator / length_squared).max(0.0).min(1.0), 0.0);
+}
+
+} // namespace
+
+TrianglePacket::Ray::Ray(const Eigen::Vector4d &origin,
+                         const Eigen::Vector4d &direction)
+    : origin(origin.head<3>()) {
+  Eigen::Index z_axis = 0;
+  direction.head<3>().cwiseAbs().maxCoeff(&z_axis);
+  Eigen::Index x_axis = (z_axis + 1) % 3;
+  Eigen::Index y_axis = (x_axis + 1) % 3;
+  // Swapping x and y keeps the winding order of the Triangles if the ray
+  // points into the negative direction.
+  if (direction[z_axis] < 0.0) {
+    std::swap(x_axis, y_axis);
+  }
+  axes = {x_axis, y_axis, z_axis};
+  shear = {direction[x_axis] / direction[z_axis],
+           direction[y_axis] / direction[z_axis], 1.0 / direction[z_axis]};
+}
+
+void TrianglePacket::load(const std::vector<Triangle> &triangles,
+                          std::size_t first, std::size_t end) {
+  count = std::min(c_width, end - first);
+
+  for (std::size_t lane = 0U; lane < count; ++lane) {
+    setLane(lane, triangles[first + lane]);
+  }
+  clearUnusedLanes();
+}
+
+void TrianglePacket::load(const std::vector<Triangle> &triangles,
+                          const std::vector<std::uint32_t> &indices,
+                          std::size_t first, std::size_t end) {
+  count = std::min(c_width, end - first);
+
+  for (std::size_t lane = 0U; lane < count; ++lane) {
+    setLane(lane, triangles[indices[first + lane]]);
+  }
+  clearUnusedLanes();
+}
+
+void TrianglePacket::setLane(std::size_t lane, const Triangle &triangle) {
+  for (Eigen::Index axis = 0; axis < 3; ++axis) {
+    a[axis][lane] = triangle.a.pos[axis];
+    b[axis][lane] = triangle.b.pos[axis];
+    c[axis][lane] = triangle.c.pos[axis];
+  }
+}
+
+void TrianglePacket::clearUnusedLanes() {
+  for (std::size_t lane = count; lane < c_width; ++lane) {
+    for (Eigen::Index axis = 0; axis < 3; ++axis) {
+      a[axis][lane] = 0.0;
+      b[axis][lane] = 0.0;
+      c[axis][lane] = 0.0;
+    }
+  }
+}
+
+void TrianglePacket::transform(const AffineTransform &transformation) {
+  const Eigen::Matrix4d matrix = transformation.getMatrix();
+  for (auto *vertex : {&a, &b, &c}) {
+    const std::array<Lanes, 3U> source = *vertex;
+    for (Eigen::Index row = 0; row < 3; ++row) {
+      (*vertex)[row] = matrix(row, 0) * source[0U] +
+                       matrix(row, 1) * source[1U] +
+                       matrix(row, 2) * source[2U] + matrix(row, 3);
+    }
+  }
+}
+
+TrianglePacket::Lanes TrianglePacket::getAreas() const {
+  const Lanes ab_x = b[0U] - a[0U];
+  const Lanes ab_y = b[1U] - a[1U];
+  const Lanes ab_z = b[2U] - a[2U];
+  const Lanes ac_x = c[0U] - a[0U];
+  const Lanes ac_y = c[1U] - a[1U];
+  const Lanes ac_z = c[2U] - a[2U];
+
+  const Lanes cross_x = ab_y * ac_z - ab_z * ac_y;
+  const Lanes cross_y = ab_z * ac_x - ab_x * ac_z;
+  const Lanes cross_z = ab_x * ac_y - ab_y * ac_x;
+
+  return (cross_x.square() + cross_y.square() + cross_z.square()).sqrt() / 2.0;
+}
+
+TrianglePacket::Lanes TrianglePacket::getSignedVolumes() const {
+  const Lanes cross_x = a[1U] * b[2U] - a[2U] * b[1U];
+  const Lanes cross_y = a[2U] * b[0U] - a[0U] * b[2U];
+  const Lanes cross_z = a[0U] * b[1U] - a[1U] * b[0U];
+
+  return (cross_x * c[0U] + cross_y * c[1U] + cross_z * c[2U]) / 6.0;
+}
+
+TrianglePacket::Intersections
+TrianglePacket::intersect(const Ray &ray) const {
+  const auto [x_axis, y_axis, z_axis] = ray.axes;
+  const auto &origin = ray.origin;
+
+  // Moves the vertices into the space of the ray.
+  const auto project = [&](const std::array<Lanes, 3U> &vertex) {
+    const Lanes z = vertex[z_axis] - origin[z_axis];
+    return std::array<Lanes, 3U>{
+        vertex[x_axis] - origin[x_axis] - ray.shear[0] * z,
+        vertex[y_axis] - origin[y_axis] - ray.shear[1] * z,
+        ray.shear[2] * z};
+  };
+  const auto pa = project(a);
+  const auto pb = project(b);
+  const auto pc = project(c);
+
+  // The edge functions, the scaled barycentric coordinates of the origin.
+  const Lanes edge_u = pc[0U] * pb[1U] - pc[1U] * pb[0U];
+  const Lanes edge_v = pa[0U] * pc[1U] - pa[1U] * pc[0U];
+  const Lanes edge_w = pb[0U] * pa[1U] - pb[1U] * pa[0U];
+  const Lanes det = edge_u + edge_v + edge_w;
+
+  // Triangles facing away from the ray are turned around, so the edge
+  // functions have to be non-negative inside.
+  const Mask is_flipped = det < 0.0;
+  const Lanes sign = is_flipped.select(Lanes::Constant(-1.0), 1.0);
+  const Lanes u = sign * edge_u;
+  const Lanes v = sign * edge_v;
+  const Lanes w = sign * edge_w;
+  const Lanes abs_det = sign * det;
+  const Lanes t = sign * (edge_u * pa[2U] + edge_v * pb[2U] + edge_w * pc[2U]);
+
+  const Mask owns_u = isTopLeft(pc[0U] - pb[0U], pc[1U] - pb[1U]) != is_flipped;
+  const Mask owns_v = isTopLeft(pa[0U] - pc[0U], pa[1U] - pc[1U]) != is_flipped;
+  const Mask owns_w = isTopLeft(pb[0U] - pa[0U], pb[1U] - pa[1U]) != is_flipped;
+
+  Intersections intersections;
+  Mask is_used;
+  for (std::size_t lane = 0U; lane < c_width; ++lane) {
+    is_used[lane] = lane < count;
+  }
+  intersections.is_parallel = det == 0.0 && is_used;
+  const Mask is_inside =
+      (u >= 0.0) && (v >= 0.0) && (w >= 0.0) && (abs_det > 0.0);
+  const Mask is_owned = (u > 0.0 || (u == 0.0 && owns_u)) &&
+                        (v > 0.0 || (v == 0.0 && owns_v)) &&
+                        (w > 0.0 || (w == 0.0 && owns_w));
+
+  intersections.inclusive_hit = is_inside && t >= 0.0;
+  intersections.hit = intersections.inclusive_hit && is_owned;
+  intersections.contains_origin = is_inside && t == 0.0;
+
+  const Lanes inverse_det =
+      intersections.is_parallel.select(Lanes::Zero(), abs_det.inverse());
+  intersections.t = t * inverse_det;
+  intersections.u = v * inverse_det;
+  intersections.v = w * inverse_det;
+  return intersections;
+}
+
+TrianglePacket::ClosestPoints
+TrianglePacket::findClosestPoints(const Eigen::Vector3d &point) const {
+  std::array<Lanes, 3U> ab;
+  std::array<Lanes, 3U> ac;
+  std::array<Lanes, 3U> bc;
+  std::array<Lanes, 3U> ap;
+  std::array<Lanes, 3U> bp;
+  for (std::size_t axis = 0U; axis < 3U; ++axis) {
+    ab[axis] = b[axis] - a[axis];
+    ac[axis] = c[axis] - a[axis];
+    bc[axis] = c[axis] - b[axis];
+    ap[axis] = point[static_cast<Eigen::Index>(axis)] - a[axis];
+    bp[axis] = point[static_cast<Eigen::Index>(axis)] - b[axis];
+  }
+  const auto dot = [](const std::array<Lanes, 3U> &lhs,
+                      const std::array<Lanes, 3U> &rhs) {
+    return Lanes(lhs[0U] * rhs[0U] + lhs[1U] * rhs[1U] + lhs[2U] * rhs[2U]);
+  };
+  // The squared distance of the point and start + t * edge.
+  const auto distanceSquared = [](const std::array<Lanes, 3U> &to_point,
+                                  const std::array<Lanes, 3U> &edge,
+                                  const Lanes &t) {
+    Lanes sum = Lanes::Zero();
+    for (std::size_t axis = 0U; axis < 3U; ++axis) {
+      sum += (to_point[axis] - t * edge[axis]).square();
+    }
+    return sum;
+  };
+
+  const Lanes ab_ab = dot(ab, ab);
+  const Lanes ab_ac = dot(ab, ac);
+  const Lanes ac_ac = dot(ac, ac);
+  const Lanes ap_ab = dot(ap, ab);
+  const Lanes ap_ac = dot(ap, ac);
+  const Lanes bc_bc = dot(bc, bc);
+
+  // The closest points of the edges.
+  const Lanes t_ab = clampSegmentParameter(ap_ab, ab_ab);
+  const Lanes t_ac = clampSegmentParameter(ap_ac, ac_ac);
+  const Lanes t_bc = clampSegmentParameter(dot(bp, bc), bc_bc);
+  const Lanes distance_ab = distanceSquared(ap, ab, t_ab);
+  const Lanes distance_ac = distanceSquared(ap, ac, t_ac);
+  const Lanes distance_bc = distanceSquared(bp, bc, t_bc);
+
+  ClosestPoints result;
+  const Mask is_ab_closer = distance_ab <= distance_ac;
+  result.distance_squared = is_ab_closer.select(distance_ab, distance_ac);
+  result.u = is_ab_closer.select(t_ab, 0.0);
+  result.v = is_ab_closer.select(Lanes::Zero(), t_ac);
+  const Mask is_bc_closer = distance_bc < result.distance_squared;
+  result.distance_squared =
+      is_bc_closer.select(distance_bc, result.distance_squared);
+  result.u = is_bc_closer.select(1.0 - t_bc, result.u);
+  result.v = is_bc_closer.select(t_bc, result.v);
+
+  // The projection onto the plane, where it is inside of the Triangle. The
+  // denominator is the squared norm of the cross product of the edges.
+  const Lanes denominator = ab_ab * ac_ac - ab_ac * ab_ac;
+  const Lanes inverse = (denominator > 0.0).select(1.0 / denominator, 0.0);
+  const Lanes u = (ac_ac * ap_ab - ab_ac * ap_ac) * inverse;
+  const Lanes v = (ab_ab * ap_ac - ab_ac * ap_ab) * inverse;
+  const Mask is_inside =
+      (denominator > 0.0) && (u >= 0.0) && (v >= 0.0) && (u + v <= 1.0);
+  Lanes distance_plane = Lanes::Zero();
+  for (std::size_t axis = 0U; axis < 3U; ++axis) {
+    distance_plane += (ap[axis] - u * ab[axis] - v * ac[axis]).square();
+  }
+  result.distance_squared =
+      is_inside.select(distance_plane, result.distance_squared);
+  result.u = is_inside.select(u, result.u);
+  result.v = is_inside.select(v, result.v);
+  return result;
+}
+
+} // namespace Converter
@@ -0,0 +1,215 @@
+#ifndef TRIANGLE_PACKET_HPP
+#define TRIANGLE_PACKET_HPP
+
+#include <Eigen/Dense>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "triangle.hpp"
+
+namespace Converter {
+
+/**
+ * @brief Holds the vertex positions of a small group of Triangles in a
+ * structure of arrays layout.
+ * @details Every coordinate is stored in its own fixed size Eigen array, one
+ * lane per Triangle, so the per Triangle math is done with SIMD instructions
+ * on every lane at once. Unused lanes are filled with zeroes.
+ */
+class TrianglePacket {
+public:
+  /**
+   * @brief The number of Triangles in a packet.
+   */
+  static constexpr std::size_t c_width = 8U;
+
+  /**
+   * @brief One value for every Triangle of the packet.
+   */
+  using Lanes = Eigen::Array<double, c_width, 1>;
+
+  /**
+   * @brief One flag for every Triangle of the packet.
+   */
+  using Mask = Eigen::Array<bool, c_width, 1>;
+
+  /**
+   * @brief A ray prepared for the watertight intersection test.
+   * @details The ray is transformed so that it points along the z axis, by
+   * permuting the axes so that z is the dominant direction, then shearing the
+   * x and y coordinates. The Triangles are transformed the same way during
+   * the test, which reduces it to 2D edge functions around the origin.
+   */
+  struct Ray {
+    /**
+     * @brief Prepares a ray for the intersection tests.
+     * @param origin The point in which the ray starts.
+     * @param direction The direction of the ray, does not have to be
+     * normalized but must not be zero.
+     */
+    Ray(const Eigen::Vector4d &origin, const Eigen::Vector4d &direction);
+
+    /**
+     * @brief Holds the starting point of the ray.
+     */
+    Eigen::Vector3d origin;
+    /**
+     * @brief Holds the indices of the axes used as x, y and z, z being the
+     * dominant direction of the ray.
+     */
+    std::array<Eigen::Index, 3U> axes;
+    /**
+     * @brief Holds the shear constants of the x and y axes, and the
+     * reciprocal of the z component of the direction.
+     */
+    Eigen::Vector3d shear;
+  };
+
+  /**
+   * @brief The result of intersecting a ray with a packet.
+   * @param t The distance along the ray in units of the direction vector.
+   * @param u The barycentric coordinate of the second vertex at the hit.
+   * @param v The barycentric coordinate of the third vertex at the hit.
+   * @param hit Set for the Triangles hit at t >= 0. Hits exactly on an
+   * edge or vertex are counted for only one of the Triangles sharing it, so
+   * a ray crossing a closed mesh produces exactly one hit per crossing.
+   * @param inclusive_hit Set for the Triangles hit at t >= 0, counting hits
+   * on edges and vertices for every Triangle sharing them. Used when only
+   * the existence or the distance of a hit matters.
+   * @param contains_origin Set for the Triangles the origin of the ray lies
+   * on, edges and vertices included.
+   * @param is_parallel Set for the used lanes whose Triangles are parallel
+   * to the ray, or degenerate. They are never hit.
+   */
+  struct Intersections {
+    Lanes t;
+    Lanes u;
+    Lanes v;
+    Mask hit;
+    Mask inclusive_hit;
+    Mask contains_origin;
+    Mask is_parallel;
+  };
+
+  /**
+   * @brief The closest points of a packet to a query point.
+   * @param distance_squared The squared distance of the closest point of
+   * each Triangle.
+   * @param u The barycentric coordinate of the second vertex at the closest
+   * point.
+   * @param v The barycentric coordinate of the third vertex at the closest
+   * point.
+   */
+  struct ClosestPoints {
+    Lanes distance_squared;
+    Lanes u;
+    Lanes v;
+  };
+
+  /**
+   * @brief Holds the x, y and z coordinates of the first vertices.
+   */
+  std::array<Lanes, 3U> a;
+  /**
+   * @brief Holds the x, y and z coordinates of the second vertices.
+   */
+  std::array<Lanes, 3U> b;
+  /**
+   * @brief Holds the x, y and z coordinates of the third vertices.
+   */
+  std::array<Lanes, 3U> c;
+  /**
+   * @brief Holds the number of used lanes.
+   */
+  std::size_t count = 0U;
+
+  /**
+   * @brief Loads the next Triangles into the packet.
+   * @param triangles The Triangles to load from.
+   * @param first The index of the first Triangle to load.
+   * @param end The index after the last Triangle that may be loaded, at most
+   * c_width Triangles are loaded.
+   */
+  void load(const std::vector<Triangle> &triangles, std::size_t first,
+            std::size_t end);
+
+  /**
+   * @brief Loads the Triangles referenced by a range of indices.
+   * @param triangles The Triangles to load from.
+   * @param indices The indices of the Triangles to load.
+   * @param first The position of the first index to load.
+   * @param end The position after the last index that may be loaded, at most
+   * c_width Triangles are loaded.
+   */
+  void load(const std::vector<Triangle> &triangles,
+            const std::vector<std::uint32_t> &indices, std::size_t first,
+            std::size_t end);
+
+  /**
+   * @brief Transforms the vertices of every lane.
+   * @note The vertices are treated as points with 1 as their homogeneous
+   * coordinate.
+   * @param transformation The transformation to be applied.
+   */
+  void transform(const AffineTransform &transformation);
+
+  /**
+   * @brief Calculates the areas of the Triangles.
+   * @return The area of each Triangle, zero for the unused lanes.
+   */
+  Lanes getAreas() const;
+
+  /**
+   * @brief Calculates the signed volumes of the tetrahedrons formed by the
+   * Triangles and the origin.
+   * @return The signed volume for each Triangle, zero for the unused lanes.
+   */
+  Lanes getSignedVolumes() const;
+
+  /**
+   * @brief Intersects a ray with every Triangle of the packet.
+   * @details Implements the watertight ray-triangle intersection of Woop,
+   * Benthin and Wald. Unlike the plane based test of Triangle, there are no
+   * epsilons, so the result does not depend on the scale of the mesh, and a
+   * ray can't slip through the shared edge of two Triangles. Ties on edges are
+   * broken with a top-left rule relative to the winding of the Triangle.
+   * @param ray The prepared ray.
+   * @return The intersections, the unused lanes are never hit.
+   */
+  Intersections intersect(const Ray &ray) const;
+
+  /**
+   * @brief Finds the closest point of every Triangle of the packet to a
+   * point.
+   * @details The point is projected onto the plane of each Triangle, and if
+   * the projection is outside of the Triangle the closest point is on one of
+   * the edges, so the closest points of the three edges are compared
+   * instead. Every case is calculated for every lane and the results are
+   * selected without branches. Degenerate Triangles are handled as their
+   * edges.
+   * @param point The query point.
+   * @return The closest points, the unused lanes hold the distance to the
+   * origin.
+   */
+  ClosestPoints findClosestPoints(const Eigen::Vector3d &point) const;
+
+private:
+  /**
+   * @brief Copies the vertex positions of a Triangle into a lane.
+   * @param lane The lane to be set.
+   * @param triangle The Triangle to be copied.
+   */
+  void setLane(std::size_t lane, const Triangle &triangle);
+
+  /**
+   * @brief Fills the lanes after count with zeroes.
+   */
+  void clearUnusedLanes();
+};
+
+} // namespace Converter
+
+#endif
@@ -0,0 +1,177 @@
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "indexed_mesh.hpp"
+#include "vertex_cache.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief Marks the vertices that were not renumbered yet, and the end of
+ * the fanning.
+ */
+constexpr std::uint32_t c_none = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief Reorders the faces with the Tipsify algorithm.
+ * @param mesh The mesh whose faces are reordered.
+ * @param cache_size The number of vertices in the cache.
+ * @return The indices of the faces in the new order.
+ */
+std::vector<std::uint32_t> tipsify(const IndexedMesh &mesh,
+                                   std::size_t cache_size) {
+  const std::size_t vertex_count = mesh.vertices.size();
+  const std::size_t face_count = mesh.faces.size();
+
+  // The faces of every vertex, in a compressed table. The number of faces
+  // not emitted yet is tracked for every vertex.
+  std::vector<std::uint32_t> face_offsets(vertex_count + 1U, 0U);
+  for (const auto &face : mesh.faces) {
+    for (const auto vertex : face) {
+      ++face_offsets[vertex + 1U];
+    }
+  }
+  std::vector<std::uint32_t> live_counts(vertex_count);
+  for (std::size_t i = 0U; i < vertex_count; ++i) {
+    live_counts[i] = face_offsets[i + 1U];
+    face_offsets[i + 1U] += face_offsets[i];
+  }
+  std::vector<std::uint32_t> vertex_faces(face_offsets.back());
+  std::vector<std::uint32_t> fill(face_offsets.begin(),
+                                  face_offsets.end() - 1);
+  for (std::size_t i = 0U; i < face_count; ++i) {
+    for (const auto vertex : mesh.faces[i]) {
+      vertex_faces[fill[vertex]++] = static_cast<std::uint32_t>(i);
+    }
+  }
+
+  // A vertex is in the cache if it was added at most cache_size misses ago,
+  // the time starts above the cache size so initially nothing is cached.
+  std::vector<std::size_t> cache_times(vertex_count, 0U);
+  std::size_t time = cache_size + 1U;
+  std::vector<std::uint8_t> is_emitted(face_count, 0U);
+  std::vector<std::uint32_t> dead_ends;
+  std::vector<std::uint32_t> candidates;
+  std::size_t next_unprocessed = 0U;
+
+  std::vector<std::uint32_t> order;
+  order.reserve(face_count);
+  std::uint32_t fanning = face_count > 0U ? mesh.faces[0U][0U] : c_none;
+  while (fanning != c_none) {
+    candidates.clear();
+    for (std::uint32_t i = face_offsets[fanning];
+         i < face_offsets[fanning + 1U]; ++i) {
+      const std::uint32_t face = vertex_faces[i];
+      if (is_emitted[face] != 0U) {
+        continue;
+      }
+      is_emitted[face] = 1U;
+      order.push_back(face);
+      for (const auto vertex : mesh.faces[face]) {
+        dead_ends.push_back(vertex);
+        candidates.push_back(vertex);
+        --live_counts[vertex];
+        if (time - cache_times[vertex] > cache_size) {
+          cache_times[vertex] = time++;
+        }
+      }
+    }
+
+    // Prefers the candidates that stay in the cache while their remaining
+    // faces are emitted, and among them the oldest one.
+    fanning = c_none;
+    std::size_t best_priority = 0U;
+    bool is_found = false;
+    for (const auto vertex : candidates) {
+      if (live_counts[vertex] == 0U) {
+        continue;
+      }
+      std::size_t priority = 0U;
+      if (time - cache_times[vertex] + 2U * live_counts[vertex] <=
+          cache_size) {
+        priority = time - cache_times[vertex];
+      }
+      if (!is_found || priority > best_priority) {
+        best_priority = priority;
+        fanning = vertex;
+        is_found = true;
+      }
+    }
+
+    // Dead end, continues with the most recent vertex having faces left, or
+    // with the next such vertex in index order.
+    while (fanning == c_none && !dead_ends.empty()) {
+      const std::uint32_t vertex = dead_ends.back();
+      dead_ends.pop_back();
+      if (live_counts[vertex] > 0U) {
+        fanning = vertex;
+      }
+    }
+    for (; fanning == c_none && next_unprocessed < vertex_count;
+         ++next_unprocessed) {
+      if (live_counts[next_unprocessed] > 0U) {
+        fanning = static_cast<std::uint32_t>(next_unprocessed);
+      }
+    }
+  }
+  return order;
+}
+
+} // namespace
+
+double VertexCache::calculateAcmr(const IndexedMesh &mesh,
+                                  std::size_t cache_size) {
+  if (mesh.faces.empty()) {
+    return 0.0;
+  }
+
+  std::vector<std::size_t> cache_times(mesh.vertices.size(), 0U);
+  std::size_t time = cache_size + 1U;
+  std::size_t miss_count = 0U;
+  for (const auto &face : mesh.faces) {
+    for (const auto vertex : face) {
+      if (time - cache_times[vertex] > cache_size) {
+        cache_times[vertex] = time++;
+        ++miss_count;
+      }
+    }
+  }
+  return static_cast<double>(miss_count) /
+         static_cast<double>(mesh.faces.size());
+}
+
+IndexedMesh VertexCache::optimize(const IndexedMesh &mesh,
+                                  std::size_t cache_size) {
+  const auto order = tipsify(mesh, cache_size);
+
+  IndexedMesh optimized;
+  optimized.material_file = mesh.material_file;
+  optimized.vertices.reserve(mesh.vertices.size());
+  optimized.faces.reserve(mesh.faces.size());
+  std::vector<std::uint32_t> new_indices(mesh.vertices.size(), c_none);
+  for (const auto face_index : order) {
+    IndexedMesh::Face face;
+    for (std::size_t corner = 0U; corner < 3U; ++corner) {
+      const std::uint32_t vertex = mesh.faces[face_index][corner];
+      if (new_indices[vertex] == c_none) {
+        new_indices[vertex] =
+            static_cast<std::uint32_t>(optimized.vertices.size());
+        optimized.vertices.push_back(mesh.vertices[vertex]);
+      }
+      face[corner] = new_indices[vertex];
+    }
+    optimized.faces.push_back(face);
+  }
+  for (std::size_t vertex = 0U; vertex < mesh.vertices.size(); ++vertex) {
+    if (new_indices[vertex] == c_none) {
+      optimized.vertices.push_back(mesh.vertices[vertex]);
+    }
+  }
+  return optimized;
+}
+
+} // namespace Converter
@@ -0,0 +1,55 @@
+#ifndef VERTEX_CACHE_HPP
+#define VERTEX_CACHE_HPP
+
+#include <cstddef>
+
+namespace Converter {
+
+class IndexedMesh;
+
+/**
+ * @brief Reorders indexed meshes for the post-transform vertex cache of
+ * GPUs.
+ * @details A GPU keeps the last few transformed vertices in a small cache,
+ * so the number of vertex shader invocations depends on how often the faces
+ * reuse recent vertices. The faces are reordered with the Tipsify algorithm
+ * of Sander, Nehab and Barczak, which fans around one vertex at a time and
+ * picks the next fanning vertex from the ones that are still in the cache,
+ * in time linear in the number of faces. The vertices are then renumbered in
+ * the order of their first use, which makes the vertex fetches sequential.
+ */
+class VertexCache {
+public:
+  /**
+   * @brief The default number of vertices in the simulated cache.
+   */
+  static constexpr std::size_t c_default_cache_size = 16U;
+
+  /**
+   * @brief Calculates the average cache miss ratio of a mesh.
+   * @details A first in, first out cache of the given size is simulated
+   * over the faces in order.
+   * @param mesh The mesh whose faces are drawn.
+   * @param cache_size The number of vertices in the cache.
+   * @return The number of cache misses divided by the number of faces,
+   * between 0.5 and 3 for most meshes, zero for a mesh without faces.
+   */
+  static double calculateAcmr(const IndexedMesh &mesh,
+                              std::size_t cache_size = c_default_cache_size);
+
+  /**
+   * @brief Reorders the faces and the vertices of a mesh.
+   * @details The faces keep their orientation. The vertices not used by any
+   * face are kept after the used ones, in their original order.
+   * @param mesh The mesh to be reordered.
+   * @param cache_size The number of vertices in the cache the order is
+   * optimized for.
+   * @return The reordered mesh.
+   */
+  static IndexedMesh optimize(const IndexedMesh &mesh,
+                              std::size_t cache_size = c_default_cache_size);
+};
+
+} // namespace Converter
+
+#endif
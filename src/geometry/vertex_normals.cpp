@@ -0,0 +1,183 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "indexed_mesh.hpp"
+#include "meshdata.hpp"
+#include "parallel.hpp"
+#include "vertex_normals.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief The length of a sum of normals relative to the sum of its weights,
+ * below which the normals are considered to cancel out.
+ */
+constexpr double c_cancel_ratio = 1e-12;
+
+} // namespace
+
+VertexNormals VertexNormals::calculate(const IndexedMesh &mesh,
+                                       Weighting weighting,
+                                       double crease_angle) {
+  const auto &faces = mesh.faces;
+  const std::size_t face_count = faces.size();
+  const std::size_t vertex_count = mesh.vertices.size();
+
+  // The unit normal of every face and the weight of every corner.
+  std::vector<Eigen::Vector3d> face_normals(face_count);
+  std::vector<double> corner_weights(3U * face_count);
+  Parallel::forEachBlock(
+      face_count, Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          const std::array<Eigen::Vector3d, 3U> corners{
+              mesh.vertices[faces[i][0U]].head<3>(),
+              mesh.vertices[faces[i][1U]].head<3>(),
+              mesh.vertices[faces[i][2U]].head<3>()};
+          const Eigen::Vector3d cross =
+              (corners[1U] - corners[0U]).cross(corners[2U] - corners[0U]);
+          const double norm = cross.norm();
+          face_normals[i] =
+              norm > 0.0 ? Eigen::Vector3d(cross / norm)
+                         : Eigen::Vector3d(Eigen::Vector3d::Zero());
+          for (std::size_t k = 0U; k < 3U; ++k) {
+            if (weighting == Weighting::AREA) {
+              corner_weights[3U * i + k] = norm / 2.0;
+            } else {
+              const Eigen::Vector3d first =
+                  corners[(k + 1U) % 3U] - corners[k];
+              const Eigen::Vector3d second =
+                  corners[(k + 2U) % 3U] - corners[k];
+              corner_weights[3U * i + k] = std::atan2(
+                  first.cross(second).norm(), first.dot(second));
+            }
+          }
+        }
+      });
+
+  // The corners of every vertex, in a compressed table.
+  std::vector<std::uint32_t> corner_offsets(vertex_count + 1U, 0U);
+  for (const auto &face : faces) {
+    for (const auto vertex : face) {
+      ++corner_offsets[vertex + 1U];
+    }
+  }
+  for (std::size_t i = 0U; i < vertex_count; ++i) {
+    corner_offsets[i + 1U] += corner_offsets[i];
+  }
+  std::vector<std::uint32_t> vertex_corners(corner_offsets.back());
+  std::vector<std::uint32_t> fill(corner_offsets.begin(),
+                                  corner_offsets.end() - 1);
+  for (std::size_t i = 0U; i < face_count; ++i) {
+    for (std::size_t k = 0U; k < 3U; ++k) {
+      vertex_corners[fill[faces[i][k]]++] =
+          static_cast<std::uint32_t>(3U * i + k);
+    }
+  }
+
+  // Every vertex writes only its own corners.
+  const bool is_creased = crease_angle < c_no_crease;
+  const double min_cosine = std::cos(crease_angle);
+  VertexNormals result;
+  result.corner_normals.resize(3U * face_count);
+  const std::size_t block_count =
+      (vertex_count + Parallel::c_block_size - 1U) / Parallel::c_block_size;
+  std::vector<std::size_t> block_split_counts(block_count, 0U);
+  Parallel::forEachBlock(
+      vertex_count, Parallel::c_block_size,
+      [&](std::size_t block, std::size_t begin, std::size_t end) {
+        auto &split_count = block_split_counts[block];
+        std::vector<std::array<double, 3U>> normals;
+        for (std::size_t vertex = begin; vertex < end; ++vertex) {
+          const std::uint32_t first = corner_offsets[vertex];
+          const std::uint32_t last = corner_offsets[vertex + 1U];
+          // Sums the normals of the faces within the crease angle of a
+          // normal, false if they cancel out.
+          const auto sumNormals = [&](const Eigen::Vector3d &own_normal,
+                                      Eigen::Vector3d &normal) {
+            Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+            double total_weight = 0.0;
+            for (std::uint32_t i = first; i < last; ++i) {
+              const std::uint32_t corner = vertex_corners[i];
+              const auto &face_normal = face_normals[corner / 3U];
+              if (!is_creased || face_normal.dot(own_normal) >= min_cosine) {
+                sum += corner_weights[corner] * face_normal;
+                total_weight += corner_weights[corner];
+              }
+            }
+            const double norm = sum.norm();
+            if (norm <= c_cancel_ratio * total_weight) {
+              return false;
+            }
+            normal = sum / norm;
+            return true;
+          };
+
+          // Without a crease the sum is the same for every corner.
+          Eigen::Vector3d smooth_normal;
+          const bool is_smooth =
+              !is_creased && sumNormals(Eigen::Vector3d::Zero(), smooth_normal);
+          for (std::uint32_t i = first; i < last; ++i) {
+            const std::uint32_t corner = vertex_corners[i];
+            const auto &own_normal = face_normals[corner / 3U];
+            auto &normal = result.corner_normals[corner];
+            if (is_smooth) {
+              normal = smooth_normal;
+            } else if (!is_creased || !sumNormals(own_normal, normal)) {
+              normal = own_normal;
+            }
+          }
+
+          // The distinct normals are counted after sorting them, which
+          // stays fast for vertices shared by many faces.
+          normals.clear();
+          for (std::uint32_t i = first; i < last; ++i) {
+            const auto &normal = result.corner_normals[vertex_corners[i]];
+            normals.push_back({normal.x(), normal.y(), normal.z()});
+          }
+          std::sort(normals.begin(), normals.end());
+          split_count += static_cast<std::size_t>(
+              std::unique(normals.begin(), normals.end()) - normals.begin());
+        }
+      });
+  for (const auto split_count : block_split_counts) {
+    result.split_vertex_count += split_count;
+  }
+  return result;
+}
+
+void VertexNormals::apply(MeshData &mesh) const {
+  auto &triangles = mesh.triangles;
+  const auto &transformation = mesh.getPendingTransform();
+  const bool is_transformed =
+      transformation.getKind() != AffineTransform::Kind::IDENTITY;
+  // The inverse of the inverse transpose of the linear part.
+  const Eigen::Matrix3d inverse_normal_matrix =
+      transformation.getMatrix().topLeftCorner<3, 3>().transpose();
+  Parallel::forEachBlock(
+      triangles.size(), Parallel::c_block_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          auto &triangle = triangles[i];
+          std::size_t corner = 3U * i;
+          for (auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+            Eigen::Vector3d normal = corner_normals[corner++];
+            if (is_transformed) {
+              normal = (inverse_normal_matrix * normal).normalized();
+            }
+            vertex->normal =
+                Eigen::Vector4d(normal.x(), normal.y(), normal.z(), 0.0);
+          }
+        }
+      });
+}
+
+} // namespace Converter
@@ -0,0 +1,101 @@
+#ifndef VERTEX_NORMALS_HPP
+#define VERTEX_NORMALS_HPP
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <vector>
+
+namespace Converter {
+
+class IndexedMesh;
+class MeshData;
+
+/**
+ * @brief Calculates smooth vertex normals of indexed meshes.
+ * @details The normal of a vertex is the weighted sum of the unit normals of
+ * its faces, weighted by the area of the faces or by their angle at the
+ * vertex. The angle weights do not depend on how the faces around a vertex
+ * are tessellated. The faces of every vertex are gathered from a compressed
+ * vertex to corner table, and every thread writes the corners of its own
+ * vertices, so no atomics are needed. With a crease angle a corner only
+ * averages the faces whose normal is within that angle of the normal of its
+ * own face, which splits the vertices at sharp edges into several normals.
+ * The result does not depend on the number of threads.
+ */
+class VertexNormals {
+public:
+  /**
+   * @brief The weights of the face normals.
+   */
+  enum class Weighting {
+    /**
+     * @brief Weights the faces by their area.
+     */
+    AREA,
+    /**
+     * @brief Weights the faces by their angle at the vertex.
+     */
+    ANGLE
+  };
+
+  /**
+   * @brief The crease angle which never splits a vertex.
+   */
+  static constexpr double c_no_crease = 3.14159265358979323846;
+
+  /**
+   * @brief Calculates the normals of the corners of a mesh.
+   * @param mesh The mesh, whose shared vertices are smoothed over.
+   * @param weighting The weights of the face normals.
+   * @param crease_angle The largest angle in radians between the normals of
+   * faces that are averaged, c_no_crease or more averages every face of a
+   * vertex.
+   * @return The normals, the unit normal of the face if the faces of a
+   * vertex cancel out, and zero for degenerate faces without any smooth
+   * neighbors.
+   */
+  static VertexNormals calculate(const IndexedMesh &mesh, Weighting weighting,
+                                 double crease_angle = c_no_crease);
+
+  /**
+   * @brief Returns the normals of the corners.
+   * @return The normals, the normal of the k-th corner of the i-th face is
+   * at index 3 * i + k.
+   */
+  const std::vector<Eigen::Vector3d> &getCornerNormals() const {
+    return corner_normals;
+  }
+
+  /**
+   * @brief Returns the number of vertices after splitting.
+   * @details Counts the different normals of every vertex used by any face,
+   * which is the number of vertices a renderer needs.
+   * @return The number of distinct vertex and normal pairs.
+   */
+  std::size_t getSplitVertexCount() const { return split_vertex_count; }
+
+  /**
+   * @brief Writes the normals to the vertices of the Triangles.
+   * @details IndexedMesh::weld applies the pending transformation, so the
+   * normals are mapped back with the inverse of its normal matrix, which
+   * the pending transformation then undoes. The transformation stays
+   * deferred.
+   * @note The Triangles must be the ones the faces were welded from.
+   * @param mesh The mesh whose normals are replaced.
+   */
+  void apply(MeshData &mesh) const;
+
+private:
+  /**
+   * @brief Holds the normals of the corners.
+   */
+  std::vector<Eigen::Vector3d> corner_normals;
+  /**
+   * @brief Holds the number of distinct vertex and normal pairs.
+   */
+  std::size_t split_vertex_count = 0U;
+};
+
+} // namespace Converter
+
+#endif
@@ -0,0 +1,419 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "meshdata.hpp"
+#include "parallel.hpp"
+#include "voxel_grid.hpp"
+
+namespace Converter {
+
+namespace {
+
+/**
+ * @brief The number of rows of columns a task rasterizes and fills.
+ */
+constexpr std::size_t c_rows_per_block = 4U;
+
+/**
+ * @brief The number of Triangles a task bins.
+ */
+constexpr std::size_t c_chunk_size = std::size_t{1U} << 16U;
+
+/**
+ * @brief The transformed vertex positions of a Triangle.
+ */
+using Corners = std::array<Eigen::Vector3d, 3U>;
+
+/**
+ * @brief The transformed vertex positions of a Triangle relative to the
+ * lowest corner of the grid, in single precision, a ninth of the size of a
+ * Triangle.
+ */
+using PackedCorners = std::array<float, 9U>;
+
+/**
+ * @brief Finds the voxel centers within a range along an axis.
+ * @param low The lower end of the range, relative to the grid.
+ * @param high The upper end of the range, relative to the grid.
+ * @param voxel_size The edge length of a voxel.
+ * @param count The number of voxels along the axis.
+ * @return The index of the first voxel whose center is at least low, and
+ * the index after the last one whose center is at most high.
+ */
+std::pair<std::size_t, std::size_t> getCenterRange(double low, double high,
+                                                   double voxel_size,
+                                                   std::size_t count) {
+  const auto max_index = static_cast<double>(count);
+  const double first =
+      std::clamp(std::ceil(low / voxel_size - 0.5), 0.0, max_index);
+  const double end =
+      std::clamp(std::floor(high / voxel_size - 0.5) + 1.0, 0.0, max_index);
+  return {static_cast<std::size_t>(first),
+          static_cast<std::size_t>(std::max(first, end))};
+}
+
+/**
+ * @brief Calculates the edge function of a directed 2D edge at a point.
+ * @details The edge is evaluated from its lexicographically smaller end, so
+ * the value of the reversed edge is exactly the negative, and two
+ * Triangles sharing an edge agree on which side of it a column center is.
+ * @param start The start of the edge, z is ignored.
+ * @param end The end of the edge, z is ignored.
+ * @param x The x coordinate of the point.
+ * @param y The y coordinate of the point.
+ * @return Twice the signed area of the triangle of the edge and the point,
+ * positive if the point is on the left of the edge.
+ */
+double getEdgeFunction(const Eigen::Vector3d &start, const Eigen::Vector3d &end,
+                       double x, double y) {
+  if (end.x() < start.x() || (end.x() == start.x() && end.y() < start.y())) {
+    return -getEdgeFunction(end, start, x, y);
+  }
+  return (end.x() - start.x()) * (y - start.y()) -
+         (end.y() - start.y()) * (x - start.x());
+}
+
+/**
+ * @brief Decides which Triangle owns a column center lying on an edge.
+ * @param dx The x component of the edge of a counter-clockwise Triangle.
+ * @param dy The y component of the edge of a counter-clockwise Triangle.
+ * @return True if the edge is owned, the reversed edge is never owned.
+ */
+bool isTopLeft(double dx, double dy) {
+  return dy < 0.0 || (dy == 0.0 && dx > 0.0);
+}
+
+/**
+ * @brief Collects the heights a Triangle crosses the column centers at.
+ * @param corners The transformed vertex positions of the Triangle, relative
+ * to the lowest corner of the grid.
+ * @param voxel_size The edge length of a voxel.
+ * @param size_x The number of columns along x.
+ * @param rows The first row and the row after the last one to collect.
+ * @param crossings The crossings are appended to this, with the index of the
+ * column relative to the first row.
+ */
+void rasterize(const Corners &corners, double voxel_size, std::size_t size_x,
+               const std::pair<std::size_t, std::size_t> &rows,
+               std::vector<std::pair<std::size_t, double>> &crossings) {
+  const auto &[a, b, c] = corners;
+  const auto [min_x, max_x] = std::minmax({a.x(), b.x(), c.x()});
+  const auto [min_y, max_y] = std::minmax({a.y(), b.y(), c.y()});
+  const auto columns = getCenterRange(min_x, max_x, voxel_size, size_x);
+  auto triangle_rows = getCenterRange(min_y, max_y, voxel_size, rows.second);
+  triangle_rows.first = std::max(triangle_rows.first, rows.first);
+  if (columns.first == columns.second ||
+      triangle_rows.first >= triangle_rows.second) {
+    return;
+  }
+
+  const double area = getEdgeFunction(a, b, c.x(), c.y());
+  if (!(area != 0.0)) {
+    // Parallel to the columns, or not a number.
+    return;
+  }
+  // The edges opposite to a, b and c, oriented counter-clockwise.
+  const double orientation = area > 0.0 ? 1.0 : -1.0;
+  const std::array<const Eigen::Vector3d *, 3U> starts = {&b, &c, &a};
+  const std::array<const Eigen::Vector3d *, 3U> ends = {&c, &a, &b};
+  std::array<bool, 3U> is_owned;
+  for (std::size_t edge = 0U; edge < 3U; ++edge) {
+    is_owned[edge] =
+        isTopLeft(orientation * (ends[edge]->x() - starts[edge]->x()),
+                  orientation * (ends[edge]->y() - starts[edge]->y()));
+  }
+
+  for (std::size_t row = triangle_rows.first; row < triangle_rows.second;
+       ++row) {
+    const double y = (static_cast<double>(row) + 0.5) * voxel_size;
+    for (std::size_t column = columns.first; column < columns.second;
+         ++column) {
+      const double x = (static_cast<double>(column) + 0.5) * voxel_size;
+      std::array<double, 3U> weights;
+      bool is_inside = true;
+      for (std::size_t edge = 0U; edge < 3U && is_inside; ++edge) {
+        weights[edge] =
+            orientation * getEdgeFunction(*starts[edge], *ends[edge], x, y);
+        is_inside = weights[edge] > 0.0 ||
+                    (weights[edge] == 0.0 && is_owned[edge]);
+      }
+      if (!is_inside) {
+        continue;
+      }
+      const double z =
+          (weights[0U] * a.z() + weights[1U] * b.z() + weights[2U] * c.z()) /
+          (weights[0U] + weights[1U] + weights[2U]);
+      crossings.emplace_back(column + size_x * (row - rows.first), z);
+    }
+  }
+}
+
+/**
+ * @brief Sets a range of bits of a column.
+ * @param column The first word of the column.
+ * @param first The first bit to set.
+ * @param end The bit after the last one to set.
+ */
+void setBits(std::uint64_t *column, std::size_t first, std::size_t end) {
+  while (first < end) {
+    const std::size_t bit = first % 64U;
+    const std::size_t count = std::min<std::size_t>(64U - bit, end - first);
+    const std::uint64_t mask =
+        count == 64U ? ~std::uint64_t{0U}
+                     : ((std::uint64_t{1U} << count) - 1U) << bit;
+    column[first / 64U] |= mask;
+    first += count;
+  }
+}
+
+} // namespace
+
+VoxelGrid VoxelGrid::voxelize(const MeshData &mesh, std::size_t resolution) {
+  VoxelGrid grid;
+  if (mesh.triangles.empty()) {
+    return grid;
+  }
+
+  // Calculates the bounding box of the transformed positions.
+  const std::size_t triangle_count = mesh.triangles.size();
+  const std::size_t chunk_count =
+      (triangle_count + c_chunk_size - 1U) / c_chunk_size;
+  const auto &transformation = mesh.getPendingTransform();
+  const auto transformCorners = [&mesh, &transformation](std::size_t i) {
+    const auto &triangle = mesh.triangles[i];
+    return Corners{transformation.transformPoint(triangle.a.pos).head<3>(),
+                   transformation.transformPoint(triangle.b.pos).head<3>(),
+                   transformation.transformPoint(triangle.c.pos).head<3>()};
+  };
+  std::vector<Eigen::AlignedBox3d> chunk_boxes(chunk_count);
+  Parallel::forEachBlock(
+      triangle_count, c_chunk_size,
+      [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto &chunk_box = chunk_boxes[chunk];
+        chunk_box.setEmpty();
+        for (std::size_t i = begin; i < end; ++i) {
+          const auto corners = transformCorners(i);
+          if (std::all_of(corners.begin(), corners.end(),
+                          [](const Eigen::Vector3d &corner) {
+                            return corner.allFinite();
+                          })) {
+            for (const auto &corner : corners) {
+              chunk_box.extend(corner);
+            }
+          }
+        }
+      });
+  Eigen::AlignedBox3d box;
+  for (const auto &chunk_box : chunk_boxes) {
+    box.extend(chunk_box);
+  }
+  if (box.isEmpty()) {
+    return grid;
+  }
+
+  grid.voxel_size = box.sizes().maxCoeff() /
+                    static_cast<double>(std::max<std::size_t>(resolution, 1U));
+  if (!(grid.voxel_size > 0.0)) {
+    grid.voxel_size = 1.0;
+  }
+  grid.origin = box.min();
+  // Copies the positions relative to the grid into a compact array, which
+  // is read several times. They are subtracted in double precision, so the
+  // rounding to float depends on the size of the mesh, not its distance from
+  // the origin.
+  std::vector<PackedCorners> packed_corners(triangle_count);
+  Parallel::forEachBlock(
+      triangle_count, c_chunk_size,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          const auto corners = transformCorners(i);
+          auto &packed = packed_corners[i];
+          for (std::size_t corner = 0U; corner < 3U; ++corner) {
+            for (Eigen::Index axis = 0; axis < 3; ++axis) {
+              packed[3U * corner + static_cast<std::size_t>(axis)] =
+                  static_cast<float>(corners[corner][axis] -
+                                     grid.origin[axis]);
+            }
+          }
+        }
+      });
+  for (Eigen::Index axis = 0; axis < 3; ++axis) {
+    grid.dimensions[static_cast<std::size_t>(axis)] = std::max<std::size_t>(
+        static_cast<std::size_t>(
+            std::ceil(box.sizes()[axis] / grid.voxel_size)),
+        1U);
+  }
+  const std::size_t size_x = grid.dimensions[0U];
+  const std::size_t size_y = grid.dimensions[1U];
+  const std::size_t size_z = grid.dimensions[2U];
+  grid.words_per_column = (size_z + 63U) / 64U;
+  grid.words.assign(size_x * size_y * grid.words_per_column, 0U);
+
+  const auto unpack = [](const PackedCorners &packed) {
+    return Corners{Eigen::Vector3d(packed[0U], packed[1U], packed[2U]),
+                   Eigen::Vector3d(packed[3U], packed[4U], packed[5U]),
+                   Eigen::Vector3d(packed[6U], packed[7U], packed[8U])};
+  };
+  // The rows of the column centers a Triangle may cross, empty if it
+  // falls between the centers.
+  const auto getRows = [&grid, size_x, size_y](const Corners &corners) {
+    const auto [min_x, max_x] =
+        std::minmax({corners[0U].x(), corners[1U].x(), corners[2U].x()});
+    const auto columns =
+        getCenterRange(min_x, max_x, grid.voxel_size, size_x);
+    if (columns.first == columns.second) {
+      return columns;
+    }
+    const auto [min_y, max_y] =
+        std::minmax({corners[0U].y(), corners[1U].y(), corners[2U].y()});
+    return getCenterRange(min_y, max_y, grid.voxel_size, size_y);
+  };
+
+  // Bins the Triangles into the blocks of rows they cover, counting the
+  // Triangles of every chunk and block first.
+  const std::size_t block_count =
+      (size_y + c_rows_per_block - 1U) / c_rows_per_block;
+  std::vector<std::size_t> offsets(chunk_count * block_count, 0U);
+  const auto forEachBlockOfTriangle = [&](const auto &func) {
+    Parallel::forEachBlock(
+        triangle_count, c_chunk_size,
+        [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i) {
+            const auto rows = getRows(unpack(packed_corners[i]));
+            if (rows.first == rows.second) {
+              continue;
+            }
+            for (std::size_t block = rows.first / c_rows_per_block;
+                 block <= (rows.second - 1U) / c_rows_per_block; ++block) {
+              func(chunk * block_count + block, i);
+            }
+          }
+        });
+  };
+  forEachBlockOfTriangle(
+      [&offsets](std::size_t slot, std::size_t) { ++offsets[slot]; });
+  std::vector<std::size_t> block_offsets(block_count + 1U, 0U);
+  std::size_t position = 0U;
+  for (std::size_t block = 0U; block < block_count; ++block) {
+    block_offsets[block] = position;
+    for (std::size_t chunk = 0U; chunk < chunk_count; ++chunk) {
+      const std::size_t count = offsets[chunk * block_count + block];
+      offsets[chunk * block_count + block] = position;
+      position += count;
+    }
+  }
+  block_offsets[block_count] = position;
+  // The positions are copied into the bins rather than indexed, so every
+  // block reads its Triangles sequentially.
+  std::vector<PackedCorners> binned(position);
+  forEachBlockOfTriangle([&](std::size_t slot, std::size_t i) {
+    binned[offsets[slot]++] = packed_corners[i];
+  });
+  offsets = std::vector<std::size_t>();
+  packed_corners = std::vector<PackedCorners>();
+
+  // Rasterizes every block of rows and fills its columns by parity.
+  Parallel::forEachBlock(
+      block_count, 1U, [&](std::size_t block, std::size_t, std::size_t) {
+        const std::pair<std::size_t, std::size_t> rows = {
+            block * c_rows_per_block,
+            std::min(size_y, (block + 1U) * c_rows_per_block)};
+        std::vector<std::pair<std::size_t, double>> crossings;
+        for (std::size_t i = block_offsets[block];
+             i < block_offsets[block + 1U]; ++i) {
+          rasterize(unpack(binned[i]), grid.voxel_size, size_x, rows,
+                    crossings);
+        }
+
+        // Groups the crossings by column with a counting sort, then sorts
+        // the few heights of every column.
+        const std::size_t column_count = size_x * (rows.second - rows.first);
+        std::vector<std::size_t> column_offsets(column_count + 1U, 0U);
+        for (const auto &crossing : crossings) {
+          ++column_offsets[crossing.first + 1U];
+        }
+        for (std::size_t column = 0U; column < column_count; ++column) {
+          column_offsets[column + 1U] += column_offsets[column];
+        }
+        std::vector<double> heights(crossings.size());
+        std::vector<std::size_t> positions(column_offsets.begin(),
+                                           column_offsets.end() - 1);
+        for (const auto &crossing : crossings) {
+          heights[positions[crossing.first]++] = crossing.second;
+        }
+
+        for (std::size_t column = 0U; column < column_count; ++column) {
+          const auto first = heights.begin() + column_offsets[column];
+          const auto last = heights.begin() + column_offsets[column + 1U];
+          std::sort(first, last);
+          // With an odd number of crossings the mesh has a hole, the last
+          // one is dropped.
+          for (auto enter = first; last - enter >= 2; enter += 2) {
+            const auto voxels =
+                getCenterRange(*enter, *(enter + 1), grid.voxel_size,
+                               size_z);
+            setBits(grid.words.data() +
+                        (column + size_x * rows.first) *
+                            grid.words_per_column,
+                    voxels.first, voxels.second);
+          }
+        }
+      });
+  return grid;
+}
+
+std::size_t VoxelGrid::countFilled() const {
+  std::size_t count = 0U;
+  for (const auto word : words) {
+    count += std::bitset<64U>(word).count();
+  }
+  return count;
+}
+
+double VoxelGrid::calculateVolume() const {
+  return static_cast<double>(countFilled()) * voxel_size * voxel_size *
+         voxel_size;
+}
+
+void VoxelGrid::write(std::ostream &out_stream) const {
+  // NRRD places the samples at the voxel centers.
+  const Eigen::Vector3d first_center =
+      origin + Eigen::Vector3d::Constant(voxel_size / 2.0);
+  out_stream << std::setprecision(std::numeric_limits<double>::max_digits10);
+  out_stream << "NRRD0004\n"
+             << "# Solid voxelization, 1 inside the mesh\n"
+             << "type: uchar\n"
+             << "dimension: 3\n"
+             << "space dimension: 3\n"
+             << "sizes: " << dimensions[0U] << ' ' << dimensions[1U] << ' '
+             << dimensions[2U] << '\n'
+             << "space directions: (" << voxel_size << ",0,0) (0,"
+             << voxel_size << ",0) (0,0," << voxel_size << ")\n"
+             << "space origin: (" << first_center.x() << ','
+             << first_center.y() << ',' << first_center.z() << ")\n"
+             << "encoding: raw\n\n";
+
+  std::vector<char> layer(dimensions[0U] * dimensions[1U]);
+  for (std::size_t z = 0U; z < dimensions[2U]; ++z) {
+    const std::size_t word = z / 64U;
+    const std::size_t bit = z % 64U;
+    for (std::size_t column = 0U; column < layer.size(); ++column) {
+      layer[column] = static_cast<char>(
+          (words[column * words_per_column + word] >> bit) & 1U);
+    }
+    out_stream.write(layer.data(), static_cast<std::streamsize>(layer.size()));
+  }
+}
+
+} // namespace Converter
@@ -0,0 +1,145 @@
+#ifndef VOXEL_GRID_HPP
+#define VOXEL_GRID_HPP
+
+#include <Eigen/Dense>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace Converter {
+
+class MeshData;
+
+/**
+ * @brief Solid voxelization of a mesh, stored as one bit per voxel.
+ * @details The voxels are stored in columns along the z axis, every column
+ * is packed into 64-bit words with the lowest bit being the lowest voxel.
+ * The mesh is voxelized by casting a ray along z through the center of
+ * every column: the Triangles are rasterized into the columns, collecting
+ * the heights they cross the column centers at, and the voxels between
+ * every odd and even crossing are filled. The Triangles are binned into
+ * blocks of rows first, and the blocks are rasterized and filled in
+ * parallel. The crossings of a column center lying exactly on an edge or a
+ * vertex are counted for only one of the Triangles sharing it, with the
+ * same top-left rule as the watertight ray test, so a closed mesh always
+ * produces an even number of crossings per column.
+ */
+class VoxelGrid {
+public:
+  /**
+   * @brief The default number of voxels along the longest side of the
+   * bounding box.
+   */
+  static constexpr std::size_t c_default_resolution = 256U;
+
+  /**
+   * @brief Voxelizes the inside of a mesh.
+   * @details A voxel is filled if its center is inside of the mesh.
+   * @note The pending transformation of the mesh is applied. The mesh
+   * should be closed, the columns crossing a hole may be filled wrongly. The
+   * result does not depend on the number of threads.
+   * @param mesh The mesh to be voxelized.
+   * @param resolution The number of voxels along the longest side of the
+   * bounding box of the mesh.
+   * @return The voxels, covering the bounding box of the mesh. Empty if the
+   * mesh has no Triangles.
+   */
+  static VoxelGrid voxelize(const MeshData &mesh,
+                            std::size_t resolution = c_default_resolution);
+
+  /**
+   * @brief Returns the number of voxels along each axis.
+   * @return The number of voxels along x, y and z.
+   */
+  const std::array<std::size_t, 3U> &getDimensions() const {
+    return dimensions;
+  }
+
+  /**
+   * @brief Returns the position of the lowest corner of the grid.
+   * @return The minimum corner of the voxel (0, 0, 0).
+   */
+  const Eigen::Vector3d &getOrigin() const { return origin; }
+
+  /**
+   * @brief Returns the edge length of a voxel.
+   * @return The size of a voxel.
+   */
+  double getVoxelSize() const { return voxel_size; }
+
+  /**
+   * @brief Returns the number of 64-bit words of a column.
+   * @return The number of words holding the voxels along z.
+   */
+  std::size_t getWordsPerColumn() const { return words_per_column; }
+
+  /**
+   * @brief Returns the packed voxels.
+   * @return The words of the columns, the column of the voxels (x, y, *)
+   * starts at (x + y * dimensions[0]) * getWordsPerColumn().
+   */
+  const std::vector<std::uint64_t> &getWords() const { return words; }
+
+  /**
+   * @brief Returns if a voxel is inside of the mesh.
+   * @param x The index of the voxel along the x axis.
+   * @param y The index of the voxel along the y axis.
+   * @param z The index of the voxel along the z axis.
+   * @return True if the voxel is filled, otherwise false.
+   */
+  bool isFilled(std::size_t x, std::size_t y, std::size_t z) const {
+    const std::size_t column = x + dimensions[0U] * y;
+    return ((words[column * words_per_column + z / 64U] >> (z % 64U)) &
+            1U) != 0U;
+  }
+
+  /**
+   * @brief Counts the filled voxels.
+   * @return The number of voxels inside of the mesh.
+   */
+  std::size_t countFilled() const;
+
+  /**
+   * @brief Calculates the volume of the filled voxels.
+   * @return The number of filled voxels times the volume of a voxel.
+   */
+  double calculateVolume() const;
+
+  /**
+   * @brief Writes the voxels as an NRRD file.
+   * @details A short text header describing the dimensions, the spacing and
+   * the position of the first voxel center is followed by one unsigned byte
+   * per voxel, 1 inside the mesh and 0 outside, with x changing the
+   * fastest, then y, then z. The columns are unpacked one z layer at a time.
+   * @param out_stream The binary stream to write to.
+   */
+  void write(std::ostream &out_stream) const;
+
+private:
+  /**
+   * @brief Holds the number of voxels along each axis.
+   */
+  std::array<std::size_t, 3U> dimensions = {0U, 0U, 0U};
+  /**
+   * @brief Holds the position of the lowest corner of the grid.
+   */
+  Eigen::Vector3d origin = Eigen::Vector3d::Zero();
+  /**
+   * @brief Holds the edge length of a voxel.
+   */
+  double voxel_size = 0.0;
+  /**
+   * @brief Holds the number of words of a column.
+   */
+  std::size_t words_per_column = 0U;
+  /**
+   * @brief Holds the packed voxels, column by column.
+   */
+  std::vector<std::uint64_t> words;
+};
+
+} // namespace Converter
+
+#endif
@@ -0,0 +1,162 @@
+#include <Eigen/Dense>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "affine_transform.hpp"
+#include "bvh.hpp"
+#include "meshdata.hpp"
+#include "winding_number.hpp"
+
+namespace Converter {
+
+namespace {
+
+constexpr double c_four_pi = 4.0 * 3.141592653589793238;
+
+} // namespace
+
+WindingNumber::WindingNumber(const MeshData &mesh, double accuracy)
+    : bvh(mesh.triangles), accuracy(accuracy) {
+  const auto &transformation = mesh.getPendingTransform();
+  triangles.reserve(bvh.triangle_indices.size());
+  for (const auto index : bvh.triangle_indices) {
+    const auto &triangle = mesh.triangles[index];
+    triangles.push_back(
+        {transformation.transformPoint(triangle.a.pos).head<3>(),
+         transformation.transformPoint(triangle.b.pos).head<3>(),
+         transformation.transformPoint(triangle.c.pos).head<3>()});
+  }
+
+  // The hierarchy was built before the transformation, its boxes have to be
+  // recalculated.
+  if (transformation.getKind() != AffineTransform::Kind::IDENTITY) {
+    bvh.refit([this](std::size_t node_index) {
+      const auto &node = bvh.nodes[node_index];
+      Eigen::AlignedBox3d box;
+      box.setEmpty();
+      for (std::uint32_t j = node.first; j < node.first + node.count; ++j) {
+        for (const auto &vertex : triangles[j]) {
+          box.extend(vertex);
+        }
+      }
+      return box;
+    });
+  }
+
+  // Children are always stored after their parents, so iterating backwards
+  // visits every child before its parent.
+  expansions.resize(bvh.nodes.size());
+  for (std::size_t i = bvh.nodes.size(); i-- > 0U;) {
+    const auto &node = bvh.nodes[i];
+    auto &expansion = expansions[i];
+
+    if (node.isLeaf()) {
+      for (std::uint32_t j = node.first; j < node.first + node.count; ++j) {
+        const auto &[a, b, c] = triangles[j];
+        const Eigen::Vector3d cross = (b - a).cross(c - a);
+        const double area = cross.norm() / 2.0;
+        expansion.normal_sum += cross / 2.0;
+        expansion.center += area * (a + b + c) / 3.0;
+        expansion.area += area;
+      }
+      expansion.center =
+          expansion.area > 0.0
+              ? Eigen::Vector3d(expansion.center / expansion.area)
+              : node.box.center();
+      for (std::uint32_t j = node.first; j < node.first + node.count; ++j) {
+        const auto &[a, b, c] = triangles[j];
+        const Eigen::Vector3d offset = (a + b + c) / 3.0 - expansion.center;
+        expansion.moment += offset * ((b - a).cross(c - a) / 2.0).transpose();
+        for (const auto &vertex : triangles[j]) {
+          expansion.radius =
+              std::max(expansion.radius, (vertex - expansion.center).norm());
+        }
+      }
+    } else {
+      const auto &left = expansions[node.first];
+      const auto &right = expansions[node.first + 1U];
+      expansion.normal_sum = left.normal_sum + right.normal_sum;
+      expansion.area = left.area + right.area;
+      expansion.center =
+          expansion.area > 0.0
+              ? Eigen::Vector3d((left.area * left.center +
+                                 right.area * right.center) /
+                                expansion.area)
+              : node.box.center();
+      // Shifts the moments of the children to the new center.
+      expansion.moment =
+          left.moment + right.moment +
+          (left.center - expansion.center) * left.normal_sum.transpose() +
+          (right.center - expansion.center) * right.normal_sum.transpose();
+      expansion.radius =
+          std::max((left.center - expansion.center).norm() + left.radius,
+                   (right.center - expansion.center).norm() + right.radius);
+    }
+  }
+}
+
+double WindingNumber::triangleWindingNumber(const Eigen::Vector3d &a,
+                                            const Eigen::Vector3d &b,
+                                            const Eigen::Vector3d &c) {
+  // Van Oosterom and Strackee's formula for the solid angle of a triangle.
+  const double a_norm = a.norm();
+  const double b_norm = b.norm();
+  const double c_norm = c.norm();
+  const double numerator = a.dot(b.cross(c));
+  const double denominator = a_norm * b_norm * c_norm + a.dot(b) * c_norm +
+                             b.dot(c) * a_norm + c.dot(a) * b_norm;
+  return 2.0 * std::atan2(numerator, denominator) / c_four_pi;
+}
+
+double WindingNumber::calculate(const Eigen::Vector4d &point) const {
+  if (bvh.empty()) {
+    return 0.0;
+  }
+
+  const Eigen::Vector3d query = point.head<3>();
+  double winding_number = 0.0;
+
+  std::vector<std::uint32_t> stack{0U};
+  while (!stack.empty()) {
+    const std::uint32_t node_index = stack.back();
+    stack.pop_back();
+
+    const auto &node = bvh.nodes[node_index];
+    const auto &expansion = expansions[node_index];
+    const Eigen::Vector3d to_center = expansion.center - query;
+    const double distance = to_center.norm();
+
+    if (distance > accuracy * expansion.radius) {
+      // The cluster is far enough to be approximated by the Taylor expansion
+      // of the dipole field around its center, up to the second term.
+      const double distance_cubed = distance * distance * distance;
+      const double first_order = to_center.dot(expansion.normal_sum);
+      const double second_order =
+          expansion.moment.trace() -
+          3.0 * to_center.dot(expansion.moment * to_center) /
+              (distance * distance);
+      winding_number +=
+          (first_order + second_order) / (c_four_pi * distance_cubed);
+    } else if (node.isLeaf()) {
+      for (std::uint32_t j = node.first; j < node.first + node.count; ++j) {
+        const auto &[a, b, c] = triangles[j];
+        winding_number += triangleWindingNumber(a - query, b - query,
+                                                c - query);
+      }
+    } else {
+      stack.push_back(node.first);
+      stack.push_back(node.first + 1U);
+    }
+  }
+
+  return winding_number;
+}
+
+bool WindingNumber::isPointInside(const Eigen::Vector4d &point) const {
+  return calculate(point) > 0.5;
+}
+
+} // namespace Converter
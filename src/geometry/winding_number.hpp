@@ -0,0 +1,113 @@
+#ifndef WINDING_NUMBER_HPP
+#define WINDING_NUMBER_HPP
+
+#include <Eigen/Dense>
+#include <array>
+#include <vector>
+
+#include "bvh.hpp"
+
+namespace Converter {
+
+class MeshData;
+
+/**
+ * @brief Acceleration structure for evaluating the generalized winding number
+ * of a mesh.
+ * @details The generalized winding number is the sum of the signed solid
+ * angles of the Triangles seen from the query point, divided by 4 pi. For a
+ * closed, consistently oriented mesh it is 1 inside and 0 outside, and it
+ * degrades gracefully for meshes with holes or overlaps, which is what makes
+ * it robust compared to counting ray intersections. The Triangles are grouped
+ * into a Bvh, and for each node the first two terms of the far field expansion
+ * are precomputed, so clusters far from the query point are evaluated in
+ * constant time. Only the clusters near the point are evaluated exactly,
+ * which gives roughly O(log n) work per query.
+ */
+class WindingNumber {
+public:
+  /**
+   * @brief The default ratio of the distance and the radius of a cluster
+   * above which the far field approximation is used.
+   */
+  static constexpr double c_default_accuracy = 2.0;
+
+  /**
+   * @brief Builds the acceleration structure for the mesh.
+   * @param mesh The mesh whose winding number should be evaluated.
+   * @param accuracy The ratio of the distance and the radius of a cluster
+   * above which the far field approximation is used, greater is more
+   * accurate but slower.
+   */
+  explicit WindingNumber(const MeshData &mesh,
+                         double accuracy = c_default_accuracy);
+
+  /**
+   * @brief Calculates the generalized winding number at a point.
+   * @param point The point the winding number should be calculated at.
+   * @return The winding number, close to 1 inside and close to 0 outside
+   * of the mesh.
+   */
+  double calculate(const Eigen::Vector4d &point) const;
+
+  /**
+   * @brief Determines if a point is inside the mesh or not.
+   * @param point The point you wish to know if it's inside.
+   * @return True if the winding number at the point is above 0.5, otherwise
+   * false.
+   */
+  bool isPointInside(const Eigen::Vector4d &point) const;
+
+private:
+  /**
+   * @brief The far field expansion of a Bvh node.
+   * @param center The area weighted centroid of the Triangles.
+   * @param normal_sum The sum of the area weighted normals of the Triangles.
+   * @param moment The sum of the area weighted outer products of the
+   * Triangle centroid offsets and normals, used for the second order term.
+   * @param radius The radius of the sphere around the center containing all
+   * the Triangles.
+   * @param area The area of the Triangles.
+   */
+  struct Expansion {
+    Eigen::Vector3d center = Eigen::Vector3d::Zero();
+    Eigen::Vector3d normal_sum = Eigen::Vector3d::Zero();
+    Eigen::Matrix3d moment = Eigen::Matrix3d::Zero();
+    double radius = 0.0;
+    double area = 0.0;
+  };
+
+  /**
+   * @brief Calculates the solid angle of a single triangle seen from the
+   * origin, divided by 4 pi.
+   * @param a The first vertex relative to the query point.
+   * @param b The second vertex relative to the query point.
+   * @param c The third vertex relative to the query point.
+   * @return The signed solid angle divided by 4 pi.
+   */
+  static double triangleWindingNumber(const Eigen::Vector3d &a,
+                                      const Eigen::Vector3d &b,
+                                      const Eigen::Vector3d &c);
+
+  /**
+   * @brief The hierarchy of the Triangle clusters.
+   */
+  Bvh bvh;
+  /**
+   * @brief The far field expansions, one for each node of the hierarchy.
+   */
+  std::vector<Expansion> expansions;
+  /**
+   * @brief The vertex positions of the Triangles, in the order of
+   * Bvh::triangle_indices.
+   */
+  std::vector<std::array<Eigen::Vector3d, 3U>> triangles;
+  /**
+   * @brief The distance to radius ratio of the far field approximation.
+   */
+  double accuracy;
+};
+
+} // namespace Converter
+
+#endif
@@ -1,23 +1,410 @@
 #include <Eigen/Dense>
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <optional>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include "CLI11.hpp"
 #include "exception.hpp"
+#include "geometry/affine_transform.hpp"
+#include "geometry/bounding_volumes.hpp"
+#include "geometry/closest_point_query.hpp"
+#include "geometry/connected_components.hpp"
+#include "geometry/convex_hull.hpp"
+#include "geometry/decimation.hpp"
+#include "geometry/distance_field.hpp"
+#include "geometry/indexed_mesh.hpp"
+#include "geometry/mesh_statistics.hpp"
+#include "geometry/mesh_validation.hpp"
+#include "geometry/mesh_distance.hpp"
+#include "geometry/mesh_intersection.hpp"
 #include "geometry/meshdata.hpp"
+#include "geometry/quantized_mesh.hpp"
+#include "geometry/slice_stack.hpp"
 #include "geometry/triangle.hpp"
+#include "geometry/vertex_cache.hpp"
+#include "geometry/vertex_normals.hpp"
+#include "geometry/voxel_grid.hpp"
+#include "geometry/winding_number.hpp"
+#include "parallel.hpp"
 #include "reader/reader_factory.hpp"
 #include "utility.hpp"
 #include "writer/writer_factory.hpp"
 
 using namespace Converter;
 
+namespace {
+
+/**
+ * @brief Writes a vector to the stream in (x, y, z) format.
+ */
+void printVector(std::ostream &out_stream, const Eigen::Vector3d &vector) {
+  out_stream << "(" << vector.x() << ", " << vector.y() << ", " << vector.z()
+             << ")";
+}
+
+/**
+ * @brief Writes the statistics of the mesh to stdout.
+ * @param statistics The statistics to be written.
+ * @param detailed If false only the area and the volume is written.
+ */
+void printStatistics(const MeshStatistics &statistics, bool detailed) {
+  std::cout << std::setprecision(std::numeric_limits<double>::digits10)
+            << "Area: " << statistics.getSurfaceArea() << std::endl;
+  std::cout << std::setprecision(std::numeric_limits<double>::digits10)
+            << "Volume: " << std::abs(statistics.getSignedVolume())
+            << std::endl;
+
+  if (!detailed) {
+    return;
+  }
+
+  std::cout << "Triangles: " << statistics.getTriangleCount() << std::endl;
+  std::cout << "Degenerate triangles: " << statistics.getDegenerateCount()
+            << std::endl;
+  if (!statistics.getBoundingBox().isEmpty()) {
+    std::cout << "Bounding box: ";
+    printVector(std::cout, statistics.getBoundingBox().min());
+    std::cout << " - ";
+    printVector(std::cout, statistics.getBoundingBox().max());
+    std::cout << std::endl;
+  }
+  std::cout << "Centroid: ";
+  printVector(std::cout, statistics.getCentroid());
+  std::cout << std::endl;
+
+  const Eigen::Matrix3d inertia_tensor = statistics.getInertiaTensor();
+  std::cout << "Inertia tensor:" << std::endl;
+  for (Eigen::Index row = 0; row < 3; ++row) {
+    std::cout << "\t";
+    printVector(std::cout, inertia_tensor.row(row).transpose());
+    std::cout << std::endl;
+  }
+}
+
+/**
+ * @brief Writes the bounding volumes of the mesh to stdout.
+ * @param volumes The bounding volumes to be written.
+ */
+void printBoundingVolumes(const BoundingVolumes &volumes) {
+  const auto &box = volumes.getAxisAlignedBox();
+  if (box.isEmpty()) {
+    return;
+  }
+  std::cout << "Axis aligned box: ";
+  printVector(std::cout, box.min());
+  std::cout << " - ";
+  printVector(std::cout, box.max());
+  std::cout << ", volume " << box.volume() << std::endl;
+
+  const auto &oriented_box = volumes.getOrientedBox();
+  std::cout << "Oriented box: center ";
+  printVector(std::cout, oriented_box.center);
+  std::cout << ", half sizes ";
+  printVector(std::cout, oriented_box.half_sizes);
+  std::cout << ", volume " << oriented_box.getVolume() << std::endl;
+  std::cout << "Oriented box axes:" << std::endl;
+  for (Eigen::Index column = 0; column < 3; ++column) {
+    std::cout << "\t";
+    printVector(std::cout, oriented_box.axes.col(column));
+    std::cout << std::endl;
+  }
+
+  const auto &sphere = volumes.getSphere();
+  std::cout << "Bounding sphere: center ";
+  printVector(std::cout, sphere.center);
+  std::cout << ", radius " << sphere.radius << std::endl;
+}
+
+/**
+ * @brief Splits the mesh into its connected components, writes the
+ * statistics of each to stdout, and each to its own file.
+ * @details The i-th component is written next to the output file, with _i
+ * appended to its name.
+ * @param indexed_mesh The welded mesh.
+ * @param output_filename The path of the output file.
+ * @param writer The writer of the output format.
+ */
+void writeComponents(const IndexedMesh &indexed_mesh,
+                     const std::string &output_filename, IWriter &writer) {
+  const auto components = ConnectedComponents::label(indexed_mesh);
+  const auto meshes = components.split(indexed_mesh);
+  std::cout << "Components: " << meshes.size() << std::endl;
+
+  const std::filesystem::path output_path(output_filename);
+  for (std::size_t i = 0U; i < meshes.size(); ++i) {
+    const auto mesh = meshes[i].toMeshData();
+    const auto statistics = MeshStatistics::calculate(mesh);
+    std::cout << "Component " << i << ": " << statistics.getTriangleCount()
+              << " triangles, area " << statistics.getSurfaceArea()
+              << ", volume " << std::abs(statistics.getSignedVolume())
+              << ", bounding box ";
+    printVector(std::cout, statistics.getBoundingBox().min());
+    std::cout << " - ";
+    printVector(std::cout, statistics.getBoundingBox().max());
+    std::cout << std::endl;
+
+    auto component_path = output_path;
+    component_path.replace_filename(output_path.stem().string() + "_" +
+                                    std::to_string(i) +
+                                    output_path.extension().string());
+    std::ofstream out_file;
+    out_file.open(component_path, std::ios_base::binary);
+    writer.write(out_file, mesh);
+  }
+}
+
+/**
+ * @brief Checks if any Triangle of the mesh has normals or texture
+ * coordinates, which are lost when it is rebuilt from an IndexedMesh.
+ * @param mesh The mesh to be checked.
+ * @return True if any of them is not zero.
+ */
+bool hasAttributes(const MeshData &mesh) {
+  return std::any_of(
+      mesh.triangles.begin(), mesh.triangles.end(),
+      [](const Triangle &triangle) {
+        for (const auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+          if (!vertex->normal.isZero(0.0) || !vertex->texture.isZero(0.0)) {
+            return true;
+          }
+        }
+        return false;
+      });
+}
+
+/**
+ * @brief Writes the result of the mesh validation to stdout.
+ * @param validation The result to be written.
+ */
+void printValidation(const MeshValidation &validation) {
+  std::cout << "Boundary edges: " << validation.getBoundaryEdges().size()
+            << std::endl;
+  std::cout << "Non-manifold edges: "
+            << validation.getNonManifoldEdges().size() << std::endl;
+  std::cout << "Inconsistently oriented edges: "
+            << validation.getInconsistentEdges().size() << std::endl;
+  std::cout << "Degenerate faces: " << validation.getDegenerateFaces().size()
+            << std::endl;
+  if (!validation.isValid()) {
+    std::cout << "WARNING: The mesh is not a closed, consistently oriented "
+                 "manifold, the volume and the parity inside test are "
+                 "unreliable."
+              << std::endl;
+  }
+}
+
+/**
+ * @brief Reads rays from a stream, one ray per line.
+ * @details Every non-empty line holds the (x, y, z) coordinates of the origin
+ * followed by the (x, y, z) components of the direction, lines starting with
+ * # are skipped.
+ * @param in_stream The stream to read from.
+ * @param origins The vector the origins are appended to.
+ * @param directions The vector the directions are appended to.
+ * @throw IllFormedFileException if a line doesn't hold six numbers or the
+ * direction is zero.
+ */
+void readRays(std::istream &in_stream, std::vector<Eigen::Vector4d> &origins,
+              std::vector<Eigen::Vector4d> &directions) {
+  std::string line;
+  while (std::getline(in_stream, line)) {
+    std::istringstream line_stream(line);
+    std::string first_word;
+    if (!(line_stream >> first_word) || first_word[0U] == '#') {
+      continue;
+    }
+    line_stream.clear();
+    line_stream.seekg(0);
+
+    Eigen::Vector4d origin{0.0, 0.0, 0.0, 1.0};
+    Eigen::Vector4d direction{0.0, 0.0, 0.0, 0.0};
+    line_stream >> origin.x() >> origin.y() >> origin.z() >> direction.x() >>
+        direction.y() >> direction.z();
+    if (!line_stream || direction.isZero(0.0)) {
+      throw IllFormedFileException();
+    }
+    origins.push_back(origin);
+    directions.push_back(direction);
+  }
+}
+
+/**
+ * @brief Casts the rays against the mesh and writes the hits to stdout.
+ * @param mesh The mesh the rays are cast against.
+ * @param origins The starting points of the rays.
+ * @param directions The directions of the rays.
+ */
+void printRayHits(const MeshData &mesh,
+                  const std::vector<Eigen::Vector4d> &origins,
+                  const std::vector<Eigen::Vector4d> &directions) {
+  const auto hits = mesh.castRays(origins, directions);
+  for (std::size_t i = 0U; i < hits.size(); ++i) {
+    std::cout << "Ray " << i << ": ";
+    if (!hits[i]) {
+      std::cout << "no hit" << std::endl;
+      continue;
+    }
+    const Eigen::Vector4d point = origins[i] + hits[i]->t * directions[i];
+    std::cout << "triangle " << hits[i]->triangle_index << " at ";
+    printVector(std::cout, point.head<3>());
+    std::cout << ", t = " << hits[i]->t << std::endl;
+  }
+}
+
+/**
+ * @brief Reads points from a stream, one point per line.
+ * @details Every non-empty line holds the (x, y, z) coordinates of a point,
+ * lines starting with # are skipped.
+ * @param in_stream The stream to read from.
+ * @return The points read.
+ * @throw IllFormedFileException if a line doesn't hold three numbers.
+ */
+std::vector<Eigen::Vector4d> readPoints(std::istream &in_stream) {
+  std::vector<Eigen::Vector4d> points;
+  std::string line;
+  while (std::getline(in_stream, line)) {
+    std::istringstream line_stream(line);
+    std::string first_word;
+    if (!(line_stream >> first_word) || first_word[0U] == '#') {
+      continue;
+    }
+    line_stream.clear();
+    line_stream.seekg(0);
+
+    Eigen::Vector4d point{0.0, 0.0, 0.0, 1.0};
+    line_stream >> point.x() >> point.y() >> point.z();
+    if (!line_stream) {
+      throw IllFormedFileException();
+    }
+    points.push_back(point);
+  }
+  return points;
+}
+
+/**
+ * @brief Finds the closest points of the mesh and writes them to stdout.
+ * @param mesh The mesh the closest points are searched on.
+ * @param points The query points.
+ */
+void printClosestPoints(const MeshData &mesh,
+                        const std::vector<Eigen::Vector4d> &points) {
+  const auto results = ClosestPointQuery(mesh).findClosestPoints(points);
+  for (std::size_t i = 0U; i < results.size(); ++i) {
+    std::cout << "Point " << i << ": ";
+    if (!results[i]) {
+      std::cout << "no triangles" << std::endl;
+      continue;
+    }
+    std::cout << "distance " << results[i]->distance << " to triangle "
+              << results[i]->triangle_index << " at ";
+    printVector(std::cout, results[i]->point.head<3>());
+    std::cout << std::endl;
+  }
+}
+
+/**
+ * @brief Reads a mesh from a file, with the reader of its extension.
+ * @param filename The path of the file.
+ * @return The mesh read, without a transformation.
+ * @throw UnsupportedInputFormatException if the extension is not supported.
+ * @throw FileNotFoundException if the file cannot be opened.
+ */
+MeshData readMesh(const std::string &filename) {
+  const auto format = Reader::convertInputFormatToEnum(Utility::toLower(
+      std::filesystem::path(filename).extension().string()));
+  if (format == Reader::InputFormat::INVALID) {
+    throw UnsupportedInputFormatException();
+  }
+  auto reader = ReaderFactory::createReader(format);
+  if (!reader) {
+    return {};
+  }
+  std::ifstream in_stream(filename);
+  if (!in_stream) {
+    throw FileNotFoundException();
+  }
+  return reader->read(in_stream);
+}
+
+/**
+ * @brief Writes the number of intersecting pairs of Triangles to stdout.
+ * @param label The name of the pairs.
+ * @param pairs The indices of the intersecting Triangles.
+ * @param list If true every pair is written on its own line.
+ */
+void printIntersections(const std::string &label,
+                        const std::vector<MeshIntersection::Pair> &pairs,
+                        bool list) {
+  std::cout << label << ": " << pairs.size() << std::endl;
+  if (list) {
+    for (const auto &[first, second] : pairs) {
+      std::cout << "\t" << first << " " << second << std::endl;
+    }
+  }
+}
+
+/**
+ * @brief Writes the distances of the mesh and a compared mesh to stdout.
+ * @param distance The distances of the samples of the meshes.
+ */
+void printDistance(const MeshDistance &distance) {
+  const auto printOneSided = [](const std::string &label,
+                                const MeshDistance::OneSided &one_sided) {
+    std::cout << label << ": max " << one_sided.max << ", mean "
+              << one_sided.mean << ", RMS " << one_sided.rms << " over "
+              << one_sided.sample_count << " samples";
+    if (one_sided.sample_count > 0U) {
+      std::cout << ", farthest at ";
+      printVector(std::cout, one_sided.farthest_point.head<3>());
+    }
+    std::cout << std::endl;
+  };
+  printOneSided("Distance to compared mesh", distance.getFirstToSecond());
+  printOneSided("Distance from compared mesh", distance.getSecondToFirst());
+  std::cout << "Hausdorff distance: " << distance.getHausdorff()
+            << ", RMS distance: " << distance.getRms() << std::endl;
+}
+
+/**
+ * @brief Writes every layer of a sliced mesh to its own SVG file, and a
+ * summary to stdout.
+ * @details The layer numbers are padded with zeros to the same width, so
+ * the files sort by height.
+ * @param stack The sliced mesh.
+ * @param prefix The path the layer numbers are appended to.
+ */
+void writeSlices(const SliceStack &stack, const std::string &prefix) {
+  const auto &layers = stack.getLayers();
+  std::size_t contour_count = 0U;
+  for (const auto &layer : layers) {
+    contour_count += layer.contours.size();
+  }
+  std::cout << "Slices: " << layers.size() << " layers, " << contour_count
+            << " contours, " << stack.countOpenContours() << " open"
+            << std::endl;
+
+  const std::size_t width = std::to_string(layers.size()).size();
+  for (std::size_t i = 0U; i < layers.size(); ++i) {
+    std::ostringstream filename;
+    filename << prefix << std::setw(static_cast<int>(width))
+             << std::setfill('0') << i << ".svg";
+    std::ofstream out_file(filename.str());
+    stack.writeSvg(out_file, i);
+  }
+}
+
+} // namespace
+
 int main(int argc, char *argv[]) {
 
   if constexpr (!std::numeric_limits<float>::is_iec559 || sizeof(float) != 4U) {
@@ -43,19 +430,230 @@ int main(int argc, char *argv[]) {
   app.add_option("--is_point_inside", is_point_inside_args,
                  "Specifies the (x,y,z) coordinates of the point you wish to "
                  "know if it is inside the mesh or not.");
+  std::string inside_test = "parity";
+  app.add_option("--inside_test", inside_test,
+                 "Specifies the algorithm of --is_point_inside, parity counts "
+                 "ray intersections, winding_number is robust to meshes with "
+                 "holes. Default is parity.")
+      ->check(CLI::IsMember({"parity", "winding_number"}));
+  std::string slice_prefix;
+  app.add_option("--slice", slice_prefix,
+                 "Slices the mesh along z and writes the contours of every "
+                 "layer to an SVG file, named by the given prefix followed "
+                 "by the number of the layer.");
+  double layer_height = SliceStack::c_default_layer_height;
+  app.add_option("--layer_height", layer_height,
+                 "Specifies the distance of the planes of --slice. Default "
+                 "is 0.2.")
+      ->check(CLI::PositiveNumber)
+      ->needs("--slice");
+  std::string rays_filename;
+  app.add_option("--cast_rays", rays_filename,
+                 "Specifies a file of rays to cast against the mesh, one "
+                 "\"x y z dx dy dz\" ray per line. The closest hit of every "
+                 "ray is written.");
+  std::string points_filename;
+  app.add_option("--closest_points", points_filename,
+                 "Specifies a file of points, one \"x y z\" point per line. "
+                 "The distance of every point from the mesh and the closest "
+                 "point of the mesh are written.");
+  std::string sdf_filename;
+  app.add_option("--sdf", sdf_filename,
+                 "Writes the signed distance field of the mesh to the given "
+                 "NRRD file, negative inside the mesh.");
+  DistanceField::Settings sdf_settings;
+  app.add_option("--sdf_resolution", sdf_settings.resolution,
+                 "Specifies the number of voxels of --sdf along the longest "
+                 "side of the bounding box. Default is 64.")
+      ->check(CLI::PositiveNumber)
+      ->needs("--sdf");
+  std::size_t sdf_band = 0U;
+  app.add_option("--sdf_band", sdf_band,
+                 "Only calculates the distances of --sdf within the given "
+                 "number of voxels of the surface, the farther voxels are set "
+                 "to that distance.")
+      ->check(CLI::PositiveNumber)
+      ->needs("--sdf");
+  std::size_t voxel_resolution = 0U;
+  app.add_option("--voxelize", voxel_resolution,
+                 "Voxelizes the inside of the mesh with the given number of "
+                 "voxels along the longest side of the bounding box, and "
+                 "writes the number of filled voxels and their volume.")
+      ->check(CLI::PositiveNumber);
+  std::string voxel_filename;
+  app.add_option("--voxel_file", voxel_filename,
+                 "Writes the voxels of --voxelize to the given NRRD file, "
+                 "one byte per voxel, 1 inside the mesh.")
+      ->needs("--voxelize");
+  double weld_tolerance = 0.0;
+  app.add_option("--weld", weld_tolerance,
+                 "Merges the vertices closer than the given tolerance after "
+                 "reading the input, zero merges only the identical ones. "
+                 "The normals and texture coordinates are kept.")
+      ->check(CLI::NonNegativeNumber);
+  double cluster_size = 0.0;
+  auto cluster_option =
+      app.add_option("--cluster", cluster_size,
+                     "Simplifies the mesh after reading the input by merging "
+                     "the vertices in every cell of a grid with the given "
+                     "cell size into their average, and dropping the "
+                     "collapsed triangles. Much faster but coarser than "
+                     "--decimate. Drops the normals and texture "
+                     "coordinates.")
+          ->check(CLI::PositiveNumber);
+  bool spatial_sort = false;
+  app.add_flag("--spatial_sort", spatial_sort,
+               "Reorders the triangles along a Z-order curve after reading "
+               "the input, which speeds up the spatial queries and is kept "
+               "in the output file.");
+  bool validate_set = false;
+  app.add_flag("--validate", validate_set,
+               "Checks if the mesh is closed, manifold and consistently "
+               "oriented, and reports the degenerate faces. The vertices are "
+               "welded with the --weld tolerance, zero if it is not set.");
+  bool split_components = false;
+  app.add_flag("--split_components", split_components,
+               "Writes every connected component of the mesh to its own file, "
+               "named after the output file with _<index> appended, and "
+               "writes the statistics of each. The vertices are welded with "
+               "the --weld tolerance, zero if it is not set. Drops the "
+               "normals and texture coordinates.");
+  std::size_t decimate_target = 0U;
+  app.add_option("--decimate", decimate_target,
+                 "Simplifies the mesh before writing it, until it has at "
+                 "most the given number of triangles. The mesh is split "
+                 "into --decimate_partitions slabs, simplified in parallel. "
+                 "The vertices are welded with the --weld tolerance, zero if "
+                 "it is not set. Drops the normals and texture "
+                 "coordinates.");
+  double decimate_error = std::numeric_limits<double>::infinity();
+  app.add_option("--decimate_error", decimate_error,
+                 "Stops the simplification of --decimate when the distance "
+                 "error of the next edge collapse is above the given value, "
+                 "even if the number of triangles is above the target.")
+      ->check(CLI::NonNegativeNumber);
+  std::size_t decimate_partitions = Decimation::c_default_partition_count;
+  app.add_option("--decimate_partitions", decimate_partitions,
+                 "Specifies the number of slabs --decimate simplifies in "
+                 "parallel, the result only depends on it and not on the "
+                 "number of threads. Default is 8.")
+      ->check(CLI::PositiveNumber);
+  bool optimize_vertex_cache = false;
+  app.add_flag("--optimize_vertex_cache", optimize_vertex_cache,
+               "Reorders the triangles for the vertex cache of GPUs before "
+               "writing the mesh, and writes the average cache miss ratio "
+               "before and after. The vertices are welded with the --weld "
+               "tolerance, zero if it is not set. Drops the normals and "
+               "texture coordinates.");
+  bool convex_hull = false;
+  app.add_flag("--convex_hull", convex_hull,
+               "Replaces the mesh by its convex hull before the statistics "
+               "and the output are calculated.")
+      ->excludes("--split_components");
+  bool bounding_volumes = false;
+  app.add_flag("--bounding_volumes", bounding_volumes,
+               "Writes the axis aligned bounding box, a tight oriented "
+               "bounding box and the minimal bounding sphere.");
+  std::string normals_weighting;
+  app.add_option("--normals", normals_weighting,
+                 "Recalculates the vertex normals of the mesh in memory, "
+                 "weighting the face normals by their area or by their angle "
+                 "at the vertex, and writes the number of vertices after "
+                 "splitting. STL only stores facet normals, so the output "
+                 "file does not change. The vertices are welded with the "
+                 "--weld tolerance, zero if it is not set.")
+      ->check(CLI::IsMember({"area", "angle"}))
+      ->excludes("--split_components");
+  double crease_angle = VertexNormals::c_no_crease;
+  app.add_option("--crease_angle", crease_angle,
+                 "Splits the vertex normals of --normals at the edges whose "
+                 "faces differ by more than the given angle in radians. "
+                 "Default is no splitting.")
+      ->check(CLI::NonNegativeNumber)
+      ->needs("--normals");
+  bool self_intersections = false;
+  app.add_flag("--self_intersections", self_intersections,
+               "Writes the number of pairs of triangles that intersect each "
+               "other, besides the vertices and edges they share.");
+  std::string interference_filename;
+  app.add_option("--interference", interference_filename,
+                 "Writes the number of pairs of triangles of the mesh and of "
+                 "the given mesh that intersect or touch. The "
+                 "transformation is only applied to the input mesh.");
+  bool list_intersections = false;
+  app.add_flag("--list_intersections", list_intersections,
+               "Writes the indices of every pair of --self_intersections "
+               "and --interference.");
+  std::string compare_filename;
+  app.add_option("--compare", compare_filename,
+                 "Compares the mesh, after every other change, with the "
+                 "given mesh by sampling both surfaces, and writes the "
+                 "one-sided and symmetric Hausdorff and RMS distances. The "
+                 "transformation is only applied to the input mesh.");
+  std::size_t compare_samples = MeshDistance::c_default_sample_count;
+  app.add_option("--compare_samples", compare_samples,
+                 "Specifies the number of points --compare samples on each "
+                 "mesh. Default is 100000.")
+      ->check(CLI::PositiveNumber)
+      ->needs("--compare");
+  unsigned int quantize_bits = 0U;
+  auto quantize_option =
+      app.add_option("--quantize", quantize_bits,
+                     "Quantizes the positions to the given number of bits "
+                     "per coordinate over the bounding box while reading the "
+                     "input, which is read twice instead of being stored at "
+                     "full precision, and writes the memory usage and the "
+                     "largest position error.")
+          ->check(CLI::IsMember({16U, 21U}));
+  unsigned int thread_count = 0U;
+  app.add_option("--threads", thread_count,
+                 "Specifies the number of threads to use. Default is the "
+                 "number of hardware threads.");
+  bool statistics_set = false;
+  app.add_flag("--statistics", statistics_set,
+               "Writes the triangle count, degenerate triangle count, bounding "
+               "box, centroid and inertia tensor besides the area and volume.");
+  bool analyze_only = false;
+  auto analyze_only_flag = app.add_flag(
+      "--analyze_only", analyze_only,
+      "Only calculates the statistics while reading the input, without "
+      "storing the mesh or writing an output file.");
   std::string input_filename;
   app.add_option("--input", input_filename, "The path to the input file.")
       ->required();
   std::string output_filename;
-  app.add_option("--output", output_filename, "The path to the output file.")
-      ->required();
+  app.add_option("--output", output_filename,
+                 "The path to the output file, required unless "
+                 "--analyze_only is set.");
+  // Both modes read the input as a stream, so the options working on the
+  // stored mesh are not available.
+  for (const auto *name :
+       {"--is_point_inside", "--slice", "--cast_rays", "--closest_points",
+        "--sdf", "--voxelize", "--weld", "--validate", "--split_components",
+        "--decimate", "--decimate_error", "--decimate_partitions", "--cluster",
+        "--spatial_sort", "--optimize_vertex_cache", "--convex_hull",
+        "--bounding_volumes", "--normals", "--self_intersections",
+        "--interference", "--list_intersections", "--compare",
+        "--compare_samples"}) {
+    analyze_only_flag->excludes(name);
+    quantize_option->excludes(name);
+  }
+  analyze_only_flag->excludes("--quantize");
+  cluster_option->excludes("--weld");
   CLI11_PARSE(app, argc, argv);
 
+  if (!analyze_only && output_filename.empty()) {
+    std::cerr << "ERROR: --output is required." << std::endl;
+    return -1;
+  }
+
   const bool scale_set = app.count("--scale") > 0U;
   const bool rotation_set = app.count("--rotate") > 0U;
   const bool translation_set = app.count("--translate") > 0U;
   const bool is_point_inside_set = app.count("--is_point_inside") > 0U;
 
+  Parallel::setThreadCount(thread_count);
+
   try {
     auto input_extension = Utility::toLower(
         std::filesystem::path(input_filename).extension().string());
@@ -71,62 +669,267 @@ int main(int argc, char *argv[]) {
       throw UnsupportedInputFormatException();
     }
 
-    if (output_extension_enum == Writer::OutputFormat::INVALID) {
+    if (!analyze_only &&
+        output_extension_enum == Writer::OutputFormat::INVALID) {
       throw UnsupportedOutputFormatException();
     }
 
+    const bool transform_set = scale_set || rotation_set || translation_set;
+    Eigen::Matrix4d translation_matrix;
+    translation_matrix.setIdentity();
+    Eigen::Matrix4d rotation_matrix;
+    rotation_matrix.setIdentity();
+    Eigen::Matrix4d scale_matrix;
+    scale_matrix.setIdentity();
+    if (scale_set) {
+      scale_matrix = Utility::getScaleMatrix(
+          {scale_args[0U], scale_args[1U], scale_args[2U]});
+    }
+    if (rotation_set) {
+      rotation_matrix = Utility::getRotationMatrix(
+          {rotation_args[0U], rotation_args[1U], rotation_args[2U]},
+          rotation_args[3U]);
+    }
+    if (translation_set) {
+      translation_matrix = Utility::getTranslationMatrix(
+          {translation_args[0U], translation_args[1U], translation_args[2U]});
+    }
+
     auto reader = ReaderFactory::createReader(input_extension_enum);
-    MeshData mesh;
+    std::ifstream in_file_stream;
     if (reader) {
-      std::ifstream in_file_stream;
       in_file_stream.open(input_filename);
       if (!in_file_stream) {
         throw FileNotFoundException();
       }
-      mesh = reader->read(in_file_stream);
     }
 
-    if (scale_set || rotation_set || translation_set) {
-      Eigen::Matrix4d scale_matrix;
-      scale_matrix.setIdentity();
-      if (scale_set) {
-        scale_matrix = Utility::getScaleMatrix(
-            {scale_args[0U], scale_args[1U], scale_args[2U]});
+    if (analyze_only) {
+      // The vertices are transformed while they are decoded and the Triangles
+      // are accumulated one by one, so the mesh is never stored.
+      MeshStatistics statistics;
+      if (reader) {
+        reader->setTransform(AffineTransform(
+            translation_matrix * rotation_matrix * scale_matrix));
+        reader->read(in_file_stream, [&statistics](const Triangle &triangle) {
+          statistics.add(triangle);
+        });
       }
+      printStatistics(statistics, statistics_set);
+      return 0;
+    }
 
-      Eigen::Matrix4d rotation_matrix;
-      rotation_matrix.setIdentity();
-      if (rotation_set) {
-        rotation_matrix = Utility::getRotationMatrix(
-            {rotation_args[0U], rotation_args[1U], rotation_args[2U]},
-            rotation_args[3U]);
+    if (quantize_bits > 0U) {
+      // The first pass finds the bounds, the second one quantizes the
+      // Triangles, so the mesh is never stored at full precision.
+      MeshStatistics statistics;
+      if (reader) {
+        reader->setTransform(AffineTransform(
+            translation_matrix * rotation_matrix * scale_matrix));
       }
+      bool is_first_pass = true;
+      const auto quantized = QuantizedMesh::encodeStreamed(
+          [&](const QuantizedMesh::TriangleCallback &callback) {
+            if (!reader) {
+              return;
+            }
+            in_file_stream.clear();
+            in_file_stream.seekg(0);
+            reader->read(in_file_stream, [&](const Triangle &triangle) {
+              if (is_first_pass) {
+                statistics.add(triangle);
+              }
+              callback(triangle);
+            });
+            is_first_pass = false;
+          },
+          quantize_bits);
+      printStatistics(statistics, statistics_set);
+      std::cout << "Quantized memory: " << quantized.getMemoryUsage()
+                << " bytes, max position error: "
+                << quantized.getMaxPositionError() << std::endl;
+      auto writer = WriterFactory::createWriter(output_extension_enum);
+      if (writer) {
+        std::ofstream out_file;
+        out_file.open(output_filename, std::ios_base::binary);
+        writer->write(out_file, quantized);
+      }
+      return 0;
+    }
 
-      Eigen::Matrix4d translation_matrix;
-      translation_matrix.setIdentity();
-      if (translation_set) {
-        translation_matrix = Utility::getTranslationMatrix(
-            {translation_args[0U], translation_args[1U], translation_args[2U]});
+    MeshData mesh;
+    if (reader) {
+      mesh = reader->read(in_file_stream);
+    }
+    if (spatial_sort) {
+      mesh.sortSpatially();
+    }
+
+    // The transformation is only applied while the statistics are calculated
+    // and while the mesh is written, which avoids a separate pass.
+    if (transform_set) {
+      mesh.deferTransform(translation_matrix, rotation_matrix, scale_matrix);
+    }
+
+    const bool weld_set = app.count("--weld") > 0U;
+    const bool cluster_set = app.count("--cluster") > 0U;
+    const bool decimate_set =
+        app.count("--decimate") > 0U || app.count("--decimate_error") > 0U;
+    if ((cluster_set || decimate_set || optimize_vertex_cache ||
+         split_components) &&
+        hasAttributes(mesh)) {
+      std::cout << "Dropped normals and texture coordinates" << std::endl;
+    }
+    std::optional<IndexedMesh> indexed_mesh;
+    if (cluster_set) {
+      indexed_mesh = IndexedMesh::cluster(mesh, cluster_size);
+      std::cout << "Clustered triangles: " << indexed_mesh->faces.size()
+                << " of " << mesh.triangles.size() << std::endl;
+      mesh = indexed_mesh->toMeshData();
+    }
+    if (weld_set || validate_set || split_components || decimate_set ||
+        optimize_vertex_cache) {
+      if (!indexed_mesh) {
+        indexed_mesh = IndexedMesh::weld(mesh, weld_tolerance);
+      }
+      if (weld_set) {
+        std::cout << "Welded vertices: " << indexed_mesh->vertices.size()
+                  << " of " << 3U * indexed_mesh->faces.size() << std::endl;
+        indexed_mesh->applyPositions(mesh);
+      }
+      if (validate_set) {
+        printValidation(MeshValidation::validate(*indexed_mesh));
+      }
+      if (decimate_set) {
+        Decimation::Settings settings;
+        settings.target_face_count = decimate_target;
+        settings.max_error = decimate_error;
+        settings.partition_count = decimate_partitions;
+        const std::size_t face_count = indexed_mesh->faces.size();
+        indexed_mesh = Decimation::decimate(*indexed_mesh, settings);
+        std::cout << "Decimated triangles: " << indexed_mesh->faces.size()
+                  << " of " << face_count << std::endl;
+        mesh = indexed_mesh->toMeshData();
+      }
+      if (optimize_vertex_cache) {
+        const double acmr = VertexCache::calculateAcmr(*indexed_mesh);
+        indexed_mesh = VertexCache::optimize(*indexed_mesh);
+        std::cout << "ACMR: " << acmr << " -> "
+                  << VertexCache::calculateAcmr(*indexed_mesh) << std::endl;
+        mesh = indexed_mesh->toMeshData();
       }
+    }
+
+    if (convex_hull) {
+      const std::size_t triangle_count = mesh.triangles.size();
+      mesh = ConvexHull::calculate(mesh);
+      std::cout << "Convex hull triangles: " << mesh.triangles.size()
+                << " of " << triangle_count << std::endl;
+    }
+
+    if (!normals_weighting.empty()) {
+      const auto welded = IndexedMesh::weld(mesh, weld_tolerance);
+      const auto normals = VertexNormals::calculate(
+          welded,
+          normals_weighting == "area" ? VertexNormals::Weighting::AREA
+                                      : VertexNormals::Weighting::ANGLE,
+          crease_angle);
+      normals.apply(mesh);
+      std::cout << "Vertex normals: " << normals.getSplitVertexCount()
+                << " vertices, " << welded.vertices.size()
+                << " before splitting" << std::endl;
+    }
+
+    printStatistics(MeshStatistics::calculate(mesh), statistics_set);
+
+    if (bounding_volumes) {
+      printBoundingVolumes(BoundingVolumes::calculate(mesh));
+    }
+
+    if (self_intersections) {
+      printIntersections("Self-intersecting triangle pairs",
+                         MeshIntersection::findSelfIntersections(mesh),
+                         list_intersections);
+    }
 
-      mesh.transform(translation_matrix, rotation_matrix, scale_matrix);
+    if (!interference_filename.empty()) {
+      printIntersections(
+          "Interfering triangle pairs",
+          MeshIntersection::findInterference(
+              mesh, readMesh(interference_filename)),
+          list_intersections);
     }
 
-    std::cout << std::setprecision(std::numeric_limits<double>::digits10)
-              << "Area: " << mesh.calculateSurfaceArea() << std::endl;
-    std::cout << std::setprecision(std::numeric_limits<double>::digits10)
-              << "Volume: " << mesh.calculateVolume() << std::endl;
+    if (!compare_filename.empty()) {
+      printDistance(MeshDistance::compare(mesh, readMesh(compare_filename),
+                                          compare_samples));
+    }
 
     if (is_point_inside_set) {
-      const bool is_inside = mesh.isPointInside(
-          {is_point_inside_args[0U], is_point_inside_args[1U],
-           is_point_inside_args[2U], 1.0});
+      const Eigen::Vector4d point{is_point_inside_args[0U],
+                                  is_point_inside_args[1U],
+                                  is_point_inside_args[2U], 1.0};
+      const bool is_inside = inside_test == "winding_number"
+                                 ? WindingNumber(mesh).isPointInside(point)
+                                 : mesh.isPointInside(point);
       std::cout << "Point is" << (is_inside ? "" : " not")
                 << " inside the mesh." << std::endl;
     }
 
+    if (!slice_prefix.empty()) {
+      writeSlices(SliceStack::slice(mesh, layer_height), slice_prefix);
+    }
+
+    if (!rays_filename.empty()) {
+      std::ifstream rays_stream(rays_filename);
+      if (!rays_stream) {
+        throw FileNotFoundException();
+      }
+      std::vector<Eigen::Vector4d> origins;
+      std::vector<Eigen::Vector4d> directions;
+      readRays(rays_stream, origins, directions);
+      printRayHits(mesh, origins, directions);
+    }
+
+    if (!points_filename.empty()) {
+      std::ifstream points_stream(points_filename);
+      if (!points_stream) {
+        throw FileNotFoundException();
+      }
+      printClosestPoints(mesh, readPoints(points_stream));
+    }
+
+    if (!sdf_filename.empty()) {
+      if (sdf_band > 0U) {
+        sdf_settings.band_width = sdf_band;
+        sdf_settings.is_narrow_band = true;
+      }
+      const auto field = DistanceField::generate(mesh, sdf_settings);
+      const auto &dimensions = field.getDimensions();
+      std::cout << "Distance field: " << dimensions[0U] << " x "
+                << dimensions[1U] << " x " << dimensions[2U]
+                << " voxels of size " << field.getVoxelSize() << std::endl;
+      std::ofstream sdf_file(sdf_filename, std::ios_base::binary);
+      field.write(sdf_file);
+    }
+
+    if (voxel_resolution > 0U) {
+      const auto grid = VoxelGrid::voxelize(mesh, voxel_resolution);
+      const auto &dimensions = grid.getDimensions();
+      std::cout << "Voxels: " << grid.countFilled() << " of "
+                << dimensions[0U] << " x " << dimensions[1U] << " x "
+                << dimensions[2U] << ", volume " << grid.calculateVolume()
+                << std::endl;
+      if (!voxel_filename.empty()) {
+        std::ofstream voxel_file(voxel_filename, std::ios_base::binary);
+        grid.write(voxel_file);
+      }
+    }
+
     auto writer = WriterFactory::createWriter(output_extension_enum);
-    if (writer) {
+    if (writer && split_components) {
+      writeComponents(*indexed_mesh, output_filename, *writer);
+    } else if (writer) {
       std::ofstream out_file;
       out_file.open(output_filename, std::ios_base::binary);
       writer->write(out_file, mesh);
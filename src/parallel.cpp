@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "parallel.hpp"
+
+namespace Converter {
+namespace Parallel {
+
+namespace {
+
+std::atomic<unsigned int> thread_count_setting{0U};
+
+/**
+ * @brief The number of values below which pairwiseSum stops splitting.
+ */
+constexpr std::size_t c_pairwise_base_size = 32U;
+
+/**
+ * @brief The number of independent accumulators in the base case, so the
+ * compiler can keep them in a single vector register.
+ */
+constexpr std::size_t c_accumulator_count = 4U;
+
+/**
+ * @brief The number of key bits sorted by a single radix sort pass.
+ */
+constexpr unsigned int c_radix_bits = 8U;
+
+/**
+ * @brief The number of buckets of a radix sort pass.
+ */
+constexpr std::size_t c_radix_size = std::size_t{1U} << c_radix_bits;
+
+} // namespace
+
+unsigned int getThreadCount() {
+  const unsigned int thread_count = thread_count_setting;
+  if (thread_count != 0U) {
+    return thread_count;
+  }
+  return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+void setThreadCount(unsigned int thread_count) {
+  thread_count_setting = thread_count;
+}
+
+Barrier::Barrier(std::size_t thread_count) : thread_count(thread_count) {}
+
+void Barrier::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  const std::size_t current_round = round;
+  if (++waiting_count == thread_count) {
+    waiting_count = 0U;
+    ++round;
+    condition.notify_all();
+    return;
+  }
+  condition.wait(lock, [this, current_round]() {
+    return round != current_round;
+  });
+}
+
+double pairwiseSum(const double *values, std::size_t count) {
+  if (count <= c_pairwise_base_size) {
+    double accumulators[c_accumulator_count] = {0.0, 0.0, 0.0, 0.0};
+    std::size_t i = 0U;
+    for (; i + c_accumulator_count <= count; i += c_accumulator_count) {
+      for (std::size_t j = 0U; j < c_accumulator_count; ++j) {
+        accumulators[j] += values[i + j];
+      }
+    }
+    for (std::size_t j = 0U; i < count; ++i, ++j) {
+      accumulators[j] += values[i];
+    }
+    return (accumulators[0U] + accumulators[1U]) +
+           (accumulators[2U] + accumulators[3U]);
+  }
+
+  const std::size_t half = count / 2U;
+  return pairwiseSum(values, half) + pairwiseSum(values + half, count - half);
+}
+
+void radixSort(std::vector<std::uint64_t> &keys,
+               std::vector<std::uint32_t> &values, unsigned int key_bits) {
+  const std::size_t size = keys.size();
+  const std::size_t chunk_count =
+      std::max<std::size_t>(std::min<std::size_t>(getThreadCount(),
+                                                  size / c_block_size),
+                            1U);
+  const std::size_t chunk_size = (size + chunk_count - 1U) / chunk_count;
+
+  std::vector<std::uint64_t> sorted_keys(size);
+  std::vector<std::uint32_t> sorted_values(size);
+  std::vector<std::array<std::size_t, c_radix_size>> offsets(chunk_count);
+  for (unsigned int shift = 0U; shift < key_bits; shift += c_radix_bits) {
+    const auto getDigit = [&keys, shift](std::size_t i) {
+      return static_cast<std::size_t>((keys[i] >> shift) &
+                                      (c_radix_size - 1U));
+    };
+
+    forEachBlock(size, chunk_size,
+                 [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                   auto &counts = offsets[chunk];
+                   counts.fill(0U);
+                   for (std::size_t i = begin; i < end; ++i) {
+                     ++counts[getDigit(i)];
+                   }
+                 });
+
+    // Turns the counts into the first position of every chunk and digit,
+    // ordered by digit first, then by chunk.
+    std::size_t position = 0U;
+    bool is_constant = false;
+    for (std::size_t digit = 0U; digit < c_radix_size; ++digit) {
+      const std::size_t digit_begin = position;
+      for (auto &chunk_offsets : offsets) {
+        const std::size_t count = chunk_offsets[digit];
+        chunk_offsets[digit] = position;
+        position += count;
+      }
+      is_constant = is_constant || position - digit_begin == size;
+    }
+    if (is_constant) {
+      continue;
+    }
+
+    forEachBlock(size, chunk_size,
+                 [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                   auto &positions = offsets[chunk];
+                   for (std::size_t i = begin; i < end; ++i) {
+                     const std::size_t target = positions[getDigit(i)]++;
+                     sorted_keys[target] = keys[i];
+                     sorted_values[target] = values[i];
+                   }
+                 });
+    keys.swap(sorted_keys);
+    values.swap(sorted_values);
+  }
+}
+
+} // namespace Parallel
+} // namespace Converter
@@ -0,0 +1,344 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Converter {
+namespace Parallel {
+
+/**
+ * @brief The default number of elements processed together by a single task.
+ * @details Reductions split their input into blocks of this size regardless
+ * of the number of threads, which is what makes their results reproducible.
+ */
+static constexpr std::size_t c_block_size = 1024U;
+
+/**
+ * @brief Returns the number of threads parallel algorithms should use.
+ * @return The number set by setThreadCount, or the number of hardware
+ * threads if it was not set.
+ */
+unsigned int getThreadCount();
+
+/**
+ * @brief Sets the number of threads parallel algorithms should use.
+ * @param thread_count The number of threads, zero means the number of
+ * hardware threads.
+ */
+void setThreadCount(unsigned int thread_count);
+
+/**
+ * @brief Calls a function for every block of a range, using multiple threads.
+ * @details The blocks are handed out to the threads dynamically, so the order
+ * of the calls is unspecified, but the boundaries of the blocks only depend on
+ * size and block_size.
+ * @tparam Func Callable with the signature void(std::size_t block_index,
+ * std::size_t begin, std::size_t end).
+ * @param size The number of elements in the range.
+ * @param block_size The number of elements in a block.
+ * @param func The function to be called for each block.
+ * @throw Rethrows the first exception thrown by func, after every thread
+ * finished.
+ */
+template <typename Func>
+void forEachBlock(std::size_t size, std::size_t block_size, const Func &func) {
+  block_size = std::max<std::size_t>(block_size, 1U);
+  const std::size_t block_count = (size + block_size - 1U) / block_size;
+  const std::size_t thread_count =
+      std::min<std::size_t>(getThreadCount(), block_count);
+
+  if (thread_count <= 1U) {
+    for (std::size_t block = 0U; block < block_count; ++block) {
+      func(block, block * block_size,
+           std::min(size, (block + 1U) * block_size));
+    }
+    return;
+  }
+
+  std::atomic<std::size_t> next_block{0U};
+  std::exception_ptr exception;
+  std::mutex exception_mutex;
+
+  const auto worker = [&]() {
+    try {
+      for (std::size_t block = next_block++; block < block_count;
+           block = next_block++) {
+        func(block, block * block_size,
+             std::min(size, (block + 1U) * block_size));
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(exception_mutex);
+      if (!exception) {
+        exception = std::current_exception();
+      }
+      next_block = block_count;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count - 1U);
+  for (std::size_t i = 1U; i < thread_count; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+/**
+ * @brief Blocks a fixed number of threads until all of them arrived.
+ * @details The barrier can be reused, the threads are released together and
+ * the next wait starts a new round.
+ */
+class Barrier {
+public:
+  /**
+   * @brief Creates a barrier for the given number of threads.
+   * @param thread_count The number of threads that have to call wait.
+   */
+  explicit Barrier(std::size_t thread_count);
+
+  /**
+   * @brief Blocks until every thread of the barrier called wait.
+   */
+  void wait();
+
+private:
+  /**
+   * @brief Guards the counters.
+   */
+  std::mutex mutex;
+
+  /**
+   * @brief Wakes up the threads at the end of a round.
+   */
+  std::condition_variable condition;
+
+  /**
+   * @brief The number of threads that have to call wait.
+   */
+  std::size_t thread_count;
+
+  /**
+   * @brief The number of threads waiting in the current round.
+   */
+  std::size_t waiting_count = 0U;
+
+  /**
+   * @brief The number of finished rounds.
+   */
+  std::size_t round = 0U;
+};
+
+/**
+ * @brief Calls a function for every block of a sequence of ranges, where a
+ * range may only start after the previous one finished, using multiple
+ * threads.
+ * @details Unlike calling forEachBlock once per level, the threads are
+ * started only once and wait at a Barrier between the levels, which matters
+ * when there are many small levels. The blocks of a level are handed out
+ * dynamically like in forEachBlock, their boundaries only depend on the size
+ * of the level and block_size.
+ * @tparam SizeFunc Callable with the signature std::size_t(std::size_t
+ * level), returning the number of elements of a level.
+ * @tparam Func Callable with the signature void(std::size_t level,
+ * std::size_t begin, std::size_t end).
+ * @param level_count The number of levels.
+ * @param getLevelSize The function returning the size of a level.
+ * @param block_size The number of elements in a block.
+ * @param func The function to be called for each block.
+ * @throw Rethrows the first exception thrown by func, after every thread
+ * finished. The levels after it are skipped.
+ */
+template <typename SizeFunc, typename Func>
+void forEachLevel(std::size_t level_count, const SizeFunc &getLevelSize,
+                  std::size_t block_size, const Func &func) {
+  block_size = std::max<std::size_t>(block_size, 1U);
+  std::size_t max_block_count = 0U;
+  for (std::size_t level = 0U; level < level_count; ++level) {
+    max_block_count = std::max(
+        max_block_count, (getLevelSize(level) + block_size - 1U) / block_size);
+  }
+  const std::size_t thread_count =
+      std::min<std::size_t>(getThreadCount(), max_block_count);
+
+  if (thread_count <= 1U) {
+    for (std::size_t level = 0U; level < level_count; ++level) {
+      const std::size_t size = getLevelSize(level);
+      for (std::size_t begin = 0U; begin < size; begin += block_size) {
+        func(level, begin, std::min(size, begin + block_size));
+      }
+    }
+    return;
+  }
+
+  std::vector<std::atomic<std::size_t>> next_blocks(level_count);
+  std::atomic<bool> is_failed{false};
+  std::exception_ptr exception;
+  std::mutex exception_mutex;
+  Barrier barrier(thread_count);
+
+  const auto worker = [&]() {
+    for (std::size_t level = 0U; level < level_count; ++level) {
+      if (!is_failed) {
+        try {
+          const std::size_t size = getLevelSize(level);
+          const std::size_t block_count = (size + block_size - 1U) / block_size;
+          auto &next_block = next_blocks[level];
+          for (std::size_t block = next_block++; block < block_count;
+               block = next_block++) {
+            func(level, block * block_size,
+                 std::min(size, (block + 1U) * block_size));
+          }
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(exception_mutex);
+          if (!exception) {
+            exception = std::current_exception();
+          }
+          is_failed = true;
+        }
+      }
+      barrier.wait();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count - 1U);
+  for (std::size_t i = 1U; i < thread_count; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+/**
+ * @brief Sums the values using pairwise summation.
+ * @details The order of the additions only depends on the number of values,
+ * and the rounding error grows with O(log n) instead of O(n) like in a simple
+ * loop.
+ * @param values Pointer to the first value.
+ * @param count The number of values.
+ * @return The sum of the values.
+ */
+double pairwiseSum(const double *values, std::size_t count);
+
+/**
+ * @brief Sums a value for each element of a range, using multiple threads.
+ * @details The range is split into blocks of c_block_size elements, the
+ * values of a block are summed pairwise, then the sums of the blocks are
+ * summed pairwise as well. The reduction tree only depends on size, so the
+ * result is bit-identical regardless of the number of threads.
+ * @tparam Func Callable with the signature void(std::size_t begin,
+ * std::size_t end, double *values), which writes the value of every element
+ * of [begin, end) to values.
+ * @param size The number of elements in the range.
+ * @param block_values The function calculating the values of a block.
+ * @return The sum of the values.
+ */
+template <typename Func>
+double reproducibleSum(std::size_t size, const Func &block_values) {
+  const std::size_t block_count = (size + c_block_size - 1U) / c_block_size;
+  std::vector<double> block_sums(block_count, 0.0);
+
+  forEachBlock(size, c_block_size,
+               [&block_values, &block_sums](std::size_t block,
+                                            std::size_t begin,
+                                            std::size_t end) {
+                 double values[c_block_size];
+                 block_values(begin, end, values);
+                 block_sums[block] = pairwiseSum(values, end - begin);
+               });
+
+  return pairwiseSum(block_sums.data(), block_sums.size());
+}
+
+/**
+ * @brief Sorts a vector using multiple threads.
+ * @details The vector is split into one chunk per thread, the chunks are
+ * sorted in parallel, then neighboring chunks are merged pairwise, also in
+ * parallel, until a single sorted range remains.
+ * @tparam T The type of the elements.
+ * @tparam Compare Callable with the signature bool(const T&, const T&).
+ * @param values The vector to be sorted.
+ * @param compare The ordering of the elements.
+ */
+template <typename T, typename Compare>
+void sort(std::vector<T> &values, const Compare &compare) {
+  const std::size_t size = values.size();
+  const std::size_t chunk_count =
+      std::max<std::size_t>(std::min<std::size_t>(getThreadCount(),
+                                                  size / c_block_size),
+                            1U);
+  const std::size_t chunk_size = (size + chunk_count - 1U) / chunk_count;
+
+  forEachBlock(size, chunk_size,
+               [&values, &compare](std::size_t, std::size_t begin,
+                                   std::size_t end) {
+                 std::sort(values.begin() + begin, values.begin() + end,
+                           compare);
+               });
+
+  for (std::size_t width = chunk_size; width < size; width *= 2U) {
+    forEachBlock(size, 2U * width,
+                 [&values, &compare, width](std::size_t, std::size_t begin,
+                                            std::size_t end) {
+                   if (begin + width < end) {
+                     std::inplace_merge(values.begin() + begin,
+                                        values.begin() + begin + width,
+                                        values.begin() + end, compare);
+                   }
+                 });
+  }
+}
+
+/**
+ * @brief Sorts values by integer keys with a stable radix sort, using
+ * multiple threads.
+ * @details Every pass sorts by 8 bits of the keys, starting from the least
+ * significant ones. The keys are split into one chunk per thread, the chunks
+ * count their digits in parallel, then scatter their elements to the
+ * positions given by the prefix sums of the counts. Passes where every key
+ * has the same digit are skipped. The sort is stable, so the result does not
+ * depend on the number of threads.
+ * @param keys The keys to be sorted.
+ * @param values The values moved together with the keys, the same number as
+ * keys.
+ * @param key_bits The number of low bits of the keys that are used, the
+ * others must be zero.
+ */
+void radixSort(std::vector<std::uint64_t> &keys,
+               std::vector<std::uint32_t> &values, unsigned int key_bits);
+
+/**
+ * @brief Sorts a vector into ascending order using multiple threads.
+ * @tparam T The type of the elements, must be comparable with operator<.
+ * @param values The vector to be sorted.
+ */
+template <typename T> void sort(std::vector<T> &values) {
+  sort(values, std::less<T>());
+}
+
+} // namespace Parallel
+} // namespace Converter
+
+#endif
@@ -2,11 +2,14 @@
 #define IREADER_HPP
 
 #include <fstream>
+#include <functional>
 #include <string>
 
 namespace Converter {
 
+class AffineTransform;
 class MeshData;
+class Triangle;
 
 /**
  * @brief Interface for classes that read 3D meshes from streams.
@@ -17,12 +20,40 @@ public:
    * @brief Default constructor.
    */
   virtual ~IReader() = default;
+
+  /**
+   * @brief Function receiving the Triangles one by one while they are read.
+   */
+  using TriangleCallback = std::function<void(const Triangle &)>;
+
   /**
    * @brief Reads data from a file stream and returns it as a MeshData.
    * @param in_file_stream The stream the class should read from.
    * @return The complete mesh in a MeshData object.
    */
   virtual MeshData read(std::istream &in_file_stream) = 0;
+
+  /**
+   * @brief Reads data from a file stream, passing every Triangle to a
+   * callback instead of storing them.
+   * @details Allows processing meshes that would not fit in memory, for
+   * example to calculate statistics.
+   * @param in_file_stream The stream the class should read from.
+   * @param callback The function that receives the Triangles in the order
+   * they are read.
+   */
+  virtual void read(std::istream &in_file_stream,
+                    const TriangleCallback &callback) = 0;
+
+  /**
+   * @brief Sets a transformation that is applied to the vertices while they
+   * are decoded.
+   * @details Transforming the decoded vertices is cheaper than transforming
+   * the Triangles afterwards, since vertices are usually shared between
+   * multiple Triangles.
+   * @param transformation The transformation to be applied.
+   */
+  virtual void setTransform(const AffineTransform &transformation) = 0;
 };
 
 } // namespace Converter
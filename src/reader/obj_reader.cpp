@@ -18,6 +18,19 @@ namespace Converter {
 
 MeshData ObjReader::read(std::istream &in_stream) {
   MeshData result;
+  read(in_stream, [&result](const Triangle &triangle) {
+    result.triangles.push_back(triangle);
+  });
+  result.material_file = material_file;
+
+  return result;
+}
+
+void ObjReader::read(std::istream &in_stream,
+                     const TriangleCallback &callback) {
+  material_file.clear();
+  const bool is_transformed =
+      transformation.getKind() != AffineTransform::Kind::IDENTITY;
   std::vector<Eigen::Vector4d> vertices;
   std::vector<Eigen::Vector4d> vertex_normals;
   std::vector<Eigen::Vector4d> vertex_textures;
@@ -28,21 +41,33 @@ MeshData ObjReader::read(std::istream &in_stream) {
     if (!words_vect.empty()) {
       if (Utility::startsWith(words_vect[0U], c_vn)) {
         readVector(words_vect, vertex_normals, true);
+        if (is_transformed) {
+          auto &normal = vertex_normals.back();
+          normal.head<3>() =
+              transformation.getNormalMatrix() * normal.head<3>();
+          normal.normalize();
+        }
       } else if (Utility::startsWith(words_vect[0U], c_vt)) {
         readVector(words_vect, vertex_textures);
       } else if (Utility::startsWith(words_vect[0U], c_v)) {
         readVector(words_vect, vertices);
+        if (is_transformed) {
+          vertices.back() = transformation.transformPoint(vertices.back());
+        }
       } else if (Utility::startsWith(words_vect[0U], c_f)) {
-        readFace(words_vect, vertices, vertex_textures, vertex_normals, result);
+        readFace(words_vect, vertices, vertex_textures, vertex_normals,
+                 callback);
       } else if (Utility::startsWith(words_vect[0U], c_mtllib)) {
         if (words_vect.size() > 1) {
-          result.material_file = words_vect[1U];
+          material_file = words_vect[1U];
         }
       }
     }
   }
+}
 
-  return result;
+void ObjReader::setTransform(const AffineTransform &transformation) {
+  this->transformation = transformation;
 }
 
 void ObjReader::readVector(const std::vector<std::string> &line,
@@ -87,6 +112,17 @@ void ObjReader::readFace(const std::vector<std::string> &line,
                          const std::vector<Eigen::Vector4d> &vertex_textures,
                          const std::vector<Eigen::Vector4d> &vertex_normals,
                          MeshData &mesh) const {
+  readFace(line, vertices, vertex_textures, vertex_normals,
+           [&mesh](const Triangle &triangle) {
+             mesh.triangles.push_back(triangle);
+           });
+}
+
+void ObjReader::readFace(const std::vector<std::string> &line,
+                         const std::vector<Eigen::Vector4d> &vertices,
+                         const std::vector<Eigen::Vector4d> &vertex_textures,
+                         const std::vector<Eigen::Vector4d> &vertex_normals,
+                         const TriangleCallback &callback) const {
   // A face definition should consist of at least 3 vertices.
   if (line.size() < 4U) {
     throw IllFormedFileException();
@@ -157,7 +193,7 @@ void ObjReader::readFace(const std::vector<std::string> &line,
       triangle.c.normal = *face_vertex_normals[i + 2U];
     }
 
-    mesh.triangles.push_back(std::move(triangle));
+    callback(triangle);
   }
 }
 
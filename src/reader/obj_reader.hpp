@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include "geometry/affine_transform.hpp"
 #include "ireader.hpp"
 
 namespace Converter {
@@ -32,6 +33,16 @@ protected:
   static constexpr const char *c_vt = "vt";
   static constexpr const char *c_mtllib = "mtllib";
 
+  /**
+   * @brief Holds the name of the material file of the last read stream.
+   */
+  std::string material_file;
+
+  /**
+   * @brief Holds the transformation applied to the decoded vertices.
+   */
+  AffineTransform transformation;
+
   /**
    * @brief Reads the indices defined by a face for example, between slashes.
    * @details We have to know if there were actual values present, since .obj
@@ -65,6 +76,19 @@ protected:
                 const std::vector<Eigen::Vector4d> &vertex_normals,
                 MeshData &mesh) const;
 
+  /**
+   * @brief Reads the definition of a face from the .obj file, passing the
+   * resulting Triangles to a callback.
+   * @details Same as the overload populating a MeshData, see that for the
+   * description of the other parameters.
+   * @param callback The function receiving the Triangles of the face.
+   */
+  void readFace(const std::vector<std::string> &line,
+                const std::vector<Eigen::Vector4d> &vertices,
+                const std::vector<Eigen::Vector4d> &vertex_textures,
+                const std::vector<Eigen::Vector4d> &vertex_normals,
+                const TriangleCallback &callback) const;
+
   /**
    * @brief Reads the definition of a vector from the .obj file.
    * @details Multiple types of objects are defined in the same way in .obj
@@ -91,6 +115,21 @@ public:
    * from the .obj file.
    */
   MeshData read(std::istream &in_stream) override;
+
+  /**
+   * @brief Reads the mesh from an .obj file or stream without storing it.
+   * @param in_stream The stream the function should read from.
+   * @param callback The function that receives the Triangles in the order
+   * they are defined in the file.
+   */
+  void read(std::istream &in_stream, const TriangleCallback &callback) override;
+
+  /**
+   * @brief Sets the transformation applied to the positions and normals
+   * while they are decoded.
+   * @param transformation The transformation to be applied.
+   */
+  void setTransform(const AffineTransform &transformation) override;
 };
 
 } // namespace Converter
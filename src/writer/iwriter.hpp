@@ -7,6 +7,7 @@
 namespace Converter {
 
 class MeshData;
+class QuantizedMesh;
 
 /**
  * @brief Interface for classes that write 3D meshes to stream.
@@ -24,6 +25,15 @@ public:
    * @param mesh The mesh the function should write the data from.
    */
   virtual void write(std::ostream &out_file, const MeshData &mesh) const = 0;
+
+  /**
+   * @brief Writes a quantized mesh to the output stream, decoding it on the
+   * fly.
+   * @param out_file_stream The stream the class should write data to.
+   * @param mesh The mesh the function should write the data from.
+   */
+  virtual void write(std::ostream &out_file,
+                     const QuantizedMesh &mesh) const = 0;
 };
 } // namespace Converter
 
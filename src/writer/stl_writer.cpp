@@ -1,12 +1,15 @@
 #include <Eigen/Dense>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <fstream>
-#include <functional>
 #include <iostream>
 #include <sstream>
 
+#include "geometry/affine_transform.hpp"
 #include "geometry/meshdata.hpp"
+#include "geometry/quantized_mesh.hpp"
+#include "geometry/triangle_packet.hpp"
 #include "stl_writer.hpp"
 #include "utility.hpp"
 
@@ -18,6 +21,13 @@ void StlWriter::write(std::ostream &out_stream, const MeshData &mesh) const {
   writeTriangles(out_stream, mesh);
 }
 
+void StlWriter::write(std::ostream &out_stream,
+                      const QuantizedMesh &mesh) const {
+  writeHeader(out_stream);
+  writeNumOfTriangles(out_stream, mesh);
+  writeTriangles(out_stream, mesh);
+}
+
 void StlWriter::writeHeader(std::ostream &out_stream) const {
   std::array<char, c_header_size_in_bytes> header_buffer;
   header_buffer.fill(static_cast<char>(0));
@@ -37,46 +47,106 @@ void StlWriter::writeNumOfTriangles(std::ostream &out_stream,
   out_stream.write((const char *)(&number_of_triangles), sizeof(std::uint32_t));
 }
 
+void StlWriter::writeNumOfTriangles(std::ostream &out_stream,
+                                    const QuantizedMesh &mesh) const {
+  std::uint32_t number_of_triangles =
+      static_cast<std::uint32_t>(mesh.size());
+
+  if (!Utility::isIntegerLittleEndian()) {
+    number_of_triangles = Utility::swapByteOrder(number_of_triangles);
+  }
+
+  out_stream.write((const char *)(&number_of_triangles), sizeof(std::uint32_t));
+}
+
 void StlWriter::writeTriangles(std::ostream &out_stream,
                                const MeshData &mesh) const {
-  const bool needs_byte_swap = !Utility::isFloatLittleEndian();
+  // The pending transformation is applied while encoding, so it doesn't need
+  // a separate pass over the mesh.
+  const auto &transformation = mesh.getPendingTransform();
+  const bool is_transformed =
+      transformation.getKind() != AffineTransform::Kind::IDENTITY;
+  // The cached normals are transformed with the normal matrix, which has to
+  // be flipped for mirroring transformations to match the winding order.
+  const Eigen::Matrix3d normal_matrix =
+      transformation.getMatrix().topLeftCorner<3, 3>().determinant() < 0.0
+          ? Eigen::Matrix3d(-transformation.getNormalMatrix())
+          : transformation.getNormalMatrix();
+  const auto &planes = mesh.getPlanes();
+
+  for (std::size_t i = 0U; i < mesh.triangles.size(); ++i) {
+    const auto &source_triangle = mesh.triangles[i];
+    Triangle transformed_triangle;
+    if (is_transformed) {
+      transformed_triangle.a.pos =
+          transformation.transformPoint(source_triangle.a.pos);
+      transformed_triangle.b.pos =
+          transformation.transformPoint(source_triangle.b.pos);
+      transformed_triangle.c.pos =
+          transformation.transformPoint(source_triangle.c.pos);
+    }
+    const Triangle &triangle =
+        is_transformed ? transformed_triangle : source_triangle;
+
+    Eigen::Vector4d normal = planes[i].normal;
+    if (is_transformed) {
+      normal.head<3>() = normal_matrix * normal.head<3>();
+      normal.normalize();
+    }
+
+    writeTriangle(out_stream, normal.head<3>(),
+                  {triangle.a.pos.x(), triangle.a.pos.y(), triangle.a.pos.z(),
+                   triangle.b.pos.x(), triangle.b.pos.y(), triangle.b.pos.z(),
+                   triangle.c.pos.x(), triangle.c.pos.y(),
+                   triangle.c.pos.z()});
+  }
+}
+
+void StlWriter::writeTriangles(std::ostream &out_stream,
+                               const QuantizedMesh &mesh) const {
+  TrianglePacket packet;
+  for (std::size_t first = 0U; first < mesh.size();
+       first += TrianglePacket::c_width) {
+    mesh.loadPacket(packet, first, mesh.size());
+    for (std::size_t lane = 0U; lane < packet.count; ++lane) {
+      const Eigen::Vector3d a{packet.a[0U][lane], packet.a[1U][lane],
+                              packet.a[2U][lane]};
+      const Eigen::Vector3d b{packet.b[0U][lane], packet.b[1U][lane],
+                              packet.b[2U][lane]};
+      const Eigen::Vector3d c{packet.c[0U][lane], packet.c[1U][lane],
+                              packet.c[2U][lane]};
+      const Eigen::Vector3d cross = (b - a).cross(c - a);
+      const double length = cross.norm();
+      writeTriangle(out_stream,
+                    length > 0.0 ? Eigen::Vector3d(cross / length)
+                                 : Eigen::Vector3d::Zero(),
+                    {a.x(), a.y(), a.z(), b.x(), b.y(), b.z(), c.x(), c.y(),
+                     c.z()});
+    }
+  }
+}
 
-  const std::function<float(const float &)> swap_byte_order =
-      Utility::swapByteOrder<float>;
-  const std::function<float(const float &)> do_nothing =
-      [](const float &arg) -> float { return arg; };
-  const auto swapper_func = needs_byte_swap ? swap_byte_order : do_nothing;
-
-  for (const auto &triangle : mesh.triangles) {
-    const auto a_pos = triangle.a.pos.cast<float>();
-    const auto b_pos = triangle.b.pos.cast<float>();
-    const auto c_pos = triangle.c.pos.cast<float>();
-
-    std::array<float, 9U> triangle_coords{
-        swapper_func(a_pos.x()), swapper_func(a_pos.y()),
-        swapper_func(a_pos.z()), swapper_func(b_pos.x()),
-        swapper_func(b_pos.y()), swapper_func(b_pos.z()),
-        swapper_func(c_pos.x()), swapper_func(c_pos.y()),
-        swapper_func(c_pos.z())};
-
-    Eigen::Vector4f cross = (triangle.b.pos - triangle.a.pos)
-                                .cross3(triangle.c.pos - triangle.a.pos)
-                                .cast<float>();
-    cross.normalize();
-
-    cross.x() = swapper_func(cross.x());
-    cross.y() = swapper_func(cross.y());
-    cross.z() = swapper_func(cross.z());
-
-    out_stream.write((const char *)&(cross.x()), sizeof(float));
-    out_stream.write((const char *)&(cross.y()), sizeof(float));
-    out_stream.write((const char *)&(cross.z()), sizeof(float));
-    out_stream.write((const char *)triangle_coords.data(),
-                     triangle_coords.size() * sizeof(float));
-
-    static constexpr std::uint16_t attribute_byte_count = 0U;
-    out_stream.write((const char *)&attribute_byte_count,
-                     sizeof(std::uint16_t));
+void StlWriter::writeTriangle(std::ostream &out_stream,
+                              const Eigen::Vector3d &normal,
+                              const std::array<double, 9U> &vertices) const {
+  const bool needs_byte_swap = !Utility::isFloatLittleEndian();
+  const auto encode = [needs_byte_swap](double value) {
+    const float encoded = static_cast<float>(value);
+    return needs_byte_swap ? Utility::swapByteOrder(encoded) : encoded;
+  };
+
+  std::array<float, 12U> record;
+  for (std::size_t i = 0U; i < 3U; ++i) {
+    record[i] = encode(normal[i]);
+  }
+  for (std::size_t i = 0U; i < vertices.size(); ++i) {
+    record[3U + i] = encode(vertices[i]);
   }
+  out_stream.write((const char *)record.data(),
+                   record.size() * sizeof(float));
+
+  static constexpr std::uint16_t attribute_byte_count = 0U;
+  out_stream.write((const char *)&attribute_byte_count,
+                   sizeof(std::uint16_t));
 }
 } // namespace Converter
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef STL_WRITER_HPP
 #define STL_WRITER_HPP
 
+#include <Eigen/Dense>
+#include <array>
 #include <string>
 
 #include "iwriter.hpp"
@@ -8,6 +10,7 @@
 namespace Converter {
 
 class MeshData;
+class QuantizedMesh;
 
 /**
  * @brief Writer implementation for .stl type of files.
@@ -35,14 +38,45 @@ protected:
   void writeNumOfTriangles(std::ostream &out_stream,
                            const MeshData &mesh) const;
 
+  /**
+   * @brief Writes the number of Triangles in the quantized mesh to the
+   * stream.
+   * @param out_file The stream the number of Triangles should be written to.
+   * @param mesh The mesh containing the Triangles.
+   */
+  void writeNumOfTriangles(std::ostream &out_stream,
+                           const QuantizedMesh &mesh) const;
+
   /**
    * @brief Writes the Triangles in the mesh to the stream.
    * @note Also writes 2 bytes of attribute count data, but it is always zero.
+   * The pending transformation of the mesh is applied to every Triangle
+   * while it is encoded, and the normals are taken from the plane cache of
+   * the mesh.
    * @param out_file The stream the Triangles should be written to.
    * @param mesh The mesh containing the Triangles.
    */
   void writeTriangles(std::ostream &out_stream, const MeshData &mesh) const;
 
+  /**
+   * @brief Writes the Triangles in the quantized mesh to the stream.
+   * @note The positions are decoded a packet at a time, and the normals are
+   * calculated from the decoded positions.
+   * @param out_file The stream the Triangles should be written to.
+   * @param mesh The mesh containing the Triangles.
+   */
+  void writeTriangles(std::ostream &out_stream,
+                      const QuantizedMesh &mesh) const;
+
+  /**
+   * @brief Writes a single Triangle record to the stream.
+   * @param out_file The stream the Triangle should be written to.
+   * @param normal The normal of the Triangle.
+   * @param vertices The x, y and z coordinates of the three vertices.
+   */
+  void writeTriangle(std::ostream &out_stream, const Eigen::Vector3d &normal,
+                     const std::array<double, 9U> &vertices) const;
+
 public:
   /**
    * @brief Writes the mesh data to the output stream.
@@ -51,6 +85,14 @@ public:
    */
   void write(std::ostream &out_stream,
              const MeshData &mesh) const final override;
+
+  /**
+   * @brief Writes the quantized mesh to the output stream.
+   * @param out_stream The stream the mesh data should be written to.
+   * @param mesh The quantized mesh.
+   */
+  void write(std::ostream &out_stream,
+             const QuantizedMesh &mesh) const final override;
 };
 
 } // namespace Converter
@@ -0,0 +1,58 @@
+#ifndef TEST_MESHES_HPP
+#define TEST_MESHES_HPP
+
+#include <Eigen/Dense>
+#include <array>
+
+#include "geometry/meshdata.hpp"
+
+namespace TestMeshes {
+
+/**
+ * @brief Creates an axis aligned cube centered at the origin, with outward
+ * facing Triangles.
+ * @param half_size Half of the edge length of the cube.
+ * @param subdivisions The number of segments each edge is divided into, every
+ * face consists of 2 * subdivisions^2 Triangles.
+ * @return The mesh of the cube.
+ */
+inline Converter::MeshData makeCube(double half_size = 1.0,
+                                    int subdivisions = 1) {
+  Converter::MeshData mesh;
+
+  // Each face is described by its normal axis, the sign of the normal and the
+  // two axes spanning it, chosen so that u x v points outwards.
+  const std::array<std::array<int, 4U>, 6U> faces{{{0, 1, 1, 2},
+                                                   {0, -1, 2, 1},
+                                                   {1, 1, 2, 0},
+                                                   {1, -1, 0, 2},
+                                                   {2, 1, 0, 1},
+                                                   {2, -1, 1, 0}}};
+  const double step = 2.0 * half_size / subdivisions;
+
+  for (const auto &[axis, sign, u_axis, v_axis] : faces) {
+    const auto point = [&, axis = axis, sign = sign, u_axis = u_axis,
+                        v_axis = v_axis](int i, int j) {
+      Eigen::Vector4d p{0.0, 0.0, 0.0, 1.0};
+      p[axis] = sign * half_size;
+      p[u_axis] = -half_size + i * step;
+      p[v_axis] = -half_size + j * step;
+      return p;
+    };
+
+    for (int i = 0; i < subdivisions; ++i) {
+      for (int j = 0; j < subdivisions; ++j) {
+        mesh.triangles.push_back(
+            {point(i, j), point(i + 1, j), point(i + 1, j + 1)});
+        mesh.triangles.push_back(
+            {point(i, j), point(i + 1, j + 1), point(i, j + 1)});
+      }
+    }
+  }
+
+  return mesh;
+}
+
+} // namespace TestMeshes
+
+#endif
@@ -0,0 +1,132 @@
+#include <Eigen/Dense>
+#include <vector>
+
+#include "geometry/affine_transform.hpp"
+#include "geometry/triangle.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+namespace {
+
+static constexpr double PI = 3.141592653589793238;
+
+/**
+ * @brief Transforms the Triangles one by one with Triangle::transform.
+ */
+std::vector<Triangle> transformReference(std::vector<Triangle> triangles,
+                                         const Eigen::Matrix4d &matrix) {
+  Eigen::Matrix4d normal_matrix = Eigen::Matrix4d::Identity();
+  normal_matrix.topLeftCorner<3, 3>() =
+      matrix.topLeftCorner<3, 3>().inverse().transpose();
+  for (auto &triangle : triangles) {
+    triangle.transform(matrix, normal_matrix);
+  }
+  return triangles;
+}
+
+std::vector<Triangle> makeTriangles() {
+  auto triangles = TestMeshes::makeCube(1.5, 10).triangles;
+  // Only every other Triangle has normals, like a mesh read from a file
+  // that defines them for some of the faces.
+  for (std::size_t i = 0U; i < triangles.size(); i += 2U) {
+    auto &triangle = triangles[i];
+    triangle.a.normal = triangle.getNormal();
+    triangle.b.normal = triangle.getNormal();
+    triangle.c.normal = triangle.getNormal();
+  }
+  return triangles;
+}
+
+void expectEqual(const std::vector<Triangle> &lhs,
+                 const std::vector<Triangle> &rhs) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  for (std::size_t i = 0U; i < lhs.size(); ++i) {
+    EXPECT_TRUE(lhs[i].a.pos.isApprox(rhs[i].a.pos));
+    EXPECT_TRUE(lhs[i].b.pos.isApprox(rhs[i].b.pos));
+    EXPECT_TRUE(lhs[i].c.pos.isApprox(rhs[i].c.pos));
+    EXPECT_TRUE(lhs[i].a.normal.isApprox(rhs[i].a.normal) ||
+                (lhs[i].a.normal.isZero() && rhs[i].a.normal.isZero()));
+    EXPECT_TRUE(lhs[i].c.normal.isApprox(rhs[i].c.normal) ||
+                (lhs[i].c.normal.isZero() && rhs[i].c.normal.isZero()));
+  }
+}
+
+} // namespace
+
+TEST(AffineTransformTests, TestKind) {
+  EXPECT_EQ(AffineTransform().getKind(), AffineTransform::Kind::IDENTITY);
+  EXPECT_EQ(AffineTransform(Utility::getTranslationMatrix({1.0, 0.0, 0.0}))
+                .getKind(),
+            AffineTransform::Kind::TRANSLATION);
+  EXPECT_EQ(AffineTransform(Utility::getScaleMatrix({2.0, 2.0, 2.0}))
+                .getKind(),
+            AffineTransform::Kind::UNIFORM_SCALE);
+  EXPECT_EQ(AffineTransform(Utility::getTranslationMatrix({1.0, 0.0, 0.0}) *
+                            Utility::getScaleMatrix({2.0, 2.0, 2.0}))
+                .getKind(),
+            AffineTransform::Kind::UNIFORM_SCALE);
+  EXPECT_EQ(AffineTransform(Utility::getScaleMatrix({2.0, 1.0, 2.0}))
+                .getKind(),
+            AffineTransform::Kind::GENERAL);
+  EXPECT_EQ(AffineTransform(Utility::getRotationMatrix({0.0, 1.0, 0.0}, 0.5))
+                .getKind(),
+            AffineTransform::Kind::GENERAL);
+}
+
+TEST(AffineTransformTests, TestMatchesTriangleTransform) {
+  const std::vector<Eigen::Matrix4d> matrices{
+      Utility::getTranslationMatrix({1.0, -2.0, 3.5}),
+      Utility::getScaleMatrix({3.0, 3.0, 3.0}),
+      Utility::getScaleMatrix({-0.5, -0.5, -0.5}),
+      Utility::getTranslationMatrix({0.1, 0.2, 0.3}) *
+          Utility::getRotationMatrix({1.0, 2.0, 3.0}, PI / 3.0) *
+          Utility::getScaleMatrix({1.0, 5.0, 0.25})};
+
+  for (const auto &matrix : matrices) {
+    for (const unsigned int thread_count : {1U, 3U}) {
+      Parallel::setThreadCount(thread_count);
+      auto triangles = makeTriangles();
+      const auto expected = transformReference(triangles, matrix);
+      AffineTransform(matrix).apply(triangles);
+      expectEqual(triangles, expected);
+    }
+  }
+  Parallel::setThreadCount(0U);
+}
+
+TEST(AffineTransformTests, TestMissingNormalsStayZero) {
+  std::vector<Triangle> triangles{{Eigen::Vector4d{0.0, 0.0, 0.0, 1.0},
+                                   Eigen::Vector4d{1.0, 0.0, 0.0, 1.0},
+                                   Eigen::Vector4d{0.0, 1.0, 0.0, 1.0}}};
+  AffineTransform(Utility::getRotationMatrix({0.0, 0.0, 1.0}, 1.0) *
+                  Utility::getScaleMatrix({1.0, 2.0, 3.0}))
+      .apply(triangles);
+  EXPECT_TRUE(triangles[0U].a.normal.isZero(0.0));
+  EXPECT_TRUE(triangles[0U].b.normal.isZero(0.0));
+  EXPECT_TRUE(triangles[0U].c.normal.isZero(0.0));
+}
+
+TEST(AffineTransformTests, TestInverseAndComposition) {
+  const AffineTransform rotation(
+      Utility::getRotationMatrix({1.0, 1.0, 0.0}, 0.7));
+  const AffineTransform translation(
+      Utility::getTranslationMatrix({1.0, 2.0, 3.0}));
+  const AffineTransform scale(Utility::getScaleMatrix({2.0, 0.5, 4.0}));
+  const AffineTransform composed = translation * rotation * scale;
+
+  const Eigen::Vector4d point{0.3, -1.2, 2.0, 1.0};
+  const Eigen::Vector4d transformed = composed.transformPoint(point);
+  EXPECT_TRUE(transformed.isApprox(translation.transformPoint(
+      rotation.transformPoint(scale.transformPoint(point)))));
+  EXPECT_TRUE(composed.getInverse().transformPoint(transformed).isApprox(
+      point));
+
+  const Eigen::Vector4d direction{0.0, 1.0, 0.0, 0.0};
+  EXPECT_TRUE(translation.transformDirection(direction).isApprox(direction));
+  EXPECT_TRUE(scale.transformDirection(direction).isApprox(
+      Eigen::Vector4d{0.0, 0.5, 0.0, 0.0}));
+}
@@ -0,0 +1,165 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "geometry/bounding_volumes.hpp"
+#include "geometry/mesh_statistics.hpp"
+#include "geometry/meshdata.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+namespace {
+
+static constexpr double EPSILON = 0.0000001;
+
+// Checks whether a sphere contains every point.
+bool containsAll(const BoundingVolumes::Sphere &sphere,
+                 const std::vector<Eigen::Vector3d> &points) {
+  return std::all_of(points.begin(), points.end(),
+                     [&sphere](const Eigen::Vector3d &point) {
+                       return (point - sphere.center).norm() <=
+                              sphere.radius + EPSILON;
+                     });
+}
+
+// Finds the minimal enclosing sphere by trying the spheres through every
+// two, three and four points.
+double getMinimalRadius(const std::vector<Eigen::Vector3d> &points) {
+  double min_radius = std::numeric_limits<double>::infinity();
+  const auto tryCenter = [&](const Eigen::Vector3d &center, double radius) {
+    if (radius < min_radius && containsAll({center, radius}, points)) {
+      min_radius = radius;
+    }
+  };
+  const std::size_t size = points.size();
+  for (std::size_t i = 0U; i < size; ++i) {
+    for (std::size_t j = i + 1U; j < size; ++j) {
+      const Eigen::Vector3d u = points[j] - points[i];
+      tryCenter((points[i] + points[j]) / 2.0, u.norm() / 2.0);
+      for (std::size_t k = j + 1U; k < size; ++k) {
+        const Eigen::Vector3d v = points[k] - points[i];
+        const Eigen::Vector3d normal = u.cross(v);
+        const Eigen::Vector3d offset =
+            (u.squaredNorm() * v.cross(normal) +
+             v.squaredNorm() * normal.cross(u)) /
+            (2.0 * normal.squaredNorm());
+        tryCenter(points[i] + offset, offset.norm());
+        for (std::size_t l = k + 1U; l < size; ++l) {
+          Eigen::Matrix3d edges;
+          edges << u.transpose(), v.transpose(),
+              (points[l] - points[i]).transpose();
+          const Eigen::Vector3d solution =
+              edges.inverse() * Eigen::Vector3d(edges.row(0).squaredNorm(),
+                                                edges.row(1).squaredNorm(),
+                                                edges.row(2).squaredNorm()) /
+              2.0;
+          tryCenter(points[i] + solution, solution.norm());
+        }
+      }
+    }
+  }
+  return min_radius;
+}
+
+} // namespace
+
+TEST(BoundingVolumesTests, TestCube) {
+  const auto volumes =
+      BoundingVolumes::calculate(TestMeshes::makeCube(1.0, 3));
+  EXPECT_TRUE(volumes.getAxisAlignedBox().min().isApprox(
+      Eigen::Vector3d(-1.0, -1.0, -1.0)));
+  EXPECT_TRUE(volumes.getAxisAlignedBox().max().isApprox(
+      Eigen::Vector3d(1.0, 1.0, 1.0)));
+  EXPECT_NEAR(volumes.getOrientedBox().getVolume(), 8.0, EPSILON);
+  EXPECT_TRUE(volumes.getOrientedBox().center.isZero(EPSILON));
+  EXPECT_NEAR(volumes.getSphere().radius, std::sqrt(3.0), EPSILON);
+  EXPECT_TRUE(volumes.getSphere().center.isZero(EPSILON));
+}
+
+TEST(BoundingVolumesTests, TestRotatedBox) {
+  // The principal axes of the box are distinct, but those of its faces are
+  // not.
+  for (const Eigen::Vector3d &scale :
+       {Eigen::Vector3d(1.0, 2.0, 3.0), Eigen::Vector3d(2.0, 2.0, 2.0)}) {
+    auto box = TestMeshes::makeCube(1.0, 2);
+    box.deferTransform(
+        Utility::getTranslationMatrix(Eigen::Vector3d{5.0, 0.0, 0.0}),
+        Utility::getRotationMatrix(Eigen::Vector3d{1.0, 2.0, 3.0}, 0.7),
+        Utility::getScaleMatrix(scale));
+    const auto volumes = BoundingVolumes::calculate(box);
+    const double volume = 8.0 * scale.prod();
+
+    const auto &oriented_box = volumes.getOrientedBox();
+    EXPECT_NEAR(oriented_box.getVolume(), volume, EPSILON);
+    EXPECT_TRUE(oriented_box.center.isApprox(Eigen::Vector3d(5.0, 0.0, 0.0)));
+    EXPECT_TRUE((oriented_box.axes.transpose() * oriented_box.axes)
+                    .isIdentity(EPSILON));
+    EXPECT_NEAR(oriented_box.axes.determinant(), 1.0, EPSILON);
+    EXPECT_GT(volumes.getAxisAlignedBox().volume(), volume);
+    EXPECT_TRUE(volumes.getAxisAlignedBox().isApprox(
+        MeshStatistics::calculate(box).getBoundingBox()));
+
+    EXPECT_NEAR(volumes.getSphere().radius, scale.norm(), EPSILON);
+    EXPECT_TRUE(volumes.getSphere().center.isApprox(
+        Eigen::Vector3d(5.0, 0.0, 0.0)));
+  }
+}
+
+TEST(BoundingVolumesTests, TestSphere) {
+  std::mt19937 generator(11U);
+  std::normal_distribution<double> distribution(0.0, 1.0);
+  for (std::size_t size : {1U, 2U, 5U, 30U}) {
+    std::vector<Eigen::Vector3d> points(size);
+    for (auto &point : points) {
+      point = Eigen::Vector3d(distribution(generator), distribution(generator),
+                              distribution(generator));
+    }
+    const auto sphere = BoundingVolumes::calculateSphere(points);
+    EXPECT_TRUE(containsAll(sphere, points));
+    if (size > 1U) {
+      EXPECT_NEAR(sphere.radius, getMinimalRadius(points), EPSILON);
+    } else {
+      EXPECT_EQ(sphere.radius, 0.0);
+    }
+  }
+
+  // Points on a circle are all on the surface of the sphere.
+  std::vector<Eigen::Vector3d> circle;
+  for (std::size_t i = 0U; i < 100U; ++i) {
+    const double angle = 0.0628 * static_cast<double>(i);
+    circle.emplace_back(2.0 * std::cos(angle), 2.0 * std::sin(angle), 1.0);
+  }
+  const auto sphere = BoundingVolumes::calculateSphere(circle);
+  EXPECT_NEAR(sphere.radius, 2.0, EPSILON);
+  EXPECT_TRUE(sphere.center.isApprox(Eigen::Vector3d(0.0, 0.0, 1.0)));
+}
+
+TEST(BoundingVolumesTests, TestFlat) {
+  // The square has no hull, but still a box with a side along its edges.
+  auto square = TestMeshes::makeCube(1.0, 2);
+  square.triangles.resize(8U);
+  square.deferTransform(
+      Eigen::Matrix4d::Identity(),
+      Utility::getRotationMatrix(Eigen::Vector3d{1.0, 1.0, 0.0}, 0.3),
+      Eigen::Matrix4d::Identity());
+  const auto volumes = BoundingVolumes::calculate(square);
+  auto half_sizes = volumes.getOrientedBox().half_sizes;
+  std::sort(half_sizes.data(), half_sizes.data() + 3);
+  EXPECT_TRUE(half_sizes.isApprox(Eigen::Vector3d(0.0, 1.0, 1.0)));
+  EXPECT_NEAR(volumes.getSphere().radius, std::sqrt(2.0), EPSILON);
+}
+
+TEST(BoundingVolumesTests, TestEmpty) {
+  const auto volumes = BoundingVolumes::calculate(MeshData{});
+  EXPECT_TRUE(volumes.getAxisAlignedBox().isEmpty());
+  EXPECT_EQ(volumes.getOrientedBox().getVolume(), 0.0);
+  EXPECT_EQ(volumes.getSphere().radius, 0.0);
+  EXPECT_EQ(BoundingVolumes::calculateSphere({}).radius, 0.0);
+}
@@ -0,0 +1,51 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "geometry/bvh.hpp"
+#include "test_meshes.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+TEST(BvhTests, TestEmpty) {
+  Bvh bvh(std::vector<Triangle>{});
+  EXPECT_TRUE(bvh.empty());
+  EXPECT_TRUE(bvh.triangle_indices.empty());
+}
+
+TEST(BvhTests, TestStructure) {
+  const auto cube = TestMeshes::makeCube(1.0, 8);
+  Bvh bvh(cube.triangles, 4U);
+  ASSERT_FALSE(bvh.empty());
+
+  // Every triangle is referenced exactly once.
+  auto indices = bvh.triangle_indices;
+  std::sort(indices.begin(), indices.end());
+  for (std::uint32_t i = 0U; i < indices.size(); ++i) {
+    EXPECT_EQ(indices[i], i);
+  }
+
+  EXPECT_TRUE(bvh.nodes[0U].box.isApprox(
+      Eigen::AlignedBox3d{Eigen::Vector3d{-1.0, -1.0, -1.0},
+                          Eigen::Vector3d{1.0, 1.0, 1.0}}));
+
+  std::size_t leaf_triangles = 0U;
+  for (const auto &node : bvh.nodes) {
+    if (node.isLeaf()) {
+      EXPECT_LE(node.count, 4U);
+      leaf_triangles += node.count;
+      for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+        const auto &triangle = cube.triangles[bvh.triangle_indices[i]];
+        EXPECT_TRUE(node.box.contains(triangle.a.pos.head<3>()));
+        EXPECT_TRUE(node.box.contains(triangle.b.pos.head<3>()));
+        EXPECT_TRUE(node.box.contains(triangle.c.pos.head<3>()));
+      }
+    } else {
+      EXPECT_TRUE(node.box.contains(bvh.nodes[node.first].box));
+      EXPECT_TRUE(node.box.contains(bvh.nodes[node.first + 1U].box));
+    }
+  }
+  EXPECT_EQ(leaf_triangles, cube.triangles.size());
+}
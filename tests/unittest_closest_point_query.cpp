@@ -0,0 +1,119 @@
+#include <Eigen/Dense>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "geometry/closest_point_query.hpp"
+#include "geometry/meshdata.hpp"
+#include "geometry/triangle_packet.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+class ClosestPointQueryTests : public ::testing::Test {
+protected:
+  void TearDown() { Parallel::setThreadCount(0U); }
+};
+
+namespace {
+
+static constexpr double EPSILON = 0.0000001;
+
+// Tests every Triangle, used as the reference of the hierarchy.
+double bruteForceDistance(const MeshData &mesh, const Eigen::Vector4d &point) {
+  double closest = std::numeric_limits<double>::infinity();
+  for (const auto &packet : mesh.getPackets()) {
+    const auto points = packet.findClosestPoints(point.head<3>());
+    for (std::size_t lane = 0U; lane < packet.count; ++lane) {
+      closest = std::min(closest, points.distance_squared[lane]);
+    }
+  }
+  return std::sqrt(closest);
+}
+
+} // namespace
+
+TEST_F(ClosestPointQueryTests, TestFindClosestPoint) {
+  const auto cube = TestMeshes::makeCube(1.0, 4);
+  const ClosestPointQuery query(cube);
+  ASSERT_EQ(query.size(), cube.triangles.size());
+
+  const Eigen::Vector4d point{0.3, -0.2, -5.0, 1.0};
+  const auto result = query.findClosestPoint(point);
+  ASSERT_TRUE(result);
+  EXPECT_NEAR(result->distance, 4.0, EPSILON);
+  EXPECT_TRUE(result->point.isApprox(Eigen::Vector4d{0.3, -0.2, -1.0, 1.0}));
+
+  // The barycentric coordinates give back the closest point.
+  const auto &triangle = cube.triangles[result->triangle_index];
+  const Eigen::Vector4d barycentric_point =
+      (1.0 - result->u - result->v) * triangle.a.pos +
+      result->u * triangle.b.pos + result->v * triangle.c.pos;
+  EXPECT_TRUE(barycentric_point.isApprox(result->point));
+
+  // Inside of the cube and beyond a corner.
+  EXPECT_NEAR(query.findClosestPoint({0.1, 0.7, 0.2, 1.0})->distance, 0.3,
+              EPSILON);
+  EXPECT_NEAR(query.findClosestPoint({2.0, 3.0, -3.0, 1.0})->distance,
+              std::sqrt(9.0), EPSILON);
+
+  EXPECT_FALSE(query.findClosestPoint(point, 3.5));
+  EXPECT_FALSE(ClosestPointQuery(MeshData{}).findClosestPoint(point));
+}
+
+TEST_F(ClosestPointQueryTests, TestPendingTransform) {
+  auto cube = TestMeshes::makeCube(1.0, 4);
+  cube.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{10.0, 0.0, 0.0}),
+      Eigen::Matrix4d::Identity(),
+      Utility::getScaleMatrix(Eigen::Vector3d{2.0, 2.0, 2.0}));
+  const ClosestPointQuery query(cube);
+
+  const auto result = query.findClosestPoint({10.5, 0.0, 5.0, 1.0});
+  ASSERT_TRUE(result);
+  EXPECT_NEAR(result->distance, 3.0, EPSILON);
+  EXPECT_TRUE(result->point.isApprox(Eigen::Vector4d{10.5, 0.0, 2.0, 1.0}));
+}
+
+TEST_F(ClosestPointQueryTests, TestMatchesBruteForce) {
+  std::mt19937 generator(3U);
+  std::uniform_real_distribution<double> distribution(-2.0, 2.0);
+  MeshData soup;
+  for (std::size_t i = 0U; i < 300U; ++i) {
+    const Eigen::Vector4d center{distribution(generator),
+                                 distribution(generator),
+                                 distribution(generator), 1.0};
+    Triangle triangle;
+    for (auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+      vertex->pos = center + 0.2 * Eigen::Vector4d{distribution(generator),
+                                                   distribution(generator),
+                                                   distribution(generator),
+                                                   0.0};
+    }
+    soup.triangles.push_back(triangle);
+  }
+  const ClosestPointQuery query(soup);
+
+  std::vector<Eigen::Vector4d> points;
+  for (std::size_t i = 0U; i < 500U; ++i) {
+    points.push_back({distribution(generator), distribution(generator),
+                      distribution(generator), 1.0});
+  }
+
+  Parallel::setThreadCount(4U);
+  const auto results = query.findClosestPoints(points);
+
+  ASSERT_EQ(results.size(), points.size());
+  for (std::size_t i = 0U; i < points.size(); ++i) {
+    ASSERT_TRUE(results[i]);
+    EXPECT_NEAR(results[i]->distance, bruteForceDistance(soup, points[i]),
+                EPSILON);
+    EXPECT_NEAR((results[i]->point - points[i]).norm(), results[i]->distance,
+                EPSILON);
+  }
+}
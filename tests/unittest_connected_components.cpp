@@ -0,0 +1,93 @@
+#include <Eigen/Dense>
+
+#include "geometry/connected_components.hpp"
+#include "geometry/indexed_mesh.hpp"
+#include "geometry/meshdata.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+namespace {
+
+static constexpr double EPSILON = 0.0000001;
+
+// Exactly representable sizes, so the welded cubes are closed.
+double getHalfSize(int i) { return 1.0 + 0.5 * (i % 3); }
+
+// Creates a mesh of separate cubes along the x axis, with the faces of the
+// cubes interleaved.
+MeshData makeCubes(int count, int subdivisions) {
+  std::vector<MeshData> cubes;
+  for (int i = 0; i < count; ++i) {
+    cubes.push_back(TestMeshes::makeCube(getHalfSize(i), subdivisions));
+    cubes.back().transform(
+        Utility::getTranslationMatrix(Eigen::Vector3d{5.0 * i, 0.0, 0.0}),
+        Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity());
+  }
+  MeshData mesh;
+  for (std::size_t j = 0U; j < cubes[0U].triangles.size(); ++j) {
+    for (const auto &cube : cubes) {
+      mesh.triangles.push_back(cube.triangles[j]);
+    }
+  }
+  return mesh;
+}
+
+} // namespace
+
+TEST(ConnectedComponentsTests, TestLabel) {
+  const auto mesh = IndexedMesh::weld(makeCubes(3, 2), 0.0);
+  const auto components = ConnectedComponents::label(mesh);
+
+  EXPECT_EQ(components.getComponentCount(), 3U);
+  const auto &face_labels = components.getFaceLabels();
+  ASSERT_EQ(face_labels.size(), mesh.faces.size());
+  for (std::size_t i = 0U; i < face_labels.size(); ++i) {
+    // The components are numbered in the order of their first face.
+    EXPECT_EQ(face_labels[i], i % 3U);
+    EXPECT_EQ(components.getVertexLabels()[mesh.faces[i][1U]], i % 3U);
+  }
+}
+
+TEST(ConnectedComponentsTests, TestSplit) {
+  const auto mesh = IndexedMesh::weld(makeCubes(3, 2), 0.0);
+  const auto meshes = ConnectedComponents::label(mesh).split(mesh);
+
+  ASSERT_EQ(meshes.size(), 3U);
+  for (std::size_t i = 0U; i < meshes.size(); ++i) {
+    const double size = 2.0 * getHalfSize(static_cast<int>(i));
+    EXPECT_EQ(meshes[i].faces.size(), 6U * 2U * 2U * 2U);
+    EXPECT_EQ(meshes[i].vertices.size(), 6U * 2U * 2U + 2U);
+    EXPECT_NEAR(meshes[i].toMeshData().calculateVolume(),
+                size * size * size, EPSILON);
+  }
+}
+
+TEST(ConnectedComponentsTests, TestIsDeterministic) {
+  const auto mesh = IndexedMesh::weld(makeCubes(20, 4), 0.0);
+
+  Parallel::setThreadCount(1U);
+  const auto reference = ConnectedComponents::label(mesh);
+  EXPECT_EQ(reference.getComponentCount(), 20U);
+  for (const unsigned int thread_count : {2U, 5U, 16U}) {
+    Parallel::setThreadCount(thread_count);
+    const auto components = ConnectedComponents::label(mesh);
+    EXPECT_EQ(components.getFaceLabels(), reference.getFaceLabels());
+    EXPECT_EQ(components.getVertexLabels(), reference.getVertexLabels());
+  }
+  Parallel::setThreadCount(0U);
+}
+
+TEST(ConnectedComponentsTests, TestUnusedVertices) {
+  auto mesh = IndexedMesh::weld(TestMeshes::makeCube(1.0, 1), 0.0);
+  mesh.vertices.push_back({9.0, 9.0, 9.0, 1.0});
+  const auto components = ConnectedComponents::label(mesh);
+
+  EXPECT_EQ(components.getComponentCount(), 1U);
+  EXPECT_EQ(components.getVertexLabels().back(),
+            ConnectedComponents::c_no_component);
+  EXPECT_EQ(components.split(mesh)[0U].vertices.size(), 8U);
+}
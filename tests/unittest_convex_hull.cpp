@@ -0,0 +1,162 @@
+#include <Eigen/Dense>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "geometry/convex_hull.hpp"
+#include "geometry/indexed_mesh.hpp"
+#include "geometry/mesh_statistics.hpp"
+#include "geometry/mesh_validation.hpp"
+#include "geometry/meshdata.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+class ConvexHullTests : public ::testing::Test {
+protected:
+  void TearDown() { Parallel::setThreadCount(0U); }
+};
+
+namespace {
+
+static constexpr double EPSILON = 0.0000001;
+
+// Returns the largest distance of a point above the plane of a Triangle of
+// the hull, zero or less if the hull contains every point.
+double getMaxOutsideDistance(const MeshData &hull,
+                             const std::vector<Eigen::Vector3d> &points) {
+  double max_distance = -1.0;
+  for (const auto &triangle : hull.triangles) {
+    const Eigen::Vector3d a = triangle.a.pos.head<3>();
+    const Eigen::Vector3d normal = (triangle.b.pos.head<3>() - a)
+                                       .cross(triangle.c.pos.head<3>() - a)
+                                       .normalized();
+    for (const auto &point : points) {
+      max_distance = std::max(max_distance, normal.dot(point - a));
+    }
+  }
+  return max_distance;
+}
+
+// Returns every vertex position of a mesh.
+std::vector<Eigen::Vector3d> getPositions(const MeshData &mesh) {
+  std::vector<Eigen::Vector3d> positions;
+  for (const auto &triangle : mesh.triangles) {
+    for (const auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+      positions.push_back(vertex->pos.head<3>());
+    }
+  }
+  return positions;
+}
+
+} // namespace
+
+TEST_F(ConvexHullTests, TestCube) {
+  // The vertices inside of the faces of the cube are on the hull, but they
+  // are not needed.
+  const auto hull = ConvexHull::calculate(TestMeshes::makeCube(1.0, 4));
+  EXPECT_EQ(hull.triangles.size(), 12U);
+  EXPECT_NEAR(hull.calculateVolume(), 8.0, EPSILON);
+  EXPECT_NEAR(hull.calculateSurfaceArea(), 24.0, EPSILON);
+  EXPECT_TRUE(MeshValidation::validate(IndexedMesh::weld(hull, 0.0))
+                  .isValid());
+}
+
+TEST_F(ConvexHullTests, TestInnerVertices) {
+  auto mesh = TestMeshes::makeCube(1.0, 2);
+  const auto inner = TestMeshes::makeCube(0.5, 3);
+  mesh.triangles.insert(mesh.triangles.end(), inner.triangles.begin(),
+                        inner.triangles.end());
+  const auto hull = ConvexHull::calculate(mesh);
+  EXPECT_EQ(hull.triangles.size(), 12U);
+  EXPECT_NEAR(hull.calculateVolume(), 8.0, EPSILON);
+}
+
+TEST_F(ConvexHullTests, TestRandomPoints) {
+  std::mt19937 generator(3U);
+  std::normal_distribution<double> distribution(0.0, 1.0);
+  std::vector<Eigen::Vector3d> points(20000U);
+  for (auto &point : points) {
+    point = Eigen::Vector3d(distribution(generator), distribution(generator),
+                            distribution(generator));
+  }
+  // Some points on the unit sphere, which are all on the hull.
+  for (std::size_t i = 0U; i < 100U; ++i) {
+    points[i] = points[i].normalized() * 10.0;
+  }
+  // Duplicates are allowed.
+  points.push_back(points[0U]);
+
+  const auto hull = ConvexHull::calculate(points);
+  EXPECT_LE(getMaxOutsideDistance(hull, points), 1e-12);
+  EXPECT_GE(hull.triangles.size(), 2U * 100U - 4U);
+  EXPECT_TRUE(MeshValidation::validate(IndexedMesh::weld(hull, 0.0))
+                  .isValid());
+  EXPECT_GT(hull.calculateVolume(), 0.0);
+}
+
+TEST_F(ConvexHullTests, TestDegenerate) {
+  EXPECT_TRUE(ConvexHull::calculate(MeshData{}).triangles.empty());
+
+  // A flat square has no volume.
+  auto square = TestMeshes::makeCube(1.0, 2);
+  square.triangles.resize(8U);
+  EXPECT_TRUE(ConvexHull::calculate(square).triangles.empty());
+
+  EXPECT_TRUE(ConvexHull::calculate(std::vector<Eigen::Vector3d>{
+                                        Eigen::Vector3d::Zero(),
+                                        Eigen::Vector3d::UnitX(),
+                                        Eigen::Vector3d::UnitY()})
+                  .triangles.empty());
+}
+
+TEST_F(ConvexHullTests, TestPendingTransform) {
+  auto cube = TestMeshes::makeCube(1.0, 2);
+  cube.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{5.0, 0.0, 0.0}),
+      Utility::getRotationMatrix(Eigen::Vector3d{0.0, 0.0, 1.0}, 0.5),
+      Eigen::Matrix4d::Identity());
+  const auto hull = ConvexHull::calculate(cube);
+  EXPECT_EQ(hull.triangles.size(), 12U);
+  EXPECT_NEAR(hull.calculateVolume(), 8.0, EPSILON);
+  const auto box = MeshStatistics::calculate(hull).getBoundingBox();
+  EXPECT_TRUE(box.center().isApprox(Eigen::Vector3d(5.0, 0.0, 0.0)));
+}
+
+TEST_F(ConvexHullTests, TestChunks) {
+  // A bumpy ball of several chunks, whose chunk hulls keep only a part of
+  // the vertices.
+  auto ball = TestMeshes::makeCube(1.0, 80);
+  std::mt19937 generator(7U);
+  std::uniform_real_distribution<double> noise(0.9, 1.0);
+  for (auto &triangle : ball.triangles) {
+    for (auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+      const Eigen::Vector3d position = vertex->pos.head<3>();
+      const double radius =
+          noise(generator) *
+          (1.0 + 0.1 * std::sin(5.0 * position.x() + 3.0 * position.y()));
+      vertex->pos.head<3>() = position.normalized() * radius;
+    }
+  }
+  ASSERT_GT(ball.triangles.size(), 65536U);
+
+  Parallel::setThreadCount(1U);
+  const auto serial = ConvexHull::calculate(ball);
+  Parallel::setThreadCount(4U);
+  const auto parallel = ConvexHull::calculate(ball);
+
+  const auto positions = getPositions(ball);
+  std::vector<Eigen::Vector3d> samples;
+  for (std::size_t i = 0U; i < positions.size(); i += 16U) {
+    samples.push_back(positions[i]);
+  }
+  EXPECT_LE(getMaxOutsideDistance(serial, samples), 1e-12);
+  EXPECT_NEAR(serial.calculateVolume(),
+              ConvexHull::calculate(positions).calculateVolume(), EPSILON);
+  ASSERT_EQ(serial.triangles.size(), parallel.triangles.size());
+  EXPECT_EQ(getPositions(serial), getPositions(parallel));
+}
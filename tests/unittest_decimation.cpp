@@ -0,0 +1,106 @@
+#include <Eigen/Dense>
+#include <algorithm>
+
+#include "geometry/decimation.hpp"
+#include "geometry/indexed_mesh.hpp"
+#include "geometry/mesh_statistics.hpp"
+#include "geometry/mesh_validation.hpp"
+#include "geometry/meshdata.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+namespace {
+
+static constexpr double EPSILON = 0.0000001;
+
+// Creates a flat, open grid of 2 * subdivisions^2 faces on the z = 1 plane.
+IndexedMesh makeGrid(int subdivisions) {
+  auto cube = TestMeshes::makeCube(1.0, subdivisions);
+  const std::size_t face_triangles =
+      2U * static_cast<std::size_t>(subdivisions * subdivisions);
+  // The fifth face of the cube is the one facing +z.
+  cube.triangles.erase(cube.triangles.begin() + 5 * face_triangles,
+                       cube.triangles.end());
+  cube.triangles.erase(cube.triangles.begin(),
+                       cube.triangles.begin() + 4 * face_triangles);
+  return IndexedMesh::weld(cube, 0.0);
+}
+
+} // namespace
+
+TEST(DecimationTests, TestCubeKeepsItsShape) {
+  const auto mesh = IndexedMesh::weld(TestMeshes::makeCube(1.0, 8), 0.0);
+  Decimation::Settings settings;
+  settings.target_face_count = 12U;
+  const auto decimated = Decimation::decimate(mesh, settings);
+
+  EXPECT_EQ(decimated.faces.size(), 12U);
+  EXPECT_EQ(decimated.vertices.size(), 8U);
+  EXPECT_TRUE(MeshValidation::validate(decimated).isValid());
+  EXPECT_NEAR(decimated.toMeshData().calculateVolume(), 8.0, EPSILON);
+}
+
+TEST(DecimationTests, TestMaxError) {
+  auto cube = TestMeshes::makeCube(1.0, 4);
+  // Bends the cube, so collapses across the crease have non-zero error.
+  for (auto &triangle : cube.triangles) {
+    for (auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+      vertex->pos.z() += 0.1 * vertex->pos.x() * vertex->pos.x();
+    }
+  }
+  const auto mesh = IndexedMesh::weld(cube, 0.0);
+
+  Decimation::Settings settings;
+  settings.max_error = 1e-9;
+  const auto flat_only = Decimation::decimate(mesh, settings);
+  settings.max_error = 1.0;
+  const auto coarse = Decimation::decimate(mesh, settings);
+
+  EXPECT_LT(flat_only.faces.size(), mesh.faces.size());
+  EXPECT_LT(coarse.faces.size(), flat_only.faces.size());
+  EXPECT_TRUE(MeshValidation::validate(flat_only).isValid());
+  EXPECT_TRUE(MeshValidation::validate(coarse).isValid());
+}
+
+TEST(DecimationTests, TestBoundaryIsKept) {
+  const auto mesh = makeGrid(8);
+  Decimation::Settings settings;
+  settings.target_face_count = 2U;
+  const auto decimated = Decimation::decimate(mesh, settings);
+
+  EXPECT_LT(decimated.faces.size(), 16U);
+  const auto statistics = MeshStatistics::calculate(decimated.toMeshData());
+  EXPECT_NEAR(statistics.getSurfaceArea(), 4.0, EPSILON);
+  for (const auto &vertex : decimated.vertices) {
+    EXPECT_NEAR(vertex.z(), 1.0, EPSILON);
+  }
+}
+
+TEST(DecimationTests, TestParallelIsDeterministic) {
+  const auto mesh = IndexedMesh::weld(TestMeshes::makeCube(1.0, 16), 0.0);
+  Decimation::Settings settings;
+  settings.target_face_count = 100U;
+  settings.partition_count = 4U;
+
+  Parallel::setThreadCount(1U);
+  const auto reference = Decimation::decimate(mesh, settings);
+  EXPECT_LE(reference.faces.size(), 100U);
+  EXPECT_TRUE(MeshValidation::validate(reference).isValid());
+  EXPECT_NEAR(reference.toMeshData().calculateVolume(), 8.0, EPSILON);
+  for (const unsigned int thread_count : {2U, 4U, 7U}) {
+    Parallel::setThreadCount(thread_count);
+    const auto decimated = Decimation::decimate(mesh, settings);
+    EXPECT_EQ(decimated.faces, reference.faces);
+    EXPECT_EQ(decimated.vertices, reference.vertices);
+  }
+  Parallel::setThreadCount(0U);
+}
+
+TEST(DecimationTests, TestEmptyMesh) {
+  const auto decimated = Decimation::decimate(IndexedMesh{}, {});
+  EXPECT_TRUE(decimated.faces.empty());
+  EXPECT_TRUE(decimated.vertices.empty());
+}
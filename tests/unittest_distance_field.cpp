@@ -0,0 +1,123 @@
+#include <Eigen/Dense>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "geometry/closest_point_query.hpp"
+#include "geometry/distance_field.hpp"
+#include "geometry/meshdata.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+class DistanceFieldTests : public ::testing::Test {
+protected:
+  void TearDown() { Parallel::setThreadCount(0U); }
+};
+
+namespace {
+
+static constexpr double EPSILON = 0.00001;
+
+} // namespace
+
+TEST_F(DistanceFieldTests, TestGrid) {
+  DistanceField::Settings settings;
+  settings.resolution = 20U;
+  settings.band_width = 2U;
+  const auto field =
+      DistanceField::generate(TestMeshes::makeCube(1.0, 4), settings);
+
+  // 20 voxels over the cube, with three voxels of padding on each side.
+  EXPECT_NEAR(field.getVoxelSize(), 0.1, EPSILON);
+  EXPECT_EQ(field.getDimensions(), (std::array<std::size_t, 3U>{27U, 27U,
+                                                                27U}));
+  EXPECT_EQ(field.getValues().size(), 27U * 27U * 27U);
+  EXPECT_TRUE(field.getOrigin().isApprox(Eigen::Vector3d::Constant(-1.3)));
+  EXPECT_TRUE(field.getPosition(13U, 13U, 13U).head<3>().isZero(EPSILON));
+
+  EXPECT_TRUE(DistanceField::generate(MeshData{}, settings).getValues()
+                  .empty());
+}
+
+TEST_F(DistanceFieldTests, TestDenseField) {
+  const auto cube = TestMeshes::makeCube(1.0, 4);
+  DistanceField::Settings settings;
+  settings.resolution = 20U;
+  settings.band_width = 2U;
+  const auto field = DistanceField::generate(cube, settings);
+  const ClosestPointQuery query(cube);
+
+  for (std::size_t z = 0U; z < 27U; ++z) {
+    for (std::size_t y = 0U; y < 27U; ++y) {
+      for (std::size_t x = 0U; x < 27U; ++x) {
+        const Eigen::Vector4d position = field.getPosition(x, y, z);
+        const bool is_inside =
+            (position.head<3>().cwiseAbs().array() < 1.0 - EPSILON).all();
+        const double distance = query.findClosestPoint(position)->distance;
+        const double value = field.getValue(x, y, z);
+        // The sweeping reaches the closest Triangle of every grid point.
+        EXPECT_NEAR(std::abs(value), distance, EPSILON);
+        if (distance > EPSILON) {
+          EXPECT_EQ(value < 0.0, is_inside);
+        }
+      }
+    }
+  }
+  EXPECT_NEAR(field.getValue(13U, 13U, 13U), -1.0, 0.05);
+}
+
+TEST_F(DistanceFieldTests, TestNarrowBand) {
+  auto cube = TestMeshes::makeCube(1.0, 4);
+  cube.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{5.0, 0.0, 0.0}),
+      Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity());
+  DistanceField::Settings settings;
+  settings.resolution = 20U;
+  settings.band_width = 3U;
+  settings.is_narrow_band = true;
+  const auto field = DistanceField::generate(cube, settings);
+
+  EXPECT_TRUE(field.getOrigin().isApprox(Eigen::Vector3d{3.6, -1.4, -1.4}));
+  EXPECT_NEAR(field.getValue(14U, 14U, 14U), -0.3, EPSILON);
+  EXPECT_NEAR(field.getValue(0U, 0U, 0U), 0.3, EPSILON);
+  EXPECT_NEAR(field.getValue(2U, 14U, 14U), 0.2, EPSILON);
+  EXPECT_NEAR(field.getValue(5U, 14U, 14U), -0.1, EPSILON);
+}
+
+TEST_F(DistanceFieldTests, TestThreadCountIndependence) {
+  const auto cube = TestMeshes::makeCube(1.0, 6);
+  DistanceField::Settings settings;
+  settings.resolution = 16U;
+
+  Parallel::setThreadCount(1U);
+  const auto serial = DistanceField::generate(cube, settings);
+  Parallel::setThreadCount(4U);
+  const auto parallel = DistanceField::generate(cube, settings);
+
+  EXPECT_EQ(serial.getValues(), parallel.getValues());
+}
+
+TEST_F(DistanceFieldTests, TestWrite) {
+  DistanceField::Settings settings;
+  settings.resolution = 4U;
+  settings.band_width = 1U;
+  const auto field =
+      DistanceField::generate(TestMeshes::makeCube(1.0, 2), settings);
+  std::ostringstream stream;
+  field.write(stream);
+  const std::string data = stream.str();
+
+  EXPECT_EQ(data.rfind("NRRD0004\n", 0U), 0U);
+  EXPECT_NE(data.find("sizes: 9 9 9\n"), std::string::npos);
+  const std::size_t header_end = data.find("\n\n") + 2U;
+  ASSERT_EQ(data.size() - header_end, 9U * 9U * 9U * sizeof(float));
+  float value = 0.0F;
+  std::memcpy(&value, data.data() + header_end, sizeof(float));
+  EXPECT_EQ(value, field.getValue(0U, 0U, 0U));
+}
@@ -0,0 +1,236 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "geometry/affine_transform.hpp"
+#include "geometry/indexed_mesh.hpp"
+#include "geometry/meshdata.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+namespace {
+
+static constexpr double EPSILON = 0.0000001;
+
+}
+
+TEST(IndexedMeshTests, TestWeldExact) {
+  const auto cube = TestMeshes::makeCube(1.0, 4);
+  const auto indexed_mesh = IndexedMesh::weld(cube, 0.0);
+
+  // A cube with n segments per edge has 6n^2 + 2 distinct vertices.
+  EXPECT_EQ(indexed_mesh.vertices.size(), 6U * 4U * 4U + 2U);
+  ASSERT_EQ(indexed_mesh.faces.size(), cube.triangles.size());
+
+  // The vertices are numbered in the order of their first occurrence.
+  EXPECT_EQ(indexed_mesh.faces[0U], (IndexedMesh::Face{0U, 1U, 2U}));
+  EXPECT_TRUE(indexed_mesh.vertices[0U] == cube.triangles[0U].a.pos);
+
+  for (std::size_t i = 0U; i < cube.triangles.size(); ++i) {
+    const auto &face = indexed_mesh.faces[i];
+    EXPECT_TRUE(indexed_mesh.vertices[face[0U]] == cube.triangles[i].a.pos);
+    EXPECT_TRUE(indexed_mesh.vertices[face[1U]] == cube.triangles[i].b.pos);
+    EXPECT_TRUE(indexed_mesh.vertices[face[2U]] == cube.triangles[i].c.pos);
+  }
+}
+
+TEST(IndexedMeshTests, TestWeldWithTolerance) {
+  auto cube = TestMeshes::makeCube(1.0, 4);
+  // Moves the vertices to the middle of the cells, then perturbs every
+  // corner separately.
+  std::mt19937 generator(3U);
+  std::uniform_real_distribution<double> noise(-1e-4, 1e-4);
+  for (auto &triangle : cube.triangles) {
+    for (auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+      for (Eigen::Index axis = 0; axis < 3; ++axis) {
+        vertex->pos[axis] += noise(generator);
+      }
+    }
+  }
+  cube.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{0.005, 0.005, 0.005}),
+      Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity());
+
+  EXPECT_EQ(IndexedMesh::weld(cube, 0.0).vertices.size(),
+            3U * cube.triangles.size());
+  const auto indexed_mesh = IndexedMesh::weld(cube, 0.01);
+  EXPECT_EQ(indexed_mesh.vertices.size(), 6U * 4U * 4U + 2U);
+
+  // The pending transformation is applied to the welded positions.
+  const Eigen::Vector4d expected =
+      cube.getPendingTransform().transformPoint(cube.triangles[0U].a.pos);
+  EXPECT_TRUE(indexed_mesh.vertices[0U].isApprox(expected));
+}
+
+TEST(IndexedMeshTests, TestWeldIsDeterministic) {
+  const auto cube = TestMeshes::makeCube(2.0, 40);
+
+  Parallel::setThreadCount(1U);
+  const auto reference = IndexedMesh::weld(cube, 0.0);
+  for (const unsigned int thread_count : {2U, 7U, 16U}) {
+    Parallel::setThreadCount(thread_count);
+    const auto indexed_mesh = IndexedMesh::weld(cube, 0.0);
+    EXPECT_EQ(indexed_mesh.faces, reference.faces);
+    EXPECT_EQ(indexed_mesh.vertices.size(), reference.vertices.size());
+  }
+  Parallel::setThreadCount(0U);
+}
+
+TEST(IndexedMeshTests, TestClusterFineGrid) {
+  const auto cube = TestMeshes::makeCube(1.0, 4);
+  const auto clustered = IndexedMesh::cluster(cube, 1e-6);
+
+  // Every cell holds a single position, so nothing is collapsed.
+  EXPECT_EQ(clustered.vertices.size(), 6U * 4U * 4U + 2U);
+  EXPECT_EQ(clustered.faces.size(), cube.triangles.size());
+  EXPECT_NEAR(clustered.toMeshData().calculateVolume(), 8.0, EPSILON);
+}
+
+TEST(IndexedMeshTests, TestClusterCoarseGrid) {
+  auto cube = TestMeshes::makeCube(1.0, 16);
+  // The translation keeps the vertices off the cell boundaries.
+  cube.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{0.01, 0.02, 0.03}),
+      Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity());
+  const double cell_size = 0.3;
+  const auto clustered = IndexedMesh::cluster(cube, cell_size);
+
+  EXPECT_GT(clustered.faces.size(), 0U);
+  EXPECT_LT(clustered.faces.size(), cube.triangles.size() / 4U);
+  std::vector<bool> is_used(clustered.vertices.size(), false);
+  for (const auto &face : clustered.faces) {
+    EXPECT_NE(face[0U], face[1U]);
+    EXPECT_NE(face[1U], face[2U]);
+    EXPECT_NE(face[2U], face[0U]);
+    for (const auto vertex : face) {
+      is_used[vertex] = true;
+    }
+  }
+  EXPECT_EQ(std::count(is_used.begin(), is_used.end(), false), 0);
+
+  // The averages stay inside their cells, so every vertex has its own cell.
+  std::set<std::array<double, 3U>> cells;
+  for (const auto &vertex : clustered.vertices) {
+    cells.insert({std::floor(vertex.x() / cell_size),
+                  std::floor(vertex.y() / cell_size),
+                  std::floor(vertex.z() / cell_size)});
+  }
+  EXPECT_EQ(cells.size(), clustered.vertices.size());
+}
+
+TEST(IndexedMeshTests, TestClusterAveragesDistinctVertices) {
+  // A fan of 8 Triangles around the first position, and one Triangle using
+  // the second position in the same cell. Averaging the corners would put
+  // the vertex at 0.1 + 0.4 / 9 along x.
+  const Eigen::Vector4d center{0.1, 0.1, 0.1, 1.0};
+  const Eigen::Vector4d other{0.5, 0.1, 0.1, 1.0};
+  MeshData mesh;
+  for (int i = 0; i < 8; ++i) {
+    const double angle = EIGEN_PI / 4.0 * i;
+    const double next = EIGEN_PI / 4.0 * (i + 1);
+    mesh.triangles.push_back(
+        {center,
+         Eigen::Vector4d{10.0 * std::cos(angle), 10.0 * std::sin(angle), 0.5,
+                         1.0},
+         Eigen::Vector4d{10.0 * std::cos(next), 10.0 * std::sin(next), 0.5,
+                         1.0}});
+  }
+  mesh.triangles.push_back({other, Eigen::Vector4d{0.5, 20.5, 0.5, 1.0},
+                            Eigen::Vector4d{20.5, 0.5, 0.5, 1.0}});
+  const auto clustered = IndexedMesh::cluster(mesh, 1.0);
+
+  ASSERT_EQ(clustered.faces.size(), mesh.triangles.size());
+  EXPECT_TRUE(clustered.vertices[clustered.faces[0U][0U]].isApprox(
+      Eigen::Vector4d{0.3, 0.1, 0.1, 1.0}));
+  EXPECT_EQ(clustered.faces[8U][0U], clustered.faces[0U][0U]);
+}
+
+TEST(IndexedMeshTests, TestClusterDropsDuplicateFaces) {
+  // The first two Triangles collapse onto the same cells in the same order,
+  // the third one has the opposite orientation.
+  MeshData mesh;
+  for (const double offset : {0.1, 0.2}) {
+    mesh.triangles.push_back({Eigen::Vector4d{offset, offset, offset, 1.0},
+                              Eigen::Vector4d{5.0 + offset, offset, 0.1, 1.0},
+                              Eigen::Vector4d{offset, 5.0 + offset, 0.1, 1.0}});
+  }
+  mesh.triangles.push_back({Eigen::Vector4d{0.3, 0.3, 0.3, 1.0},
+                            Eigen::Vector4d{0.3, 5.3, 0.1, 1.0},
+                            Eigen::Vector4d{5.3, 0.3, 0.1, 1.0}});
+  const auto clustered = IndexedMesh::cluster(mesh, 1.0);
+
+  ASSERT_EQ(clustered.faces.size(), 2U);
+  EXPECT_EQ(clustered.faces[0U], (IndexedMesh::Face{0U, 1U, 2U}));
+  EXPECT_EQ(clustered.faces[1U], (IndexedMesh::Face{0U, 2U, 1U}));
+  EXPECT_EQ(clustered.vertices.size(), 3U);
+}
+
+TEST(IndexedMeshTests, TestClusterIsDeterministic) {
+  const auto cube = TestMeshes::makeCube(2.0, 40);
+
+  Parallel::setThreadCount(1U);
+  const auto reference = IndexedMesh::cluster(cube, 0.35);
+  for (const unsigned int thread_count : {2U, 7U, 16U}) {
+    Parallel::setThreadCount(thread_count);
+    const auto clustered = IndexedMesh::cluster(cube, 0.35);
+    EXPECT_EQ(clustered.faces, reference.faces);
+    EXPECT_EQ(clustered.vertices, reference.vertices);
+  }
+  Parallel::setThreadCount(0U);
+}
+
+TEST(IndexedMeshTests, TestToMeshData) {
+  const auto cube = TestMeshes::makeCube(1.5, 3);
+  const auto mesh = IndexedMesh::weld(cube, 0.0).toMeshData();
+
+  ASSERT_EQ(mesh.triangles.size(), cube.triangles.size());
+  EXPECT_NEAR(mesh.calculateSurfaceArea(), cube.calculateSurfaceArea(),
+              EPSILON);
+  EXPECT_NEAR(mesh.calculateVolume(), cube.calculateVolume(), EPSILON);
+}
+
+TEST(IndexedMeshTests, TestApplyPositions) {
+  auto cube = TestMeshes::makeCube(1.0, 2);
+  for (auto &triangle : cube.triangles) {
+    triangle.a.normal = Eigen::Vector4d::UnitZ();
+    triangle.b.texture = Eigen::Vector4d(0.5, 0.25, 0.0, 0.0);
+    triangle.c.pos.x() += 1e-4;
+  }
+  // A rotation by 90 degrees about the x axis turns +z into -y.
+  cube.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{1.0, 0.0, 0.0}),
+      Utility::getRotationMatrix(Eigen::Vector3d::UnitX(), EIGEN_PI / 2.0),
+      Eigen::Matrix4d::Identity());
+  const auto indexed_mesh = IndexedMesh::weld(cube, 0.01);
+  auto mesh = cube;
+  indexed_mesh.applyPositions(mesh);
+
+  EXPECT_EQ(mesh.getPendingTransform().getKind(),
+            AffineTransform::Kind::IDENTITY);
+  ASSERT_EQ(mesh.triangles.size(), cube.triangles.size());
+  for (std::size_t i = 0U; i < mesh.triangles.size(); ++i) {
+    const auto &triangle = mesh.triangles[i];
+    const auto &face = indexed_mesh.faces[i];
+    EXPECT_TRUE(triangle.a.pos == indexed_mesh.vertices[face[0U]]);
+    EXPECT_TRUE(triangle.b.pos == indexed_mesh.vertices[face[1U]]);
+    EXPECT_TRUE(triangle.c.pos == indexed_mesh.vertices[face[2U]]);
+    EXPECT_TRUE(triangle.a.normal.isApprox(-Eigen::Vector4d::UnitY()));
+    EXPECT_EQ(triangle.b.texture, cube.triangles[i].b.texture);
+  }
+}
+
+TEST(IndexedMeshTests, TestEmptyMesh) {
+  const auto indexed_mesh = IndexedMesh::weld(MeshData{}, 0.0);
+  EXPECT_TRUE(indexed_mesh.vertices.empty());
+  EXPECT_TRUE(indexed_mesh.faces.empty());
+  EXPECT_TRUE(IndexedMesh::cluster(MeshData{}, 1.0).faces.empty());
+}
@@ -0,0 +1,121 @@
+#include <Eigen/Dense>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "geometry/mesh_distance.hpp"
+#include "geometry/meshdata.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+class MeshDistanceTests : public ::testing::Test {
+protected:
+  void TearDown() { Parallel::setThreadCount(0U); }
+};
+
+namespace {
+
+static constexpr double EPSILON = 0.0000001;
+
+} // namespace
+
+TEST_F(MeshDistanceTests, TestSamplePoints) {
+  // Two Triangles with the areas 1 and 3, the samples are stratified, so
+  // they are split exactly by area.
+  MeshData mesh;
+  mesh.triangles.push_back({Eigen::Vector4d{0.0, 0.0, 0.0, 1.0},
+                            Eigen::Vector4d{2.0, 0.0, 0.0, 1.0},
+                            Eigen::Vector4d{0.0, 1.0, 0.0, 1.0}});
+  mesh.triangles.push_back({Eigen::Vector4d{0.0, 0.0, 1.0, 1.0},
+                            Eigen::Vector4d{3.0, 0.0, 1.0, 1.0},
+                            Eigen::Vector4d{0.0, 2.0, 1.0, 1.0}});
+  const auto samples = MeshDistance::samplePoints(mesh, 400U);
+  ASSERT_EQ(samples.size(), 400U);
+  std::size_t first_count = 0U;
+  for (const auto &sample : samples) {
+    EXPECT_EQ(sample.w(), 1.0);
+    EXPECT_GE(sample.x(), 0.0);
+    EXPECT_GE(sample.y(), 0.0);
+    if (sample.z() == 0.0) {
+      ++first_count;
+      EXPECT_LE(sample.x() / 2.0 + sample.y(), 1.0 + EPSILON);
+    } else {
+      EXPECT_NEAR(sample.z(), 1.0, EPSILON);
+      EXPECT_LE(sample.x() / 3.0 + sample.y() / 2.0, 1.0 + EPSILON);
+    }
+  }
+  EXPECT_EQ(first_count, 100U);
+
+  EXPECT_TRUE(MeshDistance::samplePoints(MeshData{}, 10U).empty());
+  EXPECT_TRUE(MeshDistance::samplePoints(mesh, 0U).empty());
+}
+
+TEST_F(MeshDistanceTests, TestIdentical) {
+  const auto cube = TestMeshes::makeCube(1.0, 4);
+  const auto distance = MeshDistance::compare(cube, cube, 1000U);
+  EXPECT_EQ(distance.getFirstToSecond().sample_count, 1000U);
+  EXPECT_EQ(distance.getSecondToFirst().sample_count, 1000U);
+  EXPECT_NEAR(distance.getHausdorff(), 0.0, EPSILON);
+  EXPECT_NEAR(distance.getRms(), 0.0, EPSILON);
+}
+
+TEST_F(MeshDistanceTests, TestScaled) {
+  // Every point of the smaller cube is 0.1 from the larger one, the corners
+  // of the larger cube are the farthest from the smaller one.
+  const auto cube = TestMeshes::makeCube(1.0, 2);
+  auto scaled = TestMeshes::makeCube(1.0, 2);
+  scaled.deferTransform(
+      Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity(),
+      Utility::getScaleMatrix(Eigen::Vector3d::Constant(1.1)));
+  const auto distance = MeshDistance::compare(cube, scaled, 10000U);
+
+  const auto &inner = distance.getFirstToSecond();
+  EXPECT_NEAR(inner.max, 0.1, EPSILON);
+  EXPECT_NEAR(inner.mean, 0.1, EPSILON);
+  EXPECT_NEAR(inner.rms, 0.1, EPSILON);
+
+  const auto &outer = distance.getSecondToFirst();
+  EXPECT_GT(outer.max, 0.1);
+  EXPECT_LE(outer.max, 0.1 * std::sqrt(3.0) + EPSILON);
+  EXPECT_GE(outer.mean, 0.1 - EPSILON);
+  EXPECT_LE(outer.mean, outer.rms);
+  EXPECT_GT(outer.farthest_point.head<3>().cwiseAbs().minCoeff(), 1.0);
+  EXPECT_EQ(distance.getHausdorff(), outer.max);
+  EXPECT_GT(distance.getRms(), inner.rms);
+  EXPECT_LT(distance.getRms(), outer.rms);
+}
+
+TEST_F(MeshDistanceTests, TestEmpty) {
+  const auto cube = TestMeshes::makeCube(1.0, 1);
+  const auto distance = MeshDistance::compare(cube, MeshData{}, 100U);
+  EXPECT_EQ(distance.getFirstToSecond().max,
+            std::numeric_limits<double>::infinity());
+  EXPECT_EQ(distance.getSecondToFirst().sample_count, 0U);
+  EXPECT_EQ(distance.getHausdorff(), std::numeric_limits<double>::infinity());
+
+  const auto empty = MeshDistance::compare(MeshData{}, MeshData{});
+  EXPECT_EQ(empty.getHausdorff(), 0.0);
+  EXPECT_EQ(empty.getRms(), 0.0);
+}
+
+TEST_F(MeshDistanceTests, TestThreadCount) {
+  const auto cube = TestMeshes::makeCube(1.0, 10);
+  auto other = TestMeshes::makeCube(1.0, 10);
+  other.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{0.3, 0.2, 0.1}),
+      Utility::getRotationMatrix(Eigen::Vector3d{1.0, 1.0, 0.0}, 0.4),
+      Eigen::Matrix4d::Identity());
+
+  Parallel::setThreadCount(1U);
+  const auto serial = MeshDistance::compare(cube, other, 5000U);
+  Parallel::setThreadCount(4U);
+  const auto parallel = MeshDistance::compare(cube, other, 5000U);
+  EXPECT_EQ(serial.getHausdorff(), parallel.getHausdorff());
+  EXPECT_EQ(serial.getRms(), parallel.getRms());
+  EXPECT_EQ(serial.getFirstToSecond().farthest_point,
+            parallel.getFirstToSecond().farthest_point);
+}
@@ -0,0 +1,161 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "geometry/mesh_intersection.hpp"
+#include "geometry/meshdata.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+class MeshIntersectionTests : public ::testing::Test {
+protected:
+  void TearDown() { Parallel::setThreadCount(0U); }
+};
+
+namespace {
+
+/**
+ * @brief Creates a Triangle from the positions of its corners.
+ */
+Triangle makeTriangle(const Eigen::Vector3d &a, const Eigen::Vector3d &b,
+                      const Eigen::Vector3d &c) {
+  return {Eigen::Vector4d(a.x(), a.y(), a.z(), 1.0),
+          Eigen::Vector4d(b.x(), b.y(), b.z(), 1.0),
+          Eigen::Vector4d(c.x(), c.y(), c.z(), 1.0)};
+}
+
+} // namespace
+
+TEST_F(MeshIntersectionTests, TestIntersect) {
+  const auto triangle = makeTriangle({0.0, 0.0, 0.0}, {1.0, 0.0, 0.0},
+                                     {0.0, 1.0, 0.0});
+
+  // Piercing, separated and touching in a corner.
+  EXPECT_TRUE(MeshIntersection::intersect(
+      triangle, makeTriangle({0.2, 0.2, -1.0}, {0.2, 0.2, 1.0},
+                             {2.0, 2.0, 0.0})));
+  EXPECT_FALSE(MeshIntersection::intersect(
+      triangle, makeTriangle({0.0, 0.0, 1e-300}, {1.0, 0.0, 1.0},
+                             {0.0, 1.0, 1.0})));
+  EXPECT_TRUE(MeshIntersection::intersect(
+      triangle, makeTriangle({0.0, 0.0, 0.0}, {-1.0, 0.0, 1.0},
+                             {0.0, -1.0, 1.0})));
+
+  // An edge touching the hypotenuse in a single point, and just missing
+  // it, which only the exact predicates tell apart.
+  EXPECT_TRUE(MeshIntersection::intersect(
+      triangle, makeTriangle({0.25, 0.75, -1.0}, {0.25, 0.75, 1.0},
+                             {1.0, 2.0, 0.0})));
+  const double y = std::nextafter(0.75, 1.0);
+  EXPECT_FALSE(MeshIntersection::intersect(
+      triangle,
+      makeTriangle({0.25, y, -1.0}, {0.25, y, 1.0}, {1.0, 2.0, 0.0})));
+}
+
+TEST_F(MeshIntersectionTests, TestCoplanar) {
+  const auto triangle = makeTriangle({0.0, 0.0, 0.0}, {1.0, 0.0, 0.0},
+                                     {0.0, 1.0, 0.0});
+  EXPECT_TRUE(MeshIntersection::intersect(
+      triangle, makeTriangle({0.5, -0.5, 0.0}, {0.5, 2.0, 0.0},
+                             {2.0, 0.0, 0.0})));
+  EXPECT_TRUE(MeshIntersection::intersect(
+      triangle, makeTriangle({0.1, 0.1, 0.0}, {0.2, 0.1, 0.0},
+                             {0.1, 0.2, 0.0})));
+  EXPECT_TRUE(MeshIntersection::intersect(
+      makeTriangle({0.1, 0.1, 0.0}, {0.2, 0.1, 0.0}, {0.1, 0.2, 0.0}),
+      triangle));
+  EXPECT_FALSE(MeshIntersection::intersect(
+      triangle, makeTriangle({1.0, 1.0, 0.0}, {2.0, 1.0, 0.0},
+                             {1.0, 2.0, 0.0})));
+}
+
+TEST_F(MeshIntersectionTests, TestClosedMesh) {
+  // Neighbors sharing edges and vertices do not count as intersecting.
+  EXPECT_TRUE(MeshIntersection::findSelfIntersections(
+                  TestMeshes::makeCube(1.0, 4))
+                  .empty());
+  EXPECT_TRUE(MeshIntersection::findSelfIntersections(MeshData{}).empty());
+}
+
+TEST_F(MeshIntersectionTests, TestSelfIntersections) {
+  // A duplicated Triangle, and one folded back onto its neighbor.
+  MeshData mesh;
+  mesh.triangles = {
+      makeTriangle({0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}),
+      makeTriangle({0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}),
+      makeTriangle({1.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.5, 0.5, 0.0}),
+      makeTriangle({1.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.5, -0.5, 0.0}),
+      makeTriangle({5.0, 0.0, 0.0}, {6.0, 0.0, 0.0}, {7.0, 0.0, 0.0})};
+  const std::vector<MeshIntersection::Pair> expected{
+      {0U, 1U}, {0U, 2U}, {1U, 2U}};
+  EXPECT_EQ(MeshIntersection::findSelfIntersections(mesh), expected);
+
+  // Two cubes in one mesh cross each other.
+  auto cubes = TestMeshes::makeCube(1.0, 2);
+  const auto shifted = TestMeshes::makeCube(1.0, 2);
+  for (auto triangle : shifted.triangles) {
+    for (auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+      vertex->pos += Eigen::Vector4d(0.5, 0.5, 0.5, 0.0);
+    }
+    cubes.triangles.push_back(triangle);
+  }
+  const auto pairs = MeshIntersection::findSelfIntersections(cubes);
+  ASSERT_FALSE(pairs.empty());
+  for (const auto &[first, second] : pairs) {
+    EXPECT_LT(first, 48U);
+    EXPECT_GE(second, 48U);
+  }
+}
+
+TEST_F(MeshIntersectionTests, TestInterference) {
+  const auto cube = TestMeshes::makeCube(1.0, 4);
+  auto other = TestMeshes::makeCube(1.0, 4);
+
+  // Touching sides interfere, with the transformation applied.
+  other.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{2.0, 0.0, 0.0}),
+      Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity());
+  const auto touching = MeshIntersection::findInterference(cube, other);
+  ASSERT_FALSE(touching.empty());
+  for (const auto &[first, second] : touching) {
+    EXPECT_DOUBLE_EQ(
+        std::max({cube.triangles[first].a.pos.x(),
+                  cube.triangles[first].b.pos.x(),
+                  cube.triangles[first].c.pos.x()}),
+        1.0);
+    EXPECT_DOUBLE_EQ(
+        std::min({other.triangles[second].a.pos.x(),
+                  other.triangles[second].b.pos.x(),
+                  other.triangles[second].c.pos.x()}),
+        -1.0);
+  }
+
+  auto separated = TestMeshes::makeCube(1.0, 4);
+  separated.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{2.001, 0.0, 0.0}),
+      Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity());
+  EXPECT_TRUE(MeshIntersection::findInterference(cube, separated).empty());
+  EXPECT_TRUE(MeshIntersection::findInterference(cube, MeshData{}).empty());
+}
+
+TEST_F(MeshIntersectionTests, TestThreadCount) {
+  const auto cube = TestMeshes::makeCube(1.0, 40);
+  auto other = TestMeshes::makeCube(1.0, 40);
+  other.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{0.3, 0.2, 0.1}),
+      Utility::getRotationMatrix(Eigen::Vector3d{1.0, 1.0, 0.0}, 0.4),
+      Eigen::Matrix4d::Identity());
+
+  Parallel::setThreadCount(1U);
+  const auto serial = MeshIntersection::findInterference(cube, other);
+  Parallel::setThreadCount(4U);
+  const auto parallel = MeshIntersection::findInterference(cube, other);
+  EXPECT_FALSE(serial.empty());
+  EXPECT_EQ(serial, parallel);
+}
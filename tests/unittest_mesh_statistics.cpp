@@ -0,0 +1,130 @@
+#include <Eigen/Dense>
+#include <cstddef>
+#include <utility>
+
+#include "geometry/mesh_statistics.hpp"
+#include "geometry/meshdata.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+namespace {
+
+static constexpr double EPSILON = 0.0000001;
+
+}
+
+TEST(MeshStatisticsTests, TestCube) {
+  auto cube = TestMeshes::makeCube(1.0, 3);
+  cube.transform(Utility::getTranslationMatrix({1.0, 2.0, 3.0}),
+                 Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity());
+
+  const auto statistics = MeshStatistics::calculate(cube);
+  EXPECT_EQ(statistics.getTriangleCount(), cube.triangles.size());
+  EXPECT_EQ(statistics.getDegenerateCount(), 0U);
+  EXPECT_NEAR(statistics.getSurfaceArea(), 24.0, EPSILON);
+  EXPECT_NEAR(statistics.getSignedVolume(), 8.0, EPSILON);
+  EXPECT_TRUE(statistics.getBoundingBox().min().isApprox(
+      Eigen::Vector3d{0.0, 1.0, 2.0}));
+  EXPECT_TRUE(statistics.getBoundingBox().max().isApprox(
+      Eigen::Vector3d{2.0, 3.0, 4.0}));
+  EXPECT_TRUE(
+      statistics.getCentroid().isApprox(Eigen::Vector3d{1.0, 2.0, 3.0}));
+
+  // The inertia of a solid cube is m * s^2 / 6 around each axis.
+  const Eigen::Matrix3d expected_inertia =
+      8.0 * 4.0 / 6.0 * Eigen::Matrix3d::Identity();
+  EXPECT_TRUE(statistics.getInertiaTensor().isApprox(expected_inertia));
+}
+
+TEST(MeshStatisticsTests, TestInwardFacingMesh) {
+  auto cube = TestMeshes::makeCube(1.0, 1);
+  for (auto &triangle : cube.triangles) {
+    std::swap(triangle.b, triangle.c);
+  }
+
+  const auto statistics = MeshStatistics::calculate(cube);
+  EXPECT_NEAR(statistics.getSignedVolume(), -8.0, EPSILON);
+  EXPECT_TRUE(statistics.getCentroid().isZero(EPSILON));
+  EXPECT_TRUE(statistics.getInertiaTensor().isApprox(
+      8.0 * 4.0 / 6.0 * Eigen::Matrix3d::Identity()));
+}
+
+TEST(MeshStatisticsTests, TestDegenerateTriangles) {
+  MeshStatistics statistics;
+  statistics.add({Eigen::Vector4d{0.0, 0.0, 0.0, 1.0},
+                  Eigen::Vector4d{1.0, 0.0, 0.0, 1.0},
+                  Eigen::Vector4d{0.0, 1.0, 0.0, 1.0}});
+  statistics.add({Eigen::Vector4d{0.0, 0.0, 0.0, 1.0},
+                  Eigen::Vector4d{1.0, 1.0, 1.0, 1.0},
+                  Eigen::Vector4d{2.0, 2.0, 2.0, 1.0}});
+  statistics.add({Eigen::Vector4d{5.0, 5.0, 5.0, 1.0},
+                  Eigen::Vector4d{5.0, 5.0, 5.0, 1.0},
+                  Eigen::Vector4d{5.0, 5.0, 5.0, 1.0}});
+
+  EXPECT_EQ(statistics.getTriangleCount(), 3U);
+  EXPECT_EQ(statistics.getDegenerateCount(), 2U);
+  EXPECT_DOUBLE_EQ(statistics.getSurfaceArea(), 0.5);
+  // Without volume the centroid of the surface is used.
+  EXPECT_TRUE(statistics.getCentroid().isApprox(
+      Eigen::Vector3d{1.0 / 3.0, 1.0 / 3.0, 0.0}));
+}
+
+TEST(MeshStatisticsTests, TestIncrementalMatchesParallel) {
+  const auto cube = TestMeshes::makeCube(2.5, 40);
+
+  MeshStatistics incremental;
+  for (const auto &triangle : cube.triangles) {
+    incremental.add(triangle);
+  }
+
+  Parallel::setThreadCount(4U);
+  const auto parallel = MeshStatistics::calculate(cube);
+  Parallel::setThreadCount(0U);
+
+  EXPECT_EQ(incremental.getTriangleCount(), parallel.getTriangleCount());
+  EXPECT_NEAR(incremental.getSurfaceArea(), parallel.getSurfaceArea(),
+              EPSILON);
+  EXPECT_NEAR(incremental.getSignedVolume(), parallel.getSignedVolume(),
+              EPSILON);
+  EXPECT_TRUE(incremental.getBoundingBox().isApprox(parallel.getBoundingBox()));
+  EXPECT_TRUE(incremental.getInertiaTensor().isApprox(
+      parallel.getInertiaTensor()));
+}
+
+TEST(MeshStatisticsTests, TestReproducibleSums) {
+  auto mesh = TestMeshes::makeCube(1.0, 40);
+  mesh.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{0.3, 0.2, 0.1}),
+      Utility::getRotationMatrix(Eigen::Vector3d{1.0, 1.0, 0.0}, 0.4),
+      Eigen::Matrix4d::Identity());
+
+  // The area is summed with the reduction tree of reproducibleSum.
+  auto transformed = mesh;
+  transformed.applyPendingTransform();
+  const double expected_area = Parallel::reproducibleSum(
+      transformed.triangles.size(),
+      [&transformed](std::size_t begin, std::size_t end, double *values) {
+        for (std::size_t i = begin; i < end; ++i) {
+          const auto &triangle = transformed.triangles[i];
+          const Eigen::Vector3d a = triangle.a.pos.head<3>();
+          const Eigen::Vector3d b = triangle.b.pos.head<3>();
+          const Eigen::Vector3d c = triangle.c.pos.head<3>();
+          values[i - begin] = (b - a).cross(c - a).norm() / 2.0;
+        }
+      });
+
+  Parallel::setThreadCount(1U);
+  const auto serial = MeshStatistics::calculate(mesh);
+  Parallel::setThreadCount(4U);
+  const auto parallel = MeshStatistics::calculate(mesh);
+  Parallel::setThreadCount(0U);
+
+  EXPECT_EQ(serial.getSurfaceArea(), parallel.getSurfaceArea());
+  EXPECT_EQ(serial.getSignedVolume(), parallel.getSignedVolume());
+  EXPECT_EQ(parallel.getSurfaceArea(), expected_area);
+  EXPECT_NEAR(parallel.getSignedVolume(), 8.0, EPSILON);
+}
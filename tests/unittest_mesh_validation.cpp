@@ -0,0 +1,97 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <utility>
+
+#include "geometry/indexed_mesh.hpp"
+#include "geometry/mesh_validation.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+TEST(MeshValidationTests, TestClosedMesh) {
+  const auto cube = IndexedMesh::weld(TestMeshes::makeCube(1.0, 3), 0.0);
+  const auto validation = MeshValidation::validate(cube);
+
+  EXPECT_TRUE(validation.isWatertight());
+  EXPECT_TRUE(validation.isValid());
+  EXPECT_TRUE(validation.getBoundaryEdges().empty());
+  EXPECT_TRUE(validation.getNonManifoldEdges().empty());
+  EXPECT_TRUE(validation.getInconsistentEdges().empty());
+  EXPECT_TRUE(validation.getDegenerateFaces().empty());
+}
+
+TEST(MeshValidationTests, TestBoundaryEdges) {
+  auto cube = IndexedMesh::weld(TestMeshes::makeCube(1.0, 3), 0.0);
+  const auto removed_face = cube.faces[5U];
+  cube.faces.erase(cube.faces.begin() + 5);
+  const auto validation = MeshValidation::validate(cube);
+
+  EXPECT_FALSE(validation.isWatertight());
+  ASSERT_EQ(validation.getBoundaryEdges().size(), 3U);
+  const MeshValidation::Edge expected{
+      std::min(removed_face[0U], removed_face[1U]),
+      std::max(removed_face[0U], removed_face[1U])};
+  const auto &edges = validation.getBoundaryEdges();
+  EXPECT_NE(std::find(edges.begin(), edges.end(), expected), edges.end());
+  EXPECT_TRUE(std::is_sorted(edges.begin(), edges.end()));
+}
+
+TEST(MeshValidationTests, TestInconsistentWinding) {
+  auto cube = IndexedMesh::weld(TestMeshes::makeCube(1.0, 3), 0.0);
+  std::swap(cube.faces[7U][0U], cube.faces[7U][1U]);
+  const auto validation = MeshValidation::validate(cube);
+
+  EXPECT_TRUE(validation.isWatertight());
+  EXPECT_FALSE(validation.isValid());
+  EXPECT_EQ(validation.getInconsistentEdges().size(), 3U);
+}
+
+TEST(MeshValidationTests, TestNonManifoldEdges) {
+  auto cube = IndexedMesh::weld(TestMeshes::makeCube(1.0, 3), 0.0);
+  cube.faces.push_back(cube.faces[0U]);
+  const auto validation = MeshValidation::validate(cube);
+
+  EXPECT_FALSE(validation.isWatertight());
+  EXPECT_EQ(validation.getNonManifoldEdges().size(), 3U);
+  EXPECT_TRUE(validation.getBoundaryEdges().empty());
+}
+
+TEST(MeshValidationTests, TestDegenerateFaces) {
+  auto cube = IndexedMesh::weld(TestMeshes::makeCube(1.0, 1), 0.0);
+  const auto face_count = cube.faces.size();
+  // A face with a repeated vertex is left out of the edge checks.
+  cube.faces.push_back({0U, 1U, 1U});
+  // A face with collinear vertices has edges, which are boundary edges.
+  cube.vertices.push_back({2.0, 0.0, 0.0, 1.0});
+  cube.vertices.push_back({3.0, 0.0, 0.0, 1.0});
+  cube.vertices.push_back({4.0, 0.0, 0.0, 1.0});
+  const auto first = static_cast<std::uint32_t>(cube.vertices.size() - 3U);
+  cube.faces.push_back({first, first + 1U, first + 2U});
+  const auto validation = MeshValidation::validate(cube);
+
+  const auto &faces = validation.getDegenerateFaces();
+  ASSERT_EQ(faces.size(), 2U);
+  EXPECT_EQ(faces[0U], face_count);
+  EXPECT_EQ(faces[1U], face_count + 1U);
+  EXPECT_EQ(validation.getBoundaryEdges().size(), 3U);
+}
+
+TEST(MeshValidationTests, TestIsDeterministic) {
+  auto cube = IndexedMesh::weld(TestMeshes::makeCube(1.0, 30), 0.0);
+  for (std::size_t i = 0U; i < cube.faces.size(); i += 97U) {
+    std::swap(cube.faces[i][1U], cube.faces[i][2U]);
+  }
+
+  Parallel::setThreadCount(1U);
+  const auto reference = MeshValidation::validate(cube);
+  EXPECT_FALSE(reference.getInconsistentEdges().empty());
+  for (const unsigned int thread_count : {3U, 8U}) {
+    Parallel::setThreadCount(thread_count);
+    const auto validation = MeshValidation::validate(cube);
+    EXPECT_EQ(validation.getInconsistentEdges(),
+              reference.getInconsistentEdges());
+  }
+  Parallel::setThreadCount(0U);
+}
@@ -1,6 +1,11 @@
 #include <Eigen/Dense>
+#include <algorithm>
+#include <random>
 
 #include "geometry/meshdata.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
 #include "gtest/gtest.h"
 
 using namespace Converter;
@@ -65,6 +70,23 @@ TEST_F(MeshDataTests, TestCalculateVolume) {
   EXPECT_DOUBLE_EQ(cube.calculateVolume(), 8.0);
 }
 
+TEST_F(MeshDataTests, TestReductionsAreReproducible) {
+  const auto large_cube = TestMeshes::makeCube(3.7, 64);
+
+  Parallel::setThreadCount(1U);
+  const double area = large_cube.calculateSurfaceArea();
+  const double volume = large_cube.calculateVolume();
+  EXPECT_NEAR(area, 6.0 * 7.4 * 7.4, EPSILON);
+  EXPECT_NEAR(volume, 7.4 * 7.4 * 7.4, EPSILON);
+
+  for (const unsigned int thread_count : {2U, 5U, 16U}) {
+    Parallel::setThreadCount(thread_count);
+    EXPECT_EQ(large_cube.calculateSurfaceArea(), area);
+    EXPECT_EQ(large_cube.calculateVolume(), volume);
+  }
+  Parallel::setThreadCount(0U);
+}
+
 TEST_F(MeshDataTests, TestIsPointInside) {
   Eigen::Vector4d testp{0.0, 0.0, 0.0, 1.0};
   EXPECT_TRUE(double_pyramid.isPointInside(testp));
@@ -96,3 +118,134 @@ TEST_F(MeshDataTests, TestIsPointInside) {
   testp = {0.29684, -0.234, 0.194, 1.0};
   EXPECT_TRUE(double_pyramid.isPointInside(testp));
 }
+
+TEST_F(MeshDataTests, TestDeferredTransformMatchesEager) {
+  const auto translation =
+      Utility::getTranslationMatrix(Eigen::Vector3d{1.5, -2.0, 0.25});
+  const auto rotation = Utility::getRotationMatrix(
+      Eigen::Vector3d{1.0, 1.0, 0.0}.normalized(), 0.7);
+  const auto scale = Utility::getScaleMatrix(Eigen::Vector3d{2.0, 0.5, 3.0});
+
+  MeshData eager = double_pyramid;
+  eager.transform(translation, rotation, scale);
+  MeshData deferred = double_pyramid;
+  deferred.deferTransform(translation, rotation, scale);
+
+  EXPECT_NEAR(deferred.calculateSurfaceArea(), eager.calculateSurfaceArea(),
+              EPSILON);
+  EXPECT_NEAR(deferred.calculateVolume(), eager.calculateVolume(), EPSILON);
+  EXPECT_NEAR(deferred.calculateVolume(), 8.0, EPSILON);
+
+  for (const auto &local_point :
+       {Eigen::Vector4d{0.0, 0.0, 0.0, 1.0},
+        Eigen::Vector4d{0.3, -0.2, 0.2, 1.0},
+        Eigen::Vector4d{0.0, -1.2, 0.0, 1.0},
+        Eigen::Vector4d{1.1, 0.0, 0.0, 1.0}}) {
+    const Eigen::Vector4d point =
+        translation * rotation * scale * local_point;
+    EXPECT_EQ(deferred.isPointInside(point), eager.isPointInside(point));
+  }
+
+  deferred.applyPendingTransform();
+  EXPECT_EQ(deferred.getPendingTransform().getKind(),
+            AffineTransform::Kind::IDENTITY);
+  for (std::size_t i = 0U; i < eager.triangles.size(); ++i) {
+    EXPECT_TRUE(deferred.triangles[i].a.pos.isApprox(eager.triangles[i].a.pos));
+    EXPECT_TRUE(deferred.triangles[i].c.pos.isApprox(eager.triangles[i].c.pos));
+  }
+}
+
+TEST_F(MeshDataTests, TestGetPlanes) {
+  const auto &planes = double_pyramid.getPlanes();
+  ASSERT_EQ(planes.size(), double_pyramid.triangles.size());
+  for (std::size_t i = 0U; i < planes.size(); ++i) {
+    const auto &triangle = double_pyramid.triangles[i];
+    EXPECT_TRUE(planes[i].normal.isApprox(triangle.getNormal()));
+    EXPECT_NEAR(planes[i].offset, planes[i].normal.dot(triangle.b.pos),
+                EPSILON);
+    EXPECT_NEAR(planes[i].offset, planes[i].normal.dot(triangle.c.pos),
+                EPSILON);
+  }
+
+  // Transforming the mesh has to invalidate the cache
+  double_pyramid.transform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{0.0, 3.0, 0.0}),
+      Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity());
+  const auto &transformed_planes = double_pyramid.getPlanes();
+  for (std::size_t i = 0U; i < transformed_planes.size(); ++i) {
+    EXPECT_NEAR(transformed_planes[i].offset,
+                transformed_planes[i].normal.dot(
+                    double_pyramid.triangles[i].a.pos),
+                EPSILON);
+  }
+  EXPECT_TRUE(double_pyramid.isPointInside({0.0, 3.0, 0.0, 1.0}));
+  EXPECT_FALSE(double_pyramid.isPointInside({0.0, 0.0, 0.0, 1.0}));
+}
+
+TEST_F(MeshDataTests, TestIsPointInsideScaleIndependent) {
+  for (const double half_size : {1e-6, 1.0, 1e6}) {
+    const auto cube = TestMeshes::makeCube(half_size, 3);
+    EXPECT_TRUE(cube.isPointInside({0.0, 0.0, 0.0, 1.0}));
+    EXPECT_TRUE(cube.isPointInside(
+        {0.5 * half_size, -0.9 * half_size, 0.1 * half_size, 1.0}));
+    EXPECT_FALSE(cube.isPointInside({1.5 * half_size, 0.0, 0.0, 1.0}));
+    // The ray goes through the shared edges and vertices of the faces.
+    EXPECT_TRUE(cube.isPointInside(
+        {half_size / 3.0, -half_size / 3.0, half_size / 3.0, 1.0}));
+    EXPECT_FALSE(cube.isPointInside(
+        {half_size / 3.0, -2.0 * half_size, half_size / 3.0, 1.0}));
+    // Points on the faces parallel to the ray.
+    EXPECT_TRUE(cube.isPointInside({half_size, 0.0, 0.0, 1.0}));
+    EXPECT_TRUE(cube.isPointInside({0.0, 0.5 * half_size, half_size, 1.0}));
+  }
+}
+
+TEST_F(MeshDataTests, TestIsPointInsidePartialPacket) {
+  // The 12 Triangles fill one and a half packets, and the +x side, which is
+  // parallel to the ray, is moved to the partial last packet.
+  auto mesh = cube;
+  std::rotate(mesh.triangles.begin() + 2, mesh.triangles.begin() + 4,
+              mesh.triangles.end());
+  ASSERT_NE(mesh.triangles.size() % 8U, 0U);
+  EXPECT_TRUE(mesh.isPointInside({1.0, 0.2, 0.3, 1.0}));
+  EXPECT_TRUE(mesh.isPointInside({1.0, -0.5, -0.7, 1.0}));
+  EXPECT_FALSE(mesh.isPointInside({1.0, 1.5, 0.3, 1.0}));
+}
+
+TEST_F(MeshDataTests, TestSortSpatially) {
+  auto mesh = TestMeshes::makeCube(1.0, 32);
+  std::mt19937 generator(17U);
+  std::shuffle(mesh.triangles.begin(), mesh.triangles.end(), generator);
+  const double volume = mesh.calculateVolume();
+
+  // The sum of the distances of consecutive centroids measures locality.
+  const auto getPathLength = [](const MeshData &mesh) {
+    double length = 0.0;
+    for (std::size_t i = 1U; i < mesh.triangles.size(); ++i) {
+      const auto &previous = mesh.triangles[i - 1U];
+      const auto &current = mesh.triangles[i];
+      length += ((current.a.pos + current.b.pos + current.c.pos) -
+                 (previous.a.pos + previous.b.pos + previous.c.pos))
+                    .norm() /
+                3.0;
+    }
+    return length;
+  };
+  const double shuffled_length = getPathLength(mesh);
+
+  Parallel::setThreadCount(1U);
+  auto reference = mesh;
+  reference.sortSpatially();
+  EXPECT_LT(getPathLength(reference), shuffled_length / 10.0);
+  EXPECT_NEAR(reference.calculateVolume(), volume, EPSILON);
+  for (const unsigned int thread_count : {2U, 5U}) {
+    Parallel::setThreadCount(thread_count);
+    auto sorted = mesh;
+    sorted.sortSpatially();
+    ASSERT_EQ(sorted.triangles.size(), reference.triangles.size());
+    for (std::size_t i = 0U; i < sorted.triangles.size(); ++i) {
+      EXPECT_TRUE(sorted.triangles[i] == reference.triangles[i]);
+    }
+  }
+  Parallel::setThreadCount(0U);
+}
@@ -0,0 +1,38 @@
+#include <Eigen/Dense>
+#include <cstdint>
+
+#include "geometry/morton.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+TEST(MortonTests, TestEncode) {
+  EXPECT_EQ(Morton::encode(0U, 0U, 0U), 0U);
+  EXPECT_EQ(Morton::encode(1U, 0U, 0U), 1U);
+  EXPECT_EQ(Morton::encode(0U, 1U, 0U), 2U);
+  EXPECT_EQ(Morton::encode(0U, 0U, 1U), 4U);
+  EXPECT_EQ(Morton::encode(3U, 0U, 0U), 9U);
+  EXPECT_EQ(Morton::encode(0x1FFFFFU, 0x1FFFFFU, 0x1FFFFFU),
+            0x7FFFFFFFFFFFFFFFULL);
+  // Bits above the 21st are ignored.
+  EXPECT_EQ(Morton::encode(0x200001U, 0U, 0U), 1U);
+}
+
+TEST(MortonTests, TestEncodePoint) {
+  const Eigen::AlignedBox3d box(Eigen::Vector3d{0.0, 0.0, 0.0},
+                                Eigen::Vector3d{4.0, 4.0, 8.0});
+  EXPECT_EQ(Morton::encodePoint({0.0, 0.0, 0.0}, box, 2U), 0U);
+  EXPECT_EQ(Morton::encodePoint({1.5, 0.0, 2.5}, box, 2U),
+            Morton::encode(1U, 0U, 1U));
+  // The maximum and the points outside are clamped to the last cell.
+  EXPECT_EQ(Morton::encodePoint({4.0, 4.0, 8.0}, box, 2U),
+            Morton::encode(3U, 3U, 3U));
+  EXPECT_EQ(Morton::encodePoint({-1.0, 9.0, 4.0}, box, 2U),
+            Morton::encode(0U, 3U, 2U));
+
+  // A flat box puts every point in the first cell along its empty axis.
+  const Eigen::AlignedBox3d flat_box(Eigen::Vector3d{0.0, 0.0, 1.0},
+                                     Eigen::Vector3d{1.0, 1.0, 1.0});
+  EXPECT_EQ(Morton::encodePoint({0.9, 0.9, 1.0}, flat_box, 1U),
+            Morton::encode(1U, 1U, 0U));
+}
@@ -8,6 +8,7 @@
 #include "exception.hpp"
 #include "geometry/meshdata.hpp"
 #include "reader/obj_reader.hpp"
+#include "utility.hpp"
 #include "gtest/gtest.h"
 
 using namespace Converter;
@@ -173,4 +174,52 @@ TEST_F(ObjReaderTests, TestRead) {
   triangle.c.texture = ct;
 
   EXPECT_TRUE(mesh.triangles[0U] == triangle);
-}
\ No newline at end of file
+}
+TEST_F(ObjReaderTests, TestReadWithCallback) {
+  std::ifstream in_file_stream;
+  in_file_stream.open("test_file.obj");
+  EXPECT_TRUE(in_file_stream);
+  const MeshData mesh = read(in_file_stream);
+
+  in_file_stream.clear();
+  in_file_stream.seekg(0);
+  std::vector<Triangle> triangles;
+  read(in_file_stream, [&triangles](const Triangle &triangle) {
+    triangles.push_back(triangle);
+  });
+
+  ASSERT_EQ(triangles.size(), mesh.triangles.size());
+  for (std::size_t i = 0U; i < triangles.size(); ++i) {
+    EXPECT_TRUE(triangles[i] == mesh.triangles[i]);
+  }
+}
+
+TEST_F(ObjReaderTests, TestReadWithTransform) {
+  std::ifstream in_file_stream;
+  in_file_stream.open("test_file.obj");
+  EXPECT_TRUE(in_file_stream);
+  MeshData mesh = read(in_file_stream);
+  mesh.transform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{1.0, -2.0, 0.5}),
+      Utility::getRotationMatrix(Eigen::Vector3d{0.0, 0.0, 1.0}, 0.5),
+      Utility::getScaleMatrix(Eigen::Vector3d{2.0, 1.0, 3.0}));
+
+  setTransform(AffineTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{1.0, -2.0, 0.5}) *
+      Utility::getRotationMatrix(Eigen::Vector3d{0.0, 0.0, 1.0}, 0.5) *
+      Utility::getScaleMatrix(Eigen::Vector3d{2.0, 1.0, 3.0})));
+  in_file_stream.clear();
+  in_file_stream.seekg(0);
+  const MeshData transformed_mesh = read(in_file_stream);
+
+  ASSERT_EQ(transformed_mesh.triangles.size(), mesh.triangles.size());
+  for (std::size_t i = 0U; i < mesh.triangles.size(); ++i) {
+    const auto &expected = mesh.triangles[i];
+    const auto &current = transformed_mesh.triangles[i];
+    EXPECT_TRUE(current.a.pos.isApprox(expected.a.pos));
+    EXPECT_TRUE(current.b.pos.isApprox(expected.b.pos));
+    EXPECT_TRUE(current.c.pos.isApprox(expected.c.pos));
+    EXPECT_TRUE(current.a.normal.isApprox(expected.a.normal));
+    EXPECT_TRUE(current.a.texture == expected.a.texture);
+  }
+}
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+class ParallelTests : public ::testing::Test {
+protected:
+  void TearDown() { Parallel::setThreadCount(0U); }
+};
+
+TEST_F(ParallelTests, TestThreadCount) {
+  Parallel::setThreadCount(3U);
+  EXPECT_EQ(Parallel::getThreadCount(), 3U);
+  Parallel::setThreadCount(0U);
+  EXPECT_GE(Parallel::getThreadCount(), 1U);
+}
+
+TEST_F(ParallelTests, TestForEachBlock) {
+  for (const unsigned int thread_count : {1U, 4U}) {
+    Parallel::setThreadCount(thread_count);
+    std::vector<std::atomic<int>> visits(1000U);
+    Parallel::forEachBlock(
+        visits.size(), 64U,
+        [&visits](std::size_t block, std::size_t begin, std::size_t end) {
+          EXPECT_EQ(begin, block * 64U);
+          for (std::size_t i = begin; i < end; ++i) {
+            ++visits[i];
+          }
+        });
+    for (const auto &visit : visits) {
+      EXPECT_EQ(visit, 1);
+    }
+  }
+
+  Parallel::forEachBlock(0U, 64U, [](std::size_t, std::size_t, std::size_t) {
+    FAIL() << "Called for an empty range.";
+  });
+}
+
+TEST_F(ParallelTests, TestForEachBlockException) {
+  Parallel::setThreadCount(4U);
+  EXPECT_THROW(Parallel::forEachBlock(
+                   100U, 1U,
+                   [](std::size_t block, std::size_t, std::size_t) {
+                     if (block == 42U) {
+                       throw std::runtime_error("");
+                     }
+                   }),
+               std::runtime_error);
+}
+
+TEST_F(ParallelTests, TestForEachLevel) {
+  const auto getLevelSize = [](std::size_t level) {
+    return level * 37U % 100U;
+  };
+  for (const unsigned int thread_count : {1U, 4U}) {
+    Parallel::setThreadCount(thread_count);
+    std::vector<std::atomic<std::size_t>> visits(50U);
+    Parallel::forEachLevel(
+        visits.size(), getLevelSize, 8U,
+        [&](std::size_t level, std::size_t begin, std::size_t end) {
+          EXPECT_EQ(begin % 8U, 0U);
+          EXPECT_LE(end, getLevelSize(level));
+          if (level > 0U) {
+            EXPECT_EQ(visits[level - 1U], getLevelSize(level - 1U));
+          }
+          visits[level] += end - begin;
+        });
+    for (std::size_t level = 0U; level < visits.size(); ++level) {
+      EXPECT_EQ(visits[level], getLevelSize(level));
+    }
+  }
+}
+
+TEST_F(ParallelTests, TestForEachLevelException) {
+  Parallel::setThreadCount(4U);
+  std::atomic<std::size_t> last_level{0U};
+  EXPECT_THROW(Parallel::forEachLevel(
+                   10U, [](std::size_t) { return 100U; }, 1U,
+                   [&last_level](std::size_t level, std::size_t begin,
+                                 std::size_t) {
+                     last_level = std::max<std::size_t>(last_level, level);
+                     if (level == 3U && begin == 42U) {
+                       throw std::runtime_error("");
+                     }
+                   }),
+               std::runtime_error);
+  EXPECT_EQ(last_level, 3U);
+}
+
+TEST_F(ParallelTests, TestPairwiseSum) {
+  std::vector<double> values(1001U, 0.1);
+  EXPECT_NEAR(Parallel::pairwiseSum(values.data(), values.size()), 100.1,
+              1e-12);
+  EXPECT_DOUBLE_EQ(Parallel::pairwiseSum(values.data(), 0U), 0.0);
+}
+
+TEST_F(ParallelTests, TestReproducibleSum) {
+  const std::size_t size = 100003U;
+  const auto block_values = [](std::size_t begin, std::size_t end,
+                               double *values) {
+    for (std::size_t i = begin; i < end; ++i) {
+      values[i - begin] = 1.0 / static_cast<double>(i + 1U);
+    }
+  };
+
+  Parallel::setThreadCount(1U);
+  const double expected = Parallel::reproducibleSum(size, block_values);
+  for (const unsigned int thread_count : {2U, 3U, 8U}) {
+    Parallel::setThreadCount(thread_count);
+    EXPECT_EQ(Parallel::reproducibleSum(size, block_values), expected);
+  }
+}
+
+TEST_F(ParallelTests, TestSort) {
+  std::mt19937 generator(11U);
+  std::uniform_int_distribution<int> distribution(-1000, 1000);
+  for (const std::size_t size : {0U, 1U, 1000U, 100000U}) {
+    std::vector<int> values(size);
+    for (auto &value : values) {
+      value = distribution(generator);
+    }
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    for (const unsigned int thread_count : {1U, 3U, 8U}) {
+      Parallel::setThreadCount(thread_count);
+      auto sorted = values;
+      Parallel::sort(sorted);
+      EXPECT_EQ(sorted, expected);
+    }
+  }
+}
+
+TEST_F(ParallelTests, TestRadixSort) {
+  std::mt19937_64 generator(13U);
+  for (const std::size_t size : {0U, 1U, 1000U, 100000U}) {
+    // Few distinct keys, so the stability is tested as well.
+    std::vector<std::uint64_t> keys(size);
+    std::vector<std::uint32_t> values(size);
+    for (std::size_t i = 0U; i < size; ++i) {
+      keys[i] = generator() & 0x3F00FFU;
+      values[i] = static_cast<std::uint32_t>(i);
+    }
+    std::vector<std::uint32_t> expected = values;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [&keys](std::uint32_t lhs, std::uint32_t rhs) {
+                       return keys[lhs] < keys[rhs];
+                     });
+
+    for (const unsigned int thread_count : {1U, 3U, 8U}) {
+      Parallel::setThreadCount(thread_count);
+      auto sorted_keys = keys;
+      auto sorted_values = values;
+      Parallel::radixSort(sorted_keys, sorted_values, 22U);
+      EXPECT_EQ(sorted_values, expected);
+      EXPECT_TRUE(std::is_sorted(sorted_keys.begin(), sorted_keys.end()));
+    }
+  }
+}
@@ -0,0 +1,172 @@
+#include <Eigen/Dense>
+#include <cmath>
+#include <random>
+
+#include "geometry/meshdata.hpp"
+#include "geometry/quantized_mesh.hpp"
+#include "geometry/triangle_packet.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+namespace {
+
+static constexpr double EPSILON = 0.0000001;
+
+// Creates a soup of uniformly random triangles in a 20 units wide box, with
+// random normals and texture coordinates.
+MeshData makeRandomMesh(std::size_t triangle_count) {
+  std::mt19937 generator(7U);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  MeshData mesh;
+  for (std::size_t i = 0U; i < triangle_count; ++i) {
+    Triangle triangle;
+    for (auto *vertex : {&triangle.a, &triangle.b, &triangle.c}) {
+      for (Eigen::Index axis = 0; axis < 3; ++axis) {
+        vertex->pos[axis] = 10.0 * distribution(generator);
+        vertex->normal[axis] = distribution(generator);
+      }
+      vertex->normal.normalize();
+      vertex->texture.x() = 2.0 * distribution(generator);
+      vertex->texture.y() = distribution(generator);
+    }
+    mesh.triangles.push_back(triangle);
+  }
+  return mesh;
+}
+
+} // namespace
+
+TEST(QuantizedMeshTests, TestPositionError) {
+  const auto mesh = makeRandomMesh(1000U);
+  for (const unsigned int bits : {8U, 16U, 21U}) {
+    const auto quantized = QuantizedMesh::encode(mesh, bits);
+    ASSERT_EQ(quantized.size(), mesh.triangles.size());
+    // A grid of 2^bits points over the 20 units wide box.
+    const double max_error = std::sqrt(3.0) * 10.0 / ((1U << bits) - 1U);
+    EXPECT_NEAR(quantized.getMaxPositionError(), max_error, max_error * 0.1);
+
+    for (std::size_t i = 0U; i < mesh.triangles.size(); ++i) {
+      const auto triangle = quantized.getTriangle(i);
+      EXPECT_LE((triangle.a.pos - mesh.triangles[i].a.pos).norm(),
+                quantized.getMaxPositionError());
+      EXPECT_LE((triangle.c.pos - mesh.triangles[i].c.pos).norm(),
+                quantized.getMaxPositionError());
+      EXPECT_EQ(triangle.b.pos.w(), 1.0);
+    }
+  }
+}
+
+TEST(QuantizedMeshTests, TestNormalsAndTextures) {
+  auto mesh = makeRandomMesh(1000U);
+  mesh.triangles[0U].b.normal.setZero();
+  const auto quantized = QuantizedMesh::encode(mesh);
+
+  for (std::size_t i = 0U; i < mesh.triangles.size(); ++i) {
+    const auto triangle = quantized.getTriangle(i);
+    const auto &source = mesh.triangles[i];
+    if (i == 0U) {
+      EXPECT_TRUE(triangle.b.normal.isZero(0.0));
+    } else {
+      const double angle = std::acos(
+          std::clamp(triangle.b.normal.dot(source.b.normal), -1.0, 1.0));
+      EXPECT_LE(angle, QuantizedMesh::c_max_normal_error);
+    }
+    EXPECT_LE((triangle.c.texture - source.c.texture).cwiseAbs().maxCoeff(),
+              quantized.getMaxTextureError());
+  }
+}
+
+TEST(QuantizedMeshTests, TestMemoryUsage) {
+  const auto cube = TestMeshes::makeCube(1.0, 10);
+  const std::size_t vertex_count = 3U * cube.triangles.size();
+
+  // The cube has neither normals nor texture coordinates.
+  EXPECT_EQ(QuantizedMesh::encode(cube, 16U).getMemoryUsage(),
+            6U * vertex_count);
+  EXPECT_EQ(QuantizedMesh::encode(cube, 21U).getMemoryUsage(),
+            8U * vertex_count);
+  EXPECT_EQ(QuantizedMesh::encode(makeRandomMesh(10U)).getMemoryUsage(),
+            30U * 14U);
+}
+
+TEST(QuantizedMeshTests, TestAreaAndVolume) {
+  auto cube = TestMeshes::makeCube(1.5, 8);
+  cube.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{1.0, 2.0, 3.0}),
+      Utility::getRotationMatrix(Eigen::Vector3d{0.0, 0.0, 1.0}, 0.3),
+      Eigen::Matrix4d::Identity());
+  const auto quantized = QuantizedMesh::encode(cube, 21U);
+
+  EXPECT_NEAR(quantized.calculateSurfaceArea(), 6.0 * 9.0, 1e-4);
+  EXPECT_NEAR(quantized.calculateVolume(), 27.0, 1e-4);
+
+  // The pending transformation is applied before quantizing.
+  const auto decoded = quantized.toMeshData();
+  const Eigen::Vector4d expected =
+      cube.getPendingTransform().transformPoint(cube.triangles[5U].b.pos);
+  EXPECT_LE((decoded.triangles[5U].b.pos - expected).norm(),
+            quantized.getMaxPositionError());
+}
+
+TEST(QuantizedMeshTests, TestLoadPacket) {
+  const auto mesh = makeRandomMesh(11U);
+  const auto quantized = QuantizedMesh::encode(mesh);
+
+  TrianglePacket packet;
+  quantized.loadPacket(packet, 8U, 11U);
+  EXPECT_EQ(packet.count, 3U);
+  for (std::size_t lane = 0U; lane < TrianglePacket::c_width; ++lane) {
+    const auto triangle =
+        quantized.getTriangle(std::min<std::size_t>(8U + lane, 10U));
+    for (Eigen::Index axis = 0; axis < 3; ++axis) {
+      EXPECT_NEAR(packet.b[axis][lane],
+                  lane < packet.count ? triangle.b.pos[axis] : 0.0, EPSILON);
+    }
+  }
+}
+
+TEST(QuantizedMeshTests, TestEncodeStreamed) {
+  auto mesh = makeRandomMesh(1000U);
+  mesh.triangles[3U].a.normal.setZero();
+  std::size_t pass_count = 0U;
+  const auto source = [&mesh, &pass_count](
+                          const QuantizedMesh::TriangleCallback &callback) {
+    ++pass_count;
+    for (const auto &triangle : mesh.triangles) {
+      callback(triangle);
+    }
+  };
+
+  for (const unsigned int bits : {16U, 21U}) {
+    pass_count = 0U;
+    const auto streamed = QuantizedMesh::encodeStreamed(source, bits);
+    const auto encoded = QuantizedMesh::encode(mesh, bits);
+    EXPECT_EQ(pass_count, 2U);
+    ASSERT_EQ(streamed.size(), encoded.size());
+    EXPECT_EQ(streamed.getMemoryUsage(), encoded.getMemoryUsage());
+    EXPECT_EQ(streamed.getMaxPositionError(), encoded.getMaxPositionError());
+    for (std::size_t i = 0U; i < mesh.triangles.size(); ++i) {
+      const auto expected = encoded.getTriangle(i);
+      const auto triangle = streamed.getTriangle(i);
+      EXPECT_EQ(triangle.a.pos, expected.a.pos);
+      EXPECT_EQ(triangle.a.normal, expected.a.normal);
+      EXPECT_EQ(triangle.c.texture, expected.c.texture);
+    }
+  }
+
+  const auto empty = QuantizedMesh::encodeStreamed(
+      [](const QuantizedMesh::TriangleCallback &) {});
+  EXPECT_EQ(empty.size(), 0U);
+  EXPECT_EQ(empty.getMemoryUsage(), 0U);
+}
+
+TEST(QuantizedMeshTests, TestEmptyMesh) {
+  const auto quantized = QuantizedMesh::encode(MeshData{});
+  EXPECT_EQ(quantized.size(), 0U);
+  EXPECT_EQ(quantized.getMemoryUsage(), 0U);
+  EXPECT_EQ(quantized.calculateVolume(), 0.0);
+}
@@ -0,0 +1,144 @@
+#include <Eigen/Dense>
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "geometry/meshdata.hpp"
+#include "geometry/ray_caster.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+namespace {
+
+static constexpr double EPSILON = 0.0000001;
+
+// Tests every Triangle, used as the reference of the hierarchy.
+std::optional<double> bruteForceClosestT(const MeshData &mesh,
+                                         const Eigen::Vector4d &origin,
+                                         const Eigen::Vector4d &direction) {
+  const TrianglePacket::Ray ray(origin, direction);
+  std::optional<double> closest;
+  for (const auto &packet : mesh.getPackets()) {
+    const auto intersections = packet.intersect(ray);
+    for (std::size_t lane = 0U; lane < packet.count; ++lane) {
+      if (intersections.inclusive_hit[lane] &&
+          (!closest || intersections.t[lane] < *closest)) {
+        closest = intersections.t[lane];
+      }
+    }
+  }
+  return closest;
+}
+
+} // namespace
+
+TEST(RayCasterTests, TestCastRay) {
+  const auto cube = TestMeshes::makeCube(1.0, 4);
+  const RayCaster caster(cube.triangles);
+
+  const Eigen::Vector4d origin{0.3, -0.2, -5.0, 1.0};
+  const Eigen::Vector4d direction{0.0, 0.0, 2.0, 0.0};
+  const auto hit = caster.castRay(origin, direction);
+  ASSERT_TRUE(hit);
+  EXPECT_NEAR(hit->t, 2.0, EPSILON);
+
+  // The hit is on the -z face, and the barycentric coordinates give back the
+  // intersection point.
+  const auto &triangle = cube.triangles[hit->triangle_index];
+  EXPECT_NEAR(triangle.a.pos.z(), -1.0, EPSILON);
+  const Eigen::Vector4d point = (1.0 - hit->u - hit->v) * triangle.a.pos +
+                                hit->u * triangle.b.pos +
+                                hit->v * triangle.c.pos;
+  EXPECT_TRUE(point.isApprox(origin + hit->t * direction));
+
+  EXPECT_FALSE(caster.castRay(origin, -direction));
+  EXPECT_FALSE(caster.castRay(origin, direction, 1.5));
+  EXPECT_FALSE(caster.castRay({3.0, 0.0, -5.0, 1.0}, direction));
+}
+
+TEST(RayCasterTests, TestIsOccluded) {
+  const auto cube = TestMeshes::makeCube(1.0, 2);
+  const RayCaster caster(cube.triangles);
+
+  const Eigen::Vector4d origin{0.0, -4.0, 0.0, 1.0};
+  const Eigen::Vector4d direction{0.0, 1.0, 0.0, 0.0};
+  EXPECT_TRUE(caster.isOccluded(origin, direction));
+  EXPECT_TRUE(caster.isOccluded(origin, direction, 3.0));
+  EXPECT_FALSE(caster.isOccluded(origin, direction, 2.5));
+  EXPECT_FALSE(caster.isOccluded(origin, {1.0, 0.0, 0.0, 0.0}));
+  // Starting inside, the ray always hits a face.
+  EXPECT_TRUE(caster.isOccluded({0.0, 0.0, 0.0, 1.0}, {1.0, 2.0, 3.0, 0.0}));
+}
+
+TEST(RayCasterTests, TestMatchesBruteForce) {
+  const auto cube = TestMeshes::makeCube(2.0, 10);
+  const RayCaster caster(cube.triangles);
+
+  std::mt19937 generator(7U);
+  std::uniform_real_distribution<double> distribution(-4.0, 4.0);
+  std::vector<Eigen::Vector4d> origins;
+  std::vector<Eigen::Vector4d> directions;
+  for (int i = 0; i < 500; ++i) {
+    origins.push_back({distribution(generator), distribution(generator),
+                       distribution(generator), 1.0});
+    directions.push_back({distribution(generator), distribution(generator),
+                          distribution(generator), 0.0});
+  }
+  // Rays along the shared edges and through the shared vertices.
+  origins.push_back({0.4, 0.4, -5.0, 1.0});
+  directions.push_back({0.0, 0.0, 1.0, 0.0});
+  origins.push_back({-5.0, 2.0, 2.0, 1.0});
+  directions.push_back({1.0, 0.0, 0.0, 0.0});
+
+  Parallel::setThreadCount(4U);
+  const auto hits = caster.castRays(origins, directions);
+  Parallel::setThreadCount(0U);
+  ASSERT_EQ(hits.size(), origins.size());
+
+  for (std::size_t i = 0U; i < origins.size(); ++i) {
+    const auto expected = bruteForceClosestT(cube, origins[i], directions[i]);
+    ASSERT_EQ(hits[i].has_value(), expected.has_value());
+    if (expected) {
+      EXPECT_DOUBLE_EQ(hits[i]->t, *expected);
+    }
+    EXPECT_EQ(caster.isOccluded(origins[i], directions[i]),
+              expected.has_value());
+  }
+}
+
+TEST(RayCasterTests, TestPendingTransform) {
+  auto eager = TestMeshes::makeCube(1.0, 3);
+  auto deferred = eager;
+  const auto translation =
+      Utility::getTranslationMatrix(Eigen::Vector3d{1.0, 2.0, 3.0});
+  const auto rotation = Utility::getRotationMatrix(
+      Eigen::Vector3d{0.0, 1.0, 1.0}, 0.4);
+  const auto scale = Utility::getScaleMatrix(Eigen::Vector3d{2.0, 1.0, 0.5});
+  eager.transform(translation, rotation, scale);
+  deferred.deferTransform(translation, rotation, scale);
+
+  const Eigen::Vector4d origin{1.0, 2.0, -10.0, 1.0};
+  const Eigen::Vector4d direction{0.0, 0.01, 1.0, 0.0};
+  const auto eager_hit = eager.castRay(origin, direction);
+  const auto deferred_hit = deferred.castRay(origin, direction);
+  ASSERT_TRUE(eager_hit);
+  ASSERT_TRUE(deferred_hit);
+  EXPECT_NEAR(eager_hit->t, deferred_hit->t, EPSILON);
+  EXPECT_EQ(eager_hit->triangle_index, deferred_hit->triangle_index);
+  EXPECT_TRUE(deferred.isOccluded(origin, direction));
+
+  const auto hits = deferred.castRays({origin}, {direction});
+  ASSERT_TRUE(hits[0U]);
+  EXPECT_NEAR(hits[0U]->t, eager_hit->t, EPSILON);
+}
+
+TEST(RayCasterTests, TestEmptyMesh) {
+  const RayCaster caster(std::vector<Triangle>{});
+  EXPECT_FALSE(caster.castRay({0.0, 0.0, 0.0, 1.0}, {1.0, 0.0, 0.0, 0.0}));
+  EXPECT_FALSE(caster.isOccluded({0.0, 0.0, 0.0, 1.0}, {1.0, 0.0, 0.0, 0.0}));
+}
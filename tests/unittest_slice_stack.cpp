@@ -0,0 +1,150 @@
+#include <Eigen/Dense>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "geometry/meshdata.hpp"
+#include "geometry/slice_stack.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+class SliceStackTests : public ::testing::Test {
+protected:
+  void TearDown() { Parallel::setThreadCount(0U); }
+};
+
+namespace {
+
+static constexpr double EPSILON = 0.0000001;
+
+// Returns the signed area of a closed contour, positive if it runs
+// counter-clockwise.
+double getSignedArea(const SliceStack::Contour &contour) {
+  double area = 0.0;
+  const auto &points = contour.points;
+  for (std::size_t i = 0U; i < points.size(); ++i) {
+    const auto &next = points[(i + 1U) % points.size()];
+    area += points[i].x() * next.y() - next.x() * points[i].y();
+  }
+  return area / 2.0;
+}
+
+} // namespace
+
+TEST_F(SliceStackTests, TestCube) {
+  const auto stack = SliceStack::slice(TestMeshes::makeCube(1.0, 3), 0.2);
+  const auto &layers = stack.getLayers();
+  ASSERT_EQ(layers.size(), 10U);
+  for (std::size_t i = 0U; i < layers.size(); ++i) {
+    EXPECT_NEAR(layers[i].height, -0.9 + 0.2 * static_cast<double>(i),
+                EPSILON);
+    ASSERT_EQ(layers[i].contours.size(), 1U);
+    const auto &contour = layers[i].contours[0U];
+    EXPECT_TRUE(contour.is_closed);
+    EXPECT_EQ(contour.points.size(), 24U);
+    EXPECT_NEAR(getSignedArea(contour), 4.0, EPSILON);
+  }
+  EXPECT_EQ(stack.countOpenContours(), 0U);
+
+  EXPECT_TRUE(SliceStack::slice(MeshData{}).getLayers().empty());
+}
+
+TEST_F(SliceStackTests, TestVerticesOnPlanes) {
+  // The planes pass exactly through rows of vertices and the edges between
+  // them, the contours still have to close.
+  const auto stack = SliceStack::slice(TestMeshes::makeCube(1.0, 16), 0.25);
+  const auto &layers = stack.getLayers();
+  ASSERT_EQ(layers.size(), 8U);
+  for (const auto &layer : layers) {
+    ASSERT_EQ(layer.contours.size(), 1U);
+    EXPECT_TRUE(layer.contours[0U].is_closed);
+    EXPECT_NEAR(getSignedArea(layer.contours[0U]), 4.0, EPSILON);
+  }
+}
+
+TEST_F(SliceStackTests, TestHolesAndOpenContours) {
+  // A small cube inside of a large one with inverted Triangles is a hollow
+  // solid, its cuts have a clockwise inner contour.
+  auto mesh = TestMeshes::makeCube(1.0, 2);
+  auto inner = TestMeshes::makeCube(0.5, 2);
+  for (auto triangle : inner.triangles) {
+    std::swap(triangle.b, triangle.c);
+    mesh.triangles.push_back(triangle);
+  }
+  const auto stack = SliceStack::slice(mesh, 0.5);
+  const auto &layers = stack.getLayers();
+  ASSERT_EQ(layers.size(), 4U);
+  EXPECT_EQ(layers[0U].contours.size(), 1U);
+  ASSERT_EQ(layers[1U].contours.size(), 2U);
+  EXPECT_NEAR(getSignedArea(layers[1U].contours[0U]) +
+                  getSignedArea(layers[1U].contours[1U]),
+              3.0, EPSILON);
+
+  // Without a side face every layer has one open contour.
+  auto open_cube = TestMeshes::makeCube(1.0, 1);
+  open_cube.triangles.erase(open_cube.triangles.begin(),
+                            open_cube.triangles.begin() + 2);
+  const auto open_stack = SliceStack::slice(open_cube, 0.5);
+  ASSERT_EQ(open_stack.getLayers().size(), 4U);
+  EXPECT_EQ(open_stack.countOpenContours(), 4U);
+  for (const auto &layer : open_stack.getLayers()) {
+    ASSERT_EQ(layer.contours.size(), 1U);
+    EXPECT_EQ(layer.contours[0U].points.size(), 7U);
+  }
+}
+
+TEST_F(SliceStackTests, TestPendingTransform) {
+  auto cube = TestMeshes::makeCube(0.5, 1);
+  cube.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{0.0, 0.0, 5.0}),
+      Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity());
+  const auto stack = SliceStack::slice(cube, 0.25);
+  ASSERT_EQ(stack.getLayers().size(), 4U);
+  EXPECT_NEAR(stack.getLayers()[0U].height, 4.625, EPSILON);
+  EXPECT_NEAR(stack.getBoundingBox().max().z(), 5.5, EPSILON);
+}
+
+TEST_F(SliceStackTests, TestWriteSvg) {
+  const auto stack = SliceStack::slice(TestMeshes::makeCube(1.0, 1), 1.0);
+  ASSERT_EQ(stack.getLayers().size(), 2U);
+  std::ostringstream out;
+  stack.writeSvg(out, 0U);
+  const std::string svg = out.str();
+  EXPECT_NE(svg.find("<svg xmlns=\"http://www.w3.org/2000/svg\" "
+                     "viewBox=\"-1 -1 2 2\""),
+            std::string::npos);
+  EXPECT_NE(svg.find("<desc>Layer 0 at z = -0.5</desc>"), std::string::npos);
+  EXPECT_NE(svg.find("d=\"M"), std::string::npos);
+  EXPECT_NE(svg.find("Z \"/>"), std::string::npos);
+  EXPECT_NE(svg.find("</svg>"), std::string::npos);
+}
+
+TEST_F(SliceStackTests, TestThreadCountIndependence) {
+  auto cube = TestMeshes::makeCube(1.0, 16);
+  cube.deferTransform(Eigen::Matrix4d::Identity(),
+                      Utility::getRotationMatrix(
+                          Eigen::Vector3d{1.0, 1.0, 0.0}, 0.4),
+                      Eigen::Matrix4d::Identity());
+
+  Parallel::setThreadCount(1U);
+  const auto serial = SliceStack::slice(cube, 0.05);
+  Parallel::setThreadCount(4U);
+  const auto parallel = SliceStack::slice(cube, 0.05);
+
+  ASSERT_EQ(serial.getLayers().size(), parallel.getLayers().size());
+  for (std::size_t i = 0U; i < serial.getLayers().size(); ++i) {
+    const auto &contours = serial.getLayers()[i].contours;
+    const auto &parallel_contours = parallel.getLayers()[i].contours;
+    ASSERT_EQ(contours.size(), parallel_contours.size());
+    for (std::size_t j = 0U; j < contours.size(); ++j) {
+      EXPECT_EQ(contours[j].points, parallel_contours[j].points);
+    }
+  }
+  EXPECT_EQ(serial.countOpenContours(), 0U);
+}
@@ -2,6 +2,8 @@
 #include <sstream>
 
 #include "geometry/meshdata.hpp"
+#include "geometry/quantized_mesh.hpp"
+#include "utility.hpp"
 #include "writer/stl_writer.hpp"
 #include "gtest/gtest.h"
 
@@ -75,4 +77,62 @@ TEST_F(StlWriterTests, TestWriteTriangles) {
 
   // read number of attributes
   EXPECT_EQ(*((std::uint16_t *)(current_data + 12)), 0U);
-}
\ No newline at end of file
+}
+
+TEST_F(StlWriterTests, TestWriteTrianglesWithPendingTransform) {
+  Eigen::Vector4d a{0.0, 0.0, 0.0, 1.0};
+  Eigen::Vector4d b{1.0, 0.0, 0.0, 1.0};
+  Eigen::Vector4d c{0.0, 1.0, 0.0, 1.0};
+
+  MeshData mesh;
+  mesh.triangles.push_back({a, b, c});
+  mesh.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{1.0, 2.0, 3.0}),
+      Utility::getRotationMatrix(Eigen::Vector3d{1.0, 0.0, 0.0}, 3.14159265),
+      Utility::getScaleMatrix(Eigen::Vector3d{2.0, 2.0, 2.0}));
+
+  std::ostringstream oss;
+  writeTriangles(oss, mesh);
+  ASSERT_EQ(oss.str().size(), 50U);
+
+  const std::string current_data_str = oss.str();
+  const float *const current_data = (float *)current_data_str.c_str();
+
+  // Rotating around the x axis by pi flips the normal
+  EXPECT_NEAR(current_data[0], 0.0f, 1e-5f);
+  EXPECT_NEAR(current_data[1], 0.0f, 1e-5f);
+  EXPECT_NEAR(current_data[2], -1.0f, 1e-5f);
+
+  EXPECT_NEAR(current_data[3], 1.0f, 1e-5f);
+  EXPECT_NEAR(current_data[4], 2.0f, 1e-5f);
+  EXPECT_NEAR(current_data[5], 3.0f, 1e-5f);
+
+  EXPECT_NEAR(current_data[6], 3.0f, 1e-5f);
+  EXPECT_NEAR(current_data[7], 2.0f, 1e-5f);
+  EXPECT_NEAR(current_data[8], 3.0f, 1e-5f);
+
+  EXPECT_NEAR(current_data[9], 1.0f, 1e-5f);
+  EXPECT_NEAR(current_data[10], 0.0f, 1e-5f);
+  EXPECT_NEAR(current_data[11], 3.0f, 1e-5f);
+
+  // The mesh itself is left untouched
+  EXPECT_TRUE(mesh.triangles[0U].b.pos == b);
+}
+
+TEST_F(StlWriterTests, TestWriteQuantizedMesh) {
+  MeshData mesh;
+  mesh.triangles.push_back({Eigen::Vector4d{0.0, 0.0, 0.0, 1.0},
+                            Eigen::Vector4d{4.0, 0.0, 0.0, 1.0},
+                            Eigen::Vector4d{0.0, 2.0, 1.0, 1.0}});
+  mesh.triangles.push_back({Eigen::Vector4d{4.0, 0.0, 0.0, 1.0},
+                            Eigen::Vector4d{4.0, 2.0, 1.0, 1.0},
+                            Eigen::Vector4d{0.0, 2.0, 1.0, 1.0}});
+  const auto quantized = QuantizedMesh::encode(mesh);
+
+  // The corners of the bounding box are decoded exactly.
+  std::ostringstream quantized_stream;
+  write(quantized_stream, quantized);
+  std::ostringstream stream;
+  write(stream, mesh);
+  EXPECT_EQ(quantized_stream.str(), stream.str());
+}
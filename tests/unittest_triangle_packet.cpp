@@ -0,0 +1,154 @@
+#include <Eigen/Dense>
+#include <vector>
+
+#include "geometry/triangle.hpp"
+#include "geometry/triangle_packet.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+TEST(TrianglePacketTests, TestLoad) {
+  std::vector<Triangle> triangles;
+  for (double i = 0.0; i < 10.0; ++i) {
+    triangles.push_back({Eigen::Vector4d{i, 0.0, 0.0, 1.0},
+                         Eigen::Vector4d{0.0, i, 0.0, 1.0},
+                         Eigen::Vector4d{0.0, 0.0, i, 1.0}});
+  }
+
+  TrianglePacket packet;
+  packet.load(triangles, 0U, triangles.size());
+  EXPECT_EQ(packet.count, TrianglePacket::c_width);
+  EXPECT_DOUBLE_EQ(packet.a[0U][3U], 3.0);
+  EXPECT_DOUBLE_EQ(packet.b[1U][5U], 5.0);
+  EXPECT_DOUBLE_EQ(packet.c[2U][7U], 7.0);
+
+  packet.load(triangles, 8U, triangles.size());
+  EXPECT_EQ(packet.count, 2U);
+  EXPECT_DOUBLE_EQ(packet.a[0U][1U], 9.0);
+  EXPECT_DOUBLE_EQ(packet.a[0U][2U], 0.0);
+}
+
+TEST(TrianglePacketTests, TestAreasAndVolumes) {
+  std::vector<Triangle> triangles;
+  triangles.push_back({Eigen::Vector4d{1.0, 0.0, 0.0, 1.0},
+                       Eigen::Vector4d{0.0, 1.0, 0.0, 1.0},
+                       Eigen::Vector4d{0.0, 0.0, 1.0, 1.0}});
+  triangles.push_back({Eigen::Vector4d{3.923, 9.123, 4.41231, 1.0},
+                       Eigen::Vector4d{5.231, 4.16923, 8.739, 1.0},
+                       Eigen::Vector4d{11.684, 2.985, 1.194, 1.0}});
+
+  TrianglePacket packet;
+  packet.load(triangles, 0U, triangles.size());
+  const auto areas = packet.getAreas();
+  const auto volumes = packet.getSignedVolumes();
+
+  for (std::size_t i = 0U; i < triangles.size(); ++i) {
+    const auto &t = triangles[i];
+    EXPECT_DOUBLE_EQ(areas[i], t.getArea());
+    EXPECT_DOUBLE_EQ(volumes[i], t.a.pos.cross3(t.b.pos).dot(t.c.pos) / 6.0);
+  }
+  EXPECT_DOUBLE_EQ(areas[2U], 0.0);
+  EXPECT_DOUBLE_EQ(volumes[2U], 0.0);
+}
+
+TEST(TrianglePacketTests, TestIntersect) {
+  std::vector<Triangle> triangles;
+  triangles.push_back({Eigen::Vector4d{0.0, 0.0, 0.0, 1.0},
+                       Eigen::Vector4d{1.0, 0.0, 0.0, 1.0},
+                       Eigen::Vector4d{0.0, 1.0, 0.0, 1.0}});
+  triangles.push_back({Eigen::Vector4d{0.0, 0.0, 0.0, 1.0},
+                       Eigen::Vector4d{0.0, 1.0, 0.0, 1.0},
+                       Eigen::Vector4d{0.0, 1.0, 1.0, 1.0}});
+
+  TrianglePacket packet;
+  packet.load(triangles, 0U, triangles.size());
+
+  const auto hit = packet.intersect({{0.25, 0.5, 2.0, 1.0},
+                                     {0.0, 0.0, -2.0, 0.0}});
+  EXPECT_TRUE(hit.hit[0U]);
+  EXPECT_DOUBLE_EQ(hit.t[0U], 1.0);
+  EXPECT_DOUBLE_EQ(hit.u[0U], 0.25);
+  EXPECT_DOUBLE_EQ(hit.v[0U], 0.5);
+  EXPECT_FALSE(hit.contains_origin[0U]);
+  // The second Triangle is parallel to the ray, the unused lanes are not.
+  EXPECT_TRUE(hit.is_parallel[1U]);
+  EXPECT_FALSE(hit.hit[1U]);
+  EXPECT_FALSE(hit.is_parallel[2U]);
+  EXPECT_EQ(hit.hit.count(), 1);
+
+  const auto behind = packet.intersect({{0.25, 0.5, -2.0, 1.0},
+                                        {0.0, 0.0, -1.0, 0.0}});
+  EXPECT_FALSE(behind.hit.any());
+
+  const auto miss = packet.intersect({{0.75, 0.5, 2.0, 1.0},
+                                      {0.0, 0.0, -1.0, 0.0}});
+  EXPECT_FALSE(miss.hit.any());
+
+  const auto on_surface = packet.intersect({{0.25, 0.5, 0.0, 1.0},
+                                            {0.0, 0.0, 1.0, 0.0}});
+  EXPECT_TRUE(on_surface.contains_origin[0U]);
+  EXPECT_TRUE(on_surface.hit[0U]);
+}
+
+TEST(TrianglePacketTests, TestIntersectSharedEdgesOnce) {
+  // A fan of Triangles around the center of a square, every ray through the
+  // square has to produce exactly one hit, even on the shared edges and the
+  // shared vertex.
+  const Eigen::Vector4d center{0.0, 0.0, 0.0, 1.0};
+  const std::vector<Eigen::Vector4d> corners{{-1.0, -1.0, 0.0, 1.0},
+                                             {1.0, -1.0, 0.0, 1.0},
+                                             {1.0, 1.0, 0.0, 1.0},
+                                             {-1.0, 1.0, 0.0, 1.0}};
+  std::vector<Triangle> triangles;
+  for (std::size_t i = 0U; i < corners.size(); ++i) {
+    triangles.push_back({center, corners[i], corners[(i + 1U) % 4U]});
+  }
+  TrianglePacket packet;
+  packet.load(triangles, 0U, triangles.size());
+
+  for (const double x : {0.0, 0.5, -0.5, 0.25}) {
+    for (const double y : {0.0, 0.5, -0.5, 0.25}) {
+      for (const double direction : {1.0, -1.0}) {
+        const auto intersections = packet.intersect(
+            {{x, y, -direction, 1.0}, {0.0, 0.0, direction, 0.0}});
+        EXPECT_EQ(intersections.hit.count(), 1);
+      }
+    }
+  }
+}
+
+TEST(TrianglePacketTests, TestFindClosestPoints) {
+  std::vector<Triangle> triangles;
+  for (int i = 0; i < 3; ++i) {
+    triangles.push_back({Eigen::Vector4d{0.0, 0.0, 0.0, 1.0},
+                         Eigen::Vector4d{2.0, 0.0, 0.0, 1.0},
+                         Eigen::Vector4d{0.0, 2.0, 0.0, 1.0}});
+  }
+  // A degenerate Triangle, handled as a segment.
+  triangles.push_back({Eigen::Vector4d{0.0, 0.0, 0.0, 1.0},
+                       Eigen::Vector4d{2.0, 0.0, 0.0, 1.0},
+                       Eigen::Vector4d{2.0, 0.0, 0.0, 1.0}});
+
+  TrianglePacket packet;
+  packet.load(triangles, 0U, triangles.size());
+
+  // Above the inside of the Triangles.
+  auto points = packet.findClosestPoints({0.5, 0.5, 3.0});
+  EXPECT_DOUBLE_EQ(points.distance_squared[0U], 9.0);
+  EXPECT_DOUBLE_EQ(points.u[0U], 0.25);
+  EXPECT_DOUBLE_EQ(points.v[0U], 0.25);
+  EXPECT_DOUBLE_EQ(points.distance_squared[3U], 9.25);
+
+  // Outside of the hypotenuse, the closest point is on the edge bc.
+  points = packet.findClosestPoints({2.0, 2.0, 0.0});
+  EXPECT_DOUBLE_EQ(points.distance_squared[1U], 2.0);
+  EXPECT_DOUBLE_EQ(points.u[1U], 0.5);
+  EXPECT_DOUBLE_EQ(points.v[1U], 0.5);
+
+  // Behind the first vertex.
+  points = packet.findClosestPoints({-1.0, -2.0, 0.0});
+  EXPECT_DOUBLE_EQ(points.distance_squared[2U], 5.0);
+  EXPECT_DOUBLE_EQ(points.u[2U], 0.0);
+  EXPECT_DOUBLE_EQ(points.v[2U], 0.0);
+  EXPECT_DOUBLE_EQ(points.distance_squared[3U], 5.0);
+}
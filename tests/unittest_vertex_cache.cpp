@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "geometry/indexed_mesh.hpp"
+#include "geometry/meshdata.hpp"
+#include "geometry/vertex_cache.hpp"
+#include "test_meshes.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+namespace {
+
+static constexpr double EPSILON = 0.0000001;
+
+// Rotates a face so its smallest index is first, keeping its orientation.
+IndexedMesh::Face normalizeFace(const IndexedMesh::Face &face) {
+  auto normalized = face;
+  std::rotate(normalized.begin(),
+              std::min_element(normalized.begin(), normalized.end()),
+              normalized.end());
+  return normalized;
+}
+
+// Returns the faces by their vertex positions, so meshes with different
+// vertex orders can be compared.
+std::vector<std::array<std::array<double, 3U>, 3U>>
+getFacePositions(const IndexedMesh &mesh) {
+  std::vector<std::array<std::array<double, 3U>, 3U>> faces;
+  for (const auto &face : mesh.faces) {
+    std::array<std::array<double, 3U>, 3U> positions;
+    for (std::size_t i = 0U; i < 3U; ++i) {
+      const auto &vertex = mesh.vertices[face[i]];
+      positions[i] = {vertex.x(), vertex.y(), vertex.z()};
+    }
+    std::rotate(positions.begin(),
+                std::min_element(positions.begin(), positions.end()),
+                positions.end());
+    faces.push_back(positions);
+  }
+  std::sort(faces.begin(), faces.end());
+  return faces;
+}
+
+} // namespace
+
+TEST(VertexCacheTests, TestAcmr) {
+  IndexedMesh mesh;
+  mesh.vertices.resize(5U);
+  mesh.faces = {{0U, 1U, 2U}};
+  EXPECT_NEAR(VertexCache::calculateAcmr(mesh), 3.0, EPSILON);
+
+  mesh.faces.push_back({2U, 1U, 3U});
+  EXPECT_NEAR(VertexCache::calculateAcmr(mesh), 2.0, EPSILON);
+
+  // With a cache of three vertices, vertex 0 is evicted by vertex 3.
+  mesh.faces.push_back({0U, 3U, 4U});
+  EXPECT_NEAR(VertexCache::calculateAcmr(mesh, 3U), 6.0 / 3.0, EPSILON);
+  EXPECT_NEAR(VertexCache::calculateAcmr(mesh, 4U), 5.0 / 3.0, EPSILON);
+
+  EXPECT_NEAR(VertexCache::calculateAcmr(IndexedMesh{}), 0.0, EPSILON);
+}
+
+TEST(VertexCacheTests, TestOptimize) {
+  auto mesh = IndexedMesh::weld(TestMeshes::makeCube(1.0, 32), 0.0);
+  std::mt19937 generator(5U);
+  std::shuffle(mesh.faces.begin(), mesh.faces.end(), generator);
+
+  const auto optimized = VertexCache::optimize(mesh);
+  ASSERT_EQ(optimized.faces.size(), mesh.faces.size());
+  ASSERT_EQ(optimized.vertices.size(), mesh.vertices.size());
+  EXPECT_EQ(getFacePositions(optimized), getFacePositions(mesh));
+
+  const double acmr = VertexCache::calculateAcmr(mesh);
+  const double optimized_acmr = VertexCache::calculateAcmr(optimized);
+  EXPECT_GT(acmr, 2.0);
+  EXPECT_LT(optimized_acmr, 0.8);
+
+  // The vertices are numbered in the order of their first use.
+  std::uint32_t next_vertex = 0U;
+  for (const auto &face : optimized.faces) {
+    for (const auto vertex : face) {
+      EXPECT_LE(vertex, next_vertex);
+      next_vertex = std::max(next_vertex, vertex + 1U);
+    }
+  }
+}
+
+TEST(VertexCacheTests, TestOptimizeKeepsUnusedVertices) {
+  IndexedMesh mesh;
+  mesh.vertices = {{0.0, 0.0, 0.0, 1.0},
+                   {9.0, 9.0, 9.0, 1.0},
+                   {1.0, 0.0, 0.0, 1.0},
+                   {0.0, 1.0, 0.0, 1.0}};
+  mesh.faces = {{3U, 0U, 2U}};
+
+  const auto optimized = VertexCache::optimize(mesh);
+  ASSERT_EQ(optimized.vertices.size(), 4U);
+  EXPECT_EQ(normalizeFace(optimized.faces[0U]),
+            (IndexedMesh::Face{0U, 1U, 2U}));
+  EXPECT_TRUE(optimized.vertices[0U] == mesh.vertices[3U]);
+  EXPECT_TRUE(optimized.vertices[3U] == mesh.vertices[1U]);
+}
@@ -0,0 +1,154 @@
+#include <Eigen/Dense>
+#include <cstddef>
+#include <vector>
+
+#include "geometry/indexed_mesh.hpp"
+#include "geometry/meshdata.hpp"
+#include "geometry/vertex_normals.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+class VertexNormalsTests : public ::testing::Test {
+protected:
+  void TearDown() { Parallel::setThreadCount(0U); }
+};
+
+namespace {
+
+static constexpr double EPSILON = 0.0000001;
+
+} // namespace
+
+TEST_F(VertexNormalsTests, TestSmoothCube) {
+  const auto mesh = IndexedMesh::weld(TestMeshes::makeCube(1.0, 2), 0.0);
+  const auto normals =
+      VertexNormals::calculate(mesh, VertexNormals::Weighting::ANGLE);
+  ASSERT_EQ(normals.getCornerNormals().size(), 3U * mesh.faces.size());
+  EXPECT_EQ(normals.getSplitVertexCount(), mesh.vertices.size());
+
+  // The angles of every side of the cube around a vertex add up to the same
+  // value, no matter how the side is split into Triangles, so the normals
+  // point away from the center.
+  for (std::size_t i = 0U; i < mesh.faces.size(); ++i) {
+    for (std::size_t k = 0U; k < 3U; ++k) {
+      const Eigen::Vector3d position =
+          mesh.vertices[mesh.faces[i][k]].head<3>();
+      const auto &normal = normals.getCornerNormals()[3U * i + k];
+      EXPECT_NEAR(normal.norm(), 1.0, EPSILON);
+      EXPECT_TRUE(normal.isApprox(position.normalized(), EPSILON));
+    }
+  }
+}
+
+TEST_F(VertexNormalsTests, TestArea) {
+  // The face normals are weighted by the areas, a larger face pulls the
+  // normal towards itself.
+  IndexedMesh mesh;
+  mesh.vertices = {{0.0, 0.0, 0.0, 1.0},
+                   {1.0, 0.0, 0.0, 1.0},
+                   {0.0, 1.0, 0.0, 1.0},
+                   {0.0, 0.0, 3.0, 1.0}};
+  mesh.faces = {{0U, 2U, 1U}, {0U, 1U, 3U}};
+  const auto normals =
+      VertexNormals::calculate(mesh, VertexNormals::Weighting::AREA);
+  const Eigen::Vector3d expected =
+      (0.5 * Eigen::Vector3d(0.0, 0.0, -1.0) +
+       1.5 * Eigen::Vector3d(0.0, -1.0, 0.0))
+          .normalized();
+  EXPECT_TRUE(normals.getCornerNormals()[0U].isApprox(expected));
+  EXPECT_TRUE(normals.getCornerNormals()[3U].isApprox(expected));
+  EXPECT_TRUE(normals.getCornerNormals()[1U].isApprox(
+      Eigen::Vector3d(0.0, 0.0, -1.0)));
+  EXPECT_TRUE(normals.getCornerNormals()[5U].isApprox(
+      Eigen::Vector3d(0.0, -1.0, 0.0)));
+  EXPECT_EQ(normals.getSplitVertexCount(), 4U);
+}
+
+TEST_F(VertexNormalsTests, TestCrease) {
+  const auto mesh = IndexedMesh::weld(TestMeshes::makeCube(1.0, 2), 0.0);
+  const auto normals = VertexNormals::calculate(
+      mesh, VertexNormals::Weighting::ANGLE, 0.5);
+
+  // Every corner keeps the normal of its side, the corners of the cube are
+  // split in three, the middles of the edges in two.
+  for (std::size_t i = 0U; i < mesh.faces.size(); ++i) {
+    const auto &face = mesh.faces[i];
+    const Eigen::Vector3d a = mesh.vertices[face[0U]].head<3>();
+    const Eigen::Vector3d b = mesh.vertices[face[1U]].head<3>();
+    const Eigen::Vector3d c = mesh.vertices[face[2U]].head<3>();
+    const Eigen::Vector3d face_normal = (b - a).cross(c - a).normalized();
+    for (std::size_t k = 0U; k < 3U; ++k) {
+      EXPECT_TRUE(
+          normals.getCornerNormals()[3U * i + k].isApprox(face_normal));
+    }
+  }
+  EXPECT_EQ(normals.getSplitVertexCount(), 8U * 3U + 12U * 2U + 6U);
+}
+
+TEST_F(VertexNormalsTests, TestDegenerate) {
+  // The sheet folded back onto itself cancels out, and the collapsed face
+  // has no normal of its own.
+  IndexedMesh mesh;
+  mesh.vertices = {{0.0, 0.0, 0.0, 1.0},
+                   {1.0, 0.0, 0.0, 1.0},
+                   {0.0, 1.0, 0.0, 1.0},
+                   {2.0, 0.0, 0.0, 1.0}};
+  mesh.faces = {{0U, 1U, 2U}, {0U, 2U, 1U}, {0U, 1U, 3U}};
+  const auto normals =
+      VertexNormals::calculate(mesh, VertexNormals::Weighting::ANGLE);
+  const auto &corner_normals = normals.getCornerNormals();
+  EXPECT_TRUE(corner_normals[0U].isApprox(Eigen::Vector3d::UnitZ()));
+  EXPECT_TRUE(corner_normals[3U].isApprox(-Eigen::Vector3d::UnitZ()));
+  EXPECT_TRUE(corner_normals[8U].isZero());
+
+  const auto empty = VertexNormals::calculate(IndexedMesh{},
+                                              VertexNormals::Weighting::AREA);
+  EXPECT_TRUE(empty.getCornerNormals().empty());
+  EXPECT_EQ(empty.getSplitVertexCount(), 0U);
+}
+
+TEST_F(VertexNormalsTests, TestApply) {
+  auto cube = TestMeshes::makeCube(1.0, 40);
+  const auto mesh = IndexedMesh::weld(cube, 0.0);
+
+  Parallel::setThreadCount(1U);
+  const auto serial = VertexNormals::calculate(
+      mesh, VertexNormals::Weighting::AREA, 0.5);
+  Parallel::setThreadCount(4U);
+  const auto parallel = VertexNormals::calculate(
+      mesh, VertexNormals::Weighting::AREA, 0.5);
+  EXPECT_EQ(serial.getCornerNormals(), parallel.getCornerNormals());
+  EXPECT_EQ(serial.getSplitVertexCount(), parallel.getSplitVertexCount());
+
+  serial.apply(cube);
+  for (std::size_t i = 0U; i < cube.triangles.size(); ++i) {
+    const auto &triangle = cube.triangles[i];
+    EXPECT_EQ(triangle.a.normal.head<3>(), serial.getCornerNormals()[3U * i]);
+    EXPECT_EQ(triangle.c.normal.head<3>(),
+              serial.getCornerNormals()[3U * i + 2U]);
+    EXPECT_EQ(triangle.b.normal.w(), 0.0);
+  }
+}
+
+TEST_F(VertexNormalsTests, TestPendingTransform) {
+  // The normals of the sheared cube are calculated on the transformed
+  // positions and restored by applying the transformation.
+  auto cube = TestMeshes::makeCube(1.0, 2);
+  cube.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{1.0, 2.0, 3.0}),
+      Utility::getRotationMatrix(Eigen::Vector3d{1.0, 1.0, 0.0}, 0.4),
+      Utility::getScaleMatrix(Eigen::Vector3d{1.0, -2.0, 3.0}));
+  const auto mesh = IndexedMesh::weld(cube, 0.0);
+  const auto normals = VertexNormals::calculate(
+      mesh, VertexNormals::Weighting::ANGLE, 0.5);
+  normals.apply(cube);
+  cube.applyPendingTransform();
+  for (std::size_t i = 0U; i < cube.triangles.size(); ++i) {
+    EXPECT_TRUE(Eigen::Vector3d(cube.triangles[i].b.normal.head<3>())
+                    .isApprox(normals.getCornerNormals()[3U * i + 1U]));
+  }
+}
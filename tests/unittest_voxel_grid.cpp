@@ -0,0 +1,137 @@
+#include <Eigen/Dense>
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+#include "geometry/meshdata.hpp"
+#include "geometry/voxel_grid.hpp"
+#include "parallel.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+class VoxelGridTests : public ::testing::Test {
+protected:
+  void TearDown() { Parallel::setThreadCount(0U); }
+};
+
+namespace {
+
+static constexpr double EPSILON = 0.0000001;
+
+} // namespace
+
+TEST_F(VoxelGridTests, TestCube) {
+  const auto grid = VoxelGrid::voxelize(TestMeshes::makeCube(1.0, 4), 10U);
+  EXPECT_NEAR(grid.getVoxelSize(), 0.2, EPSILON);
+  EXPECT_EQ(grid.getDimensions(), (std::array<std::size_t, 3U>{10U, 10U,
+                                                               10U}));
+  EXPECT_TRUE(grid.getOrigin().isApprox(Eigen::Vector3d::Constant(-1.0)));
+  EXPECT_EQ(grid.getWordsPerColumn(), 1U);
+  EXPECT_EQ(grid.countFilled(), 1000U);
+  EXPECT_NEAR(grid.calculateVolume(), 8.0, EPSILON);
+  EXPECT_TRUE(grid.isFilled(9U, 0U, 5U));
+
+  // The columns span two words.
+  const auto fine_grid =
+      VoxelGrid::voxelize(TestMeshes::makeCube(1.0, 4), 100U);
+  EXPECT_EQ(fine_grid.getWordsPerColumn(), 2U);
+  EXPECT_EQ(fine_grid.countFilled(), 1000000U);
+  EXPECT_TRUE(fine_grid.isFilled(0U, 99U, 99U));
+
+  EXPECT_EQ(VoxelGrid::voxelize(MeshData{}).countFilled(), 0U);
+}
+
+TEST_F(VoxelGridTests, TestMatchesIsPointInside) {
+  // A rotated cube whose faces cut through the voxels.
+  auto cube = TestMeshes::makeCube(1.0, 3);
+  cube.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{0.5, 0.25, 0.0}),
+      Utility::getRotationMatrix(Eigen::Vector3d{1.0, 2.0, 3.0}, 0.7),
+      Eigen::Matrix4d::Identity());
+  const auto grid = VoxelGrid::voxelize(cube, 40U);
+
+  cube.applyPendingTransform();
+  const auto &dimensions = grid.getDimensions();
+  std::size_t mismatch_count = 0U;
+  for (std::size_t z = 0U; z < dimensions[2U]; ++z) {
+    for (std::size_t y = 0U; y < dimensions[1U]; ++y) {
+      for (std::size_t x = 0U; x < dimensions[0U]; ++x) {
+        const Eigen::Vector3d center =
+            grid.getOrigin() +
+            grid.getVoxelSize() *
+                (Eigen::Vector3d(static_cast<double>(x),
+                                 static_cast<double>(y),
+                                 static_cast<double>(z)) +
+                 Eigen::Vector3d::Constant(0.5));
+        const Eigen::Vector4d point{center.x(), center.y(), center.z(), 1.0};
+        mismatch_count += grid.isFilled(x, y, z) != cube.isPointInside(point);
+      }
+    }
+  }
+  EXPECT_EQ(mismatch_count, 0U);
+  EXPECT_NEAR(grid.calculateVolume(), 8.0, 0.1);
+}
+
+TEST_F(VoxelGridTests, TestAxisAlignedEdges) {
+  // With a voxel as large as a quad, every column center lies in the middle
+  // of a quad of the top and bottom faces, exactly on the diagonal shared by
+  // its two Triangles, and every column still has to be counted once. The
+  // grid follows the bounding box, so the translation by half a voxel along
+  // x and y leaves the centers on the diagonals.
+  auto cube = TestMeshes::makeCube(1.0, 8);
+  cube.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{0.125, 0.125, 0.0}),
+      Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity());
+  const auto grid = VoxelGrid::voxelize(cube, 8U);
+  EXPECT_EQ(grid.countFilled(), 512U);
+}
+
+TEST_F(VoxelGridTests, TestFarFromOrigin) {
+  // Floats are 8 apart at 1e8, so absolute single precision positions
+  // would collapse the cube.
+  auto cube = TestMeshes::makeCube(1.0, 4);
+  cube.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d::Constant(1.0e8)),
+      Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity());
+  const auto grid = VoxelGrid::voxelize(cube, 10U);
+  EXPECT_TRUE(grid.getOrigin().isApprox(
+      Eigen::Vector3d::Constant(1.0e8 - 1.0)));
+  EXPECT_EQ(grid.countFilled(), 1000U);
+}
+
+TEST_F(VoxelGridTests, TestThreadCountIndependence) {
+  auto cube = TestMeshes::makeCube(1.0, 16);
+  cube.deferTransform(Eigen::Matrix4d::Identity(),
+                      Utility::getRotationMatrix(
+                          Eigen::Vector3d{0.0, 1.0, 1.0}, 0.4),
+                      Eigen::Matrix4d::Identity());
+
+  Parallel::setThreadCount(1U);
+  const auto serial = VoxelGrid::voxelize(cube, 100U);
+  Parallel::setThreadCount(4U);
+  const auto parallel = VoxelGrid::voxelize(cube, 100U);
+
+  EXPECT_EQ(serial.getWords(), parallel.getWords());
+}
+
+TEST_F(VoxelGridTests, TestWrite) {
+  const auto grid = VoxelGrid::voxelize(TestMeshes::makeCube(1.0, 2), 4U);
+  std::ostringstream stream;
+  grid.write(stream);
+  const std::string data = stream.str();
+
+  EXPECT_EQ(data.rfind("NRRD0004\n", 0U), 0U);
+  EXPECT_NE(data.find("sizes: 4 4 4\n"), std::string::npos);
+  EXPECT_NE(data.find("space origin: (-0.75,-0.75,-0.75)\n"),
+            std::string::npos);
+  const std::size_t header_end = data.find("\n\n") + 2U;
+  ASSERT_EQ(data.size() - header_end, 4U * 4U * 4U);
+  for (std::size_t i = 0U; i < 4U * 4U * 4U; ++i) {
+    EXPECT_EQ(data[header_end + i],
+              grid.isFilled(i % 4U, i / 4U % 4U, i / 16U) ? 1 : 0);
+  }
+}
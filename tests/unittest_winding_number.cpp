@@ -0,0 +1,79 @@
+#include <Eigen/Dense>
+
+#include "geometry/meshdata.hpp"
+#include "geometry/winding_number.hpp"
+#include "test_meshes.hpp"
+#include "utility.hpp"
+#include "gtest/gtest.h"
+
+using namespace Converter;
+
+namespace {
+
+static constexpr double EPSILON = 0.05;
+
+}
+
+TEST(WindingNumberTests, TestClosedMesh) {
+  const auto cube = TestMeshes::makeCube(1.0, 16);
+  WindingNumber winding_number(cube);
+
+  EXPECT_NEAR(winding_number.calculate({0.0, 0.0, 0.0, 1.0}), 1.0, EPSILON);
+  EXPECT_NEAR(winding_number.calculate({0.9, -0.8, 0.95, 1.0}), 1.0, EPSILON);
+  EXPECT_NEAR(winding_number.calculate({1.1, 0.0, 0.0, 1.0}), 0.0, EPSILON);
+  EXPECT_NEAR(winding_number.calculate({30.0, -20.0, 10.0, 1.0}), 0.0,
+              EPSILON);
+
+  EXPECT_TRUE(winding_number.isPointInside({0.5, 0.5, 0.5, 1.0}));
+  EXPECT_TRUE(winding_number.isPointInside({-0.99, 0.0, 0.99, 1.0}));
+  EXPECT_FALSE(winding_number.isPointInside({-1.01, 0.0, 0.0, 1.0}));
+  EXPECT_FALSE(winding_number.isPointInside({0.0, 5.0, 0.0, 1.0}));
+}
+
+TEST(WindingNumberTests, TestMatchesExactEvaluation) {
+  const auto cube = TestMeshes::makeCube(2.0, 12);
+  WindingNumber approximate(cube);
+  // With an infinite accuracy ratio every triangle is evaluated exactly.
+  WindingNumber exact(cube, 1e300);
+
+  for (const Eigen::Vector4d &point :
+       {Eigen::Vector4d{0.3, 0.2, 0.1, 1.0},
+        Eigen::Vector4d{2.5, 0.0, 0.0, 1.0},
+        Eigen::Vector4d{1.9, 1.9, -1.9, 1.0},
+        Eigen::Vector4d{-7.0, 3.0, 1.0, 1.0}}) {
+    EXPECT_NEAR(approximate.calculate(point), exact.calculate(point), EPSILON);
+  }
+}
+
+TEST(WindingNumberTests, TestOpenMesh) {
+  auto cube = TestMeshes::makeCube(1.0, 4);
+  // Punch a hole into the -x face.
+  cube.triangles.erase(cube.triangles.begin() + 8 * 4,
+                       cube.triangles.begin() + 8 * 4 + 2);
+  WindingNumber winding_number(cube);
+
+  EXPECT_TRUE(winding_number.isPointInside({0.0, 0.0, 0.0, 1.0}));
+  EXPECT_TRUE(winding_number.isPointInside({0.3, -0.6, 0.7, 1.0}));
+  EXPECT_FALSE(winding_number.isPointInside({0.0, 0.0, 3.0, 1.0}));
+  EXPECT_FALSE(winding_number.isPointInside({0.0, 3.0, 0.0, 1.0}));
+}
+
+TEST(WindingNumberTests, TestEmptyMesh) {
+  MeshData mesh;
+  WindingNumber winding_number(mesh);
+  EXPECT_DOUBLE_EQ(winding_number.calculate({0.0, 0.0, 0.0, 1.0}), 0.0);
+}
+
+TEST(WindingNumberTests, TestPendingTransform) {
+  auto cube = TestMeshes::makeCube(1.0, 8);
+  cube.deferTransform(
+      Utility::getTranslationMatrix(Eigen::Vector3d{5.0, 0.0, 0.0}),
+      Eigen::Matrix4d::Identity(),
+      Utility::getScaleMatrix(Eigen::Vector3d{2.0, 1.0, 1.0}));
+  WindingNumber winding_number(cube);
+
+  EXPECT_NEAR(winding_number.calculate({5.0, 0.0, 0.0, 1.0}), 1.0, EPSILON);
+  EXPECT_NEAR(winding_number.calculate({6.8, 0.0, 0.0, 1.0}), 1.0, EPSILON);
+  EXPECT_NEAR(winding_number.calculate({0.0, 0.0, 0.0, 1.0}), 0.0, EPSILON);
+  EXPECT_FALSE(winding_number.isPointInside({7.2, 0.0, 0.0, 1.0}));
+}